@@ -228,6 +228,10 @@ namespace ToolKit
     {
       m_deltaTime = deltaTime;
 
+      // Keep the file index of the asset browsers up to date.
+      m_fileIndex.SetRoots({ResourcePath(), DefaultAbsolutePath()});
+      m_fileIndex.Update();
+
       // Update Mods.
       ModManager::GetInstance()->Update(deltaTime);
 
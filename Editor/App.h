@@ -10,6 +10,7 @@
 #include "DynamicMenu.h"
 #include "EditorRenderer.h"
 #include "EditorTypes.h"
+#include "FileIndex.h"
 #include "SimulationWindow.h"
 #include "Thumbnail.h"
 #include "Workspace.h"
@@ -203,6 +204,7 @@ namespace ToolKit
       float m_camSpeed         = 8.0; // Meters per sec.
       float m_mouseSensitivity = 0.08f;
       ThumbnailManager m_thumbnailManager;
+      FileIndex m_fileIndex; //!< Files of the project and the engine resources.
 
       // Simulator settings.
       EditorViewportPtr m_simulationViewport;
@@ -14,6 +14,7 @@
 
 #include <DirectionComponent.h>
 #include <Drawable.h>
+#include <MemoryTracker.h>
 #include <Mesh.h>
 #include <PluginManager.h>
 
@@ -730,6 +731,64 @@ namespace ToolKit
       }
     }
 
+    void MemoryReport(TagArgArray tagArgs)
+    {
+      static MemorySnapshot baseline;
+      static bool hasBaseline = false;
+
+      MemorySnapshot current  = MemoryTracker::TakeSnapshot();
+      MemorySnapshot report   = current;
+
+      if (GetTag("snapshot", tagArgs) != tagArgs.end())
+      {
+        baseline    = current;
+        hasBaseline = true;
+        TK_LOG("Memory baseline is taken.");
+        return;
+      }
+
+      if (GetTag("diff", tagArgs) != tagArgs.end())
+      {
+        if (!hasBaseline)
+        {
+          TK_WRN("Take a baseline first with: MemoryReport --snapshot");
+          return;
+        }
+
+        report = MemoryTracker::Diff(baseline, current);
+      }
+
+      TagArgCIt exportTag = GetTag("export", tagArgs);
+      if (exportTag != tagArgs.end())
+      {
+        if (exportTag->second.empty())
+        {
+          TK_WRN("call command with arg: --export <file>");
+          return;
+        }
+
+        if (MemoryTracker::Export(report, exportTag->second.front()))
+        {
+          TK_LOG("Memory report is exported to: %s", exportTag->second.front().c_str());
+        }
+        return;
+      }
+
+      int count          = 20;
+      TagArgCIt countTag = GetTag("count", tagArgs);
+      if (countTag != tagArgs.end() && !countTag->second.empty())
+      {
+        count = std::atoi(countTag->second.front().c_str());
+      }
+
+      StringArray lines;
+      Split(MemoryTracker::Report(report, count), "\n", lines);
+      for (const String& line : lines)
+      {
+        TK_LOG("%s", line.c_str());
+      }
+    }
+
     // ImGui ripoff. Portable helpers.
     static int Stricmp(const char* str1, const char* str2)
     {
@@ -795,6 +854,7 @@ namespace ToolKit
       CreateCommand(g_deleteSelection, DeleteSelection);
       CreateCommand(g_showProfileTimer, ShowProfileTimer);
       CreateCommand(g_selectSimilar, SelectSimilar);
+      CreateCommand(g_memoryReport, MemoryReport);
     }
 
     ConsoleWindow::~ConsoleWindow() {}
@@ -104,6 +104,9 @@ namespace ToolKit
     const String g_selectSimilar("SelectSimilar");
     TK_EDITOR_API void SelectSimilar(TagArgArray tagArgs);
 
+    const String g_memoryReport("MemoryReport");
+    TK_EDITOR_API void MemoryReport(TagArgArray tagArgs);
+
     // Command errors
     const String g_noValidEntity("No valid entity");
 
@@ -62,7 +62,5 @@ namespace ToolKit
       return nullptr;
     }
 
-    RenderTargetPtr DirectoryEntry::GetThumbnail() const { return GetApp()->m_thumbnailManager.GetThumbnail(*this); }
-
   } // namespace Editor
 } // namespace ToolKit
\ No newline at end of file
@@ -21,7 +21,6 @@ namespace ToolKit
       explicit DirectoryEntry(const String& fullPath);
       String GetFullPath() const;
       ResourceManager* GetManager() const;
-      RenderTargetPtr GetThumbnail() const;
 
      public:
       String m_ext;
@@ -290,7 +290,14 @@ namespace ToolKit
       for (const UILayerPtr& layer : layers)
       {
         EntityRawPtrArray rawNtties = ToEntityRawPtrArray(layer->m_scene->GetEntities());
-        RenderJobProcessor::CreateRenderJobs(m_uiRenderData.jobs, rawNtties);
+        RenderJobProcessor::CreateRenderJobs(m_uiRenderData.jobs,
+                                             rawNtties,
+                                             false,
+                                             0,
+                                             {},
+                                             {},
+                                             GetUIManager()->GetUICamera().get(),
+                                             viewport->m_wndContentAreaSize.y);
       }
 
       RenderJobProcessor::SeperateRenderData(m_uiRenderData, true);
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "FileIndex.h"
+
+#include <Threads.h>
+#include <ToolKit.h>
+#include <Util.h>
+
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+
+namespace ToolKit
+{
+  namespace Editor
+  {
+
+    /** @return Path in a form that is the same for all spellings of it. */
+    static String NormalizeFolderPath(const String& path)
+    {
+      String normal = std::filesystem::path(path).lexically_normal().u8string();
+      if (normal.size() > 1 && (normal.back() == '/' || normal.back() == '\\'))
+      {
+        normal.pop_back();
+      }
+
+      return normal;
+    }
+
+    /** Collects the lower cased trigrams of the name. Trigrams with non ascii bytes are skipped. */
+    static void GetTrigrams(const String& name, std::vector<uint>& trigrams)
+    {
+      trigrams.clear();
+      for (size_t i = 0; i + 2 < name.size(); i++)
+      {
+        uint trigram = 0;
+        bool ascii   = true;
+        for (size_t j = i; j < i + 3; j++)
+        {
+          uint8 c = (uint8) name[j];
+          if (c >= 0x80)
+          {
+            ascii = false;
+            break;
+          }
+
+          trigram = (trigram << 8) | (uint8) std::tolower(c);
+        }
+
+        if (ascii)
+        {
+          trigrams.push_back(trigram);
+        }
+      }
+    }
+
+    // FileIndexSnapshot
+    //////////////////////////////////////////
+
+    bool FileIndexSnapshot::ListFolder(const String& path, std::vector<DirectoryEntry>& entries) const
+    {
+      int folder = FindFolder(path);
+      if (folder == -1)
+      {
+        return false;
+      }
+
+      const std::vector<int>& folderEntries = m_folderEntries[folder];
+      entries.reserve(entries.size() + folderEntries.size());
+      for (int entry : folderEntries)
+      {
+        entries.push_back(MakeDirectoryEntry(entry));
+      }
+
+      return true;
+    }
+
+    uint64 FileIndexSnapshot::GetFolderVersion(const String& path) const
+    {
+      int folder = FindFolder(path);
+      if (folder == -1)
+      {
+        return 0;
+      }
+
+      return m_folderVersions[folder];
+    }
+
+    void FileIndexSnapshot::Search(const String& query, int maxResults, std::vector<DirectoryEntry>& results) const
+    {
+      if (query.empty())
+      {
+        return;
+      }
+
+      std::vector<uint> trigrams;
+      GetTrigrams(query, trigrams);
+
+      // Candidates are the entries that have all trigrams of the query. Lists are intersected starting from the
+      // shortest one.
+      std::vector<const std::vector<int>*> lists;
+      for (uint trigram : trigrams)
+      {
+        auto list = m_trigrams.find(trigram);
+        if (list == m_trigrams.end())
+        {
+          return;
+        }
+
+        lists.push_back(&list->second);
+      }
+
+      std::sort(lists.begin(),
+                lists.end(),
+                [](const std::vector<int>* a, const std::vector<int>* b) -> bool { return a->size() < b->size(); });
+
+      auto compareFn = [&](int entry) -> void
+      {
+        if ((int) results.size() < maxResults && Utf8CaseInsensitiveSearch(m_entries[entry].name, query))
+        {
+          results.push_back(MakeDirectoryEntry(entry));
+        }
+      };
+
+      if (lists.empty())
+      {
+        // Query is too short or has no ascii trigram, all names are compared.
+        for (int entry = 0; entry < (int) m_entries.size() && (int) results.size() < maxResults; entry++)
+        {
+          compareFn(entry);
+        }
+
+        return;
+      }
+
+      for (int entry : *lists[0])
+      {
+        bool candidate = true;
+        for (size_t i = 1; i < lists.size() && candidate; i++)
+        {
+          candidate = std::binary_search(lists[i]->begin(), lists[i]->end(), entry);
+        }
+
+        if (candidate)
+        {
+          compareFn(entry);
+        }
+
+        if ((int) results.size() >= maxResults)
+        {
+          break;
+        }
+      }
+    }
+
+    int FileIndexSnapshot::GetEntryCount() const { return (int) m_entries.size(); }
+
+    int FileIndexSnapshot::FindFolder(const String& path) const
+    {
+      auto folder = m_folderLookup.find(NormalizeFolderPath(path));
+      if (folder == m_folderLookup.end())
+      {
+        return -1;
+      }
+
+      return folder->second;
+    }
+
+    DirectoryEntry FileIndexSnapshot::MakeDirectoryEntry(int entry) const
+    {
+      const FileIndexEntry& indexEntry = m_entries[entry];
+      std::filesystem::path name       = std::filesystem::path(indexEntry.name);
+
+      DirectoryEntry dirEnt;
+      dirEnt.m_isDirectory = indexEntry.isDirectory;
+      dirEnt.m_rootPath    = m_folders[indexEntry.folder];
+      dirEnt.m_fileName    = name.stem().u8string();
+      dirEnt.m_ext         = name.extension().u8string();
+
+      return dirEnt;
+    }
+
+    // FileIndex
+    //////////////////////////////////////////
+
+    /** Content of a folder as of its last listing. */
+    struct IndexedFolder
+    {
+      uint64 writeTime = 0;                          //!< Modification time of the folder when it is listed.
+      uint64 version   = 0;                          //!< Scan that the folder is listed in.
+      std::vector<std::pair<String, bool>> children; //!< Names of the files and folders, true for folders.
+    };
+
+    /** State of the background scans. Only the scan task modifies the folders. */
+    struct FileIndex::ScanState
+    {
+      StringArray roots;
+      std::unordered_map<String, IndexedFolder> folders;
+      uint64 scanCount = 0;
+
+      std::atomic_bool scanning {false};
+      std::atomic_bool cancel {false};
+
+      mutable Mutex snapshotMutex;
+      FileIndexSnapshotPtr snapshot;
+    };
+
+    FileIndex::FileIndex() {}
+
+    FileIndex::~FileIndex()
+    {
+      if (m_state != nullptr)
+      {
+        m_state->cancel = true;
+      }
+    }
+
+    void FileIndex::SetRoots(const StringArray& roots)
+    {
+      if (roots == m_roots)
+      {
+        return;
+      }
+
+      // A running scan of the previous roots is abandoned, it finishes on its own copy of the state.
+      if (m_state != nullptr)
+      {
+        m_state->cancel = true;
+      }
+
+      m_roots        = roots;
+      m_state        = std::make_shared<ScanState>();
+      m_state->roots = roots;
+      m_lastScan     = 0.0f;
+    }
+
+    void FileIndex::Update()
+    {
+      if (m_state == nullptr || m_state->scanning)
+      {
+        return;
+      }
+
+      float now = GetElapsedMilliSeconds();
+      if (m_lastScan != 0.0f && now - m_lastScan < m_pollInterval)
+      {
+        return;
+      }
+
+      m_lastScan        = now;
+      m_state->scanning = true;
+
+      std::shared_ptr<ScanState> state = m_state;
+      TKAsyncTask(WorkerManager::BackgroundPool,
+                  [state]() -> void
+                  {
+                    Scan(*state);
+                    state->scanning = false;
+                  });
+    }
+
+    FileIndexSnapshotPtr FileIndex::GetSnapshot() const
+    {
+      if (m_state == nullptr)
+      {
+        return nullptr;
+      }
+
+      LockGuard lock(m_state->snapshotMutex);
+      return m_state->snapshot;
+    }
+
+    void FileIndex::Scan(ScanState& state)
+    {
+      float startTime = GetElapsedMilliSeconds();
+      uint64 scan     = ++state.scanCount;
+      bool changed    = false;
+
+      std::unordered_set<String> visited;
+      StringArray stack(state.roots.rbegin(), state.roots.rend());
+      while (!stack.empty())
+      {
+        if (state.cancel)
+        {
+          return;
+        }
+
+        String path = stack.back();
+        stack.pop_back();
+
+        std::error_code err;
+        if (!std::filesystem::is_directory(path, err) || !visited.insert(path).second)
+        {
+          continue;
+        }
+
+        uint64 writeTime      = (uint64) std::filesystem::last_write_time(path, err).time_since_epoch().count();
+        IndexedFolder& folder = state.folders[path];
+        if (folder.version == 0 || folder.writeTime != writeTime)
+        {
+          // Adding, removing or renaming an entry changes the modification time of the folder.
+          folder.writeTime = writeTime;
+          folder.version   = scan;
+          folder.children.clear();
+          changed = true;
+
+          for (const auto& entry : std::filesystem::directory_iterator(path, err))
+          {
+            String stem = entry.path().stem().u8string();
+
+            // Do not index hidden files.
+            if (stem.size() > 1 && stem[0] == '.')
+            {
+              continue;
+            }
+
+            folder.children.push_back({entry.path().filename().u8string(), entry.is_directory(err)});
+          }
+
+          // Folders first, files next.
+          std::sort(folder.children.begin(),
+                    folder.children.end(),
+                    [](const std::pair<String, bool>& a, const std::pair<String, bool>& b) -> bool
+                    { return a.second != b.second ? a.second : a.first < b.first; });
+        }
+
+        for (auto child = folder.children.rbegin(); child != folder.children.rend(); child++)
+        {
+          if (child->second)
+          {
+            stack.push_back((std::filesystem::path(path) / child->first).u8string());
+          }
+        }
+      }
+
+      // Folders that are removed.
+      for (auto folder = state.folders.begin(); folder != state.folders.end();)
+      {
+        if (visited.count(folder->first) == 0)
+        {
+          folder  = state.folders.erase(folder);
+          changed = true;
+        }
+        else
+        {
+          folder++;
+        }
+      }
+
+      if (!changed)
+      {
+        return;
+      }
+
+      std::shared_ptr<FileIndexSnapshot> snapshot = BuildSnapshot(state);
+      if (state.cancel)
+      {
+        return;
+      }
+
+      snapshot->m_version   = scan;
+      snapshot->m_buildTime = GetElapsedMilliSeconds() - startTime;
+
+      bool firstBuild       = false;
+      {
+        LockGuard lock(state.snapshotMutex);
+        firstBuild     = state.snapshot == nullptr;
+        state.snapshot = snapshot;
+      }
+
+      if (firstBuild)
+      {
+        TK_LOG("File index: %d entries in %.2f ms.", snapshot->GetEntryCount(), snapshot->m_buildTime);
+      }
+    }
+
+    std::shared_ptr<FileIndexSnapshot> FileIndex::BuildSnapshot(ScanState& state)
+    {
+      std::shared_ptr<FileIndexSnapshot> snapshot = std::make_shared<FileIndexSnapshot>();
+
+      // Folders are ordered by path so that the entries, and the search results, have a stable order.
+      StringArray folders;
+      folders.reserve(state.folders.size());
+      for (const auto& folder : state.folders)
+      {
+        folders.push_back(folder.first);
+      }
+      std::sort(folders.begin(), folders.end());
+
+      snapshot->m_folders = folders;
+      snapshot->m_folderVersions.resize(folders.size());
+      snapshot->m_folderEntries.resize(folders.size());
+
+      std::vector<uint> trigrams;
+      for (int i = 0; i < (int) folders.size(); i++)
+      {
+        const IndexedFolder& folder   = state.folders[folders[i]];
+        snapshot->m_folderVersions[i] = folder.version;
+        snapshot->m_folderLookup.insert({NormalizeFolderPath(folders[i]), i});
+
+        for (const auto& child : folder.children)
+        {
+          int entry = (int) snapshot->m_entries.size();
+          snapshot->m_entries.push_back({i, child.first, child.second});
+          snapshot->m_folderEntries[i].push_back(entry);
+
+          // Entries are added in ascending order, a repeated trigram of the same name is only added once.
+          GetTrigrams(child.first, trigrams);
+          for (uint trigram : trigrams)
+          {
+            std::vector<int>& list = snapshot->m_trigrams[trigram];
+            if (list.empty() || list.back() != entry)
+            {
+              list.push_back(entry);
+            }
+          }
+        }
+      }
+
+      return snapshot;
+    }
+
+  } // namespace Editor
+} // namespace ToolKit
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "DirectoryEntry.h"
+
+namespace ToolKit
+{
+  namespace Editor
+  {
+
+    // FileIndexSnapshot
+    //////////////////////////////////////////
+
+    /** A file or a folder in the index. */
+    struct FileIndexEntry
+    {
+      int folder       = -1;    //!< Index of the folder that contains the entry.
+      String name;              //!< File name with its extension.
+      bool isDirectory = false;
+    };
+
+    /**
+     * State of the file index at a point in time. Snapshots are never modified once they are published, the ui reads
+     * them without locking.
+     */
+    class TK_EDITOR_API FileIndexSnapshot
+    {
+      friend class FileIndex;
+
+     public:
+      /**
+       * Lists the content of the folder, folders first, each sorted by name.
+       * @return False if the folder is not in the index.
+       */
+      bool ListFolder(const String& path, std::vector<DirectoryEntry>& entries) const;
+
+      /** @return Version of the folder that changes when its content changes, 0 if the folder is not in the index. */
+      uint64 GetFolderVersion(const String& path) const;
+
+      /**
+       * Finds the entries whose names contain the query, case insensitive. Names are looked up through their trigrams,
+       * only the candidates that contain all trigrams of the query are compared.
+       * @param maxResults is the maximum number of entries to return.
+       */
+      void Search(const String& query, int maxResults, std::vector<DirectoryEntry>& results) const;
+
+      /** @return Number of files and folders in the index. */
+      int GetEntryCount() const;
+
+     private:
+      int FindFolder(const String& path) const;
+      DirectoryEntry MakeDirectoryEntry(int entry) const;
+
+     public:
+      uint64 m_version  = 0;    //!< Increases with each published snapshot.
+      float m_buildTime = 0.0f; //!< Milliseconds spent to scan the changes and build the snapshot.
+
+     private:
+      StringArray m_folders;                                 //!< Paths of the folders.
+      std::vector<uint64> m_folderVersions;                  //!< Version of each folder.
+      std::vector<std::vector<int>> m_folderEntries;         //!< Entries of each folder in the listing order.
+      std::unordered_map<String, int> m_folderLookup;        //!< Normalized folder path to folder index.
+      std::vector<FileIndexEntry> m_entries;                 //!< All files and folders.
+      std::unordered_map<uint, std::vector<int>> m_trigrams; //!< Lower case name trigram to ascending entry indices.
+    };
+
+    typedef std::shared_ptr<const FileIndexSnapshot> FileIndexSnapshotPtr;
+
+    // FileIndex
+    //////////////////////////////////////////
+
+    /**
+     * Index of all files under the given root folders, built on a background thread. The folders are polled for
+     * changes periodically. Only the folders whose modification time has changed are listed again and a new snapshot
+     * is published if anything has changed.
+     */
+    class TK_EDITOR_API FileIndex
+    {
+     public:
+      FileIndex();
+      ~FileIndex();
+
+      /** Sets the folders to index. The index is built again if the roots differ from the current ones. */
+      void SetRoots(const StringArray& roots);
+
+      /** Starts a scan in the background if the poll interval has passed and no scan is in progress. */
+      void Update();
+
+      /** @return Latest snapshot of the index, nullptr until the first scan completes. */
+      FileIndexSnapshotPtr GetSnapshot() const;
+
+     public:
+      float m_pollInterval = 2000.0f; //!< Milliseconds between the scans for changes.
+
+     private:
+      struct ScanState;
+
+      /** Lists the changed folders and publishes a new snapshot if there are changes. */
+      static void Scan(ScanState& state);
+
+      /** Builds the snapshot from the listed folders. */
+      static std::shared_ptr<FileIndexSnapshot> BuildSnapshot(ScanState& state);
+
+     private:
+      StringArray m_roots;
+      std::shared_ptr<ScanState> m_state; //!< Shared with the scan task, which may outlive the index.
+      float m_lastScan = 0.0f;
+    };
+
+  } // namespace Editor
+} // namespace ToolKit
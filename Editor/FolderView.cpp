@@ -66,6 +66,7 @@ namespace ToolKit
       ImGui::BeginTable("##FilterZoom", 5, ImGuiTableFlags_SizingFixedFit);
 
       ImGui::TableSetupColumn("##flt", ImGuiTableColumnFlags_WidthStretch);
+      ImGui::TableSetupColumn("##prjsrc");
       ImGui::TableSetupColumn("##zoom");
       ImGui::TableSetupColumn("##tglzoom");
 
@@ -77,6 +78,11 @@ namespace ToolKit
       ImGui::InputTextWithHint(" Search", "Search", &m_filter);
       ImGui::PopItemWidth();
 
+      // Project search.
+      ImGui::TableNextColumn();
+      ImGui::Checkbox("All##prjsrc", &m_searchProject);
+      UI::HelpMarker(TKLoc, "Searches the whole project instead of this folder.");
+
       // Zoom.
       ImGui::TableNextColumn();
       ImGui::Text("%.0f%%", GetThumbnailZoomPercent(thumbnailZoom));
@@ -230,9 +236,10 @@ namespace ToolKit
         std::swap(a, b);
       }
 
-      for (int i = a; i <= b; i++)
+      // Only the entries that pass the filter are selected.
+      for (int i : m_visibleEntries)
       {
-        if (!contains(g_selectedFiles, m_entries.data() + i))
+        if (i >= a && i <= b && !contains(g_selectedFiles, m_entries.data() + i))
         {
           g_selectedFiles.push_back(m_entries.data() + i);
         }
@@ -296,12 +303,42 @@ namespace ToolKit
 
         DrawSearchBar();
 
+        // Project search lists different entries for each filter, folder listing only hides the filtered ones.
+        if (m_listingSearch != IsProjectSearch() || (m_listingSearch && m_appliedFilter != m_filter))
+        {
+          m_dirty = true;
+        }
+        else if (m_appliedFilter != m_filter)
+        {
+          m_appliedFilter = m_filter;
+          m_visibleDirty  = true;
+        }
+
+        // Listing is refreshed when the file index reports a change for it.
+        if (FileIndexSnapshotPtr snapshot = GetApp()->m_fileIndex.GetSnapshot())
+        {
+          if (snapshot->m_version != m_seenVersion)
+          {
+            m_seenVersion  = snapshot->m_version;
+            uint64 version = m_listingSearch ? snapshot->m_version : snapshot->GetFolderVersion(m_path);
+            if (version != m_indexVersion)
+            {
+              m_dirty = true;
+            }
+          }
+        }
+
         if (m_dirty)
         {
           Iterate();
           m_dirty = false;
         }
 
+        if (m_visibleDirty)
+        {
+          UpdateVisibleEntries();
+        }
+
         // Item dropped to tab.
         MoveTo(m_path);
 
@@ -321,217 +358,241 @@ namespace ToolKit
         }
 
         bool anyButtonClicked = false;
-        // Draw folder items.
-        for (int i = 0; i < (int) m_entries.size(); i++)
-        {
-          // Prepare Item Icon.
-          ImGuiStyle& style      = ImGui::GetStyle();
-          float visX2            = ImGui::GetWindowPos().x + ImGui::GetWindowContentRegionMax().x;
 
-          DirectoryEntry& dirEnt = m_entries[i];
+        // Draw folder items in a grid of equal sized cells, only the visible rows are laid out.
+        ImGuiStyle& style  = ImGui::GetStyle();
+        float cellWidth    = m_iconSize.x + style.FramePadding.x * 2.0f;
+        float cellHeight   = m_iconSize.y + style.FramePadding.y * 2.0f + style.ItemSpacing.y;
+        cellHeight        += ImGui::GetTextLineHeight() * 2.0f;
 
-          if (m_filter.size() > 0 && !Utf8CaseInsensitiveSearch(dirEnt.m_fileName, m_filter))
+        float regionWidth  = ImGui::GetContentRegionAvail().x + style.ItemSpacing.x;
+        int columns        = glm::max(1, (int) (regionWidth / (cellWidth + style.ItemSpacing.x)));
+        int itemCount      = (int) m_visibleEntries.size();
+        int rowCount       = (itemCount + columns - 1) / columns;
+
+        ImGuiListClipper clipper;
+        clipper.Begin(rowCount, cellHeight + style.ItemSpacing.y);
+        while (clipper.Step())
+        {
+          for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
           {
-            continue;
-          }
+            int first = row * columns;
+            int last  = glm::min(first + columns, itemCount);
+            for (int item = first; item < last; item++)
+            {
+              if (item > first)
+              {
+                ImGui::SameLine();
+              }
 
-          bool flipRenderTarget = false;
-          uint iconId           = UI::m_fileIcon->m_textureId;
-
-          std::unordered_map<String, uint> extensionIconMap {
-              {SCENE,    UI::m_worldIcon->m_textureId},
-              {LAYER,    UI::m_worldIcon->m_textureId},
-              {ANIM,     UI::m_clipIcon->m_textureId },
-              {WAW,      UI::m_audioIcon->m_textureId},
-              {MP3,      UI::m_audioIcon->m_textureId},
-              {SHADER,   UI::m_codeIcon->m_textureId },
-              {LAYER,    UI::m_worldIcon->m_textureId},
-              {SKELETON, UI::m_boneIcon->m_textureId }
-          };
+              DrawEntry(m_visibleEntries[item], anyButtonClicked);
+            }
+          }
+        }
 
-          static std::unordered_set<String>
-              thumbExtensions {PNG, JPG, JPEG, TGA, BMP, PSD, HDR, MESH, SKINMESH, MATERIAL, WAW, MP3};
+        bool mouseReleased = ImGui::IsMouseReleased(ImGuiMouseButton_Left);
 
-          if (dirEnt.m_isDirectory)
-          {
-            iconId = UI::m_folderIcon->m_textureId;
-          }
-          else if (extensionIconMap.count(dirEnt.m_ext) > 0)
-          {
-            iconId = extensionIconMap[dirEnt.m_ext];
-          }
-          else if (thumbExtensions.count(dirEnt.m_ext) > 0)
+        // mouse released on empty position in this window
+        if (!anyButtonClicked && mouseReleased)
+        {
+          if (g_carryingFiles == true && g_dragBeginView != nullptr)
           {
-            if (GetApp()->m_thumbnailManager.TryGetThumbnail(iconId, dirEnt))
-            {
-              flipRenderTarget = true;
-            }
-            else
-            {
-              iconId = UI::m_imageIcon->m_textureId;
-            }
+            g_dragBeginView->DropFiles(m_path);
           }
-          else if (m_onlyNativeTypes)
+          if (!ImGui::IsKeyDown(ImGuiKey_LeftShift) && !ImGui::IsKeyDown(ImGuiKey_LeftCtrl))
           {
-            continue;
+            g_selectedFiles.clear();
           }
+        }
 
-          ImGui::PushID(i);
-          ImGui::BeginGroup();
-          ImVec2 texCoords         = flipRenderTarget ? ImVec2(1.0f, -1.0f) : ImVec2(1.0f, 1.0f);
+        g_carryingFiles = mouseReleased ? false : g_carryingFiles;
 
-          DirectoryEntry* entryPtr = m_entries.data() + i;
+        ImGui::EndChild();
 
-          bool isSelected          = contains(g_selectedFiles, entryPtr);
-          // this function will push color. we are popping it down below this if block.
-          DetermineAndSetBackgroundColor(isSelected, i);
+        ImGui::EndTabItem();
+      }
+    }
 
-          // Draw Item Icon.
-          char iconChId[16];
-          snprintf(iconChId, sizeof(iconChId), "##%d", iconId);
-          if (ImGui::ImageButton(iconChId, ConvertUIntImGuiTexture(iconId), m_iconSize, ImVec2(0.0f, 0.0f), texCoords))
-          {
-            anyButtonClicked |= true;
-            bool shiftDown    = ImGui::IsKeyDown(ImGuiKey_LeftShift);
-            bool ctrlDown     = ImGui::IsKeyDown(ImGuiKey_LeftCtrl);
-            // handle multi selection and input
-            if (!shiftDown && !ctrlDown)
-            {
-              // this means not multi selecting so select only this.
-              g_selectedFiles.clear();
-              g_selectedFiles.push_back(entryPtr);
-            }
-            else if (ctrlDown && isSelected)
-            {
-              erase_if(g_selectedFiles, [entryPtr](DirectoryEntry* other) -> bool { return other == entryPtr; });
-            }
-            else if (shiftDown && m_lastClickedEntryIdx != -1)
-            {
-              SelectFilesInRange(m_lastClickedEntryIdx, i);
-            }
-            else
-            {
-              g_selectedFiles.push_back(entryPtr);
-            }
+    void FolderView::DrawEntry(int index, bool& anyButtonClicked)
+    {
+      // Prepare Item Icon.
+      DirectoryEntry& dirEnt = m_entries[index];
+
+      uint iconId  = UI::m_fileIcon->m_textureId;
+      ImVec2 uvMin = ImVec2(0.0f, 0.0f);
+      ImVec2 uvMax = ImVec2(1.0f, 1.0f);
+
+      std::unordered_map<String, uint> extensionIconMap {
+          {SCENE,    UI::m_worldIcon->m_textureId},
+          {LAYER,    UI::m_worldIcon->m_textureId},
+          {ANIM,     UI::m_clipIcon->m_textureId },
+          {WAW,      UI::m_audioIcon->m_textureId},
+          {MP3,      UI::m_audioIcon->m_textureId},
+          {SHADER,   UI::m_codeIcon->m_textureId },
+          {LAYER,    UI::m_worldIcon->m_textureId},
+          {SKELETON, UI::m_boneIcon->m_textureId }
+      };
 
-            m_lastClickedEntryIdx = i;
-          }
+      static std::unordered_set<String>
+          thumbExtensions {PNG, JPG, JPEG, TGA, BMP, PSD, HDR, MESH, SKINMESH, MATERIAL, WAW, MP3};
 
-          if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
-          {
-            if (ResourceManager* rm = dirEnt.GetManager())
-            {
-              if (rm->m_baseType == Material::StaticClass())
-              {
-                MaterialPtr mat                  = rm->Create<Material>(dirEnt.GetFullPath());
-                MaterialWindowPtr materialWindow = MakeNewPtr<MaterialWindow>();
-                materialWindow->SetMaterial(mat);
-                materialWindow->AddToUI();
-              }
-              else if (rm->m_baseType == Mesh::StaticClass())
-              {
-                GetApp()->GetPropInspector()->SetMeshView(rm->Create<Mesh>(dirEnt.GetFullPath()));
-              }
-              else if (rm->m_baseType == SkinMesh::StaticClass())
-              {
-                GetApp()->GetPropInspector()->SetMeshView(rm->Create<SkinMesh>(dirEnt.GetFullPath()));
-              }
-            }
-          }
+      if (dirEnt.m_isDirectory)
+      {
+        iconId = UI::m_folderIcon->m_textureId;
+      }
+      else if (extensionIconMap.count(dirEnt.m_ext) > 0)
+      {
+        iconId = extensionIconMap[dirEnt.m_ext];
+      }
+      else if (thumbExtensions.count(dirEnt.m_ext) > 0)
+      {
+        // Thumbnails are requested for the visible items only, the rest would take the atlas space.
+        Thumbnail thumb;
+        if (ImGui::IsRectVisible(m_iconSize) && GetApp()->m_thumbnailManager.TryGetThumbnail(thumb, dirEnt))
+        {
+          iconId = thumb.textureId;
+          uvMin  = ImVec2(thumb.uvMin.x, thumb.uvMin.y);
+          uvMax  = ImVec2(thumb.uvMax.x, thumb.uvMax.y);
+        }
+        else
+        {
+          iconId = UI::m_imageIcon->m_textureId;
+        }
+      }
 
-          // pop colors that comming from DeterminateAndSetBackgroundColor
-          // function
-          ImGui::PopStyleColor(2);
+      ImGui::PushID(index);
+      ImGui::BeginGroup();
+      DirectoryEntry* entryPtr = m_entries.data() + index;
 
-          // Handle context menu.
-          ShowContextMenu(&dirEnt);
+      bool isSelected          = contains(g_selectedFiles, entryPtr);
+      // this function will push color. we are popping it down below this if block.
+      DetermineAndSetBackgroundColor(isSelected, index);
 
-          // Handle if item is directory.
-          if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
-          {
-            if (ImGui::IsItemHovered() && dirEnt.m_isDirectory && m_parent != nullptr)
-            {
-              String path = ConcatPaths({dirEnt.m_rootPath, dirEnt.m_fileName});
-              SelectFolder(m_parent, path);
-            }
-          }
+      // Draw Item Icon.
+      char iconChId[16];
+      snprintf(iconChId, sizeof(iconChId), "##%d", iconId);
+      if (ImGui::ImageButton(iconChId, ConvertUIntImGuiTexture(iconId), m_iconSize, uvMin, uvMax))
+      {
+        anyButtonClicked |= true;
+        bool shiftDown    = ImGui::IsKeyDown(ImGuiKey_LeftShift);
+        bool ctrlDown     = ImGui::IsKeyDown(ImGuiKey_LeftCtrl);
+        // handle multi selection and input
+        if (!shiftDown && !ctrlDown)
+        {
+          // this means not multi selecting so select only this.
+          g_selectedFiles.clear();
+          g_selectedFiles.push_back(entryPtr);
+        }
+        else if (ctrlDown && isSelected)
+        {
+          erase_if(g_selectedFiles, [entryPtr](DirectoryEntry* other) -> bool { return other == entryPtr; });
+        }
+        else if (shiftDown && m_lastClickedEntryIdx != -1)
+        {
+          SelectFilesInRange(m_lastClickedEntryIdx, index);
+        }
+        else
+        {
+          g_selectedFiles.push_back(entryPtr);
+        }
 
-          // Handle mouse hover tips.
-          String fullName = dirEnt.m_fileName + dirEnt.m_ext;
-          UI::HelpMarker(TKLoc + fullName, fullName.c_str());
+        m_lastClickedEntryIdx = index;
+      }
 
-          // Handle drag - drop to scene / inspector.
-          if (!dirEnt.m_isDirectory)
+      if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+      {
+        if (ResourceManager* rm = dirEnt.GetManager())
+        {
+          if (rm->m_baseType == Material::StaticClass())
           {
-            ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
-
-            if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
-            {
-              // if the file that we are holding is not selected
-              if (!isSelected)
-              {
-                // add to selection
-                g_selectedFiles.push_back(&dirEnt);
-              }
-              g_fileDragData.Entries  = g_selectedFiles.data();
-              g_fileDragData.NumFiles = (int) g_selectedFiles.size();
-              g_dragBeginView         = this;
-              g_carryingFiles         = true;
-
-              ImGui::SetDragDropPayload("BrowserDragZone", &g_fileDragData, sizeof(FileDragData));
-
-              char iconChId[16];
-              snprintf(iconChId, sizeof(iconChId), "##dragIcon%d", i);
-              ImGui::ImageButton(iconChId, ConvertUIntImGuiTexture(iconId), m_iconSize, ImVec2(0.0f, 0.0f), texCoords);
-              ImGui::EndDragDropSource();
-            }
-            ImGui::PopStyleColor();
+            MaterialPtr mat                  = rm->Create<Material>(dirEnt.GetFullPath());
+            MaterialWindowPtr materialWindow = MakeNewPtr<MaterialWindow>();
+            materialWindow->SetMaterial(mat);
+            materialWindow->AddToUI();
           }
-
-          // Make directories drop target for resources.
-          if (dirEnt.m_isDirectory)
+          else if (rm->m_baseType == Mesh::StaticClass())
           {
-            MoveTo(ConcatPaths({dirEnt.m_rootPath, dirEnt.m_fileName}));
+            GetApp()->GetPropInspector()->SetMeshView(rm->Create<Mesh>(dirEnt.GetFullPath()));
           }
+          else if (rm->m_baseType == SkinMesh::StaticClass())
+          {
+            GetApp()->GetPropInspector()->SetMeshView(rm->Create<SkinMesh>(dirEnt.GetFullPath()));
+          }
+        }
+      }
 
-          // Handle Item sub text.
-          ImGui::PushTextWrapPos(ImGui::GetCursorPos().x + m_iconSize.x);
-          ImGui::TextWrapped("%s", dirEnt.m_fileName.c_str());
+      // pop colors that comming from DeterminateAndSetBackgroundColor
+      // function
+      ImGui::PopStyleColor(2);
 
-          ImGui::PopTextWrapPos();
-          ImGui::EndGroup();
-          ImGui::PopID();
+      // Handle context menu.
+      ShowContextMenu(&dirEnt);
 
-          // Handle next column / row.
-          float lastBtnX2 = ImGui::GetItemRectMax().x;
-          float nextBtnX2 = lastBtnX2 + style.ItemSpacing.x + m_iconSize.x;
-          if (nextBtnX2 < visX2)
-          {
-            ImGui::SameLine();
-          }
-        } // Tab item handling ends(for loop).
+      // Handle if item is directory.
+      if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+      {
+        if (ImGui::IsItemHovered() && dirEnt.m_isDirectory && m_parent != nullptr)
+        {
+          String path = ConcatPaths({dirEnt.m_rootPath, dirEnt.m_fileName});
+          SelectFolder(m_parent, path);
+        }
+      }
 
-        bool mouseReleased = ImGui::IsMouseReleased(ImGuiMouseButton_Left);
+      // Handle mouse hover tips.
+      String fullName = dirEnt.m_fileName + dirEnt.m_ext;
+      UI::HelpMarker(TKLoc + fullName, fullName.c_str());
 
-        // mouse released on empty position in this window
-        if (!anyButtonClicked && mouseReleased)
+      // Handle drag - drop to scene / inspector.
+      if (!dirEnt.m_isDirectory)
+      {
+        ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+
+        if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
         {
-          if (g_carryingFiles == true && g_dragBeginView != nullptr)
+          // if the file that we are holding is not selected
+          if (!isSelected)
           {
-            g_dragBeginView->DropFiles(m_path);
-          }
-          if (!ImGui::IsKeyDown(ImGuiKey_LeftShift) && !ImGui::IsKeyDown(ImGuiKey_LeftCtrl))
-          {
-            g_selectedFiles.clear();
+            // add to selection
+            g_selectedFiles.push_back(&dirEnt);
           }
-        }
+          g_fileDragData.Entries  = g_selectedFiles.data();
+          g_fileDragData.NumFiles = (int) g_selectedFiles.size();
+          g_dragBeginView         = this;
+          g_carryingFiles         = true;
 
-        g_carryingFiles = mouseReleased ? false : g_carryingFiles;
+          ImGui::SetDragDropPayload("BrowserDragZone", &g_fileDragData, sizeof(FileDragData));
 
-        ImGui::EndChild();
+          char iconChId[16];
+          snprintf(iconChId, sizeof(iconChId), "##dragIcon%d", index);
+          ImGui::ImageButton(iconChId, ConvertUIntImGuiTexture(iconId), m_iconSize, uvMin, uvMax);
+          ImGui::EndDragDropSource();
+        }
+        ImGui::PopStyleColor();
+      }
 
-        ImGui::EndTabItem();
+      // Make directories drop target for resources.
+      if (dirEnt.m_isDirectory)
+      {
+        MoveTo(ConcatPaths({dirEnt.m_rootPath, dirEnt.m_fileName}));
       }
+
+      // Handle Item sub text. Text area has a fixed height so that all rows of the grid have the same height.
+      ImVec2 textPos  = ImGui::GetCursorScreenPos();
+      ImVec2 textSize = ImVec2(m_iconSize.x, ImGui::GetTextLineHeight() * 2.0f);
+      ImVec4 clipRect = ImVec4(textPos.x, textPos.y, textPos.x + textSize.x, textPos.y + textSize.y);
+      ImGui::Dummy(textSize);
+
+      ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(),
+                                          ImGui::GetFontSize(),
+                                          textPos,
+                                          ImGui::GetColorU32(ImGuiCol_Text),
+                                          dirEnt.m_fileName.c_str(),
+                                          nullptr,
+                                          textSize.x,
+                                          &clipRect);
+
+      ImGui::EndGroup();
+      ImGui::PopID();
     }
 
     void FolderView::SetDirty() { m_dirty = true; }
@@ -563,12 +624,123 @@ namespace ToolKit
     }
 
     void FolderView::Iterate()
+    {
+      // Selections point in to the entries, they are found again by their paths after the entries are refilled.
+      StringArray selectedPaths, copiedPaths;
+      auto detachFn = [this](std::vector<DirectoryEntry*>& files, StringArray& paths) -> void
+      {
+        for (auto file = files.begin(); file != files.end();)
+        {
+          if (*file >= m_entries.data() && *file < m_entries.data() + m_entries.size())
+          {
+            paths.push_back((*file)->GetFullPath());
+            file = files.erase(file);
+          }
+          else
+          {
+            file++;
+          }
+        }
+      };
+
+      detachFn(g_selectedFiles, selectedPaths);
+      detachFn(g_coppiedFiles, copiedPaths);
+
+      m_entries.clear();
+      m_indexVersion  = 0;
+      m_appliedFilter = m_filter;
+      m_listingSearch = IsProjectSearch();
+
+      // Listings come from the file index when it is ready, the disk is iterated otherwise.
+      FileIndexSnapshotPtr snapshot = GetApp()->m_fileIndex.GetSnapshot();
+      if (m_listingSearch)
+      {
+        if (snapshot != nullptr)
+        {
+          snapshot->Search(m_filter, m_maxSearchResults, m_entries);
+          m_indexVersion = snapshot->m_version;
+        }
+      }
+      else if (snapshot != nullptr && snapshot->ListFolder(m_path, m_entries))
+      {
+        m_indexVersion = snapshot->GetFolderVersion(m_path);
+      }
+      else
+      {
+        IterateDisk();
+      }
+
+      auto attachFn = [this](std::vector<DirectoryEntry*>& files, const StringArray& paths) -> void
+      {
+        for (DirectoryEntry& entry : m_entries)
+        {
+          if (contains(paths, entry.GetFullPath()))
+          {
+            files.push_back(&entry);
+          }
+        }
+      };
+
+      attachFn(g_selectedFiles, selectedPaths);
+      attachFn(g_coppiedFiles, copiedPaths);
+
+      m_visibleDirty = true;
+    }
+
+    void FolderView::UpdateVisibleEntries()
+    {
+      m_visibleEntries.clear();
+      m_visibleDirty = false;
+
+      for (int i = 0; i < (int) m_entries.size(); i++)
+      {
+        const DirectoryEntry& dirEnt = m_entries[i];
+        if (!dirEnt.m_isDirectory && m_onlyNativeTypes && !IsNativeType(dirEnt.m_ext))
+        {
+          continue;
+        }
+
+        // Project search results are already filtered.
+        if (!m_listingSearch && !m_filter.empty() && !Utf8CaseInsensitiveSearch(dirEnt.m_fileName, m_filter))
+        {
+          continue;
+        }
+
+        m_visibleEntries.push_back(i);
+      }
+    }
+
+    bool FolderView::IsProjectSearch() const { return m_searchProject && !m_filter.empty(); }
+
+    bool FolderView::IsNativeType(const String& ext)
+    {
+      static const std::unordered_set<String> nativeTypes {SCENE,
+                                                           LAYER,
+                                                           ANIM,
+                                                           WAW,
+                                                           MP3,
+                                                           SHADER,
+                                                           SKELETON,
+                                                           PNG,
+                                                           JPG,
+                                                           JPEG,
+                                                           TGA,
+                                                           BMP,
+                                                           PSD,
+                                                           HDR,
+                                                           MESH,
+                                                           SKINMESH,
+                                                           MATERIAL};
+
+      return nativeTypes.count(ext) > 0;
+    }
+
+    void FolderView::IterateDisk()
     {
       // Temporary vectors that holds DirectoryEntry's
       std::vector<DirectoryEntry> m_temp_dirs;
       std::vector<DirectoryEntry> m_temp_files;
 
-      m_entries.clear();
       for (const std::filesystem::directory_entry& e : std::filesystem::directory_iterator(m_path))
       {
         DirectoryEntry de;
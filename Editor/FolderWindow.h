@@ -66,6 +66,21 @@ namespace ToolKit
       /** Selects the files between two entry index(including a and b) */
       void SelectFilesInRange(int a, int b);
 
+      /** Draws the entry in the current grid cell. */
+      void DrawEntry(int index, bool& anyButtonClicked);
+
+      /** Fills the entries by iterating the folder on the disk. */
+      void IterateDisk();
+
+      /** Collects the entries that pass the type and name filters. */
+      void UpdateVisibleEntries();
+
+      /** @return True if the filter is searched in all files of the project. */
+      bool IsProjectSearch() const;
+
+      /** @return True if the extension belongs to a file type that the editor handles. */
+      static bool IsNativeType(const String& ext);
+
      public:
       int m_folderIndex      = -1;
 
@@ -92,6 +107,14 @@ namespace ToolKit
       bool m_dirty           = false;
       IVec2 m_contextBtnSize = IVec2(75, 20);
       String m_filter        = "";
+      String m_appliedFilter;         //!< Filter that the visible entries are collected with.
+      bool m_searchProject   = false; //!< Searches the filter in the whole project.
+      bool m_listingSearch   = false; //!< Entries are search results instead of the folder content.
+      int m_maxSearchResults = 1000;  //!< Upper limit for the project search results.
+      IntArray m_visibleEntries;      //!< Indices of the entries that pass the filters.
+      bool m_visibleDirty    = true;  //!< Visible entries needs to be collected again.
+      uint64 m_indexVersion  = 0;     //!< Version of the index that the entries are listed from, 0 if from disk.
+      uint64 m_seenVersion   = 0;     //!< Last snapshot version that is checked for changes.
       std::unordered_map<String, std::function<void(DirectoryEntry*, FolderView*)>> m_itemActions;
 
       // If you change this value, change the calculation of thumbnail zoom
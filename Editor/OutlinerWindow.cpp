@@ -38,14 +38,14 @@ namespace ToolKit
       return ImGui::GetTextLineHeight() + item_spacing_y;
     }
 
+    // rectMin.x is the position of the child rows, rectMin.y is the top of the parent row.
     void DrawTreeNodeLine(int numNodes, ImVec2 rectMin)
     {
       float line_height     = GetLineHeight();
       float halfHeight      = line_height * 0.5f;
 
-      ImVec2 cursorPos      = ImGui::GetCursorScreenPos();
       // -11 align line with arrow
-      rectMin.x             = cursorPos.x - 11.0f;
+      rectMin.x            -= 11.0f;
       rectMin.y            += halfHeight;
 
       float bottom          = rectMin.y + (numNodes * line_height);
@@ -58,63 +58,279 @@ namespace ToolKit
       drawList->AddLine(ImVec2(rectMin.x, bottom), ImVec2(rectMin.x + 5.0f, bottom), color);
     }
 
-    // returns total drawn nodes
-    int OutlinerWindow::ShowNode(EntityPtr ntt, int depth)
+    void OutlinerWindow::FlattenHierarchy(const EntityPtrArray& roots, std::vector<HierarchyItem>& items)
     {
-      if (ntt == nullptr)
+      items.clear();
+
+      // Depth first with an explicit stack, deep hierarchies can't overflow the call stack.
+      std::vector<std::pair<EntityPtr, int>> stack;
+      for (auto root = roots.rbegin(); root != roots.rend(); root++)
+      {
+        stack.push_back({*root, -1});
+      }
+
+      IntArray parents;
+      while (!stack.empty())
+      {
+        EntityPtr ntt = stack.back().first;
+        int parent    = stack.back().second;
+        stack.pop_back();
+
+        // Close the subtrees that are completed.
+        while (!parents.empty() && parents.back() != parent)
+        {
+          items[parents.back()].end = (int) items.size();
+          parents.pop_back();
+        }
+
+        int item = (int) items.size();
+        items.push_back({ntt, (int) parents.size(), parent, item + 1});
+        parents.push_back(item);
+
+        if (ntt->IsA<Prefab>())
+        {
+          continue;
+        }
+
+        NodeRawPtrArray& children = ntt->m_node->m_children;
+        for (auto child = children.rbegin(); child != children.rend(); child++)
+        {
+          if (EntityPtr childNtt = (*child)->OwnerEntity())
+          {
+            stack.push_back({childNtt, item});
+          }
+        }
+      }
+
+      while (!parents.empty())
+      {
+        items[parents.back()].end = (int) items.size();
+        parents.pop_back();
+      }
+    }
+
+    void OutlinerWindow::FilterHierarchy(const std::vector<HierarchyItem>& items,
+                                         const String& filter,
+                                         BoolArray& shown)
+    {
+      BoolArray matched(items.size(), false);
+      shown.assign(items.size(), false);
+
+      // Children of a match are shown, parents come before their children.
+      for (int i = 0; i < (int) items.size(); i++)
       {
-        return 1;
+        int parent = items[i].parent;
+        matched[i] = (parent != -1 && matched[parent]) || Utf8CaseInsensitiveSearch(items[i].ntt->GetNameVal(), filter);
       }
 
-      // if searching mode is on and entity or its parents are not shown return.
-      if (m_stringSearchMode == true)
+      // Parents of a match are shown, children come after their parents.
+      for (int i = (int) items.size() - 1; i >= 0; i--)
       {
-        bool parentsOrSelfOpen = false;
-        Node* parent           = ntt->m_node;
+        if (matched[i] || shown[i])
+        {
+          shown[i] = true;
+          if (items[i].parent != -1)
+          {
+            shown[items[i].parent] = true;
+          }
+        }
+      }
+    }
 
-        while (parent != nullptr)
+    void OutlinerWindow::CollectRows(const std::vector<HierarchyItem>& items,
+                                     const BoolArray& shown,
+                                     const std::unordered_set<ObjectId>& openEntities,
+                                     std::vector<HierarchyRow>& rows)
+    {
+      rows.clear();
+
+      IntArray openRows;
+      int item = 0;
+      while (item < (int) items.size())
+      {
+        const HierarchyItem& hierarchyItem = items[item];
+        if (!shown.empty() && !shown[item])
+        {
+          item = hierarchyItem.end;
+          continue;
+        }
+
+        // Close the open rows whose subtrees are completed.
+        while (!openRows.empty() && items[rows[openRows.back()].item].end <= item)
         {
-          parentsOrSelfOpen |= m_shownEntities.count(parent->OwnerEntity()) > 0;
-          parent             = parent->m_parent;
+          rows[openRows.back()].end = (int) rows.size();
+          openRows.pop_back();
         }
 
-        if (!parentsOrSelfOpen)
+        HierarchyRow row;
+        row.item   = item;
+        row.parent = openRows.empty() ? -1 : openRows.back();
+        row.isOpen = hierarchyItem.end > item + 1 && openEntities.count(hierarchyItem.ntt->GetIdVal()) > 0;
+        row.end    = (int) rows.size() + 1;
+        rows.push_back(row);
+
+        if (row.isOpen)
         {
-          return 0;
+          openRows.push_back((int) rows.size() - 1);
+          item++;
+        }
+        else
+        {
+          // Skip the subtree of the closed row.
+          item = hierarchyItem.end;
         }
       }
 
-      ImGuiTreeNodeFlags nodeFlags = g_treeNodeFlags;
-      EditorScenePtr currScene     = GetApp()->GetCurrentScene();
+      while (!openRows.empty())
+      {
+        rows[openRows.back()].end = (int) rows.size();
+        openRows.pop_back();
+      }
+    }
+
+    void OutlinerWindow::UpdateHierarchy(EditorScenePtr scene)
+    {
+      uint64 entityListRevision  = scene->GetEntityListRevision();
+      uint64 hierarchyRevision   = Node::GetHierarchyRevision();
+
+      bool hierarchyChanged      = m_hierarchyScene != scene.get();
+      hierarchyChanged          |= m_entityListRevision != entityListRevision;
+      hierarchyChanged          |= m_hierarchyRevision != hierarchyRevision;
+
+      if (hierarchyChanged)
+      {
+        m_hierarchyScene             = scene.get();
+        m_entityListRevision         = entityListRevision;
+        m_hierarchyRevision          = hierarchyRevision;
+
+        // get root entities
+        const EntityPtrArray& ntties = scene->GetEntities();
+        m_roots.clear();
+        std::copy_if(ntties.cbegin(),
+                     ntties.cend(),
+                     std::back_inserter(m_roots),
+                     [](const EntityPtr e) { return e->m_node->m_parent == nullptr; });
+
+        FlattenHierarchy(m_roots, m_hierarchy);
+      }
+
+      // Filtering runs on the flattened hierarchy, only when the search, the hierarchy or a name changes.
+      uint64 nameRevision = Entity::GetNameRevision();
+      if (hierarchyChanged || m_appliedSearchString != m_searchString || m_nameRevision != nameRevision)
+      {
+        m_appliedSearchString = m_searchString;
+        m_nameRevision        = nameRevision;
+        if (m_searchString.empty())
+        {
+          m_shownItems.clear();
+        }
+        else
+        {
+          FilterHierarchy(m_hierarchy, m_searchString, m_shownItems);
+        }
+
+        m_rowsDirty = true;
+      }
+    }
+
+    void OutlinerWindow::UpdateRows()
+    {
+      // Open all parents of the focused entity, including itself.
+      for (EntityPtr ntt : m_nttFocusPath)
+      {
+        m_openEntities.insert(ntt->GetIdVal());
+      }
+
+      CollectRows(m_hierarchy, m_shownItems, m_openEntities, m_rows);
+
+      m_indexToEntity.resize(m_rows.size());
+      for (size_t i = 0; i < m_rows.size(); i++)
+      {
+        m_indexToEntity[i] = m_hierarchy[m_rows[i].item].ntt;
+      }
+
+      // First entity in the focus path is the focused one.
+      if (!m_nttFocusPath.empty())
+      {
+        m_focusRow = FindIndex(m_indexToEntity, m_nttFocusPath.front());
+        m_nttFocusPath.clear();
+      }
+
+      m_rowsDirty = false;
+    }
+
+    void OutlinerWindow::ShowRow(int row)
+    {
+      const HierarchyRow& hierarchyRow   = m_rows[row];
+      const HierarchyItem& hierarchyItem = m_hierarchy[hierarchyRow.item];
+      EntityPtr ntt                      = hierarchyItem.ntt;
+
+      ImGuiTreeNodeFlags nodeFlags       = g_treeNodeFlags | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+      EditorScenePtr currScene           = GetApp()->GetCurrentScene();
       if (currScene->IsSelected(ntt->GetIdVal()))
       {
         nodeFlags |= ImGuiTreeNodeFlags_Selected;
       }
 
-      int numNodes = 1; // 1 itself and we will sum childs
-      m_indexToEntity.push_back(ntt);
-
-      if (ntt->m_node->m_children.empty() || ntt->IsA<Prefab>())
+      bool isLeaf = hierarchyItem.end == hierarchyRow.item + 1;
+      if (isLeaf)
       {
-        nodeFlags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
-        DrawHeader(ntt, nodeFlags, depth);
+        nodeFlags |= ImGuiTreeNodeFlags_Leaf;
       }
       else
       {
-        if (DrawHeader(ntt, nodeFlags, depth))
+        // Open states are kept by the outliner, rows that are not drawn have no imgui state.
+        ImGui::SetNextItemOpen(hierarchyRow.isOpen);
+      }
+
+      // Rows are not pushed to the tree, indent to the depth of the entity.
+      ImGui::SetCursorPosX(ImGui::GetCursorPosX() + hierarchyItem.depth * ImGui::GetStyle().IndentSpacing);
+
+      // Alternating pattern is fixed to the row, not to the drawing order.
+      m_oddAlternatingPattern = row;
+      bool isOpen             = DrawHeader(ntt, nodeFlags, hierarchyItem.depth);
+
+      if (!isLeaf && isOpen != hierarchyRow.isOpen)
+      {
+        if (isOpen)
         {
-          ImVec2 rectMin = ImGui::GetItemRectMin();
+          m_openEntities.insert(ntt->GetIdVal());
+        }
+        else
+        {
+          m_openEntities.erase(ntt->GetIdVal());
+        }
 
-          for (Node* node : ntt->m_node->m_children)
-          {
-            numNodes += ShowNode(node->OwnerEntity(), depth + 1);
-          }
+        m_rowsDirty = true;
+      }
+    }
 
-          DrawTreeNodeLine(numNodes, rectMin);
-          ImGui::TreePop();
+    void OutlinerWindow::DrawTreeNodeLines(int firstRow, int lastRow, float rowStartX)
+    {
+      const float lineHeight = GetLineHeight();
+      const float indent     = ImGui::GetStyle().IndentSpacing;
+
+      auto drawLineFn        = [&](int row) -> void
+      {
+        const HierarchyRow& hierarchyRow = m_rows[row];
+        if (hierarchyRow.isOpen && hierarchyRow.end > row + 1)
+        {
+          int depth = m_hierarchy[hierarchyRow.item].depth;
+          DrawTreeNodeLine(hierarchyRow.end - row,
+                           ImVec2(rowStartX + (depth + 1) * indent, m_treeStartY + row * lineHeight));
         }
+      };
+
+      // Parents of the first row may be scrolled out, their lines still pass through the visible rows.
+      for (int parent = m_rows[firstRow].parent; parent != -1; parent = m_rows[parent].parent)
+      {
+        drawLineFn(parent);
+      }
+
+      for (int row = firstRow; row < lastRow; row++)
+      {
+        drawLineFn(row);
       }
-      return numNodes;
     }
 
     // when we multi select the dragging entities are not sorted
@@ -267,32 +483,6 @@ namespace ToolKit
       }
     }
 
-    bool OutlinerWindow::FindShownEntities(EntityPtr ntt, const String& str)
-    {
-      bool self     = Utf8CaseInsensitiveSearch(ntt->GetNameVal(), str);
-      bool children = false;
-
-      if (!ntt->IsA<Prefab>())
-      {
-        for (Node* node : ntt->m_node->m_children)
-        {
-          if (EntityPtr childNtt = node->OwnerEntity())
-          {
-            bool child = FindShownEntities(childNtt, str);
-            children   = child || children;
-          }
-        }
-      }
-
-      bool isShown = self || children;
-      if (isShown)
-      {
-        m_shownEntities.insert(ntt);
-      }
-
-      return isShown;
-    }
-
     //   entity_123
     //   ---------- <- returns true if you indicate here
     //   entity_321
@@ -501,22 +691,19 @@ namespace ToolKit
 
       if (ImGui::Begin(m_name.c_str(), &m_visible))
       {
-        m_oddAlternatingPattern      = 0;
-        m_anyEntityHovered           = false;
-
-        const EntityPtrArray& ntties = currScene->GetEntities();
-        m_roots.clear();
-        m_indexToEntity.clear();
-
-        // get root entities
-        std::copy_if(ntties.cbegin(),
-                     ntties.cend(),
-                     std::back_inserter(m_roots),
-                     [](const EntityPtr e) { return e->m_node->m_parent == nullptr; });
+        m_oddAlternatingPattern = 0;
+        m_anyEntityHovered      = false;
 
         HandleStates();
         ShowSearchBar(m_searchString);
 
+        // Flattened hierarchy and the rows are cached, they are updated only when there is a change.
+        UpdateHierarchy(currScene);
+        if (m_rowsDirty || !m_nttFocusPath.empty())
+        {
+          UpdateRows();
+        }
+
         ImGui::BeginChild("##Outliner Nodes");
         ImGuiTreeNodeFlags flag = g_treeNodeFlags | ImGuiTreeNodeFlags_DefaultOpen;
 
@@ -524,11 +711,30 @@ namespace ToolKit
 
         if (DrawRootHeader("Scene", 0, flag, UI::m_collectionIcon))
         {
-          m_treeStartY = ImGui::GetCursorScreenPos().y;
+          m_treeStartY           = ImGui::GetCursorScreenPos().y;
+          float rowStartX        = ImGui::GetCursorScreenPos().x;
+          const float lineHeight = GetLineHeight();
+
+          if (m_focusRow != -1)
+          {
+            ImGui::SetScrollY(ImGui::GetCursorPosY() + m_focusRow * lineHeight - ImGui::GetWindowHeight() * 0.5f);
+            m_focusRow = -1;
+          }
 
-          for (size_t i = 0; i < m_roots.size(); ++i)
+          // Only the rows in the view are drawn.
+          ImGuiListClipper clipper;
+          clipper.Begin((int) m_rows.size(), lineHeight);
+          while (clipper.Step())
           {
-            ShowNode(m_roots[i], 0);
+            if (clipper.DisplayStart < clipper.DisplayEnd)
+            {
+              DrawTreeNodeLines(clipper.DisplayStart, clipper.DisplayEnd, rowStartX);
+            }
+
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+              ShowRow(row);
+            }
           }
 
           ImGui::TreePop();
@@ -643,12 +849,18 @@ namespace ToolKit
     void OutlinerWindow::ClearOutliner()
     {
       m_nttFocusPath.clear();
-      m_shownEntities.clear();
       m_indexToEntity.clear();
+      m_hierarchy.clear();
+      m_rows.clear();
+      m_shownItems.clear();
+      m_openEntities.clear();
       m_draggingEntities.clear();
       m_roots.clear();
       m_lastClickedEntity = nullptr;
       m_rootsParent       = nullptr;
+      m_hierarchyScene    = nullptr;
+      m_focusRow          = -1;
+      m_rowsDirty         = true;
     }
 
     bool OutlinerWindow::DrawRootHeader(const String& rootName, uint id, ImGuiTreeNodeFlags flags, TexturePtr icon)
@@ -700,25 +912,8 @@ namespace ToolKit
 
       ImGui::PushItemWidth(-1);
 
-      // algorithm will search only if we type.
-      // if string is empty search mode is of
-      if (ImGui::InputTextWithHint(" SearchString", "Search", &searchString))
-      {
-        m_stringSearchMode    = searchString.size() > 0ull;
-        bool searchStrChanged = m_searchStringSize != (int) searchString.size();
-        m_searchStringSize    = (int) searchString.size();
-
-        if (searchStrChanged && m_stringSearchMode)
-        {
-          m_shownEntities.clear();
-          // Find which entities should be shown
-          for (EntityPtr ntt : m_roots)
-          {
-            FindShownEntities(ntt, m_searchString);
-          }
-        }
-      }
-      m_stringSearchMode = searchString.size() > 0ull;
+      // Filtering is applied on the cached hierarchy when the string changes.
+      ImGui::InputTextWithHint(" SearchString", "Search", &searchString);
 
       ImGui::PopItemWidth();
 
@@ -777,23 +972,6 @@ namespace ToolKit
 
     bool OutlinerWindow::DrawHeader(EntityPtr ntt, ImGuiTreeNodeFlags flags, int depth)
     {
-      bool focusToItem  = false;
-      bool nextItemOpen = false;
-      if (!m_nttFocusPath.empty())
-      {
-        int focusIndx = IndexOf(ntt, m_nttFocusPath);
-        if (focusIndx != -1)
-        {
-          nextItemOpen = true;
-        }
-
-        focusToItem = focusIndx == 0;
-      }
-
-      if (nextItemOpen)
-      {
-        ImGui::SetNextItemOpen(true);
-      }
       // bright and dark color pattern for nodes. (even odd)
       DrawRowBackground(depth);
 
@@ -851,12 +1029,6 @@ namespace ToolKit
         ImGui::EndPopup();
       }
 
-      if (focusToItem)
-      {
-        ImGui::SetScrollHereY();
-        m_nttFocusPath.clear();
-      }
-
       SetItemState(ntt);
 
       // show name, open and slash eye, lock and unlock.
@@ -17,6 +17,25 @@ namespace ToolKit
 
     class TK_EDITOR_API OutlinerWindow : public Window
     {
+     public:
+      /** An entity in the flattened hierarchy, depth first in the order that the outliner lists them. */
+      struct HierarchyItem
+      {
+        EntityPtr ntt;
+        int depth  = 0;
+        int parent = -1; //!< Index of the parent item, -1 for the roots.
+        int end    = 0;  //!< One past the last item of the subtree.
+      };
+
+      /** A row that the outliner shows. */
+      struct HierarchyRow
+      {
+        int item    = 0;  //!< Index of the item in the hierarchy.
+        int parent  = -1; //!< Index of the parent row, -1 for the roots.
+        int end     = 0;  //!< One past the last row of the subtree.
+        bool isOpen = false;
+      };
+
      public:
       TKDeclareClass(OutlinerWindow, Window);
 
@@ -33,19 +52,43 @@ namespace ToolKit
       bool TryReorderEntites(const EntityPtrArray& movedEntities);
       bool IsInsertingAtTheEndOfEntities();
 
+      /** Flattens the hierarchies of the roots. Children of the prefabs are not listed. */
+      static void FlattenHierarchy(const EntityPtrArray& roots, std::vector<HierarchyItem>& items);
+
+      /**
+       * Marks the items whose names contain the filter, their parents and their children as shown.
+       * @param shown is filled with a value for each item.
+       */
+      static void FilterHierarchy(const std::vector<HierarchyItem>& items, const String& filter, BoolArray& shown);
+
+      /**
+       * Collects the rows of the items that are shown and whose parents are open.
+       * @param shown is the filter result for each item, empty if all items are shown.
+       */
+      static void CollectRows(const std::vector<HierarchyItem>& items,
+                              const BoolArray& shown,
+                              const std::unordered_set<ObjectId>& openEntities,
+                              std::vector<HierarchyRow>& rows);
+
      private:
       bool DrawRootHeader(const String& rootName, uint id, ImGuiTreeNodeFlags flags, TexturePtr icon);
 
       void ShowSearchBar(String& searchString);
       bool DrawHeader(EntityPtr ntt, ImGuiTreeNodeFlags flags, int depth);
 
-      int ShowNode(EntityPtr ntt, int depth);
+      void ShowRow(int row);
       void DrawRowBackground(int depth);
+      void DrawTreeNodeLines(int firstRow, int lastRow, float rowStartX);
+
+      /** Rebuilds the flattened hierarchy if the scene or its hierarchy has changed. */
+      void UpdateHierarchy(EditorScenePtr scene);
+
+      /** Collects the rows again, opening the focused entity's parents if there is a focus request. */
+      void UpdateRows();
       void SetItemState(EntityPtr ntt);
 
       void SelectEntitiesBetweenNodes(EditorScenePtr scene, EntityPtr a, EntityPtr b);
 
-      bool FindShownEntities(EntityPtr ntt, const String& str);
       void PushSelectedEntitiesToReparentQueue(EntityPtr parent);
 
       void SortDraggedEntitiesByNodeIndex();
@@ -58,20 +101,30 @@ namespace ToolKit
        * to last ntt in the array.
        */
       EntityPtrArray m_nttFocusPath;
-      std::unordered_set<EntityPtr> m_shownEntities;
       /**
        * entities up to down when we look at node tree.
        * these are imgui visible entities.
        */
       EntityPtrArray m_indexToEntity;
 
+      std::vector<HierarchyItem> m_hierarchy;      //!< Flattened hierarchy of the scene.
+      std::vector<HierarchyRow> m_rows;            //!< Rows of the outliner, index aligned with m_indexToEntity.
+      BoolArray m_shownItems;                      //!< Search result for each item, empty if not searching.
+      std::unordered_set<ObjectId> m_openEntities; //!< Entities whose children are listed.
+      Scene* m_hierarchyScene     = nullptr;       //!< Scene that the hierarchy is flattened from.
+      uint64 m_entityListRevision = UINT64_MAX;    //!< Entity list revision of the flattened hierarchy.
+      uint64 m_hierarchyRevision  = UINT64_MAX;    //!< Node hierarchy revision of the flattened hierarchy.
+      uint64 m_nameRevision       = UINT64_MAX;    //!< Entity name revision of the search result.
+      String m_appliedSearchString;                //!< Search string that the items are filtered with.
+      bool m_rowsDirty = true;                     //!< Rows needs to be collected again.
+      int m_focusRow   = -1;                       //!< Row to scroll to, -1 if there is no focus request.
+
       EntityPtrArray m_draggingEntities;
       EntityPtrArray m_roots;
       EntityPtr m_lastClickedEntity = nullptr;
       EntityPtr m_rootsParent       = nullptr;
 
       String m_searchString;
-      bool m_stringSearchMode     = false;
       bool m_searchCaseSens       = true;
       bool m_anyEntityHovered     = false;
 
@@ -81,7 +134,6 @@ namespace ToolKit
       // the objects that we want to reorder will inserted at this index
       int m_insertSelectedIndex   = TK_INT_MAX;
       float m_treeStartY          = 0.0;
-      int m_searchStringSize      = 0;
     };
 
   } // namespace Editor
@@ -13,9 +13,16 @@
 
 #include <Camera.h>
 #include <GradientSky.h>
+#include <Image.h>
 #include <Material.h>
 #include <Mesh.h>
+#include <RHI.h>
 #include <Surface.h>
+#include <TKOpenGL.h>
+#include <Util.h>
+
+#include <filesystem>
+#include <fstream>
 
 namespace ToolKit
 {
@@ -164,15 +171,19 @@ namespace ToolKit
       }
       else // extension is not recognized, this is probably shader file.
       {
-        return GetApp()->m_thumbnailManager.GetDefaultThumbnail();
+        return nullptr;
       }
 
       m_thumbnailScene->Update(0.0f);
 
-      m_thumbnailRT = MakeNewPtr<RenderTarget>(m_maxThumbSize, m_maxThumbSize, TextureSettings());
-      m_thumbnailRT->Init();
+      // Thumbnails are copied to the atlas right after they are rendered, a single target is enough.
+      if (m_thumbnailRT == nullptr)
+      {
+        m_thumbnailRT = MakeNewPtr<RenderTarget>(m_maxThumbSize, m_maxThumbSize, TextureSettings());
+        m_thumbnailRT->Init();
 
-      m_thumbnailBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, m_thumbnailRT);
+        m_thumbnailBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, m_thumbnailRT);
+      }
 
       Mat4 camTs = m_cam->m_node->GetTransform();
       m_lightSystem->m_parentNode->SetTransform(camTs);
@@ -187,51 +198,473 @@ namespace ToolKit
       return m_thumbnailRT;
     }
 
-    // ThumbnailManager
+    // ThumbnailCache
     //////////////////////////////////////////
 
-    ThumbnailManager::ThumbnailManager() { m_defaultThumbnail = MakeNewPtr<RenderTarget>(10u, 10u, TextureSettings()); }
+    /** Increase when the thumbnail images change, thumbnails of the previous versions are discarded. */
+    static const int g_thumbnailCacheVersion = 1;
 
-    ThumbnailManager::~ThumbnailManager()
+    ThumbnailCache::ThumbnailCache() {}
+
+    ThumbnailCache::~ThumbnailCache() { Close(); }
+
+    void ThumbnailCache::Open(const String& folder)
     {
-      m_defaultThumbnail = nullptr;
-      m_thumbnailCache.clear();
+      Close();
+
+      LockGuard lock(m_mutex);
+      m_folder = folder;
+      if (m_folder.empty())
+      {
+        return;
+      }
+
+      std::error_code err;
+      std::filesystem::create_directories(m_folder, err);
+
+      ReadIndex();
     }
 
-    bool ThumbnailManager::IsDefaultThumbnail(RenderTargetPtr thumb) { return thumb == m_defaultThumbnail; }
+    void ThumbnailCache::Close()
+    {
+      LockGuard lock(m_mutex);
+      if (m_dirty)
+      {
+        WriteIndex();
+      }
 
-    RenderTargetPtr ThumbnailManager::GetDefaultThumbnail() { return m_defaultThumbnail; }
+      m_folder.clear();
+      m_entries.clear();
+      m_dirty = false;
+    }
 
-    RenderTargetPtr ThumbnailManager::GetThumbnail(const DirectoryEntry& dirEnt)
+    String ThumbnailCache::Find(const String& file)
     {
-      String fullPath = dirEnt.GetFullPath();
+      Entry entry;
+      String imagePath;
+      {
+        LockGuard lock(m_mutex);
+        auto cached = m_entries.find(file);
+        if (cached == m_entries.end())
+        {
+          return String();
+        }
+
+        entry     = cached->second;
+        imagePath = GetImagePath(file);
+      }
+
+      uint64 writeTime = GetWriteTime(file);
+      if (writeTime != entry.writeTime)
+      {
+        // Time changes without the content, such as with checkouts, keep the thumbnail.
+        if (FileContentHash(file) != entry.hash)
+        {
+          Invalidate(file);
+          return String();
+        }
+
+        LockGuard lock(m_mutex);
+        m_entries[file].writeTime = writeTime;
+        m_dirty                   = true;
+      }
+
+      if (!CheckSystemFile(imagePath))
+      {
+        return String();
+      }
+
+      return imagePath;
+    }
+
+    void ThumbnailCache::Store(const String& file, const ubyte* pixels, int size)
+    {
+      Entry entry;
+      entry.writeTime = GetWriteTime(file);
+      entry.hash      = FileContentHash(file);
+
+      String imagePath;
+      {
+        LockGuard lock(m_mutex);
+        if (m_folder.empty())
+        {
+          return;
+        }
+
+        imagePath = GetImagePath(file);
+      }
+
+      if (WritePNG(imagePath, size, size, 4, pixels, size * 4) == 0)
+      {
+        TK_WRN("Can't write thumbnail: %s", imagePath.c_str());
+        return;
+      }
+
+      LockGuard lock(m_mutex);
+      m_entries[file] = entry;
+      m_dirty         = true;
+    }
+
+    void ThumbnailCache::Invalidate(const String& file)
+    {
+      LockGuard lock(m_mutex);
+      if (m_entries.erase(file) > 0)
+      {
+        std::error_code err;
+        std::filesystem::remove(GetImagePath(file), err);
+        m_dirty = true;
+      }
+    }
+
+    uint64 ThumbnailCache::GetWriteTime(const String& file)
+    {
+      std::error_code err;
+      auto time = std::filesystem::last_write_time(file, err);
+      if (err)
+      {
+        return 0;
+      }
+
+      return (uint64) time.time_since_epoch().count();
+    }
+
+    String ThumbnailCache::GetImagePath(const String& file) const
+    {
+      uint64 hash = MurmurHash64A(file.data(), (int) file.size(), 41);
+      return ConcatPaths({m_folder, std::to_string(hash) + PNG});
+    }
 
-      if (!Exist(fullPath)) // If not a thumbnail found,
+    void ThumbnailCache::ReadIndex()
+    {
+      String file = ConcatPaths({m_folder, "Index.xml"});
+      if (!CheckSystemFile(file))
+      {
+        return;
+      }
+
+      XmlFile xmlFile(file.c_str());
+      XmlDocument doc;
+      doc.parse<0>(xmlFile.data());
+
+      XmlNode* root = doc.first_node("ThumbnailCache");
+      if (root == nullptr)
+      {
+        return;
+      }
+
+      int version = 0;
+      ReadAttr(root, "version", version);
+      if (version != g_thumbnailCacheVersion)
       {
-        CreateRenderTask(dirEnt);                        // Create a render task for it.
-        m_thumbnailCache[fullPath] = m_defaultThumbnail; // Return default path.
+        return;
       }
 
-      return m_thumbnailCache[fullPath];
+      for (XmlNode* node = root->first_node("Entry"); node; node = node->next_sibling("Entry"))
+      {
+        String asset;
+        Entry entry;
+        ReadAttr(node, "file", asset);
+        ReadAttr(node, "time", entry.writeTime);
+        ReadAttr(node, "hash", entry.hash);
+
+        m_entries[asset] = entry;
+      }
     }
 
-    bool ThumbnailManager::TryGetThumbnail(uint& iconId, const DirectoryEntry& dirEnt)
+    void ThumbnailCache::WriteIndex()
     {
-      RenderTargetPtr thumb = GetThumbnail(dirEnt);
-      bool valid            = thumb->m_textureId != 0 && !IsDefaultThumbnail(thumb);
-      if (valid)
+      XmlDocument doc;
+      XmlNode* root = CreateXmlNode(&doc, "ThumbnailCache");
+      WriteAttr(root, &doc, "version", std::to_string(g_thumbnailCacheVersion));
+
+      for (const auto& entry : m_entries)
       {
-        iconId = thumb->m_textureId;
+        XmlNode* node = CreateXmlNode(&doc, "Entry", root);
+        WriteAttr(node, &doc, "file", entry.first);
+        WriteAttr(node, &doc, "time", std::to_string(entry.second.writeTime));
+        WriteAttr(node, &doc, "hash", std::to_string(entry.second.hash));
       }
-      return valid;
+
+      std::string xml;
+      rapidxml::print(std::back_inserter(xml), doc);
+
+      std::ofstream stream(ConcatPaths({m_folder, "Index.xml"}), std::ios::trunc);
+      stream << xml;
+    }
+
+    // ThumbnailAtlas
+    //////////////////////////////////////////
+
+    ThumbnailAtlas::ThumbnailAtlas(int atlasSize, int cellSize, int atlasCount)
+    {
+      m_atlasSize     = atlasSize;
+      m_cellSize      = cellSize;
+      m_cellsPerRow   = atlasSize / cellSize;
+      m_cellsPerAtlas = m_cellsPerRow * m_cellsPerRow;
+
+      m_cells.resize(m_cellsPerAtlas * atlasCount);
+      m_atlases.resize(atlasCount);
     }
 
-    bool ThumbnailManager::Exist(const String& fullPath)
+    ThumbnailAtlas::~ThumbnailAtlas()
     {
-      return m_thumbnailCache.find(fullPath) != m_thumbnailCache.end();
+      m_atlases.clear();
+      m_readBuffer = nullptr;
+      m_drawBuffer = nullptr;
     }
 
-    void ThumbnailManager::UpdateThumbnail(const DirectoryEntry& dirEnt) { CreateRenderTask(dirEnt); }
+    bool ThumbnailAtlas::Acquire(const String& file, uint64 frame, Slot& slot, String& evicted)
+    {
+      evicted.clear();
+
+      int index = -1;
+      auto used = m_fileCells.find(file);
+      if (used != m_fileCells.end())
+      {
+        index = used->second;
+      }
+      else
+      {
+        // A free cell, otherwise the least recently used one.
+        for (int i = 0; i < (int) m_cells.size(); i++)
+        {
+          const Cell& cell = m_cells[i];
+          if (cell.file.empty())
+          {
+            index = i;
+            break;
+          }
+
+          if (cell.lastFrame < frame && (index == -1 || cell.lastFrame < m_cells[index].lastFrame))
+          {
+            index = i;
+          }
+        }
+
+        if (index == -1)
+        {
+          return false;
+        }
+
+        Cell& cell = m_cells[index];
+        if (!cell.file.empty())
+        {
+          evicted = cell.file;
+          m_fileCells.erase(cell.file);
+        }
+
+        cell.file         = file;
+        m_fileCells[file] = index;
+      }
+
+      m_cells[index].lastFrame = frame;
+
+      slot.atlas               = index / m_cellsPerAtlas;
+      slot.cell                = index % m_cellsPerAtlas;
+
+      return true;
+    }
+
+    void ThumbnailAtlas::Touch(const Slot& slot, uint64 frame)
+    {
+      m_cells[slot.atlas * m_cellsPerAtlas + slot.cell].lastFrame = frame;
+    }
+
+    void ThumbnailAtlas::Clear()
+    {
+      for (Cell& cell : m_cells)
+      {
+        cell = Cell();
+      }
+      m_fileCells.clear();
+    }
+
+    Vec4 ThumbnailAtlas::GetUVRect(const Slot& slot) const
+    {
+      Vec2 origin = Vec2(GetCellOrigin(slot)) / (float) m_atlasSize;
+      float size  = (float) m_cellSize / (float) m_atlasSize;
+
+      return Vec4(origin, origin + Vec2(size));
+    }
+
+    uint ThumbnailAtlas::GetTextureId(const Slot& slot) const
+    {
+      if (RenderTargetPtr atlas = m_atlases[slot.atlas])
+      {
+        return atlas->m_textureId;
+      }
+
+      return 0;
+    }
+
+    void ThumbnailAtlas::Upload(const Slot& slot, const ubyte* pixels)
+    {
+      IVec2 origin = GetCellOrigin(slot);
+
+      RHI::SetTexture(GL_TEXTURE_2D, GetAtlas(slot.atlas)->m_textureId);
+      glTexSubImage2D(GL_TEXTURE_2D,
+                      0,
+                      origin.x,
+                      origin.y,
+                      m_cellSize,
+                      m_cellSize,
+                      GL_RGBA,
+                      GL_UNSIGNED_BYTE,
+                      pixels);
+    }
+
+    void ThumbnailAtlas::Copy(Renderer* renderer, const Slot& slot, RenderTargetPtr source)
+    {
+      RenderTargetPtr atlas = GetAtlas(slot.atlas);
+      IVec2 origin          = GetCellOrigin(slot);
+      FramebufferPtr lastFb = renderer->GetFrameBuffer();
+
+      m_readBuffer->ReconstructIfNeeded(source->m_width, source->m_height);
+      m_readBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, source);
+      m_drawBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, atlas);
+
+      RHI::SetFramebuffer(GL_READ_FRAMEBUFFER, m_readBuffer->GetFboId());
+      RHI::SetFramebuffer(GL_DRAW_FRAMEBUFFER, m_drawBuffer->GetFboId());
+
+      // Render targets start from the bottom row, destination rows are swapped to store the thumbnail top to bottom.
+      glBlitFramebuffer(0,
+                        0,
+                        source->m_width,
+                        source->m_height,
+                        origin.x,
+                        origin.y + m_cellSize,
+                        origin.x + m_cellSize,
+                        origin.y,
+                        GL_COLOR_BUFFER_BIT,
+                        GL_LINEAR);
+
+      renderer->SetFramebuffer(lastFb, GraphicBitFields::None);
+    }
+
+    void ThumbnailAtlas::Read(Renderer* renderer, const Slot& slot, std::vector<ubyte>& pixels)
+    {
+      IVec2 origin          = GetCellOrigin(slot);
+      FramebufferPtr lastFb = renderer->GetFrameBuffer();
+
+      // Attaching binds the buffer for reading as well.
+      m_drawBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, GetAtlas(slot.atlas));
+
+      pixels.resize((size_t) m_cellSize * m_cellSize * 4);
+      glReadPixels(origin.x, origin.y, m_cellSize, m_cellSize, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+      renderer->SetFramebuffer(lastFb, GraphicBitFields::None);
+    }
+
+    int ThumbnailAtlas::GetCellSize() const { return m_cellSize; }
+
+    IVec2 ThumbnailAtlas::GetCellOrigin(const Slot& slot) const
+    {
+      return IVec2(slot.cell % m_cellsPerRow, slot.cell / m_cellsPerRow) * m_cellSize;
+    }
+
+    RenderTargetPtr ThumbnailAtlas::GetAtlas(int atlas)
+    {
+      if (m_atlases[atlas] == nullptr)
+      {
+        TextureSettings set;
+        set.WarpS          = GraphicTypes::UVClampToEdge;
+        set.WarpT          = GraphicTypes::UVClampToEdge;
+        set.MinFilter      = GraphicTypes::SampleLinear;
+        set.MagFilter      = GraphicTypes::SampleLinear;
+        set.InternalFormat = GraphicTypes::FormatRGBA8;
+        set.Format         = GraphicTypes::FormatRGBA;
+        set.Type           = GraphicTypes::TypeUnsignedByte;
+
+        m_atlases[atlas]   = MakeNewPtr<RenderTarget>(m_atlasSize, m_atlasSize, set, "ThumbnailAtlasRT");
+        m_atlases[atlas]->Init();
+      }
+
+      if (m_drawBuffer == nullptr)
+      {
+        FramebufferSettings fbSettings = {m_atlasSize, m_atlasSize, false, false};
+        m_drawBuffer                   = MakeNewPtr<Framebuffer>(fbSettings, "ThumbnailAtlasFB");
+        m_drawBuffer->Init();
+
+        fbSettings   = {m_cellSize, m_cellSize, false, false};
+        m_readBuffer = MakeNewPtr<Framebuffer>(fbSettings, "ThumbnailSourceFB");
+        m_readBuffer->Init();
+      }
+
+      return m_atlases[atlas];
+    }
+
+    // ThumbnailManager
+    //////////////////////////////////////////
+
+    /** 256 thumbnails of 256 pixels are kept in 4 atlases. */
+    ThumbnailManager::ThumbnailManager() : m_atlas(2048, 256, 4) {}
+
+    ThumbnailManager::~ThumbnailManager()
+    {
+      m_cache.Close();
+      m_thumbnails.clear();
+    }
+
+    bool ThumbnailManager::TryGetThumbnail(Thumbnail& thumb, const DirectoryEntry& dirEnt)
+    {
+      OpenCacheIfNeeded();
+
+      String fullPath = dirEnt.GetFullPath();
+      auto entry      = m_thumbnails.find(fullPath);
+      if (entry == m_thumbnails.end())
+      {
+        m_thumbnails[fullPath] = ThumbnailEntry();
+        CreateLoadTask(dirEnt);
+        return false;
+      }
+
+      const ThumbnailEntry& thumbEntry = entry->second;
+      if (thumbEntry.state != ThumbnailState::Resident)
+      {
+        return false;
+      }
+
+      m_atlas.Touch(thumbEntry.slot, GetRenderSystem()->GetFrameCount());
+
+      Vec4 uvRect     = m_atlas.GetUVRect(thumbEntry.slot);
+      thumb.textureId = m_atlas.GetTextureId(thumbEntry.slot);
+      thumb.uvMin     = Vec2(uvRect.x, uvRect.y);
+      thumb.uvMax     = Vec2(uvRect.z, uvRect.w);
+
+      return thumb.textureId != 0;
+    }
+
+    bool ThumbnailManager::Exist(const String& fullPath) { return m_thumbnails.find(fullPath) != m_thumbnails.end(); }
+
+    void ThumbnailManager::UpdateThumbnail(const DirectoryEntry& dirEnt)
+    {
+      OpenCacheIfNeeded();
+
+      // Current thumbnail is displayed until the new one is rendered.
+      String fullPath = dirEnt.GetFullPath();
+      if (!Exist(fullPath))
+      {
+        m_thumbnails[fullPath] = ThumbnailEntry();
+      }
+
+      m_cache.Invalidate(fullPath);
+      CreateRenderTask(dirEnt);
+    }
+
+    void ThumbnailManager::OpenCacheIfNeeded()
+    {
+      const String& resourceRoot = Main::GetInstance()->m_resourceRoot;
+      if (resourceRoot == m_cacheRoot)
+      {
+        return;
+      }
+
+      // Thumbnails of the previous project are dropped.
+      m_cacheRoot = resourceRoot;
+      m_cache.Open(GetApp()->m_workspace.GetThumbnailDirectory());
+      m_atlas.Clear();
+      m_thumbnails.clear();
+    }
 
     void ThumbnailManager::LoadAsset(const DirectoryEntry& dirEnt)
     {
@@ -265,28 +698,106 @@ namespace ToolKit
       }
     }
 
-    void ToolKit::Editor::ThumbnailManager::CreateRenderTask(const DirectoryEntry& dirEnt)
+    void ThumbnailManager::CreateLoadTask(const DirectoryEntry& dirEnt)
     {
-      // Perform loading in the background thread.
+      // Cache look up and image decoding are performed in the background thread.
       TKAsyncTask(WorkerManager::BackgroundPool,
                   [this, dirEnt]() -> void
                   {
+                    String fullPath  = dirEnt.GetFullPath();
+                    String imagePath = m_cache.Find(fullPath);
+                    if (!imagePath.empty())
+                    {
+                      int width    = 0;
+                      int height   = 0;
+                      int comp     = 0;
+                      int cellSize = m_atlas.GetCellSize();
+
+                      ImageSetVerticalOnLoad(false);
+                      ubyte* image = ImageLoad(imagePath, &width, &height, &comp, 4);
+                      if (image != nullptr && width == cellSize && height == cellSize)
+                      {
+                        auto pixels = std::make_shared<std::vector<ubyte>>(image, image + width * height * 4);
+                        ImageFree(image);
+
+                        TKAsyncTask(WorkerManager::MainThread,
+                                    [this, fullPath, pixels]() -> void
+                                    {
+                                      ThumbnailAtlas::Slot slot;
+                                      if (!AcquireSlot(fullPath, slot))
+                                      {
+                                        // Requested again when it is visible and there is room in the atlas.
+                                        m_thumbnails.erase(fullPath);
+                                        return;
+                                      }
+
+                                      m_atlas.Upload(slot, pixels->data());
+                                      m_thumbnails[fullPath] = {ThumbnailState::Resident, slot};
+                                    });
+                        return;
+                      }
+
+                      ImageFree(image);
+                    }
+
+                    // Not in the cache, asset is loaded and rendered.
                     LoadAsset(dirEnt);
-                    // After loading complete, create a render task in the main thread.
-                    TKAsyncTask(WorkerManager::MainThread,
-                                [this, dirEnt]() -> void
-                                {
-                                  GetRenderSystem()->AddRenderTask({[=](Renderer* renderer) -> void
-                                                                    {
-                                                                      RenderTargetPtr rt =
-                                                                          m_renderer.RenderThumbnail(renderer, dirEnt);
-                                                                      m_thumbnailCache[dirEnt.GetFullPath()] = rt;
-                                                                    },
-                                                                    nullptr,
-                                                                    RenderTaskPriority::Low});
-                                });
+                    TKAsyncTask(WorkerManager::MainThread, [this, dirEnt]() -> void { CreateRenderTask(dirEnt); });
                   });
     }
 
+    void ThumbnailManager::CreateRenderTask(const DirectoryEntry& dirEnt)
+    {
+      GetRenderSystem()->AddRenderTask(
+          {[this, dirEnt](Renderer* renderer) -> void
+           {
+             String fullPath    = dirEnt.GetFullPath();
+             RenderTargetPtr rt = m_renderer.RenderThumbnail(renderer, dirEnt);
+             if (rt == nullptr)
+             {
+               m_thumbnails[fullPath].state = ThumbnailState::NoThumbnail;
+               return;
+             }
+
+             ThumbnailAtlas::Slot slot;
+             if (!AcquireSlot(fullPath, slot))
+             {
+               // Requested again when it is visible and there is room in the atlas.
+               m_thumbnails.erase(fullPath);
+               return;
+             }
+
+             m_atlas.Copy(renderer, slot, rt);
+             m_thumbnails[fullPath] = {ThumbnailState::Resident, slot};
+
+             // Stored as it is in the atlas, so that cached and rendered thumbnails look the same.
+             auto pixels            = std::make_shared<std::vector<ubyte>>();
+             m_atlas.Read(renderer, slot, *pixels);
+
+             TKAsyncTask(WorkerManager::BackgroundPool,
+                         [this, fullPath, pixels]() -> void
+                         { m_cache.Store(fullPath, pixels->data(), m_atlas.GetCellSize()); });
+           },
+           nullptr,
+           RenderTaskPriority::Low});
+    }
+
+    bool ThumbnailManager::AcquireSlot(const String& file, ThumbnailAtlas::Slot& slot)
+    {
+      String evicted;
+      if (!m_atlas.Acquire(file, GetRenderSystem()->GetFrameCount(), slot, evicted))
+      {
+        return false;
+      }
+
+      // Evicted thumbnail is read from the cache when it is needed again.
+      if (!evicted.empty())
+      {
+        m_thumbnails.erase(evicted);
+      }
+
+      return true;
+    }
+
   } // namespace Editor
 } // namespace ToolKit
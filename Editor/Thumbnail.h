@@ -24,7 +24,11 @@ namespace ToolKit
       ThumbnailRenderer();
       virtual ~ThumbnailRenderer();
 
-      /** Renders a thumbnail for given directory entry. Works synchronously. */
+      /**
+       * Renders a thumbnail for given directory entry. Works synchronously. The returned target is reused by the next
+       * render, it must be copied before that.
+       * @return Rendered thumbnail or nullptr if the entry has no thumbnail.
+       */
       RenderTargetPtr RenderThumbnail(Renderer* renderer, const DirectoryEntry& dirEnt);
 
      private:
@@ -40,9 +44,160 @@ namespace ToolKit
       GradientSkyPtr m_sky                   = nullptr;
     };
 
+    // ThumbnailCache
+    //////////////////////////////////////////
+
+    /**
+     * Thumbnails that are kept on the disk between the sessions. Each thumbnail is an image in the cache folder and an
+     * index records the modification time and the content hash of the asset that it is rendered for. A thumbnail is
+     * valid as long as the asset has the same modification time, or the same content if only the time has changed.
+     * Uses no gpu resource and can be used from any thread.
+     */
+    class TK_EDITOR_API ThumbnailCache
+    {
+     public:
+      ThumbnailCache();
+      ~ThumbnailCache();
+
+      /** Closes the current cache and opens the one in the folder. An empty folder disables the cache. */
+      void Open(const String& folder);
+
+      /** Writes the index if there are changes and closes the cache. */
+      void Close();
+
+      /**
+       * Looks up the thumbnail of the asset. The asset is hashed only if its modification time has changed.
+       * @param file is the absolute path of the asset.
+       * @return Path of the thumbnail image if it is up to date, an empty string otherwise.
+       */
+      String Find(const String& file);
+
+      /**
+       * Writes the thumbnail image of the asset and records the modification time and the content hash of the asset.
+       * @param pixels are rgba pixels of the thumbnail, rows from top to bottom.
+       * @param size is the width and height of the thumbnail.
+       */
+      void Store(const String& file, const ubyte* pixels, int size);
+
+      /** Removes the thumbnail of the asset. */
+      void Invalidate(const String& file);
+
+      /** @return Modification time of the file, 0 if the file doesn't exist. */
+      static uint64 GetWriteTime(const String& file);
+
+     private:
+      struct Entry
+      {
+        uint64 writeTime = 0; //!< Modification time of the asset when the thumbnail is rendered.
+        uint64 hash      = 0; //!< Content hash of the asset when the thumbnail is rendered.
+      };
+
+      /** @return Path of the thumbnail image for the asset. */
+      String GetImagePath(const String& file) const;
+
+      void ReadIndex();
+      void WriteIndex();
+
+     private:
+      String m_folder;
+      std::unordered_map<String, Entry> m_entries;
+      bool m_dirty = false; //!< Index has changes that are not written.
+      Mutex m_mutex;        //!< Guards the index.
+    };
+
+    // ThumbnailAtlas
+    //////////////////////////////////////////
+
+    /**
+     * Thumbnails in use, packed in to a few atlas textures of equal sized cells. When all cells are taken, the least
+     * recently used cell that is not used in the current frame is given to the new thumbnail. Cells are assigned
+     * without any gpu access, textures are created when a cell of them is first written.
+     */
+    class TK_EDITOR_API ThumbnailAtlas
+    {
+     public:
+      /** Cell of a thumbnail. */
+      struct Slot
+      {
+        int atlas = -1;
+        int cell  = -1;
+      };
+
+      ThumbnailAtlas(int atlasSize, int cellSize, int atlasCount);
+      ~ThumbnailAtlas();
+
+      /**
+       * Finds the cell of the file or assigns one to it.
+       * @param frame is the current frame, cells that are used in this frame are not evicted.
+       * @param evicted is set to the file whose cell is given to this file, if there is one.
+       * @return False if all cells are in use in this frame.
+       */
+      bool Acquire(const String& file, uint64 frame, Slot& slot, String& evicted);
+
+      /** Marks the cell as used in the frame. */
+      void Touch(const Slot& slot, uint64 frame);
+
+      /** Releases all cells. Textures are kept. */
+      void Clear();
+
+      /** @return Texture coordinates of the cell, min in xy and max in zw. */
+      Vec4 GetUVRect(const Slot& slot) const;
+
+      /** @return Texture id of the atlas that the slot is in. 0 if the atlas is not created yet. */
+      uint GetTextureId(const Slot& slot) const;
+
+      /** Uploads top to bottom rgba pixels of the size of a cell to the slot. */
+      void Upload(const Slot& slot, const ubyte* pixels);
+
+      /** Scales and copies the render target to the slot, flipping it so that the rows go from top to bottom. */
+      void Copy(Renderer* renderer, const Slot& slot, RenderTargetPtr source);
+
+      /** Reads the rgba pixels of the slot, rows from top to bottom. */
+      void Read(Renderer* renderer, const Slot& slot, std::vector<ubyte>& pixels);
+
+      int GetCellSize() const;
+
+     private:
+      struct Cell
+      {
+        String file;          //!< File that the cell belongs to, empty if free.
+        uint64 lastFrame = 0; //!< Last frame that the cell is used.
+      };
+
+      /** @return Pixel coordinates of the cell in its atlas. */
+      IVec2 GetCellOrigin(const Slot& slot) const;
+
+      /** @return Texture of the atlas, creates it if needed. */
+      RenderTargetPtr GetAtlas(int atlas);
+
+     private:
+      int m_atlasSize;
+      int m_cellSize;
+      int m_cellsPerRow;
+      int m_cellsPerAtlas;
+      std::vector<Cell> m_cells;
+      std::unordered_map<String, int> m_fileCells;
+      std::vector<RenderTargetPtr> m_atlases;
+      FramebufferPtr m_readBuffer = nullptr;
+      FramebufferPtr m_drawBuffer = nullptr;
+    };
+
     // ThumbnailManager
     //////////////////////////////////////////
 
+    /** Location of a thumbnail in its atlas texture. */
+    struct Thumbnail
+    {
+      uint textureId = 0;
+      Vec2 uvMin     = Vec2(0.0f);
+      Vec2 uvMax     = Vec2(1.0f);
+    };
+
+    /**
+     * Provides thumbnails of the assets. Thumbnails are read from the project's thumbnail cache when they are up to
+     * date, otherwise assets are loaded and rendered in the background and the results are stored in the cache. All
+     * thumbnails in use share a few atlas textures.
+     */
     class TK_EDITOR_API ThumbnailManager
     {
      public:
@@ -50,19 +205,12 @@ namespace ToolKit
       ~ThumbnailManager();
 
       /**
-       * Creates or retrieve the thumbnail for the given DirectoryEntry.
-       * @param dirEnt DirectoryEntry that will be used to create a thumbnail.
-       * @return dirEnt Created RenderTarget for DirectoryEntry.
-       */
-      RenderTargetPtr GetThumbnail(const DirectoryEntry& dirEnt);
-
-      /**
-       * Creates or retrieve the thumbnail for the given DirectoryEntry.
-       * @param iconId icon that you want to replace
+       * Retrieves the thumbnail for the given DirectoryEntry, requests it if it is not available.
+       * @param thumb is set to the atlas and the texture coordinates of the thumbnail.
        * @param dirEnt DirectoryEntry that will be used to create a thumbnail.
        * @return true if requested thumbnail is valid
        */
-      bool TryGetThumbnail(uint& iconId, const DirectoryEntry& dirEnt);
+      bool TryGetThumbnail(Thumbnail& thumb, const DirectoryEntry& dirEnt);
 
       /**
        * Checks if a thumbnail exist for given file.
@@ -71,24 +219,44 @@ namespace ToolKit
       bool Exist(const String& fullPath);
 
       /**
-       * Updates the thumbnail for given DirectoryEntry if exist or creates a
-       * new thumbnail.
+       * Renders the thumbnail for given DirectoryEntry again, replacing the cached one.
        * @param dirEnt DirectoryEntry that will be used to create a thumbnail.
        */
       void UpdateThumbnail(const DirectoryEntry& dirEnt);
 
-      bool IsDefaultThumbnail(RenderTargetPtr thumb);
-      RenderTargetPtr GetDefaultThumbnail();
-
      private:
+      enum class ThumbnailState
+      {
+        Loading,    //!< Being read from the cache or rendered.
+        Resident,   //!< In the atlas.
+        NoThumbnail //!< Asset can't have a thumbnail.
+      };
+
+      struct ThumbnailEntry
+      {
+        ThumbnailState state = ThumbnailState::Loading;
+        ThumbnailAtlas::Slot slot;
+      };
+
+      /** Opens the thumbnail cache of the project if the project has changed. */
+      void OpenCacheIfNeeded();
+
+      /** Reads the thumbnail from the cache in the background, falls back to rendering it. */
+      void CreateLoadTask(const DirectoryEntry& dirEnt);
+
       void LoadAsset(const DirectoryEntry& dirEnt);
       void CreateRenderTask(const DirectoryEntry& dirEnt);
 
+      /** Assigns a cell to the file and drops the thumbnail that is evicted from the cell. */
+      bool AcquireSlot(const String& file, ThumbnailAtlas::Slot& slot);
+
      private:
       ThumbnailRenderer m_renderer;
-      RenderTargetPtr m_defaultThumbnail = nullptr;
-      std::unordered_map<String, RenderTargetPtr> m_thumbnailCache;
+      ThumbnailCache m_cache;
+      ThumbnailAtlas m_atlas;
+      String m_cacheRoot; //!< Resource root of the project that the cache is opened for.
+      std::unordered_map<String, ThumbnailEntry> m_thumbnails;
     };
 
   } // namespace Editor
-} // namespace ToolKit
\ No newline at end of file
+} // namespace ToolKit
@@ -49,22 +49,29 @@ namespace ToolKit
       }
 
       uint iconId                        = fallbackIcon;
-      ImVec2 texCoords                   = ImVec2(1.0f, 1.0f);
+      ImVec2 uvMin                       = ImVec2(0.0f, 0.0f);
+      ImVec2 uvMax                       = ImVec2(1.0f, 1.0f);
 
       ThumbnailManager& thumbnailManager = GetApp()->m_thumbnailManager;
 
+      Thumbnail thumb;
+      bool hasThumb = false;
       if (dirEnt.m_ext.length())
       {
-        if (thumbnailManager.TryGetThumbnail(iconId, dirEnt))
-        {
-          texCoords = ImVec2(1.0f, -1.0f);
-        }
+        hasThumb = thumbnailManager.TryGetThumbnail(thumb, dirEnt);
       }
       else if (fileExist)
       {
         DecomposePath(file, &dirEnt.m_rootPath, &dirEnt.m_fileName, &dirEnt.m_ext);
 
-        thumbnailManager.TryGetThumbnail(iconId, dirEnt);
+        hasThumb = thumbnailManager.TryGetThumbnail(thumb, dirEnt);
+      }
+
+      if (hasThumb)
+      {
+        iconId = thumb.textureId;
+        uvMin  = ImVec2(thumb.uvMin.x, thumb.uvMin.y);
+        uvMax  = ImVec2(thumb.uvMax.x, thumb.uvMax.y);
       }
 
       if (!dropName.empty())
@@ -72,11 +79,7 @@ namespace ToolKit
         ImGui::Text(dropName.c_str());
       }
 
-      ImGui::ImageButton(file.c_str(),
-                         ConvertUIntImGuiTexture(iconId),
-                         ImVec2(48.0f, 48.0f),
-                         ImVec2(0.0f, 0.0f),
-                         texCoords);
+      ImGui::ImageButton(file.c_str(), ConvertUIntImGuiTexture(iconId), ImVec2(48.0f, 48.0f), uvMin, uvMax);
 
       bool clicked  = ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left);
       clicked      &= ImGui::IsItemHovered();
@@ -140,6 +140,16 @@ namespace ToolKit
       return ConcatPaths({m_activeWorkspace, m_activeProject.name, "Resources"});
     }
 
+    String Workspace::GetThumbnailDirectory() const
+    {
+      if (m_activeProject.name.empty())
+      {
+        return String();
+      }
+
+      return ConcatPaths({m_activeWorkspace, m_activeProject.name, "Intermediate", "Thumbnails"});
+    }
+
     String Workspace::GetActiveWorkspace() const { return m_activeWorkspace; }
 
     Project Workspace::GetActiveProject() const { return m_activeProject; }
@@ -17,10 +17,12 @@
 #include <SDL.h>
 #include <Scene.h>
 #include <Texture.h>
+#include <Threads.h>
 #include <ToolKit.h>
 #include <Types.h>
 #include <Util.h>
 #include <assert.h>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/pbrmaterial.h>
@@ -28,6 +30,7 @@
 #include <assimp/scene.h>
 
 #include <iostream>
+#include <map>
 
 using std::cout;
 using std::endl;
@@ -126,16 +129,144 @@ namespace ToolKit
     unsigned int boneIndex = 0;
   };
 
-  vector<string> g_usedFiles;
+  /** Files that assimp opens while reading a source file, such as external buffers and material libraries. */
+  class TrackingIOSystem : public Assimp::DefaultIOSystem
+  {
+   public:
+    Assimp::IOStream* Open(const char* file, const char* mode) override
+    {
+      Assimp::IOStream* stream = DefaultIOSystem::Open(file, mode);
+      if (stream != nullptr)
+      {
+        m_openedFiles.insert(fs::path(file).lexically_normal().u8string());
+      }
+
+      return stream;
+    }
+
+    StringSet m_openedFiles;
+  };
+
+  /**
+   * Writes the assimp log to a file. Sources are imported concurrently and the default logger is not thread safe, so
+   * messages are written under a lock.
+   */
+  class SerialFileLogger : public Assimp::Logger
+  {
+   public:
+    SerialFileLogger(const char* file, LogSeverity severity) : Logger(severity), m_file(file, ios::trunc) {}
+
+    bool attachStream(Assimp::LogStream* stream, unsigned int severity) override { return false; }
+
+    bool detachStream(Assimp::LogStream* stream, unsigned int severity) override { return false; }
 
-  bool IsUsed(const string& file) { return find(g_usedFiles.begin(), g_usedFiles.end(), file) == g_usedFiles.end(); }
+   private:
+    void OnVerboseDebug(const char* message) override { Write("Debug", message); }
 
-  void AddToUsedFiles(const string& file)
+    void OnDebug(const char* message) override { Write("Debug", message); }
+
+    void OnInfo(const char* message) override { Write("Info", message); }
+
+    void OnWarn(const char* message) override { Write("Warn", message); }
+
+    void OnError(const char* message) override { Write("Error", message); }
+
+    void Write(const char* prefix, const char* message)
+    {
+      LockGuard lock(m_mutex);
+      m_file << prefix << ": " << message << endl;
+    }
+
+   private:
+    ofstream m_file;
+    Mutex m_mutex;
+  };
+
+  /** Increase when the output of the importer changes, cached imports of the previous versions are discarded. */
+  const int g_importVersion = 1;
+
+  /** Options that change the output of the import. */
+  struct ImportOptions
+  {
+    string dest;
+    float scale           = 1.0f;
+    int optimizationLevel = 0; // 0 or 1
+
+    uint64 Hash() const
+    {
+      string key  = dest + "|" + to_string(scale) + "|" + to_string(optimizationLevel);
+      key        += "|" + to_string(g_importVersion);
+      return MurmurHash64A(key.data(), (int) key.size(), 41);
+    }
+  };
+
+  /** Stages of an import, timings are reported per stage. */
+  enum ImportStage
+  {
+    StageRead,
+    StageAnimation,
+    StageTexture,
+    StageMaterial,
+    StageSkeleton,
+    StageMesh,
+    StageScene,
+    StageCount
+  };
+
+  const char* g_stageNames[StageCount] = {"read", "animation", "texture", "material", "skeleton", "mesh", "scene"};
+
+  /**
+   * A file that an import writes. Writes are deferred until all sources are imported. If multiple sources write the
+   * same file, the last one in the import list wins, as it does when the sources are imported one by one.
+   */
+  struct ImportOutput
+  {
+    string file;
+    std::function<void()> write;
+  };
+
+  /** Result of an import that is kept in the import cache. */
+  struct ImportCacheEntry
+  {
+    uint64 optionsHash = 0;                //!< Hash of the options that the source is imported with.
+    std::map<string, uint64> dependencies; //!< Content hashes of the files that the import reads.
+    vector<string> outputs;                //!< Files that the import writes.
+    vector<string> usedFiles;              //!< Files that the import reports.
+  };
+
+  /**
+   * State of the import of a single source file. Each source is imported with its own context, there is no shared
+   * mutable state between the imports, which lets them run concurrently.
+   */
+  struct ImportContext
+  {
+    string file;                          //!< Source file.
+    const aiScene* scene = nullptr;       //!< Assimp scene of the source, valid during the import.
+    vector<string> usedFiles;             //!< Files that the import produces or refers to.
+    StringSet dependencies;               //!< Files that the import reads, the source included.
+    vector<ImportOutput> outputs;         //!< Deferred writes of the import.
+    float stageTimes[StageCount] = {};    //!< Milliseconds spent in each stage.
+    bool cached                  = false; //!< Outputs are up to date, import is skipped.
+    bool failed                  = false; //!< Source can't be read.
+    ImportCacheEntry cacheEntry;          //!< Cached state of the import.
+
+    unordered_map<string, BoneNode> skeletonMap;
+    SkeletonPtr skeleton;
+    bool isSkeletonEntityCreated = false;
+    std::vector<MaterialPtr> materials;
+    std::unordered_map<aiMesh*, MeshPtr> meshes;
+    SkinMeshPtr mainSkinMesh;
+    std::vector<LightPtr> lights;
+    std::vector<CameraPtr> cameras;
+    EntityPtrArray deletedEntities;
+  };
+
+  void AddToUsedFiles(ImportContext& ctx, const string& file)
   {
     // Add unique.
-    if (IsUsed(file))
+    if (find(ctx.usedFiles.begin(), ctx.usedFiles.end(), file) == ctx.usedFiles.end())
     {
-      g_usedFiles.push_back(file);
+      ctx.usedFiles.push_back(file);
     }
   }
 
@@ -149,11 +280,6 @@ namespace ToolKit
         ' ');
   }
 
-  unordered_map<string, BoneNode> g_skeletonMap;
-  SkeletonPtr g_skeleton;
-  bool isSkeletonEntityCreated = false;
-  const aiScene* g_scene       = nullptr;
-
   void Decompose(string& fullPath, string& path, string& name)
   {
     NormalizePath(fullPath);
@@ -207,25 +333,21 @@ namespace ToolKit
     return name;
   }
 
-  string GetMaterialName(aiMesh* mesh)
+  string GetMaterialName(ImportContext& ctx, aiMesh* mesh)
   {
-    aiString matName;
-    g_scene->mMaterials[mesh->mMaterialIndex]->Get(AI_MATKEY_NAME, matName);
-    return GetMaterialName(g_scene->mMaterials[mesh->mMaterialIndex], mesh->mMaterialIndex);
+    return GetMaterialName(ctx.scene->mMaterials[mesh->mMaterialIndex], mesh->mMaterialIndex);
   }
 
-  std::vector<MaterialPtr> tMaterials;
-
+  /** Serialization is deferred to the end of the import, the object is saved in its final state. */
   template <typename T>
-  void CreateFileAndSerializeObject(T* objectToSerialize, const String& filePath)
+  void CreateFileAndSerializeObject(ImportContext& ctx, std::shared_ptr<T> objectToSerialize, const String& filePath)
   {
     objectToSerialize->SetFile(filePath);
-    objectToSerialize->Save(false);
+    ctx.outputs.push_back({filePath, [objectToSerialize]() -> void { objectToSerialize->Save(false); }});
   }
 
   const float g_desiredFps = 30.0f;
   const float g_animEps    = 0.001f;
-  String g_currentExt;
 
   // Interpolator functions Begin
   // Range checks added by OTSoftware.
@@ -362,22 +484,22 @@ namespace ToolKit
 
   // Interpolator functions END
 
-  void ImportAnimation(const string& file)
+  void ImportAnimation(ImportContext& ctx, const string& file)
   {
-    if (!g_scene->HasAnimations())
+    if (!ctx.scene->HasAnimations())
     {
       return;
     }
 
-    for (uint i = 0; i < g_scene->mNumAnimations; i++)
+    for (uint i = 0; i < ctx.scene->mNumAnimations; i++)
     {
-      aiAnimation* anim = g_scene->mAnimations[i];
+      aiAnimation* anim = ctx.scene->mAnimations[i];
       std::string animName(anim->mName.C_Str());
       string animFilePath = file;
       replace(animName.begin(), animName.end(), '.', '_');
       replace(animName.begin(), animName.end(), '|', '_');
       animFilePath += animName + ".anim";
-      AddToUsedFiles(animFilePath);
+      AddToUsedFiles(ctx, animFilePath);
       AnimationPtr tAnim = MakeNewPtr<Animation>();
 
       double fps         = anim->mTicksPerSecond == 0 ? g_desiredFps : anim->mTicksPerSecond;
@@ -450,16 +572,16 @@ namespace ToolKit
       tAnim->m_duration = (float) (cmax / g_desiredFps);
       tAnim->m_fps      = (float) (g_desiredFps);
 
-      CreateFileAndSerializeObject(tAnim.get(), animFilePath);
+      CreateFileAndSerializeObject(ctx, tAnim, animFilePath);
     }
   }
 
-  void ImportMaterial(const string& filePath, const string& origin)
+  void ImportMaterial(ImportContext& ctx, const string& filePath, const string& origin)
   {
     fs::path pathOrg              = fs::path(origin).parent_path();
 
-    auto textureFindAndCreateFunc = [filePath, pathOrg](aiTextureType textureAssimpType,
-                                                        aiMaterial* material) -> TexturePtr
+    auto textureFindAndCreateFunc = [&ctx, filePath, pathOrg](aiTextureType textureAssimpType,
+                                                              aiMaterial* material) -> TexturePtr
     {
       int texCount = material->GetTextureCount(textureAssimpType);
       TexturePtr tTexture;
@@ -475,9 +597,9 @@ namespace ToolKit
           embedded        = true;
           string indxPart = tName.substr(1);
           uint tIndx      = atoi(indxPart.c_str());
-          if (g_scene->mNumTextures > tIndx)
+          if (ctx.scene->mNumTextures > tIndx)
           {
-            aiTexture* t = g_scene->mTextures[tIndx];
+            aiTexture* t = ctx.scene->mTextures[tIndx];
             tName        = GetEmbeddedTextureName(t, tIndx);
           }
         }
@@ -497,31 +619,35 @@ namespace ToolKit
           isGoodFile.open(fullPath, ios::binary | ios::in);
           if (isGoodFile.good())
           {
-            fs::path target = fs::path(textPath);
-            if (target.has_parent_path())
+            ctx.dependencies.insert(fullPath.u8string());
+
+            auto copyTextureFn = [fullPath, textPath]() -> void
             {
-              fs::path dir = target.parent_path();
-              if (!fs::exists(dir))
+              fs::path target = fs::path(textPath);
+              std::error_code err;
+              if (target.has_parent_path())
               {
-                fs::create_directories(dir);
+                fs::create_directories(target.parent_path(), err);
               }
-            }
 
-            fs::copy(fullPath, target, fs::copy_options::overwrite_existing);
+              fs::copy(fullPath, target, fs::copy_options::overwrite_existing, err);
+            };
+
+            ctx.outputs.push_back({textPath, copyTextureFn});
           }
           isGoodFile.close();
         }
 
-        AddToUsedFiles(textPath);
+        AddToUsedFiles(ctx, textPath);
         tTexture = MakeNewPtr<Texture>();
         tTexture->SetFile(textPath);
       }
       return tTexture;
     };
 
-    for (uint i = 0; i < g_scene->mNumMaterials; i++)
+    for (uint i = 0; i < ctx.scene->mNumMaterials; i++)
     {
-      aiMaterial* material  = g_scene->mMaterials[i];
+      aiMaterial* material  = ctx.scene->mMaterials[i];
       string name           = GetMaterialName(material, i);
       string writePath      = filePath + name + MATERIAL;
       MaterialPtr tMaterial = MakeNewPtr<Material>();
@@ -598,16 +724,16 @@ namespace ToolKit
       material->Get(AI_MATKEY_GLTF_ALPHACUTOFF, tMaterial->GetRenderState()->alphaMaskTreshold);
 
       tMaterial->SetFile(writePath);
-      CreateFileAndSerializeObject(tMaterial.get(), writePath);
-      AddToUsedFiles(writePath);
-      tMaterials.push_back(tMaterial);
+      CreateFileAndSerializeObject(ctx, tMaterial, writePath);
+      AddToUsedFiles(ctx, writePath);
+      ctx.materials.push_back(tMaterial);
     }
   }
 
   // Creates a ToolKit mesh by reading the aiMesh
   // @param mainMesh: Pointer of the mesh
   template <typename convertType>
-  void ConvertMesh(aiMesh* mesh, convertType tMesh)
+  void ConvertMesh(ImportContext& ctx, aiMesh* mesh, convertType tMesh)
   {
     assert(mesh->mNumVertices && "Mesh has no vertices!");
 
@@ -618,15 +744,15 @@ namespace ToolKit
       for (unsigned int i = 0; i < mesh->mNumBones; i++)
       {
         aiBone* bone = mesh->mBones[i];
-        assert(g_skeletonMap.find(bone->mName.C_Str()) != g_skeletonMap.end());
-        BoneNode bn = g_skeletonMap[bone->mName.C_Str()];
+        assert(ctx.skeletonMap.find(bone->mName.C_Str()) != ctx.skeletonMap.end());
+        BoneNode bn = ctx.skeletonMap[bone->mName.C_Str()];
         for (unsigned int j = 0; j < bone->mNumWeights; j++)
         {
           aiVertexWeight vw = bone->mWeights[j];
           skinData[vw.mVertexId].push_back(std::pair<int, float>(bn.boneIndex, vw.mWeight));
         }
       }
-      tMesh->m_skeleton = g_skeleton;
+      tMesh->m_skeleton = ctx.skeleton;
     }
 
     tMesh->m_clientSideVertices.resize(mesh->mNumVertices);
@@ -687,7 +813,7 @@ namespace ToolKit
     tMesh->m_loaded      = true;
     tMesh->m_vertexCount = (int) (tMesh->m_clientSideVertices.size());
     tMesh->m_indexCount  = (int) (tMesh->m_clientSideIndices.size());
-    tMesh->m_material    = tMaterials[mesh->mMaterialIndex];
+    tMesh->m_material    = ctx.materials[mesh->mMaterialIndex];
     for (ubyte i = 0; i < 3; i++)
     {
       tMesh->m_boundingBox.min[i] = mesh->mAABB.mMin[i];
@@ -695,41 +821,38 @@ namespace ToolKit
     }
   }
 
-  std::unordered_map<aiMesh*, MeshPtr> g_meshes;
-  SkinMeshPtr mainSkinMesh;
-
-  void ImportMeshes(string& filePath)
+  void ImportMeshes(ImportContext& ctx, string& filePath)
   {
     string path, name;
     Decompose(filePath, path, name);
-    mainSkinMesh = nullptr;
+    ctx.mainSkinMesh = nullptr;
 
     // Skinned meshes will be merged because they're using the same skeleton
     // (Only one skeleton is imported)
-    for (uint MeshIndx = 0; MeshIndx < g_scene->mNumMeshes; MeshIndx++)
+    for (uint MeshIndx = 0; MeshIndx < ctx.scene->mNumMeshes; MeshIndx++)
     {
-      aiMesh* aMesh = g_scene->mMeshes[MeshIndx];
+      aiMesh* aMesh = ctx.scene->mMeshes[MeshIndx];
       if (aMesh->HasBones())
       {
         SkinMeshPtr skinMesh = MakeNewPtr<SkinMesh>();
-        ConvertMesh(aMesh, skinMesh);
-        if (mainSkinMesh)
+        ConvertMesh(ctx, aMesh, skinMesh);
+        if (ctx.mainSkinMesh)
         {
-          mainSkinMesh->m_subMeshes.push_back(skinMesh);
+          ctx.mainSkinMesh->m_subMeshes.push_back(skinMesh);
         }
         else
         {
-          mainSkinMesh = skinMesh;
+          ctx.mainSkinMesh = skinMesh;
         }
       }
       else
       {
         MeshPtr mesh = MakeNewPtr<Mesh>();
-        ConvertMesh(aMesh, mesh);
+        ConvertMesh(ctx, aMesh, mesh);
 
         // Better to use scene node name
         string fileName  = "";
-        aiNode* meshNode = g_scene->mRootNode->FindNode(aMesh->mName);
+        aiNode* meshNode = ctx.scene->mRootNode->FindNode(aMesh->mName);
         if (meshNode)
         {
           fileName = std::string(meshNode->mName.C_Str());
@@ -744,30 +867,28 @@ namespace ToolKit
         Assimp::DefaultLogger::get()->info("file name: ", meshPath);
 
         mesh->SetFile(meshPath);
-        AddToUsedFiles(meshPath);
-        g_meshes[aMesh] = mesh;
-        CreateFileAndSerializeObject(mesh.get(), meshPath);
+        AddToUsedFiles(ctx, meshPath);
+        ctx.meshes[aMesh] = mesh;
+        CreateFileAndSerializeObject(ctx, mesh, meshPath);
       }
     }
-    if (mainSkinMesh)
+    if (ctx.mainSkinMesh)
     {
       ClearForbidden(name);
       String skinMeshPath = path + name + SKINMESH;
-      mainSkinMesh->SetFile(skinMeshPath);
+      ctx.mainSkinMesh->SetFile(skinMeshPath);
 
-      AddToUsedFiles(skinMeshPath);
-      CreateFileAndSerializeObject(mainSkinMesh.get(), skinMeshPath);
+      AddToUsedFiles(ctx, skinMeshPath);
+      CreateFileAndSerializeObject(ctx, ctx.mainSkinMesh, skinMeshPath);
     }
   }
 
-  std::vector<LightPtr> sceneLights;
-
-  void ImportLights()
+  void ImportLights(ImportContext& ctx)
   {
-    for (uint i = 0; i < g_scene->mNumLights; i++)
+    for (uint i = 0; i < ctx.scene->mNumLights; i++)
     {
       LightPtr tkLight  = nullptr;
-      aiLight* light    = g_scene->mLights[i];
+      aiLight* light    = ctx.scene->mLights[i];
       float lightRadius = 1.0f;
       {
         // radius for attenuation = 0.01
@@ -827,17 +948,15 @@ namespace ToolKit
         continue;
       }
 
-      sceneLights.push_back(tkLight);
+      ctx.lights.push_back(tkLight);
     }
   }
 
-  std::vector<CameraPtr> sceneCameras;
-
-  void ImportCameras()
+  void ImportCameras(ImportContext& ctx)
   {
-    for (uint i = 0; i < g_scene->mNumCameras; i++)
+    for (uint i = 0; i < ctx.scene->mNumCameras; i++)
     {
-      aiCamera* cam = g_scene->mCameras[i];
+      aiCamera* cam = ctx.scene->mCameras[i];
       if (cam->mOrthographicWidth > 0.0f)
       {
         continue; // Skip orthographic cameras.
@@ -856,13 +975,11 @@ namespace ToolKit
       tkCam->m_node->SetTransform(toMat4(transform));
       tkCam->SetLens(fov, aspect, cam->mClipPlaneNear, cam->mClipPlaneFar);
 
-      sceneCameras.push_back(tkCam);
+      ctx.cameras.push_back(tkCam);
     }
   }
 
-  EntityPtrArray deletedEntities;
-
-  bool DeleteEmptyEntitiesRecursively(ScenePtr tScene, EntityPtr ntt)
+  bool DeleteEmptyEntitiesRecursively(ImportContext& ctx, ScenePtr tScene, EntityPtr ntt)
   {
     bool shouldDelete = true;
     if (ntt->GetComponentPtrArray().size())
@@ -879,25 +996,25 @@ namespace ToolKit
 
     for (Node* child : ntt->m_node->m_children)
     {
-      if (!DeleteEmptyEntitiesRecursively(tScene, child->OwnerEntity()))
+      if (!DeleteEmptyEntitiesRecursively(ctx, tScene, child->OwnerEntity()))
       {
         shouldDelete = false;
       }
     }
     if (shouldDelete)
     {
-      deletedEntities.push_back(ntt);
+      ctx.deletedEntities.push_back(ntt);
     }
     return shouldDelete;
   }
 
-  void TraverseScene(ScenePtr tScene, const aiNode* node, EntityPtr parent)
+  void TraverseScene(ImportContext& ctx, ScenePtr tScene, const aiNode* node, EntityPtr parent)
   {
     EntityPtr ntt = nullptr;
 
     // Camera transform data is local, it gets its full transforms when merged with node.
     // So camera must be matched with a node in the graph. (Look at aiCamera doc)
-    for (CameraPtr cam : sceneCameras)
+    for (CameraPtr cam : ctx.cameras)
     {
       if (cam->GetNameVal() == node->mName.C_Str())
       {
@@ -908,7 +1025,7 @@ namespace ToolKit
     }
 
     // Same as light.
-    for (LightPtr light : sceneLights)
+    for (LightPtr light : ctx.lights)
     {
       if (light->GetNameVal() == node->mName.C_Str())
       {
@@ -955,8 +1072,8 @@ namespace ToolKit
     // Insert all meshes to the entity.
     for (uint meshIndx = 0; meshIndx < node->mNumMeshes; meshIndx++)
     {
-      aiMesh* aMesh = g_scene->mMeshes[node->mMeshes[meshIndx]];
-      if (aMesh->HasBones() && isSkeletonEntityCreated)
+      aiMesh* aMesh = ctx.scene->mMeshes[node->mMeshes[meshIndx]];
+      if (aMesh->HasBones() && ctx.isSkeletonEntityCreated)
       {
         continue;
       }
@@ -971,18 +1088,18 @@ namespace ToolKit
 
       if (aMesh->HasBones())
       {
-        meshComp->SetMeshVal(mainSkinMesh);
+        meshComp->SetMeshVal(ctx.mainSkinMesh);
 
         SkeletonComponentPtr skelComp = ntt->AddComponent<SkeletonComponent>();
-        skelComp->SetSkeletonResourceVal(g_skeleton);
+        skelComp->SetSkeletonResourceVal(ctx.skeleton);
 
-        isSkeletonEntityCreated = true;
+        ctx.isSkeletonEntityCreated = true;
       }
       else
       {
         if (firstMesh)
         {
-          meshComp->SetMeshVal(g_meshes[aMesh]);
+          meshComp->SetMeshVal(ctx.meshes[aMesh]);
         }
         else
         {
@@ -990,7 +1107,7 @@ namespace ToolKit
           MeshPtr mesh = meshComp->GetMeshVal();
           if (mesh->GetMeshCount() != node->mNumMeshes)
           {
-            mesh->m_subMeshes.push_back(g_meshes[aMesh]);
+            mesh->m_subMeshes.push_back(ctx.meshes[aMesh]);
             mesh->m_dirty = true; // We only mesh to be saved.
           }
         }
@@ -1004,78 +1121,68 @@ namespace ToolKit
       matComp->UpdateMaterialList();
     }
 
-    // Re save combined mesh.
-    if (node->mNumMeshes > 1)
-    {
-      if (MeshComponentPtr meshCom = ntt->GetMeshComponent())
-      {
-        if (MeshPtr combinedMesh = meshCom->GetMeshVal())
-        {
-          combinedMesh->Save(true);
-        }
-      }
-    }
+    // Combined meshes are saved with their sub meshes, serialization is deferred until the scene is complete.
 
     for (uint childIndx = 0; childIndx < node->mNumChildren; childIndx++)
     {
-      TraverseScene(tScene, node->mChildren[childIndx], ntt);
+      TraverseScene(ctx, tScene, node->mChildren[childIndx], ntt);
     }
 
     tScene->AddEntity(ntt);
   }
 
-  void ImportScene(string& filePath)
+  void ImportScene(ImportContext& ctx, string& filePath)
   {
     // Print Scene.
     string path, name;
     Decompose(filePath, path, name);
 
     string fullPath = path + name + SCENE;
-    AddToUsedFiles(fullPath);
+    AddToUsedFiles(ctx, fullPath);
     ScenePtr tScene = MakeNewPtr<Scene>();
 
-    TraverseScene(tScene, g_scene->mRootNode, nullptr);
+    TraverseScene(ctx, tScene, ctx.scene->mRootNode, nullptr);
     // First entity is the root entity
     EntityPtrArray roots;
     GetRootEntities(tScene->GetEntities(), roots);
     for (EntityPtr r : roots)
     {
-      DeleteEmptyEntitiesRecursively(tScene, r);
+      DeleteEmptyEntitiesRecursively(ctx, tScene, r);
     }
 
-    for (EntityPtr ntt : deletedEntities)
+    for (EntityPtr ntt : ctx.deletedEntities)
     {
       tScene->RemoveEntity(ntt->GetIdVal(), false);
     }
-    deletedEntities.clear();
+    ctx.deletedEntities.clear();
     Assimp::DefaultLogger::get()->info("scene path: ", fullPath);
 
-    CreateFileAndSerializeObject(tScene.get(), fullPath);
+    CreateFileAndSerializeObject(ctx, tScene, fullPath);
   }
 
-  void ImportSkeleton(string& filePath)
+  void ImportSkeleton(ImportContext& ctx, string& filePath)
   {
-    auto addBoneNodeFn = [](aiNode* node, aiBone* bone) -> void
+    auto addBoneNodeFn = [&ctx](aiNode* node, aiBone* bone) -> void
     {
       BoneNode bn(node, 0);
       if (node->mName == bone->mName)
       {
         bn.bone = bone;
       }
-      g_skeletonMap[node->mName.C_Str()] = bn;
+      ctx.skeletonMap[node->mName.C_Str()] = bn;
     };
 
     // Collect skeleton parts
     vector<aiBone*> bones;
-    for (unsigned int i = 0; i < g_scene->mNumMeshes; i++)
+    for (unsigned int i = 0; i < ctx.scene->mNumMeshes; i++)
     {
-      aiMesh* mesh     = g_scene->mMeshes[i];
-      aiNode* meshNode = g_scene->mRootNode->FindNode(mesh->mName);
+      aiMesh* mesh     = ctx.scene->mMeshes[i];
+      aiNode* meshNode = ctx.scene->mRootNode->FindNode(mesh->mName);
       for (unsigned int j = 0; j < mesh->mNumBones; j++)
       {
         aiBone* bone = mesh->mBones[j];
         bones.push_back(bone);
-        aiNode* node = g_scene->mRootNode->FindNode(bone->mName);
+        aiNode* node = ctx.scene->mRootNode->FindNode(bone->mName);
         while (node) // Go Up
         {
           if (node == meshNode)
@@ -1095,7 +1202,7 @@ namespace ToolKit
           node = node->mParent;
         }
 
-        node                                     = g_scene->mRootNode->FindNode(bone->mName);
+        node                                     = ctx.scene->mRootNode->FindNode(bone->mName);
 
         // Go Down
         std::function<void(aiNode*)> checkDownFn = [&checkDownFn, &bone, &addBoneNodeFn](aiNode* node) -> void
@@ -1118,9 +1225,9 @@ namespace ToolKit
 
     for (auto& bone : bones)
     {
-      if (g_skeletonMap.find(bone->mName.C_Str()) != g_skeletonMap.end())
+      if (ctx.skeletonMap.find(bone->mName.C_Str()) != ctx.skeletonMap.end())
       {
-        g_skeletonMap[bone->mName.C_Str()].bone = bone;
+        ctx.skeletonMap[bone->mName.C_Str()].bone = bone;
       }
     }
 
@@ -1130,11 +1237,12 @@ namespace ToolKit
     }
 
     // Assign indices
-    std::function<void(aiNode*, uint&)> assignBoneIndexFn = [&assignBoneIndexFn](aiNode* node, uint& index) -> void
+    std::function<void(aiNode*, uint&)> assignBoneIndexFn =
+        [&ctx, &assignBoneIndexFn](aiNode* node, uint& index) -> void
     {
-      if (g_skeletonMap.find(node->mName.C_Str()) != g_skeletonMap.end())
+      if (ctx.skeletonMap.find(node->mName.C_Str()) != ctx.skeletonMap.end())
       {
-        g_skeletonMap[node->mName.C_Str()].boneIndex = index++;
+        ctx.skeletonMap[node->mName.C_Str()].boneIndex = index++;
       }
 
       for (uint i = 0; i < node->mNumChildren; i++)
@@ -1144,34 +1252,34 @@ namespace ToolKit
     };
 
     uint boneIndex = 0;
-    assignBoneIndexFn(g_scene->mRootNode, boneIndex);
+    assignBoneIndexFn(ctx.scene->mRootNode, boneIndex);
 
     string name, path;
     Decompose(filePath, path, name);
     string fullPath = path + name + SKELETON;
 
-    g_skeleton      = MakeNewPtr<Skeleton>();
-    g_skeleton->SetFile(fullPath);
+    ctx.skeleton      = MakeNewPtr<Skeleton>();
+    ctx.skeleton->SetFile(fullPath);
 
     // Print
     std::function<void(aiNode * node, DynamicBoneMap::DynamicBone*)> setBoneHierarchyFn =
-        [&setBoneHierarchyFn](aiNode* node, DynamicBoneMap::DynamicBone* parentBone) -> void
+        [&ctx, &setBoneHierarchyFn](aiNode* node, DynamicBoneMap::DynamicBone* parentBone) -> void
     {
       DynamicBoneMap::DynamicBone* searchDBone = parentBone;
-      if (g_skeletonMap.find(node->mName.C_Str()) != g_skeletonMap.end())
+      if (ctx.skeletonMap.find(node->mName.C_Str()) != ctx.skeletonMap.end())
       {
         assert(node->mName.length);
-        g_skeleton->m_Tpose.m_boneMap.insert(
+        ctx.skeleton->m_Tpose.m_boneMap.insert(
             std::make_pair(String(node->mName.C_Str()), DynamicBoneMap::DynamicBone()));
 
-        searchDBone                       = &g_skeleton->m_Tpose.m_boneMap.find(node->mName.C_Str())->second;
+        searchDBone                       = &ctx.skeleton->m_Tpose.m_boneMap.find(node->mName.C_Str())->second;
         searchDBone->node                 = new Node();
         searchDBone->node->m_inheritScale = true;
-        searchDBone->boneIndx             = (uint) g_skeleton->m_bones.size();
-        g_skeleton->m_Tpose.AddDynamicBone(node->mName.C_Str(), *searchDBone, parentBone);
+        searchDBone->boneIndx             = (uint) ctx.skeleton->m_bones.size();
+        ctx.skeleton->m_Tpose.AddDynamicBone(node->mName.C_Str(), *searchDBone, parentBone);
 
         StaticBone* sBone = new StaticBone(node->mName.C_Str());
-        g_skeleton->m_bones.push_back(sBone);
+        ctx.skeleton->m_bones.push_back(sBone);
       }
       for (uint i = 0; i < node->mNumChildren; i++)
       {
@@ -1179,15 +1287,15 @@ namespace ToolKit
       }
     };
 
-    std::function<void(aiNode * node)> setTransformationsFn = [&setTransformationsFn](aiNode* node) -> void
+    std::function<void(aiNode * node)> setTransformationsFn = [&ctx, &setTransformationsFn](aiNode* node) -> void
     {
-      if (g_skeletonMap.find(node->mName.C_Str()) != g_skeletonMap.end())
+      if (ctx.skeletonMap.find(node->mName.C_Str()) != ctx.skeletonMap.end())
       {
-        StaticBone* sBone = g_skeleton->GetBone(node->mName.C_Str());
+        StaticBone* sBone = ctx.skeleton->GetBone(node->mName.C_Str());
 
         // Set bone node transformation
         {
-          DynamicBoneMap::DynamicBone& dBone = g_skeleton->m_Tpose.m_boneMap[node->mName.C_Str()];
+          DynamicBoneMap::DynamicBone& dBone = ctx.skeleton->m_Tpose.m_boneMap[node->mName.C_Str()];
           Vec3 t, s;
           Quaternion r;
           DecomposeAssimpMatrix(node->mTransformation, &t, &r, &s);
@@ -1199,7 +1307,7 @@ namespace ToolKit
 
         // Set bind pose transformation
         {
-          aiBone* bone = g_skeletonMap[node->mName.C_Str()].bone;
+          aiBone* bone = ctx.skeletonMap[node->mName.C_Str()].bone;
 
           if (bone)
           {
@@ -1222,38 +1330,295 @@ namespace ToolKit
       }
     };
 
-    setBoneHierarchyFn(g_scene->mRootNode, nullptr);
-    setTransformationsFn(g_scene->mRootNode);
+    setBoneHierarchyFn(ctx.scene->mRootNode, nullptr);
+    setTransformationsFn(ctx.scene->mRootNode);
 
-    CreateFileAndSerializeObject(g_skeleton.get(), fullPath);
-    AddToUsedFiles(fullPath);
+    CreateFileAndSerializeObject(ctx, ctx.skeleton, fullPath);
+    AddToUsedFiles(ctx, fullPath);
   }
 
-  void ImportTextures(const string& filePath)
+  void ImportTextures(ImportContext& ctx, const string& filePath)
   {
     // Embedded textures.
-    if (g_scene->HasTextures())
+    if (ctx.scene->HasTextures())
     {
-      for (uint i = 0; i < g_scene->mNumTextures; i++)
+      for (uint i = 0; i < ctx.scene->mNumTextures; i++)
       {
-        aiTexture* texture = g_scene->mTextures[i];
+        aiTexture* texture = ctx.scene->mTextures[i];
         string embId       = GetEmbeddedTextureName(texture, i);
 
+        // Texture data belongs to the assimp scene, it is copied for the deferred write.
+        const char* begin  = (const char*) texture->pcData;
+
         // Compressed.
         if (texture->mHeight == 0)
         {
-          ofstream file(filePath + embId, fstream::out | std::fstream::binary);
-          assert(file.good());
+          string file  = filePath + embId;
+          auto data    = std::make_shared<vector<char>>(begin, begin + texture->mWidth);
+
+          auto writeFn = [file, data]() -> void
+          {
+            ofstream stream(file, fstream::out | std::fstream::binary);
+            assert(stream.good());
+
+            stream.write(data->data(), data->size());
+          };
 
-          file.write((const char*) texture->pcData, texture->mWidth);
+          ctx.outputs.push_back({file, writeFn});
         }
         else
         {
-          unsigned char* buffer = (unsigned char*) texture->pcData;
-          WritePNG(filePath.c_str(), texture->mWidth, texture->mHeight, 4, buffer, texture->mWidth * 4);
+          int width    = (int) texture->mWidth;
+          int height   = (int) texture->mHeight;
+          auto data    = std::make_shared<vector<char>>(begin, begin + (size_t) width * height * 4);
+
+          auto writeFn = [filePath, width, height, data]() -> void
+          { WritePNG(filePath.c_str(), width, height, 4, (unsigned char*) data->data(), width * 4); };
+
+          ctx.outputs.push_back({filePath, writeFn});
+        }
+      }
+    }
+  }
+
+  /**
+   * Imports of the previous runs, kept next to the importer. A source is not imported again if the options, the
+   * content of the source and the content of the files that it reads are the same and its outputs still exist.
+   */
+  class ImportCache
+  {
+   public:
+    void Read(const string& file)
+    {
+      if (!CheckSystemFile(file))
+      {
+        return;
+      }
+
+      XmlFile xmlFile(file.c_str());
+      XmlDocument doc;
+      doc.parse<0>(xmlFile.data());
+
+      XmlNode* root = doc.first_node("ImportCache");
+      if (root == nullptr)
+      {
+        return;
+      }
+
+      int version = 0;
+      ReadAttr(root, "version", version);
+      if (version != g_importVersion)
+      {
+        return;
+      }
+
+      for (XmlNode* node = root->first_node("Source"); node; node = node->next_sibling("Source"))
+      {
+        string source;
+        ImportCacheEntry entry;
+        ReadAttr(node, "file", source);
+        ReadAttr(node, "options", entry.optionsHash);
+
+        for (XmlNode* dep = node->first_node("Dependency"); dep; dep = dep->next_sibling("Dependency"))
+        {
+          string depFile;
+          uint64 hash = 0;
+          ReadAttr(dep, "file", depFile);
+          ReadAttr(dep, "hash", hash);
+          entry.dependencies[depFile] = hash;
+        }
+
+        for (XmlNode* out = node->first_node("Output"); out; out = out->next_sibling("Output"))
+        {
+          string outFile;
+          ReadAttr(out, "file", outFile);
+          entry.outputs.push_back(outFile);
+        }
+
+        for (XmlNode* used = node->first_node("Used"); used; used = used->next_sibling("Used"))
+        {
+          string usedFile;
+          ReadAttr(used, "file", usedFile);
+          entry.usedFiles.push_back(usedFile);
+        }
+
+        m_entries[source] = entry;
+      }
+    }
+
+    void Write(const string& file) const
+    {
+      XmlDocument doc;
+      XmlNode* root = CreateXmlNode(&doc, "ImportCache");
+      WriteAttr(root, &doc, "version", to_string(g_importVersion));
+
+      // Sorted for a stable file.
+      std::map<string, const ImportCacheEntry*> sorted;
+      for (const auto& entry : m_entries)
+      {
+        sorted[entry.first] = &entry.second;
+      }
+
+      for (const auto& entry : sorted)
+      {
+        XmlNode* node = CreateXmlNode(&doc, "Source", root);
+        WriteAttr(node, &doc, "file", entry.first);
+        WriteAttr(node, &doc, "options", to_string(entry.second->optionsHash));
+
+        for (const auto& dep : entry.second->dependencies)
+        {
+          XmlNode* depNode = CreateXmlNode(&doc, "Dependency", node);
+          WriteAttr(depNode, &doc, "file", dep.first);
+          WriteAttr(depNode, &doc, "hash", to_string(dep.second));
+        }
+
+        for (const string& outFile : entry.second->outputs)
+        {
+          WriteAttr(CreateXmlNode(&doc, "Output", node), &doc, "file", outFile);
+        }
+
+        for (const string& usedFile : entry.second->usedFiles)
+        {
+          WriteAttr(CreateXmlNode(&doc, "Used", node), &doc, "file", usedFile);
+        }
+      }
+
+      string xml;
+      rapidxml::print(std::back_inserter(xml), doc);
+
+      ofstream stream(file, ios::trunc);
+      stream << xml;
+    }
+
+    /** Marks the import of the context as cached if its previous result is still valid. Thread safe. */
+    bool Find(ImportContext& ctx, uint64 optionsHash) const
+    {
+      auto entry = m_entries.find(ctx.file);
+      if (entry == m_entries.end())
+      {
+        return false;
+      }
+
+      const ImportCacheEntry& cached = entry->second;
+      if (cached.optionsHash != optionsHash || cached.dependencies.empty())
+      {
+        return false;
+      }
+
+      for (const auto& dep : cached.dependencies)
+      {
+        if (FileContentHash(dep.first) != dep.second)
+        {
+          return false;
+        }
+      }
+
+      for (const string& outFile : cached.outputs)
+      {
+        if (!CheckSystemFile(outFile))
+        {
+          return false;
         }
       }
+
+      ctx.cacheEntry = cached;
+      ctx.usedFiles  = cached.usedFiles;
+      ctx.cached     = true;
+
+      return true;
     }
+
+    void Update(const ImportContext& ctx) { m_entries[ctx.file] = ctx.cacheEntry; }
+
+   private:
+    unordered_map<string, ImportCacheEntry> m_entries;
+  };
+
+  /** Imports the source of the context. Outputs are appended to the context to be written once all imports end. */
+  void ImportFile(ImportContext& ctx, const ImportOptions& options)
+  {
+    float stageStart = GetElapsedMilliSeconds();
+    auto endStage    = [&ctx, &stageStart](ImportStage stage) -> void
+    {
+      float now              = GetElapsedMilliSeconds();
+      ctx.stageTimes[stage] += now - stageStart;
+      stageStart             = now;
+    };
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT);
+    importer.SetPropertyFloat(AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, options.scale);
+
+    // Importer owns the io system.
+    TrackingIOSystem* ioSystem = new TrackingIOSystem();
+    importer.SetIOHandler(ioSystem);
+
+    int optFlags = aiProcess_FlipUVs | aiProcess_GlobalScale;
+    if (options.optimizationLevel == 1)
+    {
+      optFlags |= aiProcessPreset_TargetRealtime_MaxQuality;
+    }
+
+    ctx.scene = importer.ReadFile(ctx.file, optFlags);
+    endStage(StageRead);
+
+    if (ctx.scene == nullptr)
+    {
+      TK_ERR("Assimp failed to import the file. Probably file is corrupted! %s", ctx.file.c_str());
+      ctx.failed = true;
+      return;
+    }
+
+    String fileName;
+    DecomposePath(ctx.file, nullptr, &fileName, nullptr);
+    string destFile = options.dest + fileName;
+
+    // DON'T BREAK THE CALLING ORDER!
+
+    ImportAnimation(ctx, options.dest);
+    endStage(StageAnimation);
+
+    // Create Textures to reference in Materials
+    ImportTextures(ctx, options.dest);
+    endStage(StageTexture);
+
+    // Create Materials to reference in Meshes
+    ImportMaterial(ctx, options.dest, ctx.file);
+    endStage(StageMaterial);
+
+    // Create a Skeleton to reference in Meshes
+    ImportSkeleton(ctx, destFile);
+    endStage(StageSkeleton);
+
+    // Add Meshes, lights and cameras.
+    ImportMeshes(ctx, destFile);
+    ImportLights(ctx);
+    ImportCameras(ctx);
+    endStage(StageMesh);
+
+    // Create Meshes & Scene
+    ImportScene(ctx, destFile);
+    endStage(StageScene);
+
+    // Scene is released with the importer.
+    ctx.scene = nullptr;
+
+    // Files that assimp reads for the source, such as external buffers, are dependencies of the import as well.
+    ctx.dependencies.insert(ctx.file);
+    ctx.dependencies.insert(ioSystem->m_openedFiles.begin(), ioSystem->m_openedFiles.end());
+
+    ctx.cacheEntry.optionsHash = options.Hash();
+    for (const string& dep : ctx.dependencies)
+    {
+      ctx.cacheEntry.dependencies[dep] = FileContentHash(dep);
+    }
+
+    for (const ImportOutput& output : ctx.outputs)
+    {
+      ctx.cacheEntry.outputs.push_back(output.file);
+    }
+
+    ctx.cacheEntry.usedFiles = ctx.usedFiles;
   }
 
   int ToolKitMain(int argc, char* argv[])
@@ -1266,12 +1631,10 @@ namespace ToolKit
         throw(-1);
       }
 
-      Assimp::Importer importer;
-      importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT);
-
-      int optimizationLevel = 0; // 0 or 1
-      string dest, file = argv[1];
-      Assimp::DefaultLogger::create("Assimplog.txt", Assimp::Logger::VERBOSE);
+      ImportOptions options;
+      string file = argv[1];
+      // Logger is deleted by kill.
+      Assimp::DefaultLogger::set(new SerialFileLogger("Assimplog.txt", Assimp::Logger::VERBOSE));
       for (int i = 0; i < argc; i++)
       {
         string arg = argv[i];
@@ -1279,25 +1642,24 @@ namespace ToolKit
 
         if (arg == "-t")
         {
-          dest = fs::path(argv[i + 1]).append("").u8string();
+          options.dest = fs::path(argv[i + 1]).append("").u8string();
         }
 
         if (arg == "-s")
         {
-          float scale = (float) (std::atof(argv[i + 1]));
-          importer.SetPropertyFloat(AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, scale);
+          options.scale = (float) (std::atof(argv[i + 1]));
         }
 
         if (arg == "-o")
         {
-          optimizationLevel = std::atoi(argv[i + 1]);
+          options.optimizationLevel = std::atoi(argv[i + 1]);
         }
       }
 
-      dest = fs::path(dest).lexically_normal().u8string();
-      if (!dest.empty())
+      options.dest = fs::path(options.dest).lexically_normal().u8string();
+      if (!options.dest.empty())
       {
-        fs::create_directories(dest);
+        fs::create_directories(options.dest);
       }
 
       string ext = file.substr(file.find_last_of("."));
@@ -1351,64 +1713,167 @@ namespace ToolKit
 
       g_proxy->Init();
 
-      for (int i = 0; i < (int) (files.size()); i++)
+      ImportCache cache;
+      cache.Read("ImportCache.xml");
+      uint64 optionsHash = options.Hash();
+
+      // Each source is imported with its own context.
+      vector<ImportContext> contexts(files.size());
+      for (size_t i = 0; i < files.size(); i++)
       {
-        file = files[i];
-        // Clear global materials for each scene to prevent wrong referencing
-        tMaterials.clear();
+        contexts[i].file = files[i];
+      }
 
-        int optFlags = aiProcess_FlipUVs | aiProcess_GlobalScale;
-        if (optimizationLevel == 1)
+      float importTime = GetElapsedMilliSeconds();
+
+      using poolstl::iota_iter;
+      std::for_each(TKExecByConditional(contexts.size() > 1, WorkerManager::FramePool),
+                    iota_iter<int>(0),
+                    iota_iter<int>((int) contexts.size()),
+                    [&](int i) -> void
+                    {
+                      ImportContext& ctx = contexts[i];
+                      if (!cache.Find(ctx, optionsHash))
+                      {
+                        ImportFile(ctx, options);
+                      }
+                    });
+
+      // A file is written by the last source that produces it. Cached sources don't write their outputs, so a cached
+      // source that shares an output with a preceding imported source is imported again to write its version last.
+      StringSet produced;
+      vector<size_t> reimports;
+      for (size_t i = 0; i < contexts.size(); i++)
+      {
+        const ImportContext& ctx = contexts[i];
+        if (!ctx.cached)
         {
-          optFlags |= aiProcessPreset_TargetRealtime_MaxQuality;
+          for (const ImportOutput& output : ctx.outputs)
+          {
+            produced.insert(fs::path(output.file).lexically_normal().u8string());
+          }
+          continue;
         }
 
-        const aiScene* scene = importer.ReadFile(file, optFlags);
-        if (scene == nullptr)
+        for (const string& outFile : ctx.cacheEntry.outputs)
         {
-          assert(0 && "Assimp failed to import the file. Probably file is corrupted!");
-          throw(-1);
+          if (produced.count(fs::path(outFile).lexically_normal().u8string()) > 0)
+          {
+            reimports.push_back(i);
+            for (const string& reimported : ctx.cacheEntry.outputs)
+            {
+              produced.insert(fs::path(reimported).lexically_normal().u8string());
+            }
+            break;
+          }
         }
-        g_scene                 = scene;
-        isSkeletonEntityCreated = false;
-
-        String fileName;
-        DecomposePath(file, nullptr, &fileName, &g_currentExt);
-        string destFile = dest + fileName;
-        // DON'T BREAK THE CALLING ORDER!
-
-        ImportAnimation(dest);
+      }
 
-        // Create Textures to reference in Materials
-        ImportTextures(dest);
+      std::for_each(TKExecByConditional(reimports.size() > 1, WorkerManager::FramePool),
+                    reimports.begin(),
+                    reimports.end(),
+                    [&](size_t i) -> void
+                    {
+                      ImportContext& ctx = contexts[i];
+                      ctx.cached         = false;
+                      ctx.cacheEntry     = {};
+                      ctx.usedFiles.clear();
+                      ImportFile(ctx, options);
+                    });
+
+      importTime = GetElapsedMilliSeconds() - importTime;
+
+      for (const ImportContext& ctx : contexts)
+      {
+        if (ctx.failed)
+        {
+          throw(-1);
+        }
+      }
 
-        // Create Materials to reference in Meshes
-        ImportMaterial(dest, file);
+      // A file is written once, by the last source that produces it.
+      unordered_map<string, const ImportOutput*> lastWrites;
+      for (const ImportContext& ctx : contexts)
+      {
+        for (const ImportOutput& output : ctx.outputs)
+        {
+          lastWrites[fs::path(output.file).lexically_normal().u8string()] = &output;
+        }
+      }
 
-        // Create a Skeleton to reference in Meshes
-        ImportSkeleton(destFile);
+      vector<const ImportOutput*> writes;
+      for (const ImportContext& ctx : contexts)
+      {
+        for (const ImportOutput& output : ctx.outputs)
+        {
+          if (lastWrites[fs::path(output.file).lexically_normal().u8string()] == &output)
+          {
+            writes.push_back(&output);
+          }
+        }
+      }
 
-        // Add Meshes.
-        ImportMeshes(destFile);
+      float writeTime = GetElapsedMilliSeconds();
 
-        // Add lights.
-        ImportLights();
+      std::for_each(TKExecByConditional(writes.size() > 1, WorkerManager::FramePool),
+                    writes.begin(),
+                    writes.end(),
+                    [](const ImportOutput* output) -> void { output->write(); });
 
-        // Add cameras.
-        ImportCameras();
+      writeTime = GetElapsedMilliSeconds() - writeTime;
 
-        // Create Meshes & Scene
-        ImportScene(destFile);
+      int cachedCount = 0;
+      for (const ImportContext& ctx : contexts)
+      {
+        if (ctx.cached)
+        {
+          cachedCount++;
+        }
+        else
+        {
+          cache.Update(ctx);
+        }
       }
+      cache.Write("ImportCache.xml");
 
       // Report all in use files.
+      StringSet reported;
       fstream inUse("out.txt", ios::out);
-      for (const string& fs : g_usedFiles)
+      for (const ImportContext& ctx : contexts)
       {
-        inUse << fs << endl;
+        for (const string& fs : ctx.usedFiles)
+        {
+          if (reported.insert(fs).second)
+          {
+            inUse << fs << endl;
+          }
+        }
       }
       inUse.close();
 
+      for (const ImportContext& ctx : contexts)
+      {
+        if (ctx.cached)
+        {
+          TK_LOG("Up to date: %s", ctx.file.c_str());
+          continue;
+        }
+
+        string stages;
+        for (int stage = 0; stage < StageCount; stage++)
+        {
+          stages += " " + string(g_stageNames[stage]) + ": " + to_string((int) ctx.stageTimes[stage]) + "ms";
+        }
+        TK_LOG("Imported: %s%s", ctx.file.c_str(), stages.c_str());
+      }
+
+      TK_LOG("Imported %d files, %d up to date, in %.2fms. Written %d files in %.2fms.",
+             (int) contexts.size(),
+             cachedCount,
+             importTime,
+             (int) writes.size(),
+             writeTime);
+
       g_proxy->Uninit();
       g_proxy = nullptr;
     }
@@ -10,10 +10,14 @@
 #include <FileManager.h>
 #include <Image.h>
 #include <Material.h>
+#include <PakBuilder.h>
 #include <RenderSystem.h>
 #include <SDL.h>
+#include <Skeleton.h>
 #include <TKOpenGL.h>
 #include <Texture.h>
+#include <TextureAtlas.h>
+#include <TextureCompressor.h>
 #include <ToolKit.h>
 #include <Types.h>
 #include <Util.h>
@@ -81,6 +85,25 @@ namespace ToolKit
     void AndroidRunOnPhone(bool isAPKUnsigned);
     int PackResources();
 
+    /**
+     * Compresses the project textures to gpu formats with their mip chains. Only the textures that are modified after
+     * their last cook are compressed again. Cooked images are packed next to the sources.
+     */
+    int CookTextures();
+
+    /**
+     * Packs the ui and sprite images in to atlas pages, so that the surfaces using them share a texture and can be
+     * batched. The atlas is built again only if the images have changed.
+     */
+    int BuildAtlases();
+
+    /**
+     * Bakes the animation data textures of the skeletons and the animations that the scenes and the layers use, so that
+     * published builds read them from the pak instead of baking on first play. Data is baked again only if the content
+     * has changed.
+     */
+    int BakeAnimations();
+
     /**
      * Checks the error code and returns true if there is an error.
      * Also reports the message to console in case of error.
@@ -117,6 +140,29 @@ namespace ToolKit
       return -1;
     }
 
+    // Pages are built first, so that they are cooked along with the other textures.
+    int atlasResult = BuildAtlases();
+    if (atlasResult != 0)
+    {
+      return atlasResult;
+    }
+
+    int animResult = BakeAnimations();
+    if (animResult != 0)
+    {
+      return animResult;
+    }
+
+    // Mobile and web gpus sample block compressed formats, which saves memory and bandwidth.
+    if (m_platform == PublishPlatform::Android || m_platform == PublishPlatform::Web)
+    {
+      int cookResult = CookTextures();
+      if (cookResult != 0)
+      {
+        return cookResult;
+      }
+    }
+
     int packResult = GetFileManager()->PackResources();
     if (packResult != 0)
     {
@@ -126,6 +172,168 @@ namespace ToolKit
     return 0;
   }
 
+  int Packer::CookTextures()
+  {
+    TK_LOG("Cooking textures\n");
+
+    int cookedCount   = 0;
+    uint64 sourceSize = 0;
+    uint64 cookedSize = 0;
+
+    // Normal and metallic roughness maps are sampled as linear, the others as srgb.
+    StringSet linearTextures;
+    ResourceDependencyScanner scanner;
+    scanner.AddFolder(ScenePath(""));
+    scanner.AddFolder(LayerPath(""));
+    scanner.Scan();
+
+    for (const String& file : scanner.GetFiles())
+    {
+      String ext;
+      DecomposePath(file, nullptr, nullptr, &ext);
+      if (ext != MATERIAL)
+      {
+        continue;
+      }
+
+      MaterialPtr material = GetMaterialManager()->Create<Material>(file);
+      for (const TexturePtr& texture : {material->GetNormalTextureVal(), material->GetMetallicRoughnessTextureVal()})
+      {
+        if (texture != nullptr && !texture->GetFile().empty())
+        {
+          linearTextures.insert(std::filesystem::absolute(texture->GetFile()).lexically_normal().string());
+        }
+      }
+    }
+
+    std::error_code errorCode;
+    static const StringArray cookableExtensions = {PNG, JPG, JPEG, TGA, BMP, PSD};
+    for (auto it = std::filesystem::recursive_directory_iterator(TexturePath(""), errorCode);
+         it != std::filesystem::recursive_directory_iterator();
+         it.increment(errorCode))
+    {
+      if (errorCode)
+      {
+        TK_ERR("%s\n", errorCode.message().c_str());
+        return -1;
+      }
+
+      if (!it->is_regular_file())
+      {
+        continue;
+      }
+
+      String source = it->path().string();
+      String ext    = it->path().extension().string();
+      std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+      if (!contains(cookableExtensions, ext))
+      {
+        continue;
+      }
+
+      // Cooked and cache folders are skipped by an empty path.
+      String cooked = TextureCompressor::CookedFilePath(source);
+      if (cooked.empty())
+      {
+        continue;
+      }
+
+      bool srgb = linearTextures.find(std::filesystem::absolute(source).lexically_normal().string()) ==
+                  linearTextures.end();
+
+      // Incremental, the image is cooked only if the source is newer than the cooked file or its usage has changed.
+      std::error_code timeError;
+      if (std::filesystem::exists(cooked) &&
+          std::filesystem::last_write_time(cooked, timeError) >= std::filesystem::last_write_time(source, timeError))
+      {
+        CompressedImage cookedImage;
+        bool readable = TextureCompressor::ReadKTX(GetFileManager()->GetBinaryFile(cooked), cookedImage);
+        if (readable && cookedImage.srgb == srgb)
+        {
+          continue;
+        }
+      }
+
+      CompressedImagePtr image = TextureCompressor::CookTexture(source, cooked, srgb);
+      if (image == nullptr)
+      {
+        TK_WRN("Texture can't be cooked, source image will be used: %s\n", source.c_str());
+        continue;
+      }
+
+      // Uncompressed mip chain is ~4 / 3 of the largest level.
+      uint64 largestLevel  = (uint64) image->width * (uint64) image->height * 4;
+      sourceSize          += largestLevel + largestLevel / 3;
+      cookedSize          += image->DataSize();
+      cookedCount++;
+    }
+
+    if (cookedCount > 0)
+    {
+      TK_LOG("Cooked %d textures. Gpu memory: %.2f MB -> %.2f MB\n",
+             cookedCount,
+             (double) sourceSize / (1024.0 * 1024.0),
+             (double) cookedSize / (1024.0 * 1024.0));
+    }
+
+    return 0;
+  }
+
+  int Packer::BuildAtlases()
+  {
+    TK_LOG("Building texture atlases\n");
+
+    TextureAtlasBuilder builder;
+    builder.AddFolder(TexturePath("UI"));
+    builder.AddFolder(SpritePath(""));
+
+    return builder.Build(TextureAtlas::GetManifestPath()) ? 0 : -1;
+  }
+
+  int Packer::BakeAnimations()
+  {
+    TK_LOG("Baking animations\n");
+
+    ResourceDependencyScanner scanner;
+    scanner.AddFolder(ScenePath(""));
+    scanner.AddFolder(LayerPath(""));
+    scanner.Scan();
+
+    std::vector<SkeletonPtr> skeletons;
+    std::vector<AnimationPtr> animations;
+    for (const String& file : scanner.GetFiles())
+    {
+      String ext;
+      DecomposePath(file, nullptr, nullptr, &ext);
+
+      if (ext == SKELETON)
+      {
+        skeletons.push_back(GetSkeletonManager()->Create<Skeleton>(file));
+      }
+      else if (ext == ANIM)
+      {
+        animations.push_back(GetAnimationManager()->Create<Animation>(file));
+      }
+    }
+
+    // Which skeleton plays an animation is decided at runtime, so every pair is tried. Pairs whose animation has no
+    // keys for any bone of the skeleton produce no data and are skipped.
+    int bakedCount = 0;
+    for (const SkeletonPtr& skeleton : skeletons)
+    {
+      for (const AnimationPtr& anim : animations)
+      {
+        if (AnimationPlayer::WriteAnimationData(skeleton, anim))
+        {
+          bakedCount++;
+        }
+      }
+    }
+
+    TK_LOG("Animation data is ready for %d skeleton animation pairs.\n", bakedCount);
+    return 0;
+  }
+
   bool Packer::CheckErrorReturn(String message)
   {
     if (m_errorCode)
@@ -12,11 +12,15 @@
 		uniform sampler2D s_texture0; //Image to be processed 
 		uniform sampler2D s_texture1; //Linear depth, where max value is far plane distance
 
-		uniform vec2 uPixelSize; //The size of a pixel: vec2(1.0/width, 1.0/height) 
-		uniform float focusPoint;
-		uniform float focusScale;
-		uniform float blurSize;
-		uniform float radiusScale; // Smaller = nicer blur, larger = faster
+		// Matches DofParams in DofPass.h.
+		layout(std140) uniform DofParams
+		{
+			vec2 uPixelSize; //The size of a pixel: vec2(1.0/width, 1.0/height) 
+			float focusPoint;
+			float focusScale;
+			float blurSize;
+			float radiusScale; // Smaller = nicer blur, larger = faster
+		};
 
 		const float GOLDEN_ANGLE = 2.39996323; 
 
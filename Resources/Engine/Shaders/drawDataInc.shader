@@ -28,6 +28,11 @@
 		return bool(drawCommand[0].z > 0.5);
 	}
 
+	int GetDiffuseSHIndex()
+	{
+		return int(drawCommand[0].w);
+	}
+
 	int GetActivePointLightCount()
 	{
 		return int(drawCommand[1].x);
@@ -55,6 +60,7 @@
 	#define MAX_POINT_LIGHT_PER_OBJECT 24
 	#define SPOT_LIGHT_CACHE_ITEM_COUNT 32
 	#define MAX_SPOT_LIGHT_PER_OBJECT 24
+	#define DIFFUSE_SH_CACHE_ITEM_COUNT 32
 
 	// Graphic Constants Data
 	//////////////////////////////////////////
@@ -145,6 +151,19 @@
 		SpotLightData spotLightArray[SPOT_LIGHT_CACHE_ITEM_COUNT];
 	};
 
+	// Diffuse Spherical Harmonics Data
+	//////////////////////////////////////////
+
+	struct DiffuseSHData
+	{
+		vec4 coefficients[9];
+	};
+
+	layout(std140) uniform DiffuseSHCache
+	{
+		DiffuseSHData diffuseSHArray[DIFFUSE_SH_CACHE_ITEM_COUNT];
+	};
+
 	#endif // DRAW_DATA
 
 	-->
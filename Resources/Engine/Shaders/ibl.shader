@@ -15,6 +15,18 @@ uniform sampler2D s_texture16;		// IBL BRDF Lut
 
 uniform mat4 iblRotation;
 
+// Evaluates the irradiance coefficients of the environment, basis constants are already in the coefficients.
+vec3 DiffuseSHIrradiance(int index, vec3 n)
+{
+	vec4 c[9] = diffuseSHArray[index].coefficients;
+	vec3 irradiance = c[0].rgb
+		+ c[1].rgb * n.y + c[2].rgb * n.z + c[3].rgb * n.x
+		+ c[4].rgb * (n.x * n.y) + c[5].rgb * (n.y * n.z) + c[6].rgb * (3.0 * n.z * n.z - 1.0)
+		+ c[7].rgb * (n.x * n.z) + c[8].rgb * (n.x * n.x - n.y * n.y);
+
+	return max(irradiance, vec3(0.0));
+}
+
 vec3 IBLDiffusePBR(vec3 normal, vec3 fragToEye, vec3 albedo, float metallic, float roughness, vec3 fresnel)
 {
 	vec3 irradiance = vec3(0.0);
@@ -23,7 +35,16 @@ vec3 IBLDiffusePBR(vec3 normal, vec3 fragToEye, vec3 albedo, float metallic, flo
 		vec3 kS = fresnel;
 		vec3 kD = 1.0 - kS;
 		vec3 iblSamplerVec = (iblRotation * vec4(normal, 1.0)).xyz;
-		vec3 iblIrradiance = texture(s_texture7, iblSamplerVec).rgb;
+		int shIndex = GetDiffuseSHIndex();
+		vec3 iblIrradiance;
+		if (shIndex < 0)
+		{
+			iblIrradiance = texture(s_texture7, iblSamplerVec).rgb;
+		}
+		else
+		{
+			iblIrradiance = DiffuseSHIrradiance(shIndex, normalize(iblSamplerVec));
+		}
 		vec3 diffuse    = iblIrradiance * albedo;
 		irradiance    = kD * diffuse;
 	}
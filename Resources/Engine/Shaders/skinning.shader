@@ -38,16 +38,19 @@ uniform float blendKeyFrameCount;
 uniform sampler2D s_texture2; // Blend animation data texture
 uniform sampler2D s_texture3; // Animation data texture
 
+// Each key frame holds top 3 rows of the bone matrices. Key frames wrap to next row when a texture row is filled.
 mat4 getMatrixFromTexture(sampler2D animDataTexture, float boneIndx, float keyframe, float numberOfKeyFrames)
 {
-  float matrixPos   = boneIndx / numBones;
-  float stepX       = 1.0 / (numBones * 4.0);
-  vec2 moveToCenter = vec2(stepX / 2.0, 1.0 / (numberOfKeyFrames * 2.0));
+  int bonesTexelCount = int(numBones) * 3;
+  int framesPerRow    = max(textureSize(animDataTexture, 0).x / bonesTexelCount, 1);
+  int key             = int(keyframe * numberOfKeyFrames + 0.5);
+  ivec2 texel         = ivec2((key % framesPerRow) * bonesTexelCount + int(boneIndx) * 3, key / framesPerRow);
 
-  return mat4(texture(animDataTexture, vec2(matrixPos, keyframe) + moveToCenter),
-              texture(animDataTexture, vec2(matrixPos + stepX, keyframe) + moveToCenter),
-              texture(animDataTexture, vec2(matrixPos + (stepX * 2.0), keyframe) + moveToCenter),
-              texture(animDataTexture, vec2(matrixPos + (stepX * 3.0), keyframe) + moveToCenter));
+  vec4 row0 = texelFetch(animDataTexture, texel, 0);
+  vec4 row1 = texelFetch(animDataTexture, texel + ivec2(1, 0), 0);
+  vec4 row2 = texelFetch(animDataTexture, texel + ivec2(2, 0), 0);
+
+  return transpose(mat4(row0, row1, row2, vec4(0.0, 0.0, 0.0, 1.0)));
 }
 
 // keyFramesData-> x: keyFrame1 y: keyFrame2 z: time w: key frame count
@@ -61,7 +64,7 @@ void skinCalc(in sampler2D animDataTexture, vec4 keyFramesData, in vec4 vertexPo
 
     if (isAnimated == 0u)
     {
-      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.5, keyFramesData.w);
+      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.0, keyFramesData.w);
       skinnedPos += bindPoseMatrix * vertexPos * vWeights[i];
     }
     else
@@ -98,7 +101,7 @@ void skinCalc
 
     if (isAnimated == 0u)
     {
-      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.5, keyFramesData.w);
+      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.0, keyFramesData.w);
       skinnedPos += bindPoseMatrix * vertexPos * vWeights[i];
       skinnedNormal += mat3(bindPoseMatrix) * vertexNormal * vWeights[i];
     }
@@ -145,7 +148,7 @@ void skinCalc
 
     if (isAnimated == 0u)
     {
-      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.5, keyFramesData.w);
+      mat4 bindPoseMatrix = getMatrixFromTexture(animDataTexture, vBones[i], 0.0, keyFramesData.w);
       mat3 bindPoseMatrix3x3 = mat3(bindPoseMatrix);
       skinnedPos += bindPoseMatrix * vertexPos * vWeights[i];
       skinnedNormal += bindPoseMatrix3x3 * vertexNormal * vWeights[i];
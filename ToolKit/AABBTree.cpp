@@ -293,9 +293,8 @@ namespace ToolKit
       return entities;
     }
 
-    EntityRawPtrArray entitiesInVolume;
-    entitiesInVolume.resize(m_nodeCapacity);
-    std::fill(entitiesInVolume.begin(), entitiesInVolume.end(), nullptr);
+    // Indexed by node, threads write their hits without synchronization. Transient, lives in the frame arena.
+    FrameArray<Entity*> entitiesInVolume(m_nodeCapacity, nullptr);
 
     m_maxThreadCount =
         m_nodeCount > m_threadTreshold && threaded ? GetWorkerManager()->GetThreadCount(WorkerManager::FramePool) : 0;
@@ -566,12 +565,12 @@ namespace ToolKit
     }
   }
 
-  void AABBTree::VolumeQuery(EntityRawPtrArray& result,
+  void AABBTree::VolumeQuery(FrameArray<Entity*>& result,
                              std::atomic_int& threadCount,
                              AABBNodeProxy root,
                              std::function<IntersectResult(AABBNodeProxy)> queryFn) const
   {
-    std::deque<AABBNodeProxy> stack;
+    FrameArray<AABBNodeProxy> stack;
     stack.emplace_back(root);
 
     while (stack.size() != 0)
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "FrameAllocator.h"
 #include "GeometryTypes.h"
 
 namespace ToolKit
@@ -94,7 +95,7 @@ namespace ToolKit
     void RemoveLeaf(AABBNodeProxy leaf);
     void Rotate(AABBNodeProxy node);
 
-    void VolumeQuery(EntityRawPtrArray& result,
+    void VolumeQuery(FrameArray<Entity*>& result,
                      std::atomic_int& threadCount,
                      AABBNodeProxy root,
                      std::function<IntersectResult(AABBNodeProxy)> queryFn) const;
@@ -15,12 +15,24 @@
 #include "Mesh.h"
 #include "Node.h"
 #include "Skeleton.h"
+#include "Threads.h"
 #include "ToolKit.h"
 #include "Util.h"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 #include "DebugNew.h"
 
-static constexpr bool SERIALIZE_ANIMATION_AS_BINARY = true;
+static constexpr bool SERIALIZE_ANIMATION_AS_BINARY    = true;
+
+// Animation data textures wrap key frames to next row beyond this width. Minimum texture size guaranteed by gles 3.0.
+static constexpr uint ANIMATION_DATA_TEXTURE_MAX_WIDTH = 2048;
+
+// Increment when the layout of the baked animation data changes to invalidate the disk cache.
+static constexpr uint ANIMATION_DATA_CACHE_VERSION     = 1;
+static constexpr uint ANIMATION_DATA_CACHE_MAGIC       = 0x42414B54; // TKAB
 
 namespace ToolKit
 {
@@ -119,6 +131,17 @@ namespace ToolKit
 
   void Animation::GetPose(Node* node, int frame) { GetPose(node, frame * 1.0f / m_fps); }
 
+  uint64 Animation::GetCpuMemory() const
+  {
+    uint64 memory = 0;
+    for (auto& boneKeys : m_keys)
+    {
+      memory += boneKeys.first.capacity() + boneKeys.second.capacity() * sizeof(Key);
+    }
+
+    return memory;
+  }
+
   void Animation::Load()
   {
     if (!m_loaded)
@@ -382,6 +405,8 @@ namespace ToolKit
 
   void AnimationPlayer::Update(float deltaTimeSec)
   {
+    UpdatePendingAnimationData();
+
     // Updates all the records in the player and returns true if record needs to be removed.
     auto updateRecordsFn = [&](AnimRecordPtr record) -> bool
     {
@@ -486,6 +511,16 @@ namespace ToolKit
         SkeletonComponentPtr skComp = ntt->GetComponent<SkeletonComponent>();
         if (meshComp->GetMeshVal()->IsSkinned() && skComp != nullptr)
         {
+          // Render the bind pose until the animation data is baked.
+          SkeletonPtr skeleton = skComp->GetSkeletonResourceVal();
+          ObjectId skelID      = skeleton != nullptr ? skeleton->GetIdVal() : NullHandle;
+          if (GetAnimationDataTexture(skelID, record->m_animation->GetIdVal()) == nullptr)
+          {
+            skComp->m_animData.currentAnimation = nullptr;
+            skComp->m_animData.blendAnimation   = nullptr;
+            continue;
+          }
+
           assert(record->m_animation->m_keys.size() > 0);
           KeyArray& keys = (*(record->m_animation->m_keys.begin())).second;
           int key1, key2;
@@ -499,7 +534,8 @@ namespace ToolKit
           skComp->m_animData.currentAnimation          = record->m_animation;
 
           AnimRecordPtr recordToBlend                  = record->m_blendingData.recordToBlend;
-          if (recordToBlend != nullptr)
+          if (recordToBlend != nullptr &&
+              GetAnimationDataTexture(skelID, recordToBlend->m_animation->GetIdVal()) != nullptr)
           {
             KeyArray& blendAnimKeys = (*(recordToBlend->m_animation->m_keys.begin())).second;
             recordToBlend->m_animation->GetNearestKeys(blendAnimKeys, key1, key2, ratio, recordToBlend->m_currentTime);
@@ -553,14 +589,26 @@ namespace ToolKit
       {
         if (SkeletonPtr skeleton = skelComp->GetSkeletonResourceVal())
         {
-          if (m_animTextures.find(std::make_pair(skeleton->GetIdVal(), anim->GetIdVal())) != m_animTextures.end())
+          std::pair<ObjectId, ObjectId> key = std::make_pair(skeleton->GetIdVal(), anim->GetIdVal());
+          if (m_animTextures.find(key) != m_animTextures.end() ||
+              m_pendingAnimData.find(key) != m_pendingAnimData.end())
           {
             // this animation data already exists
             return;
           }
 
-          DataTexturePtr texture = CreateAnimationDataTexture(skeleton, anim);
-          m_animTextures[std::make_pair(skeleton->GetIdVal(), anim->GetIdVal())] = texture;
+          if (Main::GetInstance()->m_threaded)
+          {
+            // Bake in the background to prevent a hitch on first play. Texture is created when the data is ready.
+            ThreadPool& pool       = GetWorkerManager()->GetPool(WorkerManager::BackgroundPool);
+            m_pendingAnimData[key] = pool.submit([skeleton, anim]() -> AnimationDataPtr
+                                                 { return BakeAnimationData(skeleton, anim); });
+          }
+          else
+          {
+            AnimationDataPtr data = BakeAnimationData(skeleton, anim);
+            m_animTextures[key]   = data != nullptr ? CreateAnimationDataTexture(*data) : nullptr;
+          }
         }
       }
     }
@@ -568,10 +616,9 @@ namespace ToolKit
 
   void AnimationPlayer::UpdateAnimationData()
   {
-    std::map<std::pair<ObjectId, ObjectId>, DataTexturePtr>::iterator it;
-    for (it = m_animTextures.begin(); it != m_animTextures.end();)
+    // States if any of the records is playing the animation on the skeleton.
+    auto isInUseFn = [this](const std::pair<ObjectId, ObjectId>& key) -> bool
     {
-      bool found = false;
       for (AnimRecordPtr animRecord : m_records)
       {
         if (EntityPtr entity = animRecord->m_entity.lock())
@@ -583,17 +630,21 @@ namespace ToolKit
               const ObjectId skeletonID = skeleton->GetIdVal();
               const ObjectId animID     = animRecord->m_animation->GetIdVal();
 
-              if (it->first.first == skeletonID && it->first.second == animID)
+              if (key.first == skeletonID && key.second == animID)
               {
-                found = true;
-                break;
+                return true;
               }
             }
           }
         }
       }
 
-      if (found)
+      return false;
+    };
+
+    for (auto it = m_animTextures.begin(); it != m_animTextures.end();)
+    {
+      if (isInUseFn(it->first))
       {
         ++it;
       }
@@ -602,91 +653,283 @@ namespace ToolKit
         it = m_animTextures.erase(it);
       }
     }
+
+    // Baking tasks are not cancelled, their results are dropped.
+    for (auto it = m_pendingAnimData.begin(); it != m_pendingAnimData.end();)
+    {
+      if (isInUseFn(it->first))
+      {
+        ++it;
+      }
+      else
+      {
+        it = m_pendingAnimData.erase(it);
+      }
+    }
+  }
+
+  void AnimationPlayer::UpdatePendingAnimationData()
+  {
+    for (auto it = m_pendingAnimData.begin(); it != m_pendingAnimData.end();)
+    {
+      if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        ++it;
+        continue;
+      }
+
+      AnimationDataPtr data     = it->second.get();
+      m_animTextures[it->first] = data != nullptr ? CreateAnimationDataTexture(*data) : nullptr;
+      it                        = m_pendingAnimData.erase(it);
+    }
+  }
+
+  void AnimationPlayer::ClearAnimationData()
+  {
+    m_animTextures.clear();
+    m_pendingAnimData.clear();
+  }
+
+  /** Fnv-1a hash of the given bytes, combined with the given hash. */
+  static uint64 HashAnimationBytes(uint64 hash, const void* data, size_t size)
+  {
+    const uint8* bytes = (const uint8*) data;
+    for (size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+
+    return hash;
+  }
+
+  /**
+   * Hash of all the content that effects the baked animation data. Bind pose is read from the given bone map which must
+   * be a copy of the skeleton's bind pose.
+   */
+  static uint64 HashAnimationData(const Skeleton* skeleton, const DynamicBoneMap& boneMap, const Animation* anim)
+  {
+    uint64 hash = 14695981039346656037ULL;
+    hash        = HashAnimationBytes(hash, &ANIMATION_DATA_CACHE_VERSION, sizeof(uint));
+
+    // Bone map is ordered by name, which makes the hash independent of the key map's order.
+    for (const auto& dBoneIter : boneMap.m_boneMap)
+    {
+      const String& name  = dBoneIter.first;
+      uint boneIndx       = dBoneIter.second.boneIndx;
+      Node* node          = dBoneIter.second.node;
+
+      hash                = HashAnimationBytes(hash, name.data(), name.size());
+      hash                = HashAnimationBytes(hash, &boneIndx, sizeof(uint));
+      hash                = HashAnimationBytes(hash, &skeleton->m_bones[boneIndx]->m_inverseWorldMatrix, sizeof(Mat4));
+
+      Mat4 localTransform = node->GetTransform(TransformationSpace::TS_PARENT);
+      hash                = HashAnimationBytes(hash, &localTransform, sizeof(Mat4));
+
+      auto keysIter       = anim->m_keys.find(name);
+      if (keysIter != anim->m_keys.end())
+      {
+        const KeyArray& keys = keysIter->second;
+        hash                 = HashAnimationBytes(hash, keys.data(), keys.size() * sizeof(Key));
+      }
+    }
+
+    return hash;
+  }
+
+  /** Header of the baked animation data files, followed by the texels. */
+  struct AnimationDataFileHeader
+  {
+    uint magic         = ANIMATION_DATA_CACHE_MAGIC;
+    uint version       = ANIMATION_DATA_CACHE_VERSION;
+    uint64 hash        = 0;
+    uint width         = 0;
+    uint height        = 0;
+    uint keyFrameCount = 0;
+    uint padding       = 0;
+  };
+
+  /** @return Cache file of the baked data with the given content hash. */
+  static String AnimationDataCacheFile(uint64 hash)
+  {
+    return AnimationPath(ConcatPaths({TKAnimationDataFolder, std::to_string(hash) + ".animdata"}));
+  }
+
+  static AnimationDataPtr ReadAnimationDataCache(const String& file, uint64 hash)
+  {
+    // Reads from the pak in published builds.
+    FileManager* fileMan = GetFileManager();
+    if (!fileMan->CheckFileFromResources(file))
+    {
+      return nullptr;
+    }
+
+    ByteArray bytes = fileMan->GetBinaryFile(file);
+    if (bytes.size() < sizeof(AnimationDataFileHeader))
+    {
+      return nullptr;
+    }
+
+    AnimationDataFileHeader header;
+    memcpy(&header, bytes.data(), sizeof(AnimationDataFileHeader));
+    if (header.magic != ANIMATION_DATA_CACHE_MAGIC || header.version != ANIMATION_DATA_CACHE_VERSION ||
+        header.hash != hash)
+    {
+      return nullptr;
+    }
+
+    // Size is validated before allocating, a corrupt header must not request an arbitrary amount of memory.
+    uint64 texelBytes = (uint64) header.width * (uint64) header.height * 4 * sizeof(float);
+    if (header.width == 0 || header.height == 0 || texelBytes != bytes.size() - sizeof(AnimationDataFileHeader))
+    {
+      return nullptr;
+    }
+
+    AnimationDataPtr data = std::make_shared<AnimationData>();
+    data->width           = header.width;
+    data->height          = header.height;
+    data->keyFrameCount   = header.keyFrameCount;
+    data->texels.resize((size_t) header.width * header.height * 4);
+    memcpy(data->texels.data(), bytes.data() + sizeof(AnimationDataFileHeader), texelBytes);
+
+    return data;
   }
 
-  void AnimationPlayer::ClearAnimationData() { m_animTextures.clear(); }
+  static bool WriteAnimationDataCache(const String& file, uint64 hash, const AnimationData& data)
+  {
+    std::error_code err;
+    std::filesystem::create_directories(std::filesystem::path(file).parent_path(), err);
+    if (err)
+    {
+      return false;
+    }
+
+    AnimationDataFileHeader header;
+    header.hash          = hash;
+    header.width         = data.width;
+    header.height        = data.height;
+    header.keyFrameCount = data.keyFrameCount;
+
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    stream.write((const char*) &header, sizeof(AnimationDataFileHeader));
+    stream.write((const char*) data.texels.data(), data.texels.size() * sizeof(float));
+
+    return stream.good();
+  }
 
-  DataTexturePtr AnimationPlayer::CreateAnimationDataTexture(SkeletonPtr skeleton, AnimationPtr anim)
+  AnimationDataPtr AnimationPlayer::BakeAnimationData(const SkeletonPtr& skeleton,
+                                                      const AnimationPtr& anim,
+                                                      bool useCache)
   {
-    if (anim->m_keys.empty())
+    if (skeleton == nullptr || anim == nullptr || anim->m_keys.empty() || skeleton->m_bones.empty())
     {
       return nullptr;
     }
 
-    uint height        = 1024;                               // max number of key frames
-    uint width         = (int) skeleton->m_bones.size() * 4; // number of bones * 4 (each element holds a row of matrix)
-    uint sizeOfElement = 16 * 4;                             // size of an element in bytes
+    // Pose a copy of the bind pose, skeleton is shared with the scene and other bakes.
+    DynamicBoneMap boneMap;
+    boneMap.Init(skeleton.get());
 
-    char* buffer       = new char[height * width * sizeOfElement];
+    uint64 hash = HashAnimationData(skeleton.get(), boneMap, anim.get());
+    if (useCache)
+    {
+      if (AnimationDataPtr data = ReadAnimationDataCache(AnimationDataCacheFile(hash), hash))
+      {
+        return data;
+      }
+    }
 
-    uint maxKeyCount   = 0;
-    uint keyframeIndex = 0;
-    while (true)
+    uint maxKeyCount = 0;
+    for (const auto& dBoneIter : boneMap.m_boneMap)
     {
-      if (keyframeIndex >= height)
+      auto keysIter = anim->m_keys.find(dBoneIter.first);
+      if (keysIter != anim->m_keys.end())
       {
-        TK_ERR("The maximum number of key frames for animations is 1024!");
-        TK_ERR("Animation \"%s\" has more than 1024 key frames.", anim->GetFile().c_str());
-        SafeDelArray(buffer);
-        return nullptr;
+        maxKeyCount = glm::max(maxKeyCount, (uint) keysIter->second.size());
       }
+    }
+
+    if (maxKeyCount == 0)
+    {
+      return nullptr;
+    }
+
+    const uint boneCount       = (uint) skeleton->m_bones.size();
+    const uint boneTexelCount  = boneCount * 3; // Top 3 rows of each matrix, the last row is always (0, 0, 0, 1).
+    const uint framesPerRow    = glm::max(1u, ANIMATION_DATA_TEXTURE_MAX_WIDTH / boneTexelCount);
 
-      bool keysframesLeft = false;
-      std::vector<std::pair<Node*, uint>> boneNodes;
+    AnimationDataPtr data      = std::make_shared<AnimationData>();
+    data->keyFrameCount        = maxKeyCount;
+    data->width                = glm::min(maxKeyCount, framesPerRow) * boneTexelCount;
+    data->height               = (maxKeyCount + framesPerRow - 1) / framesPerRow;
+    data->texels.resize((size_t) data->width * data->height * 4, 0.0f);
 
-      // Iterate all bones for the key frame and get node transformations
-      for (auto& dBoneIter : skeleton->m_Tpose.m_boneMap)
+    for (uint keyframeIndex = 0; keyframeIndex < maxKeyCount; keyframeIndex++)
+    {
+      for (auto& dBoneIter : boneMap.m_boneMap)
       {
-        const String& name                 = dBoneIter.first;
         DynamicBoneMap::DynamicBone& dBone = dBoneIter.second;
 
-        if (anim->m_keys.find(name) == anim->m_keys.end())
+        auto keysIter                      = anim->m_keys.find(dBoneIter.first);
+        if (keysIter == anim->m_keys.end())
         {
           dBone.node->SetLocalTransforms(Vec3(), Quaternion(), Vec3(1.0f));
-          boneNodes.push_back(std::make_pair(dBone.node, dBone.boneIndx));
           continue;
         }
 
-        std::vector<Key>& keys = anim->m_keys[name];
-        if (keys.size() <= keyframeIndex)
-        {
-          continue;
-        }
-        else
+        // Bones with fewer keys hold their last pose.
+        const KeyArray& keys = keysIter->second;
+        if (keyframeIndex < keys.size())
         {
-          if (maxKeyCount < keys.size())
-          {
-            maxKeyCount = (uint) keys.size();
-          }
-
-          keysframesLeft = true;
-
-          Key& key       = keys[keyframeIndex];
+          const Key& key = keys[keyframeIndex];
           dBone.node->SetLocalTransforms(key.m_position, key.m_rotation, key.m_scale);
-          boneNodes.push_back(std::make_pair(dBone.node, dBone.boneIndx));
         }
       }
 
-      if (!keysframesLeft)
+      boneMap.UpdateMatrixPalette(skeleton.get());
+
+      uint row    = keyframeIndex / framesPerRow;
+      uint column = (keyframeIndex % framesPerRow) * boneTexelCount;
+      float* dst  = &data->texels[((size_t) row * data->width + column) * 4];
+      for (uint boneIndx = 0; boneIndx < boneCount; boneIndx++)
       {
-        break;
+        Mat4 transposed = glm::transpose(boneMap.m_matrixPalette[boneIndx]);
+        memcpy(dst + boneIndx * 12, &transposed, sizeof(float) * 12);
       }
+    }
 
-      // After getting all node transformations re-calculate dirty nodes transformations
-      for (auto& node : boneNodes)
-      {
-        StaticBone* sBone         = skeleton->m_bones[node.second];
+    return data;
+  }
 
-        const Mat4 boneTransform  = node.first->GetTransform(TransformationSpace::TS_WORLD);
-        const Mat4 totalTransform = boneTransform * sBone->m_inverseWorldMatrix;
+  bool AnimationPlayer::WriteAnimationData(const SkeletonPtr& skeleton, const AnimationPtr& anim)
+  {
+    if (skeleton == nullptr || anim == nullptr || anim->m_keys.empty() || skeleton->m_bones.empty())
+    {
+      return false;
+    }
 
-        uint loc                  = ((keyframeIndex * (uint) skeleton->m_bones.size() + node.second) * sizeOfElement);
-        memcpy(buffer + loc, &totalTransform, sizeOfElement);
-      }
+    DynamicBoneMap boneMap;
+    boneMap.Init(skeleton.get());
 
-      ++keyframeIndex;
+    uint64 hash = HashAnimationData(skeleton.get(), boneMap, anim.get());
+    String file = AnimationDataCacheFile(hash);
+    if (CheckSystemFile(file))
+    {
+      // File name is the content hash, an existing file is up to date.
+      return true;
+    }
+
+    AnimationDataPtr data = BakeAnimationData(skeleton, anim, false);
+    if (data == nullptr)
+    {
+      return false;
     }
 
+    return WriteAnimationDataCache(file, hash, *data);
+  }
+
+  DataTexturePtr AnimationPlayer::CreateAnimationDataTexture(const AnimationData& data)
+  {
     TextureSettings dataTextureSettings;
     dataTextureSettings.Target         = GraphicTypes::Target2D;
     dataTextureSettings.WarpS          = GraphicTypes::UVClampToEdge;
@@ -695,10 +938,8 @@ namespace ToolKit
     dataTextureSettings.InternalFormat = GraphicTypes::FormatRGBA32F;
     dataTextureSettings.Format         = GraphicTypes::FormatRGBA;
     dataTextureSettings.Type           = GraphicTypes::TypeFloat;
-    DataTexturePtr animDataTexture     = MakeNewPtr<DataTexture>(width, maxKeyCount, dataTextureSettings);
-    animDataTexture->Init((void*) buffer);
-
-    SafeDelArray(buffer);
+    DataTexturePtr animDataTexture     = MakeNewPtr<DataTexture>(data.width, data.height, dataTextureSettings);
+    animDataTexture->Init((void*) data.texels.data());
 
     return animDataTexture;
   }
@@ -82,6 +82,8 @@ namespace ToolKit
 
     void Load() override; //!< Loads the animation data from file.
 
+    uint64 GetCpuMemory() const override; //!< Memory held by the key frames of the bones.
+
     /**
      * Set the resource to initiated state.
      * @param flushClientSideArray unused.
@@ -193,6 +195,21 @@ namespace ToolKit
     BlendingData m_blendingData;
   };
 
+  /**
+   * Key frame poses of an animation for a skeleton in the layout of the animation data textures. Each key frame holds
+   * the top three rows of the skinning matrix of each bone in consecutive RGBA32F texels. Key frames are wrapped to the
+   * next texture row when a row is filled, so the number of key frames is not limited by the texture height.
+   */
+  struct AnimationData
+  {
+    uint width         = 0;    //!< Width of the data texture in texels.
+    uint height        = 0;    //!< Height of the data texture in texels.
+    uint keyFrameCount = 0;    //!< Number of baked key frames.
+    std::vector<float> texels; //!< Four floats per texel, row by row.
+  };
+
+  typedef std::shared_ptr<AnimationData> AnimationDataPtr;
+
   /**
    * The class that is responsible playing animation records
    * and updating transformations of the corresponding Entities.
@@ -248,6 +265,27 @@ namespace ToolKit
      */
     DataTexturePtr GetAnimationDataTexture(ObjectId skelID, ObjectId animID);
 
+    /**
+     * Bakes the key frame poses of the animation for the skeleton. Data that is written ahead of time by
+     * WriteAnimationData is read from the disk or the pak instead, as long as the content does not change. Nothing is
+     * written, resources may be read only at runtime. Does not access the graphics api, can be called from any thread.
+     * @param skeleton is the skeleton to bake the poses for.
+     * @param anim is the animation to bake.
+     * @param useCache states if the baked data on the disk or in the pak is read.
+     * @return Baked data or nullptr if there isn't any key in the animation for the skeleton.
+     */
+    static AnimationDataPtr BakeAnimationData(const SkeletonPtr& skeleton,
+                                              const AnimationPtr& anim,
+                                              bool useCache = true);
+
+    /**
+     * Bakes the animation for the skeleton and writes the data under the Meshes/Baked folder, which is packed in to the
+     * pak. The file name is the hash of the skeleton and the animation content, existing files are not baked again.
+     * Called by the packer.
+     * @return False if there isn't any key in the animation for the skeleton or the file can't be written.
+     */
+    static bool WriteAnimationData(const SkeletonPtr& skeleton, const AnimationPtr& anim);
+
    private:
     /**
      * Clears all animation records.
@@ -270,9 +308,14 @@ namespace ToolKit
     void ClearAnimationData();
 
     /**
-     * Creates and returns animation data texture for given skeleton and animation
+     * Creates data textures for the animation data that are baked in the background.
      */
-    DataTexturePtr CreateAnimationDataTexture(SkeletonPtr skeleton, AnimationPtr anim);
+    void UpdatePendingAnimationData();
+
+    /**
+     * Creates and returns animation data texture for the baked data.
+     */
+    DataTexturePtr CreateAnimationDataTexture(const AnimationData& data);
 
    public:
     /** Global time multiplier for all track in the player. */
@@ -284,6 +327,9 @@ namespace ToolKit
 
     // Storage for animation data (skeleton id - animation id pair)
     std::map<std::pair<ObjectId, ObjectId>, DataTexturePtr> m_animTextures;
+
+    // Animation data that are being baked in the background (skeleton id - animation id pair)
+    std::map<std::pair<ObjectId, ObjectId>, std::future<AnimationDataPtr>> m_pendingAnimData;
   };
 
 } // namespace ToolKit
@@ -8,6 +8,9 @@
 #include "Audio.h"
 
 #include "FileManager.h"
+#include "Stats.h"
+#include "Threads.h"
+#include "ToolKit.h"
 
 #define MINIAUDIO_IMPLEMENTATION
 #include "miniaudio/miniaudio.h"
@@ -16,6 +19,170 @@
 
 namespace ToolKit
 {
+  // Stream file system
+  //////////////////////////////////////////
+
+  /** A file that is opened through the stream file system. */
+  struct StreamFile
+  {
+    ma_vfs_file file  = nullptr; //!< File of the default file system, null for the registered data.
+    const uint8* data = nullptr; //!< Registered data.
+    uint64 size       = 0;
+    uint64 cursor     = 0;
+  };
+
+  /**
+   * File system of the audio engine. Registered data is served from memory, other paths are forwarded to the disk.
+   * Streams of the resource manager read through it on the job thread of the engine.
+   */
+  struct StreamVFS
+  {
+    ma_vfs_callbacks callbacks {}; //!< Must be the first member, miniaudio reaches the callbacks through the vfs.
+    ma_default_vfs defaultVFS {};
+    Mutex dataMutex;
+    std::unordered_map<String, std::pair<const uint8*, uint64>> data;
+  };
+
+  static ma_result StreamVFSOpen(ma_vfs* vfs, const char* path, ma_uint32 openMode, ma_vfs_file* file)
+  {
+    StreamVFS* streamVFS   = (StreamVFS*) vfs;
+    StreamFile* streamFile = new StreamFile();
+    {
+      LockGuard lock(streamVFS->dataMutex);
+      auto data = streamVFS->data.find(path);
+      if (data != streamVFS->data.end())
+      {
+        streamFile->data = data->second.first;
+        streamFile->size = data->second.second;
+      }
+    }
+
+    if (streamFile->data == nullptr)
+    {
+      ma_result result = ma_vfs_open(&streamVFS->defaultVFS, path, openMode, &streamFile->file);
+      if (result != MA_SUCCESS)
+      {
+        SafeDel(streamFile);
+        return result;
+      }
+    }
+
+    *file = (ma_vfs_file) streamFile;
+    return MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSOpenW(ma_vfs* vfs, const wchar_t* path, ma_uint32 openMode, ma_vfs_file* file)
+  {
+    // Registered data is named with narrow strings.
+    StreamVFS* streamVFS   = (StreamVFS*) vfs;
+    StreamFile* streamFile = new StreamFile();
+
+    ma_result result       = ma_vfs_open_w(&streamVFS->defaultVFS, path, openMode, &streamFile->file);
+    if (result != MA_SUCCESS)
+    {
+      SafeDel(streamFile);
+      return result;
+    }
+
+    *file = (ma_vfs_file) streamFile;
+    return MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSClose(ma_vfs* vfs, ma_vfs_file file)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      ma_vfs_close(&((StreamVFS*) vfs)->defaultVFS, streamFile->file);
+    }
+
+    SafeDel(streamFile);
+    return MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSRead(ma_vfs* vfs, ma_vfs_file file, void* dst, size_t sizeInBytes, size_t* bytesRead)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      return ma_vfs_read(&((StreamVFS*) vfs)->defaultVFS, streamFile->file, dst, sizeInBytes, bytesRead);
+    }
+
+    size_t size = (size_t) glm::min((uint64) sizeInBytes, streamFile->size - streamFile->cursor);
+    memcpy(dst, streamFile->data + streamFile->cursor, size);
+    streamFile->cursor += size;
+
+    if (bytesRead != nullptr)
+    {
+      *bytesRead = size;
+    }
+
+    return size == 0 && sizeInBytes > 0 ? MA_AT_END : MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSWrite(ma_vfs* vfs, ma_vfs_file file, const void* src, size_t sizeInBytes, size_t* written)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      return ma_vfs_write(&((StreamVFS*) vfs)->defaultVFS, streamFile->file, src, sizeInBytes, written);
+    }
+
+    return MA_INVALID_OPERATION;
+  }
+
+  static ma_result StreamVFSSeek(ma_vfs* vfs, ma_vfs_file file, ma_int64 offset, ma_seek_origin origin)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      return ma_vfs_seek(&((StreamVFS*) vfs)->defaultVFS, streamFile->file, offset, origin);
+    }
+
+    ma_int64 base = 0;
+    if (origin == ma_seek_origin_current)
+    {
+      base = (ma_int64) streamFile->cursor;
+    }
+    else if (origin == ma_seek_origin_end)
+    {
+      base = (ma_int64) streamFile->size;
+    }
+
+    ma_int64 cursor = base + offset;
+    if (cursor < 0 || cursor > (ma_int64) streamFile->size)
+    {
+      return MA_BAD_SEEK;
+    }
+
+    streamFile->cursor = (uint64) cursor;
+    return MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSTell(ma_vfs* vfs, ma_vfs_file file, ma_int64* cursor)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      return ma_vfs_tell(&((StreamVFS*) vfs)->defaultVFS, streamFile->file, cursor);
+    }
+
+    *cursor = (ma_int64) streamFile->cursor;
+    return MA_SUCCESS;
+  }
+
+  static ma_result StreamVFSInfo(ma_vfs* vfs, ma_vfs_file file, ma_file_info* info)
+  {
+    StreamFile* streamFile = (StreamFile*) file;
+    if (streamFile->file != nullptr)
+    {
+      return ma_vfs_info(&((StreamVFS*) vfs)->defaultVFS, streamFile->file, info);
+    }
+
+    info->sizeInBytes = streamFile->size;
+    return MA_SUCCESS;
+  }
+
   // Audio
   //////////////////////////////////////////
 
@@ -31,22 +198,102 @@ namespace ToolKit
 
   void Audio::Load()
   {
-    String path = GetFile();
-    m_sound     = GetFileManager()->GetAudioFile(path);
+    if (m_loaded)
+    {
+      return;
+    }
 
-    if (m_sound == nullptr)
+    String path            = GetFile();
+    AudioManager* audioMan = GetAudioManager();
+
+    // Files on the disk are streamed from their paths, files that are only in the pak are kept encoded in memory.
+    bool onDisk            = CheckSystemFile(path);
+    uint64 encodedSize     = 0;
+    if (onDisk)
+    {
+      std::error_code err;
+      encodedSize = (uint64) std::filesystem::file_size(path, err);
+    }
+    else if (m_playback != AudioPlayback::Decoded && m_encodedFile.Open(path))
+    {
+      encodedSize = m_encodedFile.Size();
+    }
+
+    bool stream = m_playback == AudioPlayback::Streamed ||
+                  (m_playback == AudioPlayback::Auto && encodedSize > audioMan->m_streamingThreshold);
+
+    if (stream)
+    {
+      if (onDisk)
+      {
+        m_streamName = path;
+      }
+      else if (m_encodedFile.Data() != nullptr)
+      {
+        m_streamName = audioMan->RegisterStreamData(m_encodedFile.Data(), m_encodedFile.Size());
+      }
+
+      if (m_streamName.empty())
+      {
+        TK_ERR("Cannot load sound file! %s", path.c_str());
+        return;
+      }
+
+      m_duration = audioMan->GetStreamDuration(m_streamName);
+    }
+    else
     {
-      TK_ERR("Cannot load sound file! %s", path.c_str());
+      m_encodedFile.Close();
+      m_sound = GetFileManager()->GetAudioFile(path);
+
+      if (m_sound == nullptr)
+      {
+        TK_ERR("Cannot load sound file! %s", path.c_str());
+        return;
+      }
+
+      ma_sound* sound    = (ma_sound*) m_sound;
+      ma_format format   = ma_format_unknown;
+      ma_uint32 channels = 0;
+      ma_uint64 frames   = 0;
+      ma_sound_get_data_format(sound, &format, &channels, nullptr, nullptr, 0);
+      ma_sound_get_length_in_pcm_frames(sound, &frames);
+      ma_sound_get_length_in_seconds(sound, &m_duration);
+
+      m_decodedSize = (uint64) frames * channels * ma_get_bytes_per_sample(format);
     }
+
+    m_loaded = true;
   }
 
   void Audio::UnInit()
   {
-    ma_sound* sound = (ma_sound*) m_sound;
-    ma_sound_uninit(sound);
-    SafeDel(sound);
+    if (AudioManager* audioMan = GetAudioManager())
+    {
+      audioMan->ReleaseVoices(this);
+
+      if (m_encodedFile.Data() != nullptr && !m_streamName.empty())
+      {
+        audioMan->UnregisterStreamData(m_streamName);
+      }
+    }
+
+    if (m_sound != nullptr)
+    {
+      ma_sound* sound = (ma_sound*) m_sound;
+      ma_sound_uninit(sound);
+      SafeDel(sound);
+      m_sound = nullptr;
+    }
+
+    m_encodedFile.Close();
+    m_streamName.clear();
+    m_decodedSize = 0;
+    m_loaded      = false;
   }
 
+  bool Audio::IsStreamed() const { return !m_streamName.empty(); }
+
   // Audio Manager
   //////////////////////////////////////////
 
@@ -57,13 +304,28 @@ namespace ToolKit
   void AudioManager::Init()
   {
     ResourceManager::Init();
-    ma_engine* engine       = new ma_engine();
-    ma_engine_config config = ma_engine_config_init();
-    config.listenerCount    = MA_ENGINE_MAX_LISTENERS;
 
-    m_engine                = (void*) engine;
-
-    ma_result result        = ma_engine_init(&config, engine);
+    // Engine reads all files through the stream file system, which also serves the audio streamed from the pak.
+    StreamVFS* vfs = new StreamVFS();
+    ma_default_vfs_init(&vfs->defaultVFS, nullptr);
+    vfs->callbacks.onOpen      = StreamVFSOpen;
+    vfs->callbacks.onOpenW     = StreamVFSOpenW;
+    vfs->callbacks.onClose     = StreamVFSClose;
+    vfs->callbacks.onRead      = StreamVFSRead;
+    vfs->callbacks.onWrite     = StreamVFSWrite;
+    vfs->callbacks.onSeek      = StreamVFSSeek;
+    vfs->callbacks.onTell      = StreamVFSTell;
+    vfs->callbacks.onInfo      = StreamVFSInfo;
+    m_streamVFS                = (void*) vfs;
+
+    ma_engine* engine          = new ma_engine();
+    ma_engine_config config    = ma_engine_config_init();
+    config.listenerCount       = MA_ENGINE_MAX_LISTENERS;
+    config.pResourceManagerVFS = (ma_vfs*) vfs;
+
+    m_engine                   = (void*) engine;
+
+    ma_result result           = ma_engine_init(&config, engine);
     assert(result == MA_SUCCESS);
   }
 
@@ -74,9 +336,49 @@ namespace ToolKit
   void AudioManager::Uninit()
   {
     ResourceManager::Uninit();
+
+    for (AudioVoice* voice : m_voices)
+    {
+      if (voice->owner != nullptr)
+      {
+        voice->owner->OnVoiceReleased(false);
+      }
+
+      UninitVoiceSound(voice);
+      ma_sound* sound = (ma_sound*) voice->sound;
+      SafeDel(sound);
+      SafeDel(voice);
+    }
+    m_voices.clear();
+
     ma_engine* engine = (ma_engine*) m_engine;
     ma_engine_uninit(engine);
     SafeDel(engine);
+    m_engine       = nullptr;
+
+    StreamVFS* vfs = (StreamVFS*) m_streamVFS;
+    SafeDel(vfs);
+    m_streamVFS = nullptr;
+  }
+
+  void AudioManager::Update()
+  {
+    // Voices of the sounds that reached their end are returned to the pool. Looping sounds never end.
+    for (AudioVoice* voice : m_voices)
+    {
+      if (voice->owner != nullptr && ma_sound_at_end((const ma_sound*) voice->sound) == MA_TRUE)
+      {
+        voice->owner->OnVoiceReleased(true);
+        ReleaseVoice(voice);
+      }
+    }
+
+    if (TKStats* stats = GetTKStats())
+    {
+      stats->m_activeAudioVoices  = GetActiveVoiceCount();
+      stats->m_maxAudioVoices     = m_maxVoiceCount;
+      stats->m_decodedAudioMemory = GetDecodedSize();
+    }
   }
 
   SoundBuffer AudioManager::DecodeFromMemory(ubyte* buffer, uint bufferSize)
@@ -132,6 +434,234 @@ namespace ToolKit
     return (SoundBuffer) sound;
   }
 
+  String AudioManager::RegisterStreamData(const uint8* data, uint64 size)
+  {
+    char name[64];
+    snprintf(name, sizeof(name), "stream_data_%p", data);
+
+    StreamVFS* vfs = (StreamVFS*) m_streamVFS;
+    LockGuard lock(vfs->dataMutex);
+    vfs->data[name] = {data, size};
+
+    return name;
+  }
+
+  void AudioManager::UnregisterStreamData(const String& name)
+  {
+    StreamVFS* vfs = (StreamVFS*) m_streamVFS;
+    LockGuard lock(vfs->dataMutex);
+    vfs->data.erase(name);
+  }
+
+  float AudioManager::GetStreamDuration(const String& name)
+  {
+    ma_decoder decoder;
+    if (ma_decoder_init_vfs((ma_vfs*) m_streamVFS, name.c_str(), nullptr, &decoder) != MA_SUCCESS)
+    {
+      return 0.0f;
+    }
+
+    ma_uint64 frames = 0;
+    ma_decoder_get_length_in_pcm_frames(&decoder, &frames);
+
+    float duration = 0.0f;
+    if (decoder.outputSampleRate > 0)
+    {
+      duration = (float) frames / (float) decoder.outputSampleRate;
+    }
+
+    ma_decoder_uninit(&decoder);
+    return duration;
+  }
+
+  AudioVoice* AudioManager::AcquireVoice(AudioSource* source, Audio* audio, int priority)
+  {
+    if (audio == nullptr || (audio->m_sound == nullptr && !audio->IsStreamed()))
+    {
+      return nullptr;
+    }
+
+    // A free voice that already plays the audio is used as is. Otherwise an uninitialized voice is preferred, so that
+    // the sounds of the other free voices are kept for reuse.
+    AudioVoice* selected = nullptr;
+    for (AudioVoice* voice : m_voices)
+    {
+      if (voice->owner != nullptr)
+      {
+        continue;
+      }
+
+      if (voice->audio == audio)
+      {
+        selected = voice;
+        break;
+      }
+
+      if (selected == nullptr || (selected->audio != nullptr && voice->audio == nullptr))
+      {
+        selected = voice;
+      }
+    }
+
+    bool reusable = selected != nullptr && (selected->audio == audio || selected->audio == nullptr);
+    if (!reusable && (int) m_voices.size() < m_maxVoiceCount)
+    {
+      selected        = new AudioVoice();
+      selected->sound = (SoundBuffer) new ma_sound();
+      m_voices.push_back(selected);
+    }
+
+    // Steal a voice, the ones that are not playing go first, then the lowest priority and then the oldest.
+    if (selected == nullptr)
+    {
+      AudioVoice* victim = nullptr;
+      bool victimPlaying = true;
+      for (AudioVoice* voice : m_voices)
+      {
+        bool playing = ma_sound_is_playing((const ma_sound*) voice->sound) == MA_TRUE;
+        if (voice->priority > priority)
+        {
+          continue;
+        }
+
+        if (victim == nullptr || (!playing && victimPlaying) ||
+            (playing == victimPlaying &&
+             (voice->priority < victim->priority ||
+              (voice->priority == victim->priority && voice->startTick < victim->startTick))))
+        {
+          victim        = voice;
+          victimPlaying = playing;
+        }
+      }
+
+      if (victim == nullptr)
+      {
+        return nullptr;
+      }
+
+      victim->owner->OnVoiceReleased(false);
+      ReleaseVoice(victim);
+      selected = victim;
+    }
+
+    if (!InitVoiceSound(selected, audio))
+    {
+      return nullptr;
+    }
+
+    selected->owner     = source;
+    selected->priority  = priority;
+    selected->startTick = ++m_voiceTick;
+
+    return selected;
+  }
+
+  void AudioManager::ReleaseVoice(AudioVoice* voice)
+  {
+    if (voice == nullptr || voice->owner == nullptr)
+    {
+      return;
+    }
+
+    ma_sound_stop((ma_sound*) voice->sound);
+    voice->owner = nullptr;
+  }
+
+  void AudioManager::ReleaseVoices(Audio* audio)
+  {
+    for (AudioVoice* voice : m_voices)
+    {
+      if (voice->audio != audio)
+      {
+        continue;
+      }
+
+      if (voice->owner != nullptr)
+      {
+        voice->owner->OnVoiceReleased(false);
+        ReleaseVoice(voice);
+      }
+
+      UninitVoiceSound(voice);
+    }
+  }
+
+  int AudioManager::GetActiveVoiceCount() const
+  {
+    int count = 0;
+    for (AudioVoice* voice : m_voices)
+    {
+      count += voice->owner != nullptr;
+    }
+
+    return count;
+  }
+
+  uint64 AudioManager::GetDecodedSize()
+  {
+    uint64 size = 0;
+
+    SpinlockGuard lock(m_storageLock);
+    for (const auto& resource : m_storage)
+    {
+      size += static_cast<Audio*>(resource.second.get())->m_decodedSize;
+    }
+
+    return size;
+  }
+
+  bool AudioManager::InitVoiceSound(AudioVoice* voice, Audio* audio)
+  {
+    ma_sound* sound = (ma_sound*) voice->sound;
+    if (voice->audio == audio)
+    {
+      // Same sound is played again from the start.
+      ma_sound_seek_to_pcm_frame(sound, 0);
+      return true;
+    }
+
+    UninitVoiceSound(voice);
+
+    ma_engine* engine = (ma_engine*) m_engine;
+    ma_result result  = MA_ERROR;
+    if (audio->IsStreamed())
+    {
+      result = ma_sound_init_from_file(engine,
+                                       audio->m_streamName.c_str(),
+                                       MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_NO_SPATIALIZATION,
+                                       nullptr,
+                                       nullptr,
+                                       sound);
+    }
+    else
+    {
+      // Copies share the decoded data of the audio.
+      result = ma_sound_init_copy(engine,
+                                  (const ma_sound*) audio->m_sound,
+                                  MA_SOUND_FLAG_NO_SPATIALIZATION,
+                                  nullptr,
+                                  sound);
+    }
+
+    if (result != MA_SUCCESS)
+    {
+      TK_ERR("Sound %s can't be initialized for playback.", audio->GetFile().c_str());
+      return false;
+    }
+
+    voice->audio = audio;
+    return true;
+  }
+
+  void AudioManager::UninitVoiceSound(AudioVoice* voice)
+  {
+    if (voice->audio != nullptr)
+    {
+      ma_sound_uninit((ma_sound*) voice->sound);
+      voice->audio = nullptr;
+    }
+  }
+
   bool AudioManager::CanStore(ClassMeta* Class) { return Class == Audio::StaticClass(); }
 
   // AudioSource
@@ -139,77 +669,181 @@ namespace ToolKit
 
   TKDefineClass(AudioSource, Entity);
 
+  /** Moves the sound to the given second. */
+  static void SeekSound(ma_sound* sound, float seconds)
+  {
+    ma_uint32 sampRate = 0;
+    ma_sound_get_data_format(sound, nullptr, nullptr, &sampRate, nullptr, 0);
+    ma_sound_seek_to_pcm_frame(sound, (ma_uint64) (seconds * sampRate));
+  }
+
   AudioSource::~AudioSource()
   {
-    if (m_sound != nullptr)
+    if (m_voice != nullptr)
     {
-      ma_sound_uninit((ma_sound*) m_sound);
-      SafeDel(m_sound);
+      if (AudioManager* audioMan = GetAudioManager())
+      {
+        audioMan->ReleaseVoice(m_voice);
+      }
     }
   }
 
   void AudioSource::AttachAudio(const AudioPtr& audio)
   {
-    m_audio                     = audio;
+    // Voices are assigned on play, the voice of the previous audio goes back to the pool.
+    if (m_voice != nullptr)
+    {
+      GetAudioManager()->ReleaseVoice(m_voice);
+      m_voice = nullptr;
+    }
 
-    ma_engine* engine           = (ma_engine*) GetAudioManager()->m_engine;
-    const ma_sound* sourceSound = (const ma_sound*) audio->m_sound;
+    m_audio     = audio;
+    m_startTime = 0.0f;
+    m_ended     = false;
+  }
 
-    ma_sound* copySound         = new ma_sound();
-    memset(copySound, 0, sizeof(ma_sound));
+  void AudioSource::OnVoiceReleased(bool ended)
+  {
+    m_voice     = nullptr;
+    m_startTime = 0.0f;
+    m_ended     = ended;
+  }
 
-    ma_sound_init_copy(engine, sourceSound, MA_SOUND_FLAG_NO_SPATIALIZATION, nullptr, copySound);
-    m_sound = (void*) copySound;
+  void AudioSource::ApplyToVoice()
+  {
+    ma_sound* sound = (ma_sound*) m_voice->sound;
+    ma_sound_set_looping(sound, m_loop ? MA_TRUE : MA_FALSE);
+    ma_sound_set_volume(sound, m_volume);
+    ma_sound_set_pitch(sound, m_pitch);
+    ma_sound_set_position(sound, m_position.x, m_position.y, m_position.z);
   }
 
   // Setters
 
-  void AudioSource::SetLoop(bool looping) { ma_sound_set_looping((ma_sound*) m_sound, looping ? MA_TRUE : MA_FALSE); }
+  void AudioSource::SetLoop(bool looping)
+  {
+    m_loop = looping;
+    if (m_voice != nullptr)
+    {
+      ma_sound_set_looping((ma_sound*) m_voice->sound, looping ? MA_TRUE : MA_FALSE);
+    }
+  }
 
-  void AudioSource::SetVolume(float volume) { ma_sound_set_volume((ma_sound*) m_sound, volume); }
+  void AudioSource::SetVolume(float volume)
+  {
+    m_volume = volume;
+    if (m_voice != nullptr)
+    {
+      ma_sound_set_volume((ma_sound*) m_voice->sound, volume);
+    }
+  }
 
   void AudioSource::Seek(float duration)
   {
-    ma_uint32 sampRate;
-    ma_sound* sound = (ma_sound*) m_sound;
-    ma_sound_get_data_format(sound, nullptr, nullptr, &sampRate, nullptr, 0);
-    ma_sound_seek_to_pcm_frame(sound, (ma_uint64) (duration * sampRate));
+    if (m_voice != nullptr)
+    {
+      SeekSound((ma_sound*) m_voice->sound, duration);
+    }
+    else
+    {
+      m_startTime = duration;
+    }
   }
 
-  void AudioSource::SetPitch(float val) { ma_sound_set_pitch((ma_sound*) m_sound, val); }
-
-  void AudioSource::SetPosition(Vec3 pos) { ma_sound_set_position((ma_sound*) m_sound, pos.x, pos.y, pos.z); }
+  void AudioSource::SetPitch(float val)
+  {
+    m_pitch = val;
+    if (m_voice != nullptr)
+    {
+      ma_sound_set_pitch((ma_sound*) m_voice->sound, val);
+    }
+  }
 
-  void AudioSource::Play() { ma_sound_start((ma_sound*) m_sound); }
+  void AudioSource::SetPosition(Vec3 pos)
+  {
+    m_position = pos;
+    if (m_voice != nullptr)
+    {
+      ma_sound_set_position((ma_sound*) m_voice->sound, pos.x, pos.y, pos.z);
+    }
+  }
 
-  void AudioSource::Stop() { ma_sound_stop((ma_sound*) m_sound); }
+  void AudioSource::Play()
+  {
+    if (m_audio == nullptr)
+    {
+      return;
+    }
 
-  // Getters
+    if (m_voice == nullptr)
+    {
+      m_voice = GetAudioManager()->AcquireVoice(this, m_audio.get(), m_priority);
+      if (m_voice == nullptr)
+      {
+        // All voices play sources with higher priority.
+        return;
+      }
+
+      ApplyToVoice();
+    }
 
-  bool AudioSource::IsEnd() const { return ma_sound_at_end((const ma_sound*) m_sound) == MA_TRUE; }
+    m_ended         = false;
+    ma_sound* sound = (ma_sound*) m_voice->sound;
+    ma_sound_start(sound);
 
-  bool AudioSource::IsPlaying() const { return ma_sound_is_playing((const ma_sound*) m_sound) == MA_TRUE; }
+    // Starting a sound that is at its end rewinds it, seek is applied after.
+    if (m_startTime > 0.0f)
+    {
+      SeekSound(sound, m_startTime);
+      m_startTime = 0.0f;
+    }
+  }
 
-  float AudioSource::GetDuration() const
+  void AudioSource::Stop()
   {
-    float duration  = 0.0f;
-    // ma_sound_get_length_in_seconds takes a non-const pointer (not sure why).
-    // To get around this, we need a const_cast on the this pointer.
-    ma_sound* sound = (ma_sound*) const_cast<void*>(m_sound);
-    ma_sound_get_length_in_seconds(sound, &duration);
-    return duration;
+    // Voice goes back to the pool, the next play resumes from the stopped position.
+    if (m_voice == nullptr)
+    {
+      return;
+    }
+
+    ma_sound* sound = (ma_sound*) m_voice->sound;
+    float cursor    = 0.0f;
+    if (ma_sound_at_end(sound) == MA_FALSE)
+    {
+      ma_sound_get_cursor_in_seconds(sound, &cursor);
+    }
+
+    GetAudioManager()->ReleaseVoice(m_voice);
+    m_voice     = nullptr;
+    m_startTime = cursor;
   }
 
-  bool AudioSource::GetLoop() const { return ma_sound_is_looping((const ma_sound*) m_sound) == MA_TRUE; }
+  // Getters
 
-  float AudioSource::GetVolume() const { return ma_sound_get_volume((const ma_sound*) m_sound); }
+  bool AudioSource::IsEnd() const
+  {
+    if (m_voice == nullptr)
+    {
+      return m_ended;
+    }
 
-  float AudioSource::GetPitch() const { return ma_sound_get_pitch((const ma_sound*) m_sound); }
+    return ma_sound_at_end((const ma_sound*) m_voice->sound) == MA_TRUE;
+  }
 
-  Vec3 AudioSource::GetPosition() const
+  bool AudioSource::IsPlaying() const
   {
-    ma_vec3f pos = ma_sound_get_position((const ma_sound*) m_sound);
-    return Vec3(pos.x, pos.y, pos.z);
+    return m_voice != nullptr && ma_sound_is_playing((const ma_sound*) m_voice->sound) == MA_TRUE;
   }
 
+  float AudioSource::GetDuration() const { return m_audio != nullptr ? m_audio->m_duration : 0.0f; }
+
+  bool AudioSource::GetLoop() const { return m_loop; }
+
+  float AudioSource::GetVolume() const { return m_volume; }
+
+  float AudioSource::GetPitch() const { return m_pitch; }
+
+  Vec3 AudioSource::GetPosition() const { return m_position; }
+
 } // namespace ToolKit
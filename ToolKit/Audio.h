@@ -8,11 +8,20 @@
 #pragma once
 
 #include "Entity.h"
+#include "MappedFile.h"
 #include "Resource.h"
 
 namespace ToolKit
 {
 
+  /** How an audio is decoded for playback. */
+  enum class AudioPlayback
+  {
+    Auto,    //!< Streamed if the encoded file is larger than AudioManager::m_streamingThreshold.
+    Decoded, //!< Decoded in to memory at load time, all voices share the decoded data.
+    Streamed //!< Decoded page by page on the job thread of the audio engine while playing.
+  };
+
   class TK_API Audio : public Resource
   {
    public:
@@ -26,12 +35,32 @@ namespace ToolKit
     void Load() override;
     void UnInit() override;
 
+    /** @return True if the audio is streamed instead of being decoded at load time. */
+    bool IsStreamed() const;
+
    public:
-    SoundBuffer m_sound = nullptr;
+    AudioPlayback m_playback = AudioPlayback::Auto; //!< Must be set before the audio is loaded.
+    SoundBuffer m_sound      = nullptr;             //!< Decoded sound that the voices copy, null if streamed.
+    String m_streamName;                            //!< Name that the streamed voices are initialized from.
+    float m_duration         = 0.0f;                //!< Length of the audio in seconds.
+    uint64 m_decodedSize     = 0;                   //!< Bytes of pcm data that the decoded sound holds.
+
+   private:
+    MappedFile m_encodedFile; //!< Encoded content of the audio that is streamed from the pak.
   };
 
   typedef std::shared_ptr<Audio> AudioPtr;
 
+  /** A sound that plays an audio for a source. Voices are owned by the AudioManager and reused between the sources. */
+  struct AudioVoice
+  {
+    SoundBuffer sound  = nullptr; //!< Raw sound object, allocated once for the voice.
+    Audio* audio       = nullptr; //!< Audio that the sound is initialized for, null if not initialized.
+    AudioSource* owner = nullptr; //!< Source that the voice plays for, null if the voice is free.
+    int priority       = 0;       //!< Priority of the owner when the voice is acquired.
+    uint64 startTick   = 0;       //!< Order of the acquisitions. Oldest of the lowest priority is stolen first.
+  };
+
   class TK_API AudioManager : public ResourceManager
   {
    public:
@@ -42,16 +71,64 @@ namespace ToolKit
     void Stop();
     void Start();
 
+    /** Frees the voices whose sounds have ended and updates the audio statistics. Called once per frame. */
+    void Update();
+
     /** Decodes the given memory block as internal sound object. */
     SoundBuffer DecodeFromMemory(ubyte* buffer, uint bufferSize);
 
     /** Decodes the given file as internal sound object. */
     SoundBuffer DecodeFromFile(StringView file);
 
+    /**
+     * Makes the encoded data available for streaming. Data must stay valid until it is unregistered.
+     * @return Name that the streamed sounds are initialized from.
+     */
+    String RegisterStreamData(const uint8* data, uint64 size);
+
+    /** Removes the data registered for streaming. Sounds streaming from it must be released before. */
+    void UnregisterStreamData(const String& name);
+
+    /** @return Length in seconds of the stream, 0 if the decoder can't tell it without decoding. */
+    float GetStreamDuration(const String& name);
+
+    /**
+     * Assigns a voice to the source that plays the audio. If all voices are in use, the oldest voice with the lowest
+     * priority is stolen, provided that its priority is not higher than the requested one.
+     * @return Voice for the source or nullptr if no voice is available.
+     */
+    AudioVoice* AcquireVoice(AudioSource* source, Audio* audio, int priority);
+
+    /** Stops the voice and returns it to the pool. Its sound is kept for the next source that plays the same audio. */
+    void ReleaseVoice(AudioVoice* voice);
+
+    /** Releases the voices of the audio and frees their sounds. */
+    void ReleaseVoices(Audio* audio);
+
+    /** @return Number of voices that are assigned to sources. */
+    int GetActiveVoiceCount() const;
+
+    /** @return Total bytes of pcm data that the decoded audio holds. */
+    uint64 GetDecodedSize();
+
     bool CanStore(ClassMeta* Class) override;
 
+   private:
+    /** Initializes the sound of the voice for the audio, reusing it if it is already initialized for the audio. */
+    bool InitVoiceSound(AudioVoice* voice, Audio* audio);
+
+    /** Uninitializes the sound of the voice. */
+    void UninitVoiceSound(AudioVoice* voice);
+
    public:
-    void* m_engine = nullptr;
+    void* m_engine              = nullptr;
+    int m_maxVoiceCount         = 32;          //!< Number of the sounds that can play at the same time.
+    uint64 m_streamingThreshold = 1024 * 1024; //!< Encoded size in bytes above which the audio is streamed.
+
+   private:
+    std::vector<AudioVoice*> m_voices; //!< Pool of the voices, grows up to the max voice count.
+    void* m_streamVFS  = nullptr;      //!< File system of the engine that also serves the registered stream data.
+    uint64 m_voiceTick = 0;
   };
 
   class TK_API AudioSource : public Entity
@@ -82,8 +159,26 @@ namespace ToolKit
     void Stop();
 
    private:
-    SoundBuffer m_sound = nullptr; //!< Raw sound object.
+    friend class AudioManager;
+
+    /** Called by the manager when the voice is released or stolen. */
+    void OnVoiceReleased(bool ended);
+
+    /** Applies the properties of the source to its voice. */
+    void ApplyToVoice();
+
+   public:
+    int m_priority = 0; //!< Sources with lower priority lose their voices first when all voices are in use.
+
+   private:
+    AudioVoice* m_voice = nullptr; //!< Voice that plays the audio, null if the source isn't playing.
     AudioPtr m_audio    = nullptr; //!< Reference to audio resource that this entity represents.
+    bool m_loop         = false;
+    float m_volume      = 1.0f;
+    float m_pitch       = 1.0f;
+    Vec3 m_position     = Vec3(0.0f);
+    float m_startTime   = 0.0f;  //!< Position in seconds that the next voice starts from.
+    bool m_ended        = false; //!< The voice is released after the sound reached its end.
   };
 
 } // namespace ToolKit
@@ -32,7 +32,14 @@ namespace ToolKit
       m_renderData.jobs.clear();
 
       EntityRawPtrArray rawBillboards = ToEntityRawPtrArray(billboards);
-      RenderJobProcessor::CreateRenderJobs(m_renderData.jobs, rawBillboards);
+      RenderJobProcessor::CreateRenderJobs(m_renderData.jobs,
+                                           rawBillboards,
+                                           false,
+                                           0,
+                                           {},
+                                           {},
+                                           cam.get(),
+                                           m_params.Viewport->m_wndContentAreaSize.y);
       RenderJobProcessor::SeperateRenderData(m_renderData, true);
 
       renderer->RenderWithProgramFromMaterial(m_renderData.jobs);
@@ -16,6 +16,12 @@
 namespace ToolKit
 {
 
+  static const UniformHandle g_passIndxHandle("passIndx");
+  static const UniformHandle g_srcResolutionHandle("srcResolution");
+  static const UniformHandle g_thresholdHandle("threshold");
+  static const UniformHandle g_filterRadiusHandle("filterRadius");
+  static const UniformHandle g_intensityHandle("intensity");
+
   BloomPass::BloomPass() : Pass("BloomPass")
   {
     m_downsampleShader = GetShaderManager()->Create<Shader>(ShaderPath("bloomDownsample.shader", true));
@@ -41,9 +47,9 @@ namespace ToolKit
       m_pass->SetFragmentShader(m_downsampleShader, renderer);
       int passIndx = 0;
 
-      m_pass->UpdateUniform(ShaderUniform("passIndx", passIndx));
-      m_pass->UpdateUniform(ShaderUniform("srcResolution", mainRes));
-      m_pass->UpdateUniform(ShaderUniform("threshold", m_params.minThreshold));
+      m_pass->UpdateUniform(g_passIndxHandle, passIndx);
+      m_pass->UpdateUniform(g_srcResolutionHandle, mainRes);
+      m_pass->UpdateUniform(g_thresholdHandle, m_params.minThreshold);
 
       TexturePtr prevRt = m_params.FrameBuffer->GetColorAttachment(Framebuffer::Attachment::ColorAttachment0);
 
@@ -78,8 +84,8 @@ namespace ToolKit
 
         int passIndx                   = i + 1;
 
-        m_pass->UpdateUniform(ShaderUniform("passIndx", passIndx));
-        m_pass->UpdateUniform(ShaderUniform("srcResolution", prevRes));
+        m_pass->UpdateUniform(g_passIndxHandle, passIndx);
+        m_pass->UpdateUniform(g_srcResolutionHandle, prevRes);
 
         renderer->SetTexture(0, prevRt->m_textureId);
 
@@ -97,8 +103,8 @@ namespace ToolKit
       m_pass->SetFragmentShader(m_upsampleShader, renderer);
 
       const float filterRadius = 0.002f;
-      m_pass->UpdateUniform(ShaderUniform("filterRadius", filterRadius));
-      m_pass->UpdateUniform(ShaderUniform("intensity", 1.0f));
+      m_pass->UpdateUniform(g_filterRadiusHandle, filterRadius);
+      m_pass->UpdateUniform(g_intensityHandle, 1.0f);
 
       for (int i = m_currentIterationCount; i > 0; i--)
       {
@@ -127,7 +133,7 @@ namespace ToolKit
       m_pass->m_params.clearFrameBuffer = GraphicBitFields::None;
       m_pass->m_params.frameBuffer      = m_params.FrameBuffer;
 
-      m_pass->UpdateUniform(ShaderUniform("intensity", m_params.intensity));
+      m_pass->UpdateUniform(g_intensityHandle, m_params.intensity);
 
       RenderSubPass(m_pass);
     }
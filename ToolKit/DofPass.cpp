@@ -15,7 +15,7 @@
 namespace ToolKit
 {
 
-  DoFPass::DoFPass() : Pass("DoFPass")
+  DoFPass::DoFPass() : Pass("DoFPass"), m_parameterBlock("DofParams", sizeof(DofParams))
   {
     m_quadPass                       = MakeNewPtr<FullQuadPass>();
     m_quadPass->m_params.frameBuffer = MakeNewPtr<Framebuffer>("DofFB");
@@ -38,29 +38,30 @@ namespace ToolKit
 
     m_quadPass->SetFragmentShader(m_dofShader, GetRenderer());
 
-    m_quadPass->UpdateUniform(ShaderUniform("focusPoint", m_params.focusPoint));
-    m_quadPass->UpdateUniform(ShaderUniform("focusScale", m_params.focusScale));
-    m_quadPass->UpdateUniform(ShaderUniform("blurSize", 5.0f));
+    DofParams params;
+    params.focusPoint  = m_params.focusPoint;
+    params.focusScale  = m_params.focusScale;
+    params.blurSize    = 5.0f;
+    params.radiusScale = 0.5f;
 
-    float blurRadiusScale = 0.5f;
     switch (m_params.blurQuality)
     {
     case DoFQuality::Low:
-      blurRadiusScale = 2.0f;
+      params.radiusScale = 2.0f;
       break;
     case DoFQuality::Normal:
-      blurRadiusScale = 0.7f;
+      params.radiusScale = 0.7f;
       break;
     case DoFQuality::High:
-      blurRadiusScale = 0.2f;
+      params.radiusScale = 0.2f;
       break;
     }
-    m_quadPass->UpdateUniform(ShaderUniform("radiusScale", blurRadiusScale));
 
     IVec2 size(m_params.ColorRt->m_width, m_params.ColorRt->m_height);
 
     m_quadPass->m_params.frameBuffer->ReconstructIfNeeded({size.x, size.y, false, false});
-    m_quadPass->UpdateUniform(ShaderUniform("uPixelSize", Vec2(1.0f) / Vec2(size)));
+    params.pixelSize = Vec2(1.0f) / Vec2(size);
+    m_parameterBlock.Set(params);
     m_quadPass->m_params.blendFunc        = BlendFunction::NONE;
     m_quadPass->m_params.clearFrameBuffer = GraphicBitFields::None;
     m_quadPass->m_params.frameBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0, m_params.ColorRt);
@@ -76,6 +77,7 @@ namespace ToolKit
 
     renderer->SetTexture(0, m_copyTexture->m_textureId);
     renderer->SetTexture(1, m_params.DepthRt->m_textureId);
+    m_quadPass->BindParameterBlock(m_parameterBlock);
 
     RenderSubPass(m_quadPass);
   }
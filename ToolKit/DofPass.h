@@ -29,6 +29,17 @@ namespace ToolKit
     DoFQuality blurQuality  = DoFQuality::Normal;
   };
 
+  /** Std140 layout of the DofParams uniform block in depthOfFieldFrag.shader. */
+  struct DofParams
+  {
+    Vec2 pixelSize    = Vec2(0.0f);
+    float focusPoint  = 0.0f;
+    float focusScale  = 0.0f;
+    float blurSize    = 0.0f;
+    float radiusScale = 0.0f;
+    Vec2 pad0         = Vec2(0.0f);
+  };
+
   class TK_API DoFPass : public Pass
   {
    public:
@@ -45,6 +56,7 @@ namespace ToolKit
     FullQuadPassPtr m_quadPass    = nullptr;
     ShaderPtr m_dofShader         = nullptr;
     RenderTargetPtr m_copyTexture = nullptr;
+    PassParameterBlock m_parameterBlock;
   };
 
   typedef std::shared_ptr<DoFPass> DoFPassPtr;
@@ -137,6 +137,8 @@ namespace ToolKit
     EnableGpuTimer_Define(false, "GraphicSettings", 0, 0, 0);
     HDRPipeline_Define(true, "GraphicSettings", 0, 0, 0);
     RenderResolutionScale_Define(1.0f, "GraphicSettings", 0, 0, 0);
+    TextureStreaming_Define(false, "GraphicSettings", 0, 0, 0);
+    TextureStreamingBudget_Define(512, "GraphicSettings", 0, 0, 0);
   }
 
   // PostProcessingSettings
@@ -176,6 +178,21 @@ namespace ToolKit
     FXAAEnabled_Define(true, "PostProcessingSettings", 0, 0, 0);
   }
 
+  // SimulationSettings
+  //////////////////////////////////////////
+
+  TKDefineClass(SimulationSettings, Object);
+
+  void SimulationSettings::ParameterConstructor()
+  {
+    Super::ParameterConstructor();
+
+    FixedTimeStep_Define(false, "SimulationSettings", 0, 0, 0);
+    TickRate_Define(60, "SimulationSettings", 0, 0, 0);
+    MaxTicksPerFrame_Define(5, "SimulationSettings", 0, 0, 0);
+    InterpolateTransforms_Define(true, "SimulationSettings", 0, 0, 0);
+  }
+
   // EngineSettings
   //////////////////////////////////////////
 
@@ -184,6 +201,7 @@ namespace ToolKit
     m_window         = MakeNewPtr<WindowSettings>();
     m_graphics       = MakeNewPtr<GraphicSettings>();
     m_postProcessing = MakeNewPtr<PostProcessingSettings>();
+    m_simulation     = MakeNewPtr<SimulationSettings>();
   }
 
   XmlNode* EngineSettings::SerializeImp(XmlDocument* doc, XmlNode* parent) const
@@ -199,6 +217,7 @@ namespace ToolKit
     m_window->Serialize(doc, settingsNode);
     m_graphics->Serialize(doc, settingsNode);
     m_graphics->m_shadows->Serialize(doc, settingsNode);
+    m_simulation->Serialize(doc, settingsNode);
 
     XmlNode* pluginNode = CreateXmlNode(doc, "Plugins", settingsNode);
     if (PluginManager* plugMan = GetPluginManager())
@@ -248,6 +267,10 @@ namespace ToolKit
       {
         m_graphics->m_shadows->DeSerialize(info, objNode);
       }
+      else if (className == SimulationSettings::StaticClass()->Name)
+      {
+        m_simulation->DeSerialize(info, objNode);
+      }
     } while (objNode = objNode->next_sibling());
 
     if (XmlNode* pluginNode = settingsNode->first_node("Plugins"))
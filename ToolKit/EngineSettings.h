@@ -162,6 +162,15 @@ namespace ToolKit
     /** Anisotropic texture filtering value. It can be 0, 2 ,4, 8, 16. Clamped with gpu max anisotropy. */
     TKDeclareParam(MultiChoiceVariant, AnisotropicTextureFiltering);
 
+    /**
+     * Streams the mip levels of textures based on their size on screen. Textures start with their smallest levels and
+     * the rest is loaded in the background when needed. See TextureStreamer.
+     */
+    TKDeclareParam(bool, TextureStreaming);
+
+    /** Gpu memory in MB that streamed textures can use. Unused mip levels are evicted when exceeded. */
+    TKDeclareParam(int, TextureStreamingBudget);
+
     /** Global shadow settings. */
     ShadowSettingsPtr m_shadows;
   };
@@ -223,6 +232,40 @@ namespace ToolKit
 
   typedef std::shared_ptr<PostProcessingSettings> PostProcessingSettingsPtr;
 
+  // SimulationSettings
+  //////////////////////////////////////////
+
+  /**
+   * Simulation settings class that holds the update loop settings.
+   * It is used to decouple the simulation rate from the frame rate.
+   */
+  class TK_API SimulationSettings : public Object
+  {
+   public:
+    TKDeclareClass(SimulationSettings, Object);
+
+   protected:
+    void ParameterConstructor() override;
+
+   public:
+    /**
+     * Updates plugins, animations and the scene with a constant time step at TickRate. When disabled, everything is
+     * updated once per frame with the frame's delta time.
+     */
+    TKDeclareParam(bool, FixedTimeStep);
+
+    /** Number of simulation ticks per second in fixed time step mode. */
+    TKDeclareParam(int, TickRate);
+
+    /** Maximum number of ticks to catch up in a single frame. Remaining time is dropped to avoid a spiral of death. */
+    TKDeclareParam(int, MaxTicksPerFrame);
+
+    /** Renders entity transforms interpolated between the last two ticks for smooth motion in fixed time step mode. */
+    TKDeclareParam(bool, InterpolateTransforms);
+  };
+
+  typedef std::shared_ptr<SimulationSettings> SimulationSettingsPtr;
+
   // EngineSettings
   //////////////////////////////////////////
 
@@ -246,6 +289,7 @@ namespace ToolKit
     WindowSettingsPtr m_window;
     GraphicSettingsPtr m_graphics;
     PostProcessingSettingsPtr m_postProcessing;
+    SimulationSettingsPtr m_simulation;
     StringArray m_loadedPlugins;
   };
 
@@ -27,11 +27,16 @@
 #include "ToolKit.h"
 #include "Util.h"
 
+#include <atomic>
+
 #include <DebugNew.h>
 
 namespace ToolKit
 {
 
+  /** Incremented on every rename of any entity. */
+  static std::atomic<uint64> g_nameRevision = 0;
+
   TKDefineClass(Entity, Object);
 
   Entity::Entity()
@@ -167,7 +172,14 @@ namespace ToolKit
     TransformLock_Define(false, EntityCategory.Name, EntityCategory.Priority, true, true);
   }
 
-  void Entity::ParameterEventConstructor() { Super::ParameterEventConstructor(); }
+  void Entity::ParameterEventConstructor()
+  {
+    Super::ParameterEventConstructor();
+
+    ParamName().m_onValueChangedFn.push_back([](Value& oldVal, Value& newVal) -> void { g_nameRevision++; });
+  }
+
+  uint64 Entity::GetNameRevision() { return g_nameRevision; }
 
   void Entity::WeakCopy(Entity* other, bool copyComponents) const
   {
@@ -309,7 +321,10 @@ namespace ToolKit
     // Read id and other parameters.
     m_localData.DeSerialize(info, parent);
 
-    PreventIdCollision();
+    if (!info.DeferIdCollision)
+    {
+      PreventIdCollision();
+    }
 
     ClearComponents();
 
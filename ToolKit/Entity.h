@@ -174,6 +174,12 @@ namespace ToolKit
      */
     Entity* GetPrefabRoot() const;
 
+    /**
+     * Returns a counter that is incremented each time an entity is renamed. Views caching the names compare it against
+     * their last seen value to know when to rebuild.
+     */
+    static uint64 GetNameRevision();
+
     /** Bounding boxes, AABB tree are invalidated. */
     virtual void InvalidateSpatialCaches();
 
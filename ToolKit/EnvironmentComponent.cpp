@@ -42,6 +42,7 @@ namespace ToolKit
     hdri->TrySettingCacheFiles(baseName);
 
     hdri->m_generateIrradianceCaches = true;
+    hdri->m_diffuseSHOnly            = GetDiffuseSHVal();
     hdri->Init(flushClientSideArray);
 
     UpdateBoundingBoxCache();
@@ -79,6 +80,8 @@ namespace ToolKit
                      true,
                      {false, true, 0.0f, 100000.0f, 0.1f});
 
+    DiffuseSH_Define(false, EnvironmentComponentCategory.Name, EnvironmentComponentCategory.Priority, true, true);
+
     auto createParameterVariant = [](const String& name, int val)
     {
       ParameterVariant param {val};
@@ -116,7 +119,7 @@ namespace ToolKit
               return;
             }
 
-            if (hdri->m_initiated && hdri->m_specularEnvMap && hdri->m_diffuseEnvMap)
+            if (hdri->m_initiated && hdri->m_specularEnvMap && (hdri->m_diffuseEnvMap || hdri->m_diffuseSH.isValid))
             {
               // Already initialized.
               return;
@@ -125,6 +128,7 @@ namespace ToolKit
             {
               String baseName = hdri->GenerateBakedEnvironmentFileBaseName();
               hdri->TrySettingCacheFiles(baseName);
+              hdri->m_diffuseSHOnly = GetDiffuseSHVal();
 
               // Loaded as image and missing irradiance caches.
               if (hdri->m_loaded && hdri->m_initiated)
@@ -132,7 +136,8 @@ namespace ToolKit
                 hdri->m_waitingForInit  = true;
 
                 RenderSystem* renderSys = GetRenderSystem();
-                if (!hdri->_diffuseBakeFile.empty() && !hdri->_specularBakeFile.empty())
+                if (!hdri->_irradianceCacheFile.empty() ||
+                    (!hdri->_diffuseBakeFile.empty() && !hdri->_specularBakeFile.empty()))
                 {
                   renderSys->AddRenderTask(
                       {[hdri](Renderer* renderer) -> void { hdri->LoadIrradianceCaches(renderer); }});
@@ -152,6 +157,22 @@ namespace ToolKit
             }
           }
         });
+
+    ParamDiffuseSH().m_onValueChangedFn.push_back(
+        [this](Value& oldVal, Value& newVal) -> void
+        {
+          HdriPtr hdri = GetHdriVal();
+          if (hdri == nullptr || !hdri->m_initiated || hdri->m_waitingForInit)
+          {
+            // Caches are generated for the new value on init.
+            return;
+          }
+
+          // Spherical harmonics and the diffuse env map are only generated when requested.
+          hdri->m_diffuseSHOnly = std::get<bool>(newVal);
+          GetRenderSystem()->AddRenderTask(
+              {[hdri](Renderer* renderer) -> void { hdri->GenerateMissingDiffuseIrradiance(renderer); }});
+        });
   }
 
   ComponentPtr EnvironmentComponent::Copy(EntityPtr ntt)
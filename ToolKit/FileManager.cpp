@@ -10,11 +10,7 @@
 #include "Audio.h"
 #include "Image.h"
 #include "Logger.h"
-#include "Material.h"
-#include "Mesh.h"
-#include "RenderSystem.h"
-#include "Scene.h"
-#include "Shader.h"
+#include "PakBuilder.h"
 #include "ToolKit.h"
 
 #include <mz.h>
@@ -77,6 +73,9 @@ namespace ToolKit
     String relativePath = fileInfo.filePath;
     GetRelativeResourcesPath(relativePath);
 
+    // Pak file has a single read cursor, reads from it are serialized. Loose files are read concurrently.
+    std::unique_lock<std::mutex> pakLock(m_pakMutex);
+
     if (!m_zfile)
     {
       m_zfile = unzOpen(pakPath.c_str());
@@ -113,6 +112,19 @@ namespace ToolKit
           }
         }
       }
+      else if (fileType == FileType::Binary)
+      {
+        ByteArray data;
+        uint bufferSize   = 0;
+        ubyte* fileBuffer = ReadFileBufferFromZip(m_zfile, relativePath, bufferSize);
+        if (fileBuffer != nullptr)
+        {
+          data.assign(fileBuffer, fileBuffer + bufferSize);
+          SafeDelArray(fileBuffer);
+        }
+
+        return data;
+      }
       else
       {
         assert(false && "Unimplemented file type.");
@@ -120,6 +132,8 @@ namespace ToolKit
     }
     else
     {
+      pakLock.unlock();
+
       // Zip pak not found, read from file at default path
       if (fileType == FileType::Xml)
       {
@@ -143,6 +157,19 @@ namespace ToolKit
           return audioMan->DecodeFromFile(fileInfo.filePath);
         }
       }
+      else if (fileType == FileType::Binary)
+      {
+        ByteArray data;
+        std::ifstream stream(fileInfo.filePath, std::ios::binary | std::ios::ate);
+        if (stream.good())
+        {
+          data.resize((size_t) stream.tellg());
+          stream.seekg(0, std::ios::beg);
+          stream.read((char*) data.data(), data.size());
+        }
+
+        return data;
+      }
       else
       {
         assert(false && "Unimplemented file type.");
@@ -162,39 +189,35 @@ namespace ToolKit
     return std::get<SoundBuffer>(data);
   }
 
-  int FileManager::PackResources()
+  ByteArray FileManager::GetBinaryFile(const String& filePath)
   {
-    String zipFile = ConcatPaths({ResourcePath(), "..", "MinResources.pak"});
-
-    if (CheckSystemFile(zipFile.c_str()))
-    {
-      if (m_zfile)
-      {
-        unzClose(m_zfile);
-        m_zfile = nullptr;
-      }
+    String path            = filePath;
+    ImageFileInfo fileInfo = {path, nullptr, nullptr, nullptr, 0};
+    FileDataType data      = GetFile(FileType::Binary, fileInfo);
 
-      std::error_code err;
-      if (!std::filesystem::remove(zipFile, err))
-      {
-        TK_LOG("cannot remove MinResources.pak! message: %s\n", err.message().c_str());
-        return -1;
-      }
-    }
+    return std::get<ByteArray>(data);
+  }
 
-    // Load all scenes once in order to fill resource managers
-    TK_LOG("Packing Scenes\n");
-    LoadAllScenes(ScenePath(""));
+  int FileManager::PackResources()
+  {
+    String zipFile = ConcatPaths({ResourcePath(), "..", "MinResources.pak"});
 
-    TK_LOG("Packing Layers\n");
-    LoadAllScenes(LayerPath(""));
+    // Pak is rebuilt from the previous one, release it.
+    CloseZipFile();
 
     // Get all paths of resources
-    TK_LOG("Getting all used paths\n");
+    TK_LOG("Scanning Scenes and Layers\n");
     GetAllUsedResourcePaths();
 
     // Zip used resources
-    if (!ZipPack(zipFile))
+    PakBuilder builder;
+    bool packed = builder.Build(zipFile, m_allPaths);
+
+    // Pak has changed, offsets are regenerated on the next access.
+    m_zipFilesOffsetTable.clear();
+    m_offsetTableCreated = false;
+
+    if (!packed)
     {
       // Error
       TK_ERR("Error zipping.");
@@ -245,164 +268,65 @@ namespace ToolKit
     return inPak;
   }
 
-  void FileManager::LoadAllScenes(const String& path)
+  bool FileManager::CheckFileFromPak(const String& path)
   {
-    // Resources in the scene files
-    for (const auto& entry : std::filesystem::directory_iterator(path))
+    if (m_ignorePakFile)
     {
-      if (entry.is_directory())
-      {
-        // Go scenes in directories
-        LoadAllScenes(entry.path().string());
-        continue;
-      }
-
-      // Load all scenes
-      String pt = entry.path().string();
-      String name, ext;
-      DecomposePath(pt, nullptr, &name, &ext);
+      return false;
+    }
 
-      if (ext == SCENE || ext == LAYER)
-      {
-        TK_LOG("Packing Scene: %s\n", name.c_str());
+    std::lock_guard<std::mutex> pakLock(m_pakMutex);
+    GenerateOffsetTableForPakFiles();
+    if (m_zfile == nullptr)
+    {
+      return false;
+    }
 
-        ScenePtr scene = GetSceneManager()->Create<Scene>(pt);
-        scene->Load();
-        scene->Init();
+    String relativePath = path;
+    UnixifyPath(relativePath);
+    GetRelativeResourcesPath(relativePath);
 
-        GetRenderSystem()->FlushRenderTasks(); // Finalize loading baked files.
-      }
-    }
+    return IsFileInPak(relativePath);
   }
 
   void FileManager::GetAllUsedResourcePaths()
   {
-    std::unordered_map<String, ResourcePtr> mp;
+    m_allPaths.clear();
 
     // Get all engine resources
     GetAllPaths(DefaultPath());
 
-    // Material
-    mp = GetMaterialManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
-    {
-      String absolutePath = it->first;
-
-      // Skip default.material
-      if (!it->second->m_loaded)
-      {
-        continue;
-      }
-
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Materials");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
+    // Resources that the scenes and layers refer to, found without loading them.
+    ResourceDependencyScanner scanner;
+    scanner.AddFolder(ScenePath(""));
+    scanner.AddFolder(LayerPath(""));
+    scanner.Scan();
 
-      m_allPaths.insert(absolutePath);
-    }
+    const StringSet& usedFiles = scanner.GetFiles();
+    m_allPaths.insert(usedFiles.begin(), usedFiles.end());
 
-    // Meshes
-    mp = GetMeshManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
+    // Baked irradiance caches of the environments.
+    String irradianceCachePath = TexturePath(TKIrradianceCacheFolder);
+    if (CheckSystemFile(irradianceCachePath))
     {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Meshes");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
-
-      m_allPaths.insert(absolutePath);
+      GetAllPaths(irradianceCachePath);
     }
 
-    // Animations
-    mp = GetAnimationManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
+    // Atlas pages of the ui images with their manifest, and the cooked pages if there are any.
+    for (const String& atlasPath : {TexturePath(TKTextureAtlasFolder),
+                                    TexturePath(ConcatPaths({TKCookedTextureFolder, TKTextureAtlasFolder}))})
     {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
+      if (CheckSystemFile(atlasPath))
       {
-        size_t index = absolutePath.find("Meshes");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
+        GetAllPaths(atlasPath);
       }
-
-      m_allPaths.insert(absolutePath);
     }
 
-    // Skeletons
-    mp = GetSkeletonManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
+    // Animation data that the packer bakes for the skeletons.
+    String animationDataPath = AnimationPath(TKAnimationDataFolder);
+    if (CheckSystemFile(animationDataPath))
     {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Meshes");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
-
-      m_allPaths.insert(absolutePath);
-    }
-
-    // Prefabs
-    mp = GetSceneManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
-    {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Prefabs");
-        if (index == String::npos)
-        {
-          continue;
-        }
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
-
-      m_allPaths.insert(absolutePath);
-    }
-
-    // Shaders
-    mp = GetShaderManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
-    {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Shaders");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
-
-      m_allPaths.insert(absolutePath);
-    }
-
-    // Textures
-    mp = GetTextureManager()->m_storage;
-    for (auto it = mp.begin(); it != mp.end(); it++)
-    {
-      String absolutePath = it->first;
-      // If the path is relative, make it absolute
-      if (absolutePath[0] == '.')
-      {
-        size_t index = absolutePath.find("Textures");
-        absolutePath = absolutePath.substr(index);
-        absolutePath = ConcatPaths({DefaultAbsolutePath(), absolutePath});
-      }
-
-      m_allPaths.insert(absolutePath);
+      GetAllPaths(animationDataPath);
     }
 
     // Scenes
@@ -417,101 +341,6 @@ namespace ToolKit
 
   bool FileManager::CheckPakFile() { return m_zfile != nullptr; }
 
-  bool FileManager::ZipPack(const String& zipName)
-  {
-    zipFile zFile = zipOpen64(zipName.c_str(), 0);
-
-    if (zFile == NULL)
-    {
-      printf("Error opening zip.\n");
-      zipClose(zFile, NULL);
-      return false;
-    }
-
-    // Add files to zip
-    for (const String& path : m_allPaths)
-    {
-      if (!AddFileToZip(zFile, path.c_str()))
-      {
-        TK_WRN("Failed to add this file to zip: %s\n", path.c_str());
-      }
-    }
-
-    zipClose(zFile, NULL);
-
-    return true;
-  }
-
-  bool FileManager::AddFileToZip(ZipFile zfile, const char* filename)
-  {
-    FILE* f;
-    int ret;
-    size_t red;
-    size_t flen;
-
-    if (zfile == NULL || filename == NULL)
-    {
-      return false;
-    }
-
-    f = fopen(filename, "rb");
-    if (f == NULL)
-    {
-      return false;
-    }
-
-    // Get length of the file
-    std::basic_ifstream<char> stream(filename, std::ios::binary);
-    if (!stream)
-    {
-      return false;
-    }
-    stream.unsetf(std::ios::skipws);
-    stream.seekg(0, std::ios::end); // Determine stream size
-    flen               = stream.tellg();
-
-    String filenameStr = String(filename);
-    size_t index       = filenameStr.find("Resources");
-    if (index != String::npos)
-    {
-      constexpr int length = sizeof("Resources");
-      filenameStr          = filenameStr.substr(index + length);
-    }
-    else
-    {
-      TK_ERR("Resource is not under resources path: %s", filename);
-      return false;
-    }
-
-    // Compression level is -1 which is default, use 0 for no compression, 1 for best speed.
-    ret =
-        zipOpenNewFileInZip64(zfile, filenameStr.c_str(), NULL, NULL, 0, NULL, 0, NULL, MZ_COMPRESS_METHOD_ZSTD, -1, 0);
-
-    if (ret != ZIP_OK)
-    {
-      fclose(f);
-      zipCloseFileInZip(zfile);
-      return false;
-    }
-
-    char* fileData = reinterpret_cast<char*>(malloc((flen + 1) * static_cast<uint>(sizeof(char))));
-    red            = fread(fileData, 1, flen, f);
-    ret            = zipWriteInFileInZip(zfile, fileData, static_cast<uint>(flen));
-
-    if (ret != ZIP_OK)
-    {
-      fclose(f);
-      zipCloseFileInZip(zfile);
-      return false;
-    }
-
-    free(fileData);
-    fclose(f);
-    zipCloseFileInZip(zfile);
-
-    return true;
-  }
-
   void FileManager::GetAllPaths(const String& path)
   {
     for (const auto& entry : std::filesystem::directory_iterator(path))
@@ -35,11 +35,14 @@ namespace ToolKit
     /** Returns a decoded audio file or null if no decoder found. Used in Audio::Load to create resource. */
     SoundBuffer GetAudioFile(const String& filePath);
 
+    /** Returns the raw content of the file or an empty array if the file can't be read. */
+    ByteArray GetBinaryFile(const String& filePath);
+
     /**
      * Pack all the resources for the project.
-     * Does this by opening all scene and layer files in resource folder.
-     * Than accumulate all resources in all managers. Finally creates a zip file from the collected resources.
-     * Produced zip file is called "MinResources.pak"
+     * Does this by scanning all scene and layer files in resource folder for the resources they refer to, without
+     * loading them. Finally creates a zip file from the collected resources, reusing the unchanged entries of the
+     * previous one. Produced zip file is called "MinResources.pak"
      * If extra files other than automatically collected ones are needed, the function looks for a text file
      * "ExtraFiles.txt" each line in this file is added to the pack as well.
      * All files must be in the Resources folder of the project.
@@ -47,6 +50,7 @@ namespace ToolKit
     int PackResources();
 
     bool CheckFileFromResources(const String& path); //!< Checks the given file in first resource path than in pak file.
+    bool CheckFileFromPak(const String& path);       //!< Checks the given file only in the pak file.
     void GetRelativeResourcesPath(String& path);     //!< Converts the path, relative to the Resources folder.
 
     void CloseZipFile(); //!< Closes the pak file if its open.
@@ -59,14 +63,15 @@ namespace ToolKit
     void CreateResourceFolder(const String& folder);
 
    private:
-    typedef std::variant<XmlFilePtr, uint8*, float*, SoundBuffer> FileDataType;
+    typedef std::variant<XmlFilePtr, uint8*, float*, SoundBuffer, ByteArray> FileDataType;
 
     enum class FileType
     {
       Xml,
       ImageUint8,
       ImageFloat,
-      Audio
+      Audio,
+      Binary
     };
 
     struct ImageFileInfo
@@ -79,12 +84,8 @@ namespace ToolKit
     };
 
     FileDataType GetFile(FileType fileType, ImageFileInfo& fileInfo);
-    void LoadAllScenes(const String& path);
     void GetAllUsedResourcePaths();
 
-    bool ZipPack(const String& zipName);
-    bool AddFileToZip(ZipFile zfile, const char* filename);
-
     void GetAllPaths(const String& path);
     void GetExtraFilePaths();
 
@@ -107,6 +108,7 @@ namespace ToolKit
     std::unordered_map<String, std::pair<uint64, uint>> m_zipFilesOffsetTable;
     bool m_offsetTableCreated = false;
     ZipFile m_zfile           = nullptr;
+    std::mutex m_pakMutex; //!< Guards the pak file, resources may be loaded from multiple threads.
 
    public:
     bool m_ignorePakFile = false;
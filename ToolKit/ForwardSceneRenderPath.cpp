@@ -166,7 +166,15 @@ namespace ToolKit
 
     int dirEndIndx                                   = RenderJobProcessor::PreSortLights(lights);
     const EnvironmentComponentPtrArray& environments = m_params.Scene->GetEnvironmentVolumes();
-    RenderJobProcessor::CreateRenderJobs(m_renderData.jobs, entities, false, dirEndIndx, lights, environments);
+    float viewportHeight                             = (float) m_params.MainFramebuffer->GetSettings().height;
+    RenderJobProcessor::CreateRenderJobs(m_renderData.jobs,
+                                         entities,
+                                         false,
+                                         dirEndIndx,
+                                         lights,
+                                         environments,
+                                         m_params.Cam.get(),
+                                         viewportHeight);
 
     m_shadowPass->m_params.scene      = m_params.Scene;
     m_shadowPass->m_params.viewCamera = m_params.Cam;
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "FrameAllocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef TK_COUNT_HEAP_ALLOCATIONS
+  #define SKIP_TK_DEBUG_NEW
+#endif
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  static std::atomic<uint64> g_frameGeneration     = 0;
+  static std::atomic<uint64> g_heapAllocationCount = 0;
+
+  FrameArena::FrameArena() {}
+
+  FrameArena::~FrameArena()
+  {
+    for (Block& block : m_blocks)
+    {
+      free(block.data);
+    }
+  }
+
+  void* FrameArena::Allocate(size_t size, size_t alignment)
+  {
+    uint64 generation = g_frameGeneration.load(std::memory_order_relaxed);
+    if (m_generation != generation)
+    {
+      m_generation = generation;
+      Reset();
+    }
+
+    if (size == 0)
+    {
+      size = 1;
+    }
+
+    if (!m_blocks.empty())
+    {
+      Block& block   = m_blocks.back();
+      uintptr_t head = (uintptr_t) (block.data + block.offset);
+      size_t padding = (alignment - (head & (alignment - 1))) & (alignment - 1);
+      if (block.offset + padding + size <= block.size)
+      {
+        void* memory  = block.data + block.offset + padding;
+        block.offset += padding + size;
+        m_used       += padding + size;
+        return memory;
+      }
+    }
+
+    // Blocks come from malloc, which satisfies the fundamental alignments. Larger alignments are padded.
+    AddBlock(glm::max(m_blockSize, size + alignment));
+
+    Block& block   = m_blocks.back();
+    uintptr_t head = (uintptr_t) block.data;
+    size_t padding = (alignment - (head & (alignment - 1))) & (alignment - 1);
+    block.offset   = padding + size;
+    m_used        += padding + size;
+
+    return block.data + padding;
+  }
+
+  void FrameArena::Free(void* memory, size_t size)
+  {
+    // Allocations of a previous frame are released with the lazy reset, they can't be taken back.
+    if (memory == nullptr || m_blocks.empty() || m_generation != g_frameGeneration.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    // Only the last allocation can be taken back. Memory of other threads never matches.
+    Block& block = m_blocks.back();
+    if ((uint8*) memory + size == block.data + block.offset && (uint8*) memory >= block.data)
+    {
+      block.offset -= size;
+      m_used       -= size;
+    }
+  }
+
+  void FrameArena::Reset()
+  {
+    if (m_blocks.size() > 1)
+    {
+      size_t capacity = GetCapacity();
+      for (Block& block : m_blocks)
+      {
+        free(block.data);
+      }
+      m_blocks.clear();
+
+      AddBlock(capacity);
+    }
+
+    if (!m_blocks.empty())
+    {
+      m_blocks.back().offset = 0;
+    }
+
+    m_used = 0;
+  }
+
+  size_t FrameArena::GetUsedMemory() const { return m_used; }
+
+  size_t FrameArena::GetCapacity() const
+  {
+    size_t capacity = 0;
+    for (const Block& block : m_blocks)
+    {
+      capacity += block.size;
+    }
+
+    return capacity;
+  }
+
+  void FrameArena::NewFrame() { g_frameGeneration++; }
+
+  uint64 FrameArena::GetGeneration() { return g_frameGeneration.load(std::memory_order_relaxed); }
+
+  uint64 FrameArena::GetHeapAllocationCount() { return g_heapAllocationCount.load(std::memory_order_relaxed); }
+
+  void FrameArena::AddBlock(size_t size)
+  {
+    Block block;
+    block.data = (uint8*) malloc(size);
+    block.size = size;
+
+    if (block.data == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+#ifndef TK_COUNT_HEAP_ALLOCATIONS
+    g_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    m_blocks.push_back(block);
+  }
+
+  FrameArena& GetFrameArena()
+  {
+    static thread_local FrameArena arena;
+    return arena;
+  }
+
+} // namespace ToolKit
+
+#ifdef TK_COUNT_HEAP_ALLOCATIONS
+
+// Global allocation functions are replaced to count every heap allocation. Only the plain forms are replaced, aligned
+// forms keep their default implementation which pairs with their own delete.
+
+void* operator new(size_t size)
+{
+  ToolKit::g_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = malloc(size == 0 ? 1 : size))
+  {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  ToolKit::g_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* memory) noexcept { free(memory); }
+
+void operator delete[](void* memory) noexcept { free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept { free(memory); }
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { free(memory); }
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /**
+   * Linear allocator for the transient data of a frame. Allocations bump an offset in a block, frees are ignored
+   * except for the last allocation which allows growing containers to reuse their space. All allocations are released
+   * at once when the frame ends. Each thread has its own arena, see GetFrameArena(), so there is no locking.
+   * Arenas reset themselves lazily on the first allocation after Main::FrameEnd, which keeps worker threads free of
+   * any synchronization with the main thread.
+   *
+   * Memory obtained from the arena must not be kept beyond the frame that it is allocated in. It is not suitable for
+   * the background pool whose tasks span frames.
+   */
+  class TK_API FrameArena
+  {
+   public:
+    FrameArena();
+    ~FrameArena();
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Allocates memory that stays valid until the end of the frame.
+     * @param size is the number of bytes to allocate.
+     * @param alignment must be a power of two.
+     */
+    void* Allocate(size_t size, size_t alignment);
+
+    /**
+     * Releases the memory if it is the last allocation in the arena, otherwise does nothing. Memory of a previous frame
+     * must not be passed, it may overlap with the allocations of the current frame. Memory is ignored if the arena has
+     * not allocated in the current frame yet.
+     */
+    void Free(void* memory, size_t size);
+
+    /**
+     * Releases all allocations. When the frame has overflowed in to multiple blocks, they are merged in to a single
+     * block that fits the whole frame.
+     */
+    void Reset();
+
+    /** @return Bytes allocated since the last reset. */
+    size_t GetUsedMemory() const;
+
+    /** @return Bytes reserved by the arena. */
+    size_t GetCapacity() const;
+
+    /**
+     * Marks the end of the frame. Arenas of all threads reset on their next allocation. Called by Main::FrameEnd.
+     */
+    static void NewFrame();
+
+    /** @return Number of frames that are ended, which identifies the frame that the allocations are made in. */
+    static uint64 GetGeneration();
+
+    /**
+     * @return Number of heap allocations made through the global operator new. Only counted when the engine is built
+     * with TK_COUNT_HEAP_ALLOCATIONS, otherwise only the blocks allocated by the arenas are counted.
+     */
+    static uint64 GetHeapAllocationCount();
+
+   private:
+    struct Block
+    {
+      uint8* data   = nullptr;
+      size_t size   = 0;
+      size_t offset = 0;
+    };
+
+    void AddBlock(size_t size);
+
+   public:
+    size_t m_blockSize = 64 * 1024; //!< Minimum size of the blocks allocated from the heap.
+
+   private:
+    std::vector<Block> m_blocks;
+    size_t m_used       = 0;
+    uint64 m_generation = 0; //!< Frame that the arena last reset for.
+  };
+
+  /** @return Frame arena of the calling thread. */
+  TK_API FrameArena& GetFrameArena();
+
+  /**
+   * Stl compatible allocator that allocates from the frame arena of the calling thread. Containers using it must be
+   * destroyed or cleared within the frame, they can't be members of objects that live across frames. The allocator
+   * keeps the frame of its last allocation, so that a container that is destroyed in a later frame doesn't take back
+   * the memory of the current frame that happens to be at the same place.
+   */
+  template <typename T>
+  class FrameAllocator
+  {
+   public:
+    typedef T value_type;
+
+    // The frame travels with the memory.
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    FrameAllocator() = default;
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : m_generation(other.m_generation)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+      m_generation = FrameArena::GetGeneration();
+      return (T*) GetFrameArena().Allocate(count * sizeof(T), alignof(T));
+    }
+
+    void deallocate(T* memory, size_t count)
+    {
+      // Memory of a previous frame is already released with the arena.
+      if (m_generation == FrameArena::GetGeneration())
+      {
+        GetFrameArena().Free(memory, count * sizeof(T));
+      }
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>&) const
+    {
+      return true;
+    }
+
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>&) const
+    {
+      return false;
+    }
+
+   private:
+    template <typename U>
+    friend class FrameAllocator;
+
+    uint64 m_generation = 0; //!< Frame of the last allocation.
+  };
+
+  /** Vector that lives in the frame arena. */
+  template <typename T>
+  using FrameArray = std::vector<T, FrameAllocator<T>>;
+
+} // namespace ToolKit
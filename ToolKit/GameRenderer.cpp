@@ -45,6 +45,7 @@ namespace ToolKit
     // UI params
     UILayerPtrArray layers;
     m_uiRenderData.jobs.clear();
+    m_uiBatcher.Reset();
     GetUIManager()->GetLayers(m_params.viewport->m_viewportId, layers);
 
     for (const UILayerPtr& layer : layers)
@@ -52,7 +53,17 @@ namespace ToolKit
       const EntityPtrArray& uiNtties = layer->m_scene->GetEntities();
 
       EntityRawPtrArray rawUINtties  = ToEntityRawPtrArray(uiNtties);
-      RenderJobProcessor::CreateRenderJobs(m_uiRenderData.jobs, rawUINtties);
+      RenderJobProcessor::CreateRenderJobs(m_uiRenderJobs,
+                                           rawUINtties,
+                                           false,
+                                           0,
+                                           {},
+                                           {},
+                                           GetUIManager()->GetUICamera().get(),
+                                           m_params.viewport->m_wndContentAreaSize.y);
+
+      // Pack surfaces of the layer in to a few draws.
+      m_uiBatcher.Batch(m_uiRenderJobs, m_uiRenderData.jobs);
     }
 
     RenderJobProcessor::SeperateRenderData(m_uiRenderData, true);
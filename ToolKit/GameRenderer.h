@@ -10,6 +10,7 @@
 #include "ForwardSceneRenderPath.h"
 #include "GammaTonemapFxaaPass.h"
 #include "Scene.h"
+#include "UIBatcher.h"
 #include "UIManager.h"
 #include "Viewport.h"
 
@@ -55,6 +56,7 @@ namespace ToolKit
 
     RenderJobArray m_uiRenderJobs;
     RenderData m_uiRenderData;
+    UIBatcher m_uiBatcher;
   };
 
 } // namespace ToolKit
@@ -14,6 +14,13 @@
 namespace ToolKit
 {
 
+  static const UniformHandle g_enableFxaaHandle("enableFxaa");
+  static const UniformHandle g_enableGammaCorrectionHandle("enableGammaCorrection");
+  static const UniformHandle g_enableTonemappingHandle("enableTonemapping");
+  static const UniformHandle g_screenSizeHandle("screenSize");
+  static const UniformHandle g_useAcesTonemapperHandle("useAcesTonemapper");
+  static const UniformHandle g_gammaHandle("gamma");
+
   GammaTonemapFxaaPass::GammaTonemapFxaaPass() : Pass("GammaTonemapFxaaPass")
   {
     m_quadPass          = MakeNewPtr<FullQuadPass>();
@@ -37,13 +44,13 @@ namespace ToolKit
     m_quadPass->m_params.frameBuffer      = m_params.frameBuffer;
     m_quadPass->m_params.clearFrameBuffer = GraphicBitFields::AllBits;
 
-    m_quadPass->UpdateUniform(ShaderUniform("enableFxaa", (int) m_params.enableFxaa));
-    m_quadPass->UpdateUniform(ShaderUniform("enableGammaCorrection", (int) m_params.enableGammaCorrection));
-    m_quadPass->UpdateUniform(ShaderUniform("enableTonemapping", (int) m_params.enableTonemapping));
+    m_quadPass->UpdateUniform(g_enableFxaaHandle, (int) m_params.enableFxaa);
+    m_quadPass->UpdateUniform(g_enableGammaCorrectionHandle, (int) m_params.enableGammaCorrection);
+    m_quadPass->UpdateUniform(g_enableTonemappingHandle, (int) m_params.enableTonemapping);
 
-    m_quadPass->UpdateUniform(ShaderUniform("screenSize", m_params.screenSize));
-    m_quadPass->UpdateUniform(ShaderUniform("useAcesTonemapper", (uint) m_params.tonemapMethod));
-    m_quadPass->UpdateUniform(ShaderUniform("gamma", m_params.gamma));
+    m_quadPass->UpdateUniform(g_screenSizeHandle, m_params.screenSize);
+    m_quadPass->UpdateUniform(g_useAcesTonemapperHandle, (uint) m_params.tonemapMethod);
+    m_quadPass->UpdateUniform(g_gammaHandle, m_params.gamma);
   }
 
   void GammaTonemapFxaaPass::Render() { RenderSubPass(m_quadPass); }
@@ -50,135 +50,173 @@ namespace ToolKit
     virtual void InvalidateCacheItem()      = 0;
   };
 
-  /** LRU based generic cache. T must be a type derived from CacheItem. Size is in bytes. */
+  /**
+   * LRU based generic cache with fixed number of slots. T must be a type derived from CacheItem. Size is in bytes.
+   * Each item keeps the slot that it is assigned to until it gets evicted, so the index of an item in the gpu buffer is
+   * stable and found in constant time. When the cache is full, the least recently used item is evicted. Only the range
+   * of the slots that are changed since the last map is passed to gpu.
+   */
   template <typename T, uint64 ItemSize>
   class TK_API LRUCache
   {
    public:
-    LRUCache(uint64 byteSize) : m_cacheSize(byteSize) { m_data = new byte[m_cacheSize]; }
+    LRUCache(uint64 byteSize) : m_cacheSize(byteSize), m_capacity((int) (byteSize / ItemSize))
+    {
+      m_data = new byte[m_cacheSize];
+      memset(m_data, 0, m_cacheSize);
+
+      m_slots.resize(m_capacity);
+      m_cacheMap.reserve(m_capacity);
+      m_freeSlots.reserve(m_capacity);
+      for (int i = m_capacity - 1; i >= 0; i--)
+      {
+        m_freeSlots.push_back(i);
+      }
+    }
 
     virtual ~LRUCache() { SafeDelArray(m_data); }
 
     LRUCache(const LRUCache&)            = delete; //!< Prevent copy.
     LRUCache& operator=(const LRUCache&) = delete; //!< Prevent assignment.
 
-    /** Adds or updates a cache item, invalidates the cache if needed. Returns index of the item. */
+    /**
+     * Adds or updates a cache item, invalidates the cache if needed. Marks the item as the most recently used one.
+     * @return Index of the item in the cache which stays the same until the item is evicted.
+     */
     int AddOrUpdateItem(const T& item)
     {
-      // If item exist, check if update is needed.
-      auto itemItr = m_cacheMap.find(item.id);
+      int slotIndex = -1;
+
+      auto itemItr  = m_cacheMap.find(item.id);
       if (itemItr != m_cacheMap.end())
       {
-        // Check versions
-        T& CacheItem = *itemItr->second;
-        if (CacheItem.version != item.version)
+        slotIndex  = itemItr->second;
+        Slot& slot = m_slots[slotIndex];
+        if (slot.item.version != item.version)
         {
-          // Set the new item data.
-          m_lruCacheList.erase(itemItr->second);
-          m_lruCacheList.push_front(item);
-          m_cacheMap[item.id] = m_lruCacheList.begin();
-
-          m_isValid           = false;
-          return 0; // Material is the first item in the cache.
+          slot.item = item;
+          SetDirty(slotIndex);
         }
       }
       else
       {
-        // Check if there is enough space
-        uint64 usedSize = ConsumedSize();
-        if (usedSize + ItemSize > m_cacheSize)
+        if (m_freeSlots.empty())
         {
-          // Not enough space, drop the last item
-          T& lastItem = m_lruCacheList.back();
-          m_cacheMap.erase(lastItem.id);
-          m_lruCacheList.pop_back();
+          // Not enough space, drop the least recently used item.
+          int lruIndex = 0;
+          for (int i = 1; i < m_capacity; i++)
+          {
+            if (m_slots[i].lastUse < m_slots[lruIndex].lastUse)
+            {
+              lruIndex = i;
+            }
+          }
+
+          m_cacheMap.erase(m_slots[lruIndex].item.id);
+          m_freeSlots.push_back(lruIndex);
         }
 
-        // Insert the new item.
-        m_lruCacheList.push_front(item);
-        m_cacheMap[item.id] = m_lruCacheList.begin();
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
 
-        m_isValid           = false;
-        return 0; // Material is the first item in the cache.
+        m_slots[slotIndex].item = item;
+        m_cacheMap[item.id]     = slotIndex;
+        SetDirty(slotIndex);
       }
 
-      return (int) std::distance(m_lruCacheList.begin(), itemItr->second);
+      m_slots[slotIndex].lastUse = ++m_clock;
+      return slotIndex;
     }
 
     /**
-     * Returns the corresponding indexes of items in the cache.
-     * Consider only the first n if its provided.
+     * Writes the indexes of the items in the cache to the given array. Items that are not in the cache are skipped.
      * Call after buffer is mapped. Otherwise indexes will be invalid.
+     * @param items are the ids of the items to look for.
+     * @param count is the number of ids in the items array.
+     * @param indexes is the output array which must have room for count indexes.
+     * @return Number of the indexes written.
      */
-    IntArray LookUp(const IDArray& items, int n = -1)
+    int LookUp(const ObjectId* items, int count, int* indexes) const
     {
       assert(m_isValid && "Map the cache first, buffer is invalid.");
 
-      IntArray ids;
-      ids.reserve(items.size());
-
-      if (n == -1)
-      {
-        n = (int) items.size();
-      }
-      else
-      {
-        n = glm::min((int) items.size(), n);
-      }
-
-      for (int i = 0; i < n; i++)
+      int found = 0;
+      for (int i = 0; i < count; i++)
       {
-        ObjectId id  = items[i];
-        auto itemItr = m_cacheMap.find(id);
+        auto itemItr = m_cacheMap.find(items[i]);
         if (itemItr != m_cacheMap.end())
         {
-          ids.push_back((int) std::distance(m_lruCacheList.begin(), itemItr->second));
+          indexes[found++] = itemItr->second;
         }
       }
 
-      return ids;
+      return found;
     }
 
     /** Resets the cache. Flush all the items. */
     void Reset()
     {
       m_cacheMap.clear();
-      m_lruCacheList.clear();
+      m_freeSlots.clear();
+      for (int i = m_capacity - 1; i >= 0; i--)
+      {
+        m_slots[i] = Slot();
+        m_freeSlots.push_back(i);
+      }
+
       memset(m_data, 0, m_cacheSize);
-      m_isValid = false;
+      m_clock    = 0;
+      m_dirtyMin = 0;
+      m_dirtyMax = m_capacity - 1;
+      m_isValid  = false;
     }
 
     /** Returns used size of the cache in bytes. */
-    uint64 ConsumedSize() const { return ItemSize * m_lruCacheList.size(); }
+    uint64 ConsumedSize() const { return ItemSize * m_cacheMap.size(); }
+
+    /** Returns the maximum number of items that the cache can hold. */
+    int Capacity() const { return m_capacity; }
 
     /**
-     * Maps the Items to cache data in LRU.
-     * Calls the update function with current cache and size if cache is invalidated.
+     * Maps the changed items to cache data.
+     * Calls the update function with the changed range of the cache if cache is invalidated.
      * returns true if mapping is performed in case of invalidation.
      */
-    bool Map(std::function<void(const void* data, uint64 size)> updateFn = nullptr)
+    bool Map(std::function<void(const void* data, uint64 offset, uint64 size)> updateFn = nullptr)
     {
-      bool mapped = false;
-      if (!m_isValid)
+      if (m_isValid)
       {
-        int i = 0;
-        for (auto& item : m_lruCacheList)
-        {
-          void* data = item.GetData();
-          memcpy(static_cast<byte*>(m_data) + i * ItemSize, data, ItemSize);
-          i++;
-        }
+        return false;
+      }
 
-        if (updateFn != nullptr)
+      for (int i = m_dirtyMin; i <= m_dirtyMax; i++)
+      {
+        if (m_slots[i].item.id != NullHandle)
         {
-          updateFn(m_data, m_cacheSize);
+          memcpy(static_cast<byte*>(m_data) + i * ItemSize, m_slots[i].item.GetData(), ItemSize);
         }
+      }
 
-        m_isValid = true;
-        mapped    = true;
+      if (updateFn != nullptr && m_dirtyMin <= m_dirtyMax)
+      {
+        uint64 offset = m_dirtyMin * ItemSize;
+        updateFn(static_cast<byte*>(m_data) + offset, offset, (m_dirtyMax - m_dirtyMin + 1) * ItemSize);
       }
 
-      return mapped;
+      m_dirtyMin = m_capacity;
+      m_dirtyMax = -1;
+      m_isValid  = true;
+
+      return true;
+    }
+
+   private:
+    /** Extends the range of the slots that must be passed to gpu. */
+    void SetDirty(int slotIndex)
+    {
+      m_dirtyMin = glm::min(m_dirtyMin, slotIndex);
+      m_dirtyMax = glm::max(m_dirtyMax, slotIndex);
+      m_isValid  = false;
     }
 
    public:
@@ -186,17 +224,30 @@ namespace ToolKit
     const uint64 m_cacheSize;
 
    private:
-    typedef std::list<T> CacheList;
-    typedef std::unordered_map<ObjectId, typename CacheList::iterator> CacheMap;
-
-    /** Storage of items by id and list iterator. This map is used to see if an get its iterator in m_cacheList. */
-    CacheMap m_cacheMap;
-    /** List of item in the cache stored from least recently used to last.  */
-    CacheList m_lruCacheList;
+    struct Slot
+    {
+      T item;             //!< Copy of the item. Id of the item is NullHandle if the slot is free.
+      uint64 lastUse = 0; //!< Clock value of the last access. Least valued slot is evicted first.
+    };
+
+    /** Number of slots. */
+    const int m_capacity;
+    /** Items in the cache by their slot index. */
+    std::vector<Slot> m_slots;
+    /** Slot indexes of the items by id. */
+    std::unordered_map<ObjectId, int> m_cacheMap;
+    /** Slots that are not assigned to an item. */
+    IntArray m_freeSlots;
+    /** Incremented on each access to order the items by their last use. */
+    uint64 m_clock = 0;
+    /** First slot that is changed since the last map. */
+    int m_dirtyMin = 0;
+    /** Last slot that is changed since the last map. */
+    int m_dirtyMax = -1;
     /** States if a gpu map is needed. */
-    int m_isValid = false;
+    int m_isValid  = false;
     /** The full data that will be passed to gpu. */
-    void* m_data  = nullptr;
+    void* m_data   = nullptr;
   };
 
   // StructBuffer
@@ -29,7 +29,7 @@ namespace ToolKit
 
   GpuProgram::~GpuProgram()
   {
-    glDeleteProgram(m_handle);
+    RHI::DeleteProgram(m_handle);
     m_handle = 0;
   }
 
@@ -74,30 +74,83 @@ namespace ToolKit
     return shaderUniform.m_locInGPUProgram;
   }
 
-  void GpuProgram::UpdateCustomUniform(const String& uniformName, const UniformValue& val)
+  void GpuProgram::SetUniform(const UniformHandle& handle, const UniformValue& value)
   {
-    auto paramItr = m_customUniforms.find(uniformName);
-    if (paramItr == m_customUniforms.end())
+    int id = handle.GetId();
+    if (id == -1)
     {
-      m_customUniforms[uniformName] = ShaderUniform(uniformName, val);
+      return;
     }
-    else
+
+    if (id >= (int) m_customUniformIndices.size())
+    {
+      m_customUniformIndices.resize(id + 1, -1);
+    }
+
+    int& index = m_customUniformIndices[id];
+    if (index == -1)
     {
-      paramItr->second = val;
+      CustomUniform uniform;
+      uniform.location = glGetUniformLocation(m_handle, handle.GetName().c_str());
+      if (uniform.location == -1)
+      {
+        TK_WRN("Uniform: \"%s\" does not exist in program!", handle.GetName().c_str());
+      }
+
+      uniform.value = value;
+      index         = (int) m_customUniforms.size();
+      m_customUniforms.push_back(uniform);
+      return;
+    }
+
+    CustomUniform& uniform = m_customUniforms[index];
+    if (uniform.value != value)
+    {
+      uniform.value = value;
+      uniform.dirty = true;
     }
   }
 
+  void GpuProgram::UpdateCustomUniform(const String& uniformName, const UniformValue& val)
+  {
+    SetUniform(UniformHandle(uniformName), val);
+  }
+
   void GpuProgram::UpdateCustomUniform(const ShaderUniform& uniform)
   {
-    auto paramItr = m_customUniforms.find(uniform.m_name);
-    if (paramItr == m_customUniforms.end())
+    SetUniform(UniformHandle(uniform.m_name), uniform.m_value);
+  }
+
+  void GpuProgram::SetUniformBlockBinding(const UniformHandle& block, uint binding)
+  {
+    int id = block.GetId();
+    if (id == -1)
+    {
+      return;
+    }
+
+    if (id >= (int) m_uniformBlockBindings.size())
+    {
+      m_uniformBlockBindings.resize(id + 1, -1);
+    }
+
+    int& currentBinding = m_uniformBlockBindings[id];
+    if (currentBinding == (int) binding)
+    {
+      return;
+    }
+
+    GLuint blockIndex = glGetUniformBlockIndex(m_handle, block.GetName().c_str());
+    if (blockIndex == GL_INVALID_INDEX)
     {
-      m_customUniforms[uniform.m_name] = uniform;
+      TK_WRN("Uniform block: \"%s\" does not exist in program!", block.GetName().c_str());
     }
     else
     {
-      paramItr->second = uniform.m_value;
+      glUniformBlockBinding(m_handle, blockIndex, binding);
     }
+
+    currentBinding = (int) binding;
   }
 
   // GpuProgramManager
@@ -152,10 +205,8 @@ namespace ToolKit
 
       LinkProgram(program->m_handle, vertexShader, fragmentShader);
 
-      GLint currentProgram = 0;
-      glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
-
-      glUseProgram(program->m_handle);
+      GLuint currentProgram = RHI::GetCurrentProgram();
+      RHI::UseProgram(program->m_handle);
       for (ubyte slotIndx = 0; slotIndx < RHIConstants::TextureSlotCount; slotIndx++)
       {
         GLint loc = glGetUniformLocation(program->m_handle, ("s_texture" + std::to_string(slotIndx)).c_str());
@@ -169,16 +220,14 @@ namespace ToolKit
       if (loc != GL_INVALID_INDEX)
       {
         glUniformBlockBinding(program->m_handle, loc, CameraGpuBuffer::Binding());
-        glBindBufferBase(GL_UNIFORM_BUFFER, CameraGpuBuffer::Binding(), m_globalGpuBuffers->cameraBufferId);
+        RHI::BindUniformBuffer(CameraGpuBuffer::Binding(), m_globalGpuBuffers->cameraBufferId);
       }
 
       loc = glGetUniformBlockIndex(program->m_handle, "GraphicConstatsData");
       if (loc != GL_INVALID_INDEX)
       {
         glUniformBlockBinding(program->m_handle, loc, GraphicConstantsGpuBuffer::Binding());
-        glBindBufferBase(GL_UNIFORM_BUFFER,
-                         GraphicConstantsGpuBuffer::Binding(),
-                         m_globalGpuBuffers->graphicConstantBufferId);
+        RHI::BindUniformBuffer(GraphicConstantsGpuBuffer::Binding(), m_globalGpuBuffers->graphicConstantBufferId);
       }
 
       loc = glGetUniformBlockIndex(program->m_handle, "DirectionalLightBuffer");
@@ -186,9 +235,8 @@ namespace ToolKit
       {
         glUniformBlockBinding(program->m_handle, loc, DirectionalLightBuffer::BindingSlotForLight);
 
-        glBindBufferBase(GL_UNIFORM_BUFFER,
-                         DirectionalLightBuffer::BindingSlotForLight,
-                         m_globalGpuBuffers->directionalLightBufferId);
+        RHI::BindUniformBuffer(DirectionalLightBuffer::BindingSlotForLight,
+                               m_globalGpuBuffers->directionalLightBufferId);
       }
 
       loc = glGetUniformBlockIndex(program->m_handle, "DirectionalLightPVMBuffer");
@@ -196,23 +244,29 @@ namespace ToolKit
       {
         glUniformBlockBinding(program->m_handle, loc, DirectionalLightBuffer::BindingSlotForPVM);
 
-        glBindBufferBase(GL_UNIFORM_BUFFER,
-                         DirectionalLightBuffer::BindingSlotForPVM,
-                         m_globalGpuBuffers->directionalLightPVMBufferId);
+        RHI::BindUniformBuffer(DirectionalLightBuffer::BindingSlotForPVM,
+                               m_globalGpuBuffers->directionalLightPVMBufferId);
       }
 
       loc = glGetUniformBlockIndex(program->m_handle, "PointLightCache");
       if (loc != GL_INVALID_INDEX)
       {
         glUniformBlockBinding(program->m_handle, loc, PointLightCache::BindingSlot);
-        glBindBufferBase(GL_UNIFORM_BUFFER, PointLightCache::BindingSlot, m_globalGpuBuffers->pointLightBufferId);
+        RHI::BindUniformBuffer(PointLightCache::BindingSlot, m_globalGpuBuffers->pointLightBufferId);
       }
 
       loc = glGetUniformBlockIndex(program->m_handle, "SpotLightCache");
       if (loc != GL_INVALID_INDEX)
       {
         glUniformBlockBinding(program->m_handle, loc, SpotLightCache::BindingSlot);
-        glBindBufferBase(GL_UNIFORM_BUFFER, SpotLightCache::BindingSlot, m_globalGpuBuffers->spotLightBufferId);
+        RHI::BindUniformBuffer(SpotLightCache::BindingSlot, m_globalGpuBuffers->spotLightBufferId);
+      }
+
+      loc = glGetUniformBlockIndex(program->m_handle, "DiffuseSHCache");
+      if (loc != GL_INVALID_INDEX)
+      {
+        glUniformBlockBinding(program->m_handle, loc, DiffuseSHCache::BindingSlot);
+        RHI::BindUniformBuffer(DiffuseSHCache::BindingSlot, m_globalGpuBuffers->diffuseSHBufferId);
       }
 
       // Register default uniform locations
@@ -235,7 +289,11 @@ namespace ToolKit
 
       m_programs[{vertexShader->m_shaderHandle, fragmentShader->m_shaderHandle}] = program;
 
-      glUseProgram(currentProgram); // Restore current program.
+      // Restore current program.
+      if (currentProgram != UINT_MAX)
+      {
+        RHI::UseProgram(currentProgram);
+      }
 
       return m_programs[{vertexShader->m_shaderHandle, fragmentShader->m_shaderHandle}];
     }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Material.h"
+#include "RHI.h"
 #include "Shader.h"
 #include "ShaderUniform.h"
 #include "Types.h"
@@ -35,19 +36,42 @@ namespace ToolKit
     /** Returns the location of the custom uniform in the program. */
     int GetCustomUniformLocation(ShaderUniform& shaderUniform);
 
-    /** Updates or adds the given uniform to the uniform cache of the program. */
+    /**
+     * Sets the value of a custom uniform. The value is uploaded on the next draw with the program, only if it differs
+     * from the last uploaded value. Location of the uniform is resolved on the first call for each handle.
+     */
+    void SetUniform(const UniformHandle& handle, const UniformValue& value);
+
+    /**
+     * Updates or adds the given uniform to the uniform cache of the program. Registers the name on each call, prefer
+     * SetUniform with a kept handle in frequently called code.
+     */
     void UpdateCustomUniform(const String& name, const UniformValue& val);
     void UpdateCustomUniform(const ShaderUniform& uniform);
 
+    /** Assigns the uniform block of the program to the binding point. Block index is resolved once for each block. */
+    void SetUniformBlockBinding(const UniformHandle& block, uint binding);
+
    public:
     uint m_handle = 0;
     ShaderPtrArray m_shaders;
     MaterialCacheItem m_cachedMaterial; //!< Cached material data for the program.
+    UniformValueCache m_uniformCache;   //!< Last values uploaded to the uniforms of the program.
 
    private:
+    /** Value of a custom uniform and its location in the program. */
+    struct CustomUniform
+    {
+      UniformValue value;
+      int location = -1;
+      bool dirty   = true; //!< Value is not uploaded yet.
+    };
+
     std::unordered_map<Uniform, int> m_defaultUniformLocation;
     std::unordered_map<Uniform, int> m_defaultArrayUniformLocations;
-    std::unordered_map<String, ShaderUniform> m_customUniforms;
+    std::vector<CustomUniform> m_customUniforms; //!< Custom uniforms in the order of their first use.
+    std::vector<int> m_customUniformIndices;     //!< Index in m_customUniforms for each handle id, -1 if not used.
+    std::vector<int> m_uniformBlockBindings;     //!< Binding point of each uniform block handle id, -1 if not set.
   };
 
   /** Number of programmable pipeline stages. */
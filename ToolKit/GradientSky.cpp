@@ -70,7 +70,7 @@ namespace ToolKit
                            hdri->TrySettingCacheFiles(GradientDefaults.bakePath);
                          }
 
-                         if (hdri->_diffuseBakeFile.empty())
+                         if (hdri->_diffuseBakeFile.empty() && hdri->_irradianceCacheFile.empty())
                          {
                            hdri->GenerateIrradianceCaches(renderer);
                          }
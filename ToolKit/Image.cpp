@@ -7,6 +7,8 @@
 
 #include "Image.h"
 
+#include "Util.h"
+
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include "stb/stb_image_resize.h"
 
@@ -14,6 +16,10 @@
 #include "stb/stb_image_write.h"
 
 #define STB_IMAGE_IMPLEMENTATION
+// Decoded images are accounted for the texture tag, see MemoryTracker.
+#define STBI_MALLOC(sz)        ToolKit::TKMalloc(sz, ToolKit::MemoryTag::Texture)
+#define STBI_REALLOC(p, newsz) ToolKit::TKRealloc(p, newsz, ToolKit::MemoryTag::Texture)
+#define STBI_FREE(p)           ToolKit::TKFree(p)
 #ifdef __ARM_FP
   // enables simd on android phones, if supported
   #define STBI_NEON
@@ -76,7 +82,7 @@ namespace ToolKit
     return stbi_write_hdr(filename.data(), x, y, comp, data);
   }
 
-  void ImageSetVerticalOnLoad(bool val) { stbi_set_flip_vertically_on_load(val); }
+  void ImageSetVerticalOnLoad(bool val) { stbi_set_flip_vertically_on_load_thread(val); }
 
   void ImageFree(void* img) { stbi_image_free(img); }
 
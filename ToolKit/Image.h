@@ -29,7 +29,7 @@ namespace ToolKit
 
   TK_API int WritePNG(StringView filename, int x, int y, int comp, const void* data, int stride_bytes);
   TK_API int WriteHdr(StringView filename, int x, int y, int comp, const float* data);
-  TK_API void ImageSetVerticalOnLoad(bool val);
+  TK_API void ImageSetVerticalOnLoad(bool val); //!< Sets vertical flipping for the images loaded on calling thread.
   TK_API void ImageFree(void* img);
 
 } // namespace ToolKit
\ No newline at end of file
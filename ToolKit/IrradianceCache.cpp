@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "IrradianceCache.h"
+
+#include "Logger.h"
+#include "RHI.h"
+#include "Renderer.h"
+#include "TKOpenGL.h"
+#include "Texture.h"
+
+#include <fstream>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  /** Size of a half float rgba pixel in bytes. */
+  static const uint64 g_cachePixelSize = 4 * sizeof(uint16);
+
+  /** @return Size of a face of the level in pixels. */
+  static int FaceSize(uint size, int level) { return glm::max(1, (int) size >> level); }
+
+  /** @return Size of all faces of the level in bytes. */
+  static uint64 LevelBytes(uint size, int level)
+  {
+    uint64 faceSize = (uint64) FaceSize(size, level);
+    return faceSize * faceSize * g_cachePixelSize * 6;
+  }
+
+  /** @return Size of the stored diffuse env map in bytes. */
+  static uint64 DiffuseBytes(const IrradianceCacheHeader& header)
+  {
+    return header.diffuseSize > 0 ? LevelBytes(header.diffuseSize, 0) : 0;
+  }
+
+  /** Reads back all faces of the cube map level and appends them to the pixels as half float rgba. */
+  static void ReadBackLevel(Renderer* renderer, CubeMapPtr cubemap, int level, std::vector<uint16>& pixels)
+  {
+    std::vector<float> levelPixels;
+    renderer->ReadCubeMapLevel(cubemap, level, levelPixels);
+
+    for (float value : levelPixels)
+    {
+      pixels.push_back(glm::packHalf1x16(value));
+    }
+  }
+
+  /** Uploads all faces of the level to the cube map. */
+  static void UploadLevel(CubeMapPtr cubemap, uint size, int level, const uint8* faces)
+  {
+    int faceSize     = FaceSize(size, level);
+    uint64 faceBytes = LevelBytes(size, level) / 6;
+
+    RHI::SetTexture(GL_TEXTURE_CUBE_MAP, cubemap->m_textureId);
+    for (int face = 0; face < 6; face++)
+    {
+      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
+                      level,
+                      0,
+                      0,
+                      faceSize,
+                      faceSize,
+                      GL_RGBA,
+                      GL_HALF_FLOAT,
+                      faces + face * faceBytes);
+    }
+  }
+
+  IrradianceCache::IrradianceCache() {}
+
+  IrradianceCache::~IrradianceCache() {}
+
+  bool IrradianceCache::Write(Renderer* renderer,
+                              const String& file,
+                              CubeMapPtr diffuseEnvMap,
+                              CubeMapPtr specularEnvMap,
+                              int lodCount)
+  {
+    bool diffuseRendered = diffuseEnvMap == nullptr || diffuseEnvMap->m_consumedRT != nullptr;
+    if (!diffuseRendered || specularEnvMap == nullptr || specularEnvMap->m_consumedRT == nullptr)
+    {
+      TK_ERR("Irradiance caches must be rendered on the gpu to be baked.");
+      return false;
+    }
+
+    IrradianceCacheHeader header;
+    header.internalFormat   = GL_RGBA16F;
+    header.format           = GL_RGBA;
+    header.type             = GL_HALF_FLOAT;
+    header.diffuseSize      = diffuseEnvMap != nullptr ? (uint) diffuseEnvMap->m_width : 0;
+    header.specularSize     = (uint) specularEnvMap->m_width;
+    header.specularLodCount = (uint) glm::max(1, lodCount);
+
+    uint64 dataSize         = DiffuseBytes(header);
+    for (int lod = 1; lod < (int) header.specularLodCount; lod++)
+    {
+      dataSize += LevelBytes(header.specularSize, lod);
+    }
+
+    std::vector<uint16> pixels;
+    pixels.reserve(dataSize / sizeof(uint16));
+
+    if (diffuseEnvMap != nullptr)
+    {
+      ReadBackLevel(renderer, diffuseEnvMap, 0, pixels);
+    }
+
+    for (int lod = 1; lod < (int) header.specularLodCount; lod++)
+    {
+      ReadBackLevel(renderer, specularEnvMap, lod, pixels);
+    }
+
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    stream.write((const char*) &header, sizeof(IrradianceCacheHeader));
+    stream.write((const char*) pixels.data(), pixels.size() * sizeof(uint16));
+    if (!stream.good())
+    {
+      TK_ERR("Can't write irradiance cache: %s", file.c_str());
+      return false;
+    }
+
+    return true;
+  }
+
+  bool IrradianceCache::Open(const String& file)
+  {
+    if (!m_file.Open(file) || m_file.Size() < sizeof(IrradianceCacheHeader))
+    {
+      m_file.Close();
+      return false;
+    }
+
+    memcpy(&m_header, m_file.Data(), sizeof(IrradianceCacheHeader));
+
+    // Only the format that is written by the bake is accepted, images are uploaded as is.
+    IrradianceCacheHeader expected;
+    if (m_header.magic != expected.magic || m_header.version != expected.version ||
+        m_header.internalFormat != GL_RGBA16F || m_header.format != GL_RGBA || m_header.type != GL_HALF_FLOAT ||
+        m_header.specularSize == 0 || m_header.specularLodCount == 0)
+    {
+      TK_WRN("Invalid irradiance cache: %s", file.c_str());
+      m_file.Close();
+      return false;
+    }
+
+    uint64 dataSize = DiffuseBytes(m_header);
+    for (int lod = 1; lod < (int) m_header.specularLodCount; lod++)
+    {
+      dataSize += LevelBytes(m_header.specularSize, lod);
+    }
+
+    if (m_file.Size() != sizeof(IrradianceCacheHeader) + dataSize)
+    {
+      TK_WRN("Truncated irradiance cache: %s", file.c_str());
+      m_file.Close();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool IrradianceCache::HasDiffuseEnvMap() const { return m_header.diffuseSize > 0; }
+
+  CubeMapPtr IrradianceCache::CreateDiffuseEnvMap() const
+  {
+    if (!HasDiffuseEnvMap())
+    {
+      return nullptr;
+    }
+
+    // Same settings with the generated diffuse env map.
+    const TextureSettings set = {GraphicTypes::TargetCubeMap,
+                                 GraphicTypes::UVClampToEdge,
+                                 GraphicTypes::UVClampToEdge,
+                                 GraphicTypes::UVClampToEdge,
+                                 GraphicTypes::SampleNearest,
+                                 GraphicTypes::SampleNearest,
+                                 GraphicTypes::FormatRGBA16F,
+                                 GraphicTypes::FormatRGBA,
+                                 GraphicTypes::TypeFloat,
+                                 0,
+                                 false};
+
+    int size                  = (int) m_header.diffuseSize;
+    RenderTargetPtr cubeMapRt = MakeNewPtr<RenderTarget>(size, size, set, "DiffuseIRCacheRT");
+    cubeMapRt->Init();
+
+    CubeMapPtr cubeMap = MakeNewPtr<CubeMap>();
+    cubeMap->Consume(cubeMapRt);
+
+    UploadLevel(cubeMap, m_header.diffuseSize, 0, m_file.Data() + sizeof(IrradianceCacheHeader));
+
+    return cubeMap;
+  }
+
+  void IrradianceCache::UploadSpecularLods(CubeMapPtr specularEnvMap) const
+  {
+    for (int lod = 1; lod < (int) m_header.specularLodCount; lod++)
+    {
+      UploadLevel(specularEnvMap, m_header.specularSize, lod, GetSpecularLod(lod));
+    }
+  }
+
+  int IrradianceCache::GetSpecularSize() const { return (int) m_header.specularSize; }
+
+  int IrradianceCache::GetSpecularLodCount() const { return (int) m_header.specularLodCount; }
+
+  const uint8* IrradianceCache::GetSpecularLod(int lod) const
+  {
+    uint64 offset = sizeof(IrradianceCacheHeader) + DiffuseBytes(m_header);
+    for (int i = 1; i < lod; i++)
+    {
+      offset += LevelBytes(m_header.specularSize, i);
+    }
+
+    return m_file.Data() + offset;
+  }
+
+} // namespace ToolKit
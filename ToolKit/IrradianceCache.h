@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "MappedFile.h"
+
+namespace ToolKit
+{
+
+  /** Header of the irradiance cache file. Face images of all levels follow the header. */
+  struct IrradianceCacheHeader
+  {
+    uint magic            = 0x43494B54; //!< "TKIC"
+    uint version          = 1;
+    uint internalFormat   = 0;          //!< Gl internal format of the cube maps.
+    uint format           = 0;          //!< Gl pixel format of the stored images.
+    uint type             = 0;          //!< Gl pixel type of the stored images.
+    uint diffuseSize      = 0;          //!< Face size of the single level diffuse env map, 0 if not stored.
+    uint specularSize     = 0;          //!< Face size of the first level of the specular env map.
+    uint specularLodCount = 0;          //!< Number of specular lods including the first one, which is not stored.
+  };
+
+  /**
+   * Baked diffuse and specular irradiance caches of an hdri, stored in a single file in the format they are sampled on
+   * the gpu. Faces are stored as half float rgba images, level by level, in the cube map face order. Loading maps the
+   * file and uploads each face of each level as is, there is no decoding or conversion. The first specular lod is the
+   * environment map itself, so it is not stored.
+   */
+  class TK_API IrradianceCache
+  {
+   public:
+    IrradianceCache();
+    ~IrradianceCache();
+
+    /**
+     * Reads back the caches from the gpu and writes them to the file. Must be called from the render thread.
+     * @param diffuseEnvMap is the diffuse irradiance cube map. Must be rendered on the gpu. Null if the environment
+     * only uses spherical harmonics, which are generated on load.
+     * @param specularEnvMap is the pre filtered specular cube map. Must be rendered on the gpu.
+     * @param lodCount is the number of specular lods. Lods from 1 to lodCount - 1 are stored.
+     * @return False if the caches can't be read back or the file can't be written.
+     */
+    static bool Write(class Renderer* renderer,
+                      const String& file,
+                      CubeMapPtr diffuseEnvMap,
+                      CubeMapPtr specularEnvMap,
+                      int lodCount);
+
+    /** Maps the file and validates its content. @return False if the file is missing or it is not a valid cache. */
+    bool Open(const String& file);
+
+    /** States if the diffuse env map is stored in the cache. */
+    bool HasDiffuseEnvMap() const;
+
+    /** Creates the diffuse env map from the cache, nullptr if not stored. Must be called from the render thread. */
+    CubeMapPtr CreateDiffuseEnvMap() const;
+
+    /**
+     * Uploads the stored lods to the specular env map. Storage for its mip levels must be allocated. Must be called
+     * from the render thread.
+     */
+    void UploadSpecularLods(CubeMapPtr specularEnvMap) const;
+
+    /** @return Face size of the first lod of the specular env map that the cache is baked for. */
+    int GetSpecularSize() const;
+
+    /** @return Number of specular lods including the first one. */
+    int GetSpecularLodCount() const;
+
+   private:
+    /** @return Face images of the given specular lod. */
+    const uint8* GetSpecularLod(int lod) const;
+
+   private:
+    MappedFile m_file;
+    IrradianceCacheHeader m_header;
+  };
+
+} // namespace ToolKit
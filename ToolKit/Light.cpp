@@ -430,7 +430,8 @@ namespace ToolKit
 
   bool PointLightCache::Map()
   {
-    return LRUCache::Map([this](const void* data, uint64 size) { m_gpuBuffer.Map(data, size); });
+    return LRUCache::Map([this](const void* data, uint64 offset, uint64 size)
+                         { m_gpuBuffer.MapRange(data, offset, size); });
   }
 
   // PointLight
@@ -528,7 +529,8 @@ namespace ToolKit
 
   bool SpotLightCache::Map()
   {
-    return LRUCache::Map([this](const void* data, uint64 size) { m_gpuBuffer.Map(data, size); });
+    return LRUCache::Map([this](const void* data, uint64 offset, uint64 size)
+                         { m_gpuBuffer.MapRange(data, offset, size); });
   }
 
   // SpotLight
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "MappedFile.h"
+
+#include "FileManager.h"
+#include "ToolKit.h"
+#include "Util.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  MappedFile::MappedFile() {}
+
+  MappedFile::~MappedFile() { Close(); }
+
+  bool MappedFile::Open(const String& file)
+  {
+    Close();
+
+    if (CheckSystemFile(file) && Map(file))
+    {
+      return true;
+    }
+
+    // Not on the disk, possibly in the pak.
+    m_buffer = GetFileManager()->GetBinaryFile(file);
+    if (m_buffer.empty())
+    {
+      return false;
+    }
+
+    m_data = (const uint8*) m_buffer.data();
+    m_size = m_buffer.size();
+
+    return true;
+  }
+
+  void MappedFile::Close()
+  {
+    if (m_mapped)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(m_data);
+#else
+      munmap((void*) m_data, (size_t) m_size);
+#endif
+    }
+
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+  }
+
+  bool MappedFile::Map(const String& file)
+  {
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(file.c_str(),
+                                    GENERIC_READ,
+                                    FILE_SHARE_READ,
+                                    nullptr,
+                                    OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL,
+                                    nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+      CloseHandle(fileHandle);
+      return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(fileHandle);
+
+    if (mapping == nullptr)
+    {
+      return false;
+    }
+
+    // The view keeps the mapping alive, handles can be closed right away.
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (view == nullptr)
+    {
+      return false;
+    }
+
+    m_data = (const uint8*) view;
+    m_size = (uint64) fileSize.QuadPart;
+#else
+    int fileDescriptor = open(file.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+      return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+      close(fileDescriptor);
+      return false;
+    }
+
+    // The mapping keeps a reference to the file, descriptor can be closed right away.
+    void* view = mmap(nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    if (view == MAP_FAILED)
+    {
+      return false;
+    }
+
+    m_data = (const uint8*) view;
+    m_size = (uint64) fileStat.st_size;
+#endif
+
+    m_mapped = true;
+    return true;
+  }
+
+} // namespace ToolKit
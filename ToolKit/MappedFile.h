@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /**
+   * Read only view of the content of a file. Files on the disk are memory mapped, pages are brought in by the os as
+   * they are accessed and nothing is copied. Files that only exist in the pak are read in to memory as a fallback.
+   */
+  class TK_API MappedFile
+  {
+   public:
+    MappedFile();
+    ~MappedFile(); //!< Unmaps the file.
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Opens the file for reading. Closes the previously opened file if any.
+     * @return False if the file can't be found or it is empty.
+     */
+    bool Open(const String& file);
+
+    /** Unmaps the file or releases the buffer. */
+    void Close();
+
+    /** @return Content of the file or nullptr if no file is open. */
+    const uint8* Data() const { return m_data; }
+
+    /** @return Size of the file in bytes. */
+    uint64 Size() const { return m_size; }
+
+    /** States if the content is memory mapped rather than read in to memory. */
+    bool IsMapped() const { return m_mapped; }
+
+   private:
+    /** Maps the file from the disk. */
+    bool Map(const String& file);
+
+   private:
+    const uint8* m_data = nullptr;
+    uint64 m_size       = 0;
+    bool m_mapped       = false;
+    ByteArray m_buffer; //!< Content of the file when it is not mapped.
+  };
+
+} // namespace ToolKit
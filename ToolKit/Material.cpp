@@ -13,6 +13,7 @@
 #include "Renderer.h"
 #include "Shader.h"
 #include "Stats.h"
+#include "TextureCompressor.h"
 #include "ToolKit.h"
 #include "Util.h"
 
@@ -80,8 +81,12 @@ namespace ToolKit
         tex->UnInit();
         tex->Load();
 
+        // Cooked images are block compressed and can only be uploaded in their format, sampled as linear data.
+        GraphicTypes format = tex->Settings().InternalFormat;
+        bool compressed     = IsCompressedFormat(format);
+
         TextureSettings set;
-        set.InternalFormat = GraphicTypes::FormatRGBA;
+        set.InternalFormat = compressed ? TextureCompressor::ToLinearFormat(format) : GraphicTypes::FormatRGBA;
         set.MinFilter      = GraphicTypes::SampleNearest;
         set.Type           = GraphicTypes::TypeUnsignedByte;
         set.GenerateMipMap = false;
@@ -98,8 +103,12 @@ namespace ToolKit
         tex->UnInit();
         tex->Load();
 
+        // Cooked images are block compressed and can only be uploaded in their format, sampled as linear data.
+        GraphicTypes format = tex->Settings().InternalFormat;
+        bool compressed     = IsCompressedFormat(format);
+
         TextureSettings set;
-        set.InternalFormat = GraphicTypes::FormatRGBA;
+        set.InternalFormat = compressed ? TextureCompressor::ToLinearFormat(format) : GraphicTypes::FormatRGBA;
         set.MinFilter      = GraphicTypes::SampleNearest;
         set.Type           = GraphicTypes::TypeUnsignedByte;
         set.GenerateMipMap = false;
@@ -523,7 +532,7 @@ namespace ToolKit
 
   MaterialPtr MaterialManager::GetCopyOfUnlitMaterial(bool storeInMaterialManager)
   {
-    ResourcePtr source = m_storage[MaterialPath("unlit.material", true)];
+    ResourcePtr source = Find(MaterialPath("unlit.material", true));
     return Copy<Material>(source, storeInMaterialManager);
   }
 
@@ -545,7 +554,7 @@ namespace ToolKit
 
   MaterialPtr MaterialManager::GetCopyOfDefaultMaterial(bool storeInMaterialManager)
   {
-    ResourcePtr source = m_storage[MaterialPath("default.material", true)];
+    ResourcePtr source = Find(MaterialPath("default.material", true));
     return Copy<Material>(source, storeInMaterialManager);
   }
 
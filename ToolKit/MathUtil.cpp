@@ -403,35 +403,26 @@ namespace ToolKit
       return false;
   }
 
-  Vec3 CPUSkinning(const SkinVertex* vertex, const Skeleton* skel, DynamicBoneMapPtr dynamicBoneMap, bool isAnimated)
+  Vec3 CPUSkinning(const SkinVertex* vertex, const Mat4* matrixPalette)
   {
+    // Blend the matrices first, a single matrix vector product is needed instead of one per influence.
+    // Matrix columns are simd registers, weighted sums are vectorized by glm intrinsics.
+    const Vec4& bones   = vertex->bones;
+    const Vec4& weights = vertex->weights;
+    Mat4 skinTransform  = matrixPalette[(int) bones.x] * weights.x + matrixPalette[(int) bones.y] * weights.y +
+                         matrixPalette[(int) bones.z] * weights.z + matrixPalette[(int) bones.w] * weights.w;
 
-    Vec3 transformedPos;
-    for (uint boneIndx = 0; boneIndx < 4; boneIndx++)
-    {
-      uint currentBone  = (uint) vertex->bones[boneIndx];
-      StaticBone* sBone = skel->m_bones[currentBone];
-
-      if (isAnimated)
-      {
-        // Get animated pose
-        Mat4 boneTransform =
-            dynamicBoneMap->m_boneMap.find(sBone->m_name)->second.node->GetTransform(TransformationSpace::TS_WORLD);
-
-        transformedPos +=
-            Vec3((boneTransform * sBone->m_inverseWorldMatrix * Vec4(vertex->pos, 1.0f) * vertex->weights[boneIndx]));
-      }
-      else
-      {
-        // Get bind pose
-        Mat4 transform = skel->m_Tpose.m_boneMap.find(sBone->m_name)->second.node->GetTransform();
-
-        transformedPos +=
-            Vec3((transform * sBone->m_inverseWorldMatrix * Vec4(vertex->pos, 1.0f) * vertex->weights[boneIndx]));
-      }
-    }
+    return Vec3(skinTransform * Vec4(vertex->pos, 1.0f));
+  }
 
-    return transformedPos;
+  void CPUSkinning(const SkinVertex* vertices, int vertexCount, const Mat4* matrixPalette, Vec3* skinnedPositions)
+  {
+    using poolstl::iota_iter;
+    std::for_each(TKExecByConditional(vertexCount > 1000, WorkerManager::FramePool),
+                  iota_iter<int>(0),
+                  iota_iter<int>(vertexCount),
+                  [vertices, matrixPalette, skinnedPositions](int vertexIndx) -> void
+                  { skinnedPositions[vertexIndx] = CPUSkinning(vertices + vertexIndx, matrixPalette); });
   }
 
   bool RayMeshIntersection(const Mesh* const mesh, const Ray& ray, float& t, const SkeletonComponentPtr skelComp)
@@ -440,6 +431,9 @@ namespace ToolKit
     bool hit                    = false;
     bool isAnimated             = true;
 
+    // Skinned vertex positions, index aligned with the client side vertices of the skin mesh.
+    Vec3Array skinnedPositions;
+
     // Sanitize.
     if (mesh->IsSkinned())
     {
@@ -475,26 +469,38 @@ namespace ToolKit
       {
         isAnimated = false;
       }
+
+      // Skin each vertex once, faces share vertices.
+      const Skeleton* skeleton       = skinMesh->m_skeleton.get();
+      const Mat4Array* matrixPalette = &skeleton->m_Tpose.m_matrixPalette;
+      if (isAnimated && skelComp->m_map != nullptr)
+      {
+        skelComp->m_map->UpdateMatrixPalette(skeleton);
+        matrixPalette = &skelComp->m_map->m_matrixPalette;
+      }
+
+      const std::vector<SkinVertex>& vertices = skinMesh->m_clientSideVertices;
+      skinnedPositions.resize(vertices.size());
+      CPUSkinning(vertices.data(), (int) vertices.size(), matrixPalette->data(), skinnedPositions.data());
     }
 
     std::mutex updateHit;
     std::for_each(TKExecByConditional(mesh->m_faces.size() > 100, WorkerManager::FramePool),
                   mesh->m_faces.begin(),
                   mesh->m_faces.end(),
-                  [&updateHit, &t, &closestPickedDistance, &ray, &hit, skelComp, mesh, &isAnimated](const Face& face)
+                  [&updateHit, &t, &closestPickedDistance, &ray, &hit, &skinnedPositions, mesh](const Face& face)
                   {
                     Vec3 positions[3] = {face.vertices[0]->pos, face.vertices[1]->pos, face.vertices[2]->pos};
-                    if (skelComp != nullptr && mesh->IsSkinned())
+                    if (!skinnedPositions.empty())
                     {
-                      SkinMesh* skinMesh = (SkinMesh*) mesh;
+                      const SkinVertex* firstVertex = ((const SkinMesh*) mesh)->m_clientSideVertices.data();
                       for (uint vertexIndx = 0; vertexIndx < 3; vertexIndx++)
                       {
-                        positions[vertexIndx] = CPUSkinning((SkinVertex*) face.vertices[vertexIndx],
-                                                            skinMesh->m_skeleton.get(),
-                                                            skelComp->m_map,
-                                                            isAnimated);
+                        size_t index          = (const SkinVertex*) face.vertices[vertexIndx] - firstVertex;
+                        positions[vertexIndx] = skinnedPositions[index];
                       }
                     }
+
                     float dist = TK_FLT_MAX;
                     if (RayTriangleIntersection(ray, positions[0], positions[1], positions[2], dist))
                     {
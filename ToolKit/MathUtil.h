@@ -71,10 +71,25 @@ namespace ToolKit
 
   TK_API bool RayTriangleIntersection(const Ray& ray, const Vec3& v0, const Vec3& v1, const Vec3& v2, float& t);
 
-  TK_API Vec3 CPUSkinning(const class SkinVertex* vertex,
-                          const Skeleton* skel,
-                          DynamicBoneMapPtr dynamicBoneMap,
-                          bool isAnimated);
+  /**
+   * Skins the vertex position with linear blend skinning.
+   * @param vertex is the vertex to skin.
+   * @param matrixPalette is the skinning matrices indexed by bone index. See DynamicBoneMap::UpdateMatrixPalette.
+   * @return Skinned position of the vertex.
+   */
+  TK_API Vec3 CPUSkinning(const class SkinVertex* vertex, const Mat4* matrixPalette);
+
+  /**
+   * Skins the positions of all given vertices in parallel.
+   * @param vertices are the vertices to skin.
+   * @param vertexCount is the number of vertices.
+   * @param matrixPalette is the skinning matrices indexed by bone index. See DynamicBoneMap::UpdateMatrixPalette.
+   * @param skinnedPositions is the output array that must have room for vertexCount positions.
+   */
+  TK_API void CPUSkinning(const class SkinVertex* vertices,
+                          int vertexCount,
+                          const Mat4* matrixPalette,
+                          Vec3* skinnedPositions);
 
   TK_API bool RayMeshIntersection(const class Mesh* const mesh,
                                   const Ray& rayInWorldSpace,
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "MemoryTracker.h"
+
+#include "Animation.h"
+#include "Audio.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "Scene.h"
+#include "Shader.h"
+#include "Skeleton.h"
+#include "SpriteSheet.h"
+#include "Stats.h"
+#include "Texture.h"
+#include "ToolKit.h"
+
+#include <atomic>
+#include <fstream>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  static std::atomic<uint64> g_taggedMemory[(int) MemoryTag::Count] = {};
+  static std::atomic<int64> g_liveResourceCount                     = 0;
+
+  static const char* g_memoryTagNames[(int) MemoryTag::Count] =
+      {"General", "Plugin", "Texture", "Mesh", "Animation", "Audio", "Scene", "UI"};
+
+  /** Formats the bytes in the most readable unit. Negative values are kept for differences. */
+  static String FormatBytes(int64 bytes)
+  {
+    char buffer[32];
+    double absBytes = (double) glm::abs(bytes);
+    if (absBytes >= 1024.0 * 1024.0)
+    {
+      snprintf(buffer, sizeof(buffer), "%.2f MB", bytes / (1024.0 * 1024.0));
+    }
+    else if (absBytes >= 1024.0)
+    {
+      snprintf(buffer, sizeof(buffer), "%.2f KB", bytes / 1024.0);
+    }
+    else
+    {
+      snprintf(buffer, sizeof(buffer), "%lld B", (long long) bytes);
+    }
+
+    return buffer;
+  }
+
+  MemoryRecordArray MemorySnapshot::GetTypeTotals() const
+  {
+    MemoryRecordArray totals;
+    std::unordered_map<String, size_t> typeIndices;
+    for (const MemoryRecord& resource : resources)
+    {
+      auto typeIndex = typeIndices.find(resource.type);
+      if (typeIndex == typeIndices.end())
+      {
+        typeIndex = typeIndices.insert({resource.type, totals.size()}).first;
+        totals.push_back({resource.type, resource.type, 0, 0});
+      }
+
+      MemoryRecord& total  = totals[typeIndex->second];
+      total.cpu           += resource.cpu;
+      total.gpu           += resource.gpu;
+    }
+
+    return totals;
+  }
+
+  void MemoryTracker::OnAllocate(MemoryTag tag, uint64 bytes) { g_taggedMemory[(int) tag] += bytes; }
+
+  void MemoryTracker::OnFree(MemoryTag tag, uint64 bytes) { g_taggedMemory[(int) tag] -= bytes; }
+
+  void MemoryTracker::OnResourceCreated() { g_liveResourceCount++; }
+
+  void MemoryTracker::OnResourceDestroyed() { g_liveResourceCount--; }
+
+  uint64 MemoryTracker::GetTaggedMemory(MemoryTag tag) { return g_taggedMemory[(int) tag]; }
+
+  const char* MemoryTracker::GetTagName(MemoryTag tag) { return g_memoryTagNames[(int) tag]; }
+
+  MemorySnapshot MemoryTracker::TakeSnapshot()
+  {
+    MemorySnapshot snapshot;
+    snapshot.liveResourceCount = g_liveResourceCount;
+    snapshot.totalVRAM         = (int64) Stats::GetTotalVRAMUsageInBytes();
+
+    Main* main                 = Main::GetInstance();
+    if (main == nullptr)
+    {
+      return snapshot;
+    }
+
+    snapshot.time               = main->TimeSinceStartup();
+
+    ResourceManager* managers[] = {main->m_animationMan,
+                                   main->m_audioMan,
+                                   main->m_materialManager,
+                                   main->m_meshMan,
+                                   main->m_shaderMan,
+                                   main->m_spriteSheetMan,
+                                   main->m_textureMan,
+                                   main->m_sceneManager,
+                                   main->m_skeletonManager};
+
+    for (ResourceManager* manager : managers)
+    {
+      if (manager != nullptr)
+      {
+        manager->GatherMemoryUsage(snapshot.resources);
+      }
+    }
+
+    for (int tag = 0; tag < (int) MemoryTag::Count; tag++)
+    {
+      snapshot.tags.push_back({"Tag", g_memoryTagNames[tag], (int64) g_taggedMemory[tag].load(), 0});
+    }
+
+    return snapshot;
+  }
+
+  MemorySnapshot MemoryTracker::Diff(const MemorySnapshot& before, const MemorySnapshot& after)
+  {
+    MemorySnapshot diff;
+    diff.time              = after.time - before.time;
+    diff.liveResourceCount = after.liveResourceCount - before.liveResourceCount;
+    diff.totalVRAM         = after.totalVRAM - before.totalVRAM;
+
+    auto diffFn            = [](const MemoryRecordArray& beforeRecords,
+                                const MemoryRecordArray& afterRecords,
+                                MemoryRecordArray& diffRecords) -> void
+    {
+      std::unordered_map<String, const MemoryRecord*> beforeMap;
+      for (const MemoryRecord& record : beforeRecords)
+      {
+        beforeMap[record.type + record.name] = &record;
+      }
+
+      for (const MemoryRecord& record : afterRecords)
+      {
+        MemoryRecord change = record;
+        auto previous       = beforeMap.find(record.type + record.name);
+        if (previous != beforeMap.end())
+        {
+          change.cpu -= previous->second->cpu;
+          change.gpu -= previous->second->gpu;
+          beforeMap.erase(previous);
+        }
+
+        if (change.cpu != 0 || change.gpu != 0)
+        {
+          diffRecords.push_back(change);
+        }
+      }
+
+      // Released records.
+      for (const MemoryRecord& record : beforeRecords)
+      {
+        if (beforeMap.find(record.type + record.name) != beforeMap.end() && (record.cpu != 0 || record.gpu != 0))
+        {
+          diffRecords.push_back({record.type, record.name, -record.cpu, -record.gpu});
+        }
+      }
+    };
+
+    diffFn(before.resources, after.resources, diff.resources);
+    diffFn(before.tags, after.tags, diff.tags);
+
+    return diff;
+  }
+
+  String MemoryTracker::Report(const MemorySnapshot& snapshot, int maxResources)
+  {
+    auto bySizeFn = [](const MemoryRecord& a, const MemoryRecord& b) -> bool
+    { return glm::abs(a.cpu + a.gpu) > glm::abs(b.cpu + b.gpu); };
+
+    String report;
+    char buffer[512];
+
+    snprintf(buffer,
+             sizeof(buffer),
+             "Live Resources: %lld, Total VRAM: %s\n",
+             (long long) snapshot.liveResourceCount,
+             FormatBytes(snapshot.totalVRAM).c_str());
+    report += buffer;
+
+    report += "Resource Types:\n";
+    MemoryRecordArray totals = snapshot.GetTypeTotals();
+    std::sort(totals.begin(), totals.end(), bySizeFn);
+    for (const MemoryRecord& total : totals)
+    {
+      snprintf(buffer,
+               sizeof(buffer),
+               "  %-16s cpu: %12s gpu: %12s\n",
+               total.type.c_str(),
+               FormatBytes(total.cpu).c_str(),
+               FormatBytes(total.gpu).c_str());
+      report += buffer;
+    }
+
+    report += "Tagged Allocations:\n";
+    for (const MemoryRecord& tag : snapshot.tags)
+    {
+      if (tag.cpu != 0)
+      {
+        snprintf(buffer, sizeof(buffer), "  %-16s cpu: %12s\n", tag.name.c_str(), FormatBytes(tag.cpu).c_str());
+        report += buffer;
+      }
+    }
+
+    MemoryRecordArray resources = snapshot.resources;
+    std::sort(resources.begin(), resources.end(), bySizeFn);
+    if ((int) resources.size() > maxResources)
+    {
+      resources.resize(glm::max(0, maxResources));
+    }
+
+    report += "Largest Resources:\n";
+    for (const MemoryRecord& resource : resources)
+    {
+      String name = GetRelativeResourcePath(resource.name);
+      snprintf(buffer,
+               sizeof(buffer),
+               "  %-16s cpu: %12s gpu: %12s %s\n",
+               resource.type.c_str(),
+               FormatBytes(resource.cpu).c_str(),
+               FormatBytes(resource.gpu).c_str(),
+               name.c_str());
+      report += buffer;
+    }
+
+    return report;
+  }
+
+  bool MemoryTracker::Export(const MemorySnapshot& snapshot, const String& file)
+  {
+    std::ofstream stream(file, std::ios::out | std::ios::trunc);
+    if (!stream.is_open())
+    {
+      TK_ERR("Memory snapshot can't be written to: %s", file.c_str());
+      return false;
+    }
+
+    stream << "Type,Name,Cpu,Gpu\n";
+    stream << "Summary,LiveResources," << snapshot.liveResourceCount << ",0\n";
+    stream << "Summary,TotalVRAM,0," << snapshot.totalVRAM << "\n";
+
+    for (const MemoryRecord& tag : snapshot.tags)
+    {
+      stream << tag.type << "," << tag.name << "," << tag.cpu << "," << tag.gpu << "\n";
+    }
+
+    // Paths are quoted, they may contain commas.
+    for (const MemoryRecord& resource : snapshot.resources)
+    {
+      stream << resource.type << ",\"" << resource.name << "\"," << resource.cpu << "," << resource.gpu << "\n";
+    }
+
+    return stream.good();
+  }
+
+} // namespace ToolKit
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /** Categories for the allocations made through TKMalloc. */
+  enum class MemoryTag : uint8
+  {
+    General,
+    Plugin,
+    Texture,
+    Mesh,
+    Animation,
+    Audio,
+    Scene,
+    UI,
+    Count
+  };
+
+  /** Memory that is held by a resource or accounted for a tag. Signed, so that differences can be represented. */
+  struct MemoryRecord
+  {
+    String type;   //!< Resource class name or "Tag" for tagged allocations.
+    String name;   //!< Resource file, or the object id for resources without a file.
+    int64 cpu = 0; //!< Bytes of cpu memory, such as client side arrays and decoded images.
+    int64 gpu = 0; //!< Bytes of gpu memory, such as buffers and textures.
+  };
+
+  typedef std::vector<MemoryRecord> MemoryRecordArray;
+
+  /** Memory usage of the engine at a point in time. */
+  struct TK_API MemorySnapshot
+  {
+    float time              = 0.0f; //!< Time since startup in milliseconds.
+    int64 liveResourceCount = 0;    //!< Number of resource objects alive, including the ones not in managers.
+    int64 totalVRAM         = 0;    //!< Gpu memory that is reported to TKStats.
+    MemoryRecordArray resources;    //!< Memory held by each resource in the resource managers.
+    MemoryRecordArray tags;         //!< Memory allocated through TKMalloc for each tag.
+
+    /** @return Cpu and gpu memory summed for each resource type. */
+    MemoryRecordArray GetTypeTotals() const;
+  };
+
+  /**
+   * Gathers cpu and gpu memory usage of resources and tagged allocations. Snapshots can be compared to find what grows
+   * between two points, such as before and after loading a level. Resource managers report the memory of the resources
+   * they store, resources that are created without a manager are only counted in the live resource count.
+   */
+  class TK_API MemoryTracker
+  {
+   public:
+    /** Records an allocation made for the tag. Thread safe. */
+    static void OnAllocate(MemoryTag tag, uint64 bytes);
+
+    /** Records a release made for the tag. Thread safe. */
+    static void OnFree(MemoryTag tag, uint64 bytes);
+
+    /** Records the construction and destruction of resources. Thread safe. */
+    static void OnResourceCreated();
+    static void OnResourceDestroyed();
+
+    /** @return Bytes currently allocated for the tag. */
+    static uint64 GetTaggedMemory(MemoryTag tag);
+
+    /** @return Name of the tag. */
+    static const char* GetTagName(MemoryTag tag);
+
+    /** Collects the memory usage from all resource managers. Must be called from the main thread. */
+    static MemorySnapshot TakeSnapshot();
+
+    /**
+     * Calculates the change between two snapshots. Resources only present in after are reported with their full
+     * memory, resources only present in before are reported as negative. Unchanged records are omitted.
+     */
+    static MemorySnapshot Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+
+    /**
+     * Creates a human readable report of the snapshot.
+     * @param maxResources is the number of resources listed, largest first.
+     */
+    static String Report(const MemorySnapshot& snapshot, int maxResources = 20);
+
+    /** Writes all records of the snapshot to a csv file. @return False if the file can't be written. */
+    static bool Export(const MemorySnapshot& snapshot, const String& file);
+  };
+
+} // namespace ToolKit
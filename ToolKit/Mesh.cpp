@@ -141,7 +141,8 @@ namespace ToolKit
     {
       if (m_vboVertexId)
       {
-        Stats::RemoveVRAMUsageInBytes(GetVertexSize() * m_vertexCount);
+        // Streamed meshes allocate for their capacity.
+        Stats::RemoveVRAMUsageInBytes(GetVertexSize() * (uint64) glm::max(m_vertexCount, m_vertexCapacity));
       }
 
       if (m_vboIndexId)
@@ -154,10 +155,11 @@ namespace ToolKit
       glDeleteVertexArrays(1, &m_vaoId);
       RHI::BindVertexArray(0); // Of the deleted vao is set, remove it from RHI cache
     }
-    m_vboVertexId = 0;
-    m_vboIndexId  = 0;
+    m_vboVertexId    = 0;
+    m_vboIndexId     = 0;
+    m_vertexCapacity = 0;
 
-    m_vaoId       = 0;
+    m_vaoId          = 0;
 
     m_subMeshes.clear();
 
@@ -244,6 +246,42 @@ namespace ToolKit
 
   uint Mesh::GetVertexCount() const { return (uint) m_clientSideVertices.size(); }
 
+  uint64 Mesh::GetCpuMemory() const
+  {
+    uint64 memory  = m_clientSideVertices.capacity() * sizeof(Vertex);
+    memory        += m_clientSideIndices.capacity() * sizeof(uint);
+    memory        += m_faces.capacity() * sizeof(Face);
+
+    for (const MeshPtr& subMesh : m_subMeshes)
+    {
+      memory += subMesh->GetCpuMemory();
+    }
+
+    return memory;
+  }
+
+  uint64 Mesh::GetGpuMemory() const
+  {
+    // Matches the sizes reported to the vram usage.
+    uint64 memory = 0;
+    if (m_vboVertexId != 0)
+    {
+      memory += (uint64) GetVertexSize() * (uint64) glm::max(m_vertexCount, m_vertexCapacity);
+    }
+
+    if (m_vboIndexId != 0)
+    {
+      memory += sizeof(uint) * (uint64) m_indexCount;
+    }
+
+    for (const MeshPtr& subMesh : m_subMeshes)
+    {
+      memory += subMesh->GetGpuMemory();
+    }
+
+    return memory;
+  }
+
   bool Mesh::IsSkinned() const { return false; }
 
   void Mesh::CalculateAABB()
@@ -621,12 +659,13 @@ namespace ToolKit
   {
     if (m_vboVertexId != 0)
     {
-      Stats::RemoveVRAMUsageInBytes(GetVertexSize() * m_vertexCount);
+      Stats::RemoveVRAMUsageInBytes(GetVertexSize() * (uint64) glm::max(m_vertexCount, m_vertexCapacity));
     }
 
     glDeleteBuffers(1, &m_vboVertexId);
     glDeleteVertexArrays(1, &m_vaoId);
     RHI::BindVertexArray(0); // Of the deleted vao is set, remove it from RHI cache
+    m_vertexCapacity = 0;
 
     if (!m_clientSideVertices.empty())
     {
@@ -651,6 +690,48 @@ namespace ToolKit
     }
   }
 
+  void Mesh::StreamVertices()
+  {
+    uint vertexCount = (uint) m_clientSideVertices.size();
+    int vertexSize   = GetVertexSize();
+
+    if (m_vboVertexId == 0 || vertexCount > m_vertexCapacity)
+    {
+      if (m_vboVertexId != 0)
+      {
+        Stats::RemoveVRAMUsageInBytes(vertexSize * (uint64) glm::max(m_vertexCount, m_vertexCapacity));
+        glDeleteBuffers(1, &m_vboVertexId);
+        glDeleteVertexArrays(1, &m_vaoId);
+        RHI::BindVertexArray(0);
+      }
+
+      // Grow geometrically to avoid reallocating for small changes.
+      m_vertexCapacity = glm::max(vertexCount + vertexCount / 2, 64u);
+
+      glGenVertexArrays(1, &m_vaoId);
+      RHI::BindVertexArray(m_vaoId);
+
+      glGenBuffers(1, &m_vboVertexId);
+      glBindBuffer(GL_ARRAY_BUFFER, m_vboVertexId);
+      glBufferData(GL_ARRAY_BUFFER, vertexSize * m_vertexCapacity, nullptr, GL_DYNAMIC_DRAW);
+      SetVertexLayout(m_vertexLayout);
+
+      Stats::AddVRAMUsageInBytes(vertexSize * (uint64) m_vertexCapacity);
+    }
+    else
+    {
+      glBindBuffer(GL_ARRAY_BUFFER, m_vboVertexId);
+    }
+
+    if (vertexCount > 0)
+    {
+      glBufferSubData(GL_ARRAY_BUFFER, 0, vertexSize * vertexCount, m_clientSideVertices.data());
+    }
+
+    m_vertexCount = vertexCount;
+    m_initiated   = true;
+  }
+
   void Mesh::InitIndices(bool flush)
   {
     if (m_vboIndexId != 0)
@@ -765,9 +846,12 @@ namespace ToolKit
       indexes[i] = i;
     }
 
+    const Mat4* matrixPalette = skel->m_Tpose.m_matrixPalette.data();
+    Vec3Array skinnedPositions;
+
     std::for_each(indexes.begin(),
                   indexes.end(),
-                  [skel, boneMap, &AABBs, &meshes](uint index)
+                  [matrixPalette, &skinnedPositions, &AABBs, &meshes](uint index)
                   {
                     SkinMesh* m = (SkinMesh*) meshes[index];
                     if (m->m_clientSideVertices.empty())
@@ -775,18 +859,16 @@ namespace ToolKit
                       return;
                     }
 
+                    // Skin in parallel to a scratch buffer, then reduce the boundary without locking.
+                    int vertexCount = (int) m->m_clientSideVertices.size();
+                    skinnedPositions.resize(vertexCount);
+                    CPUSkinning(m->m_clientSideVertices.data(), vertexCount, matrixPalette, skinnedPositions.data());
+
                     BoundingBox& meshAABB = AABBs[index];
-                    Spinlock aabbWriteLock;
-
-                    std::for_each(TKExecBy(WorkerManager::FramePool),
-                                  m->m_clientSideVertices.begin(),
-                                  m->m_clientSideVertices.end(),
-                                  [skel, boneMap, &aabbWriteLock, &meshAABB](SkinVertex& v)
-                                  {
-                                    Vec3 skinnedPos = CPUSkinning(&v, skel, boneMap, false);
-                                    SpinlockGuard lock(aabbWriteLock);
-                                    meshAABB.UpdateBoundary(skinnedPos);
-                                  });
+                    for (int i = 0; i < vertexCount; i++)
+                    {
+                      meshAABB.UpdateBoundary(skinnedPositions[i]);
+                    }
                   });
 
     for (BoundingBox& aabb : AABBs)
@@ -837,6 +919,11 @@ namespace ToolKit
 
   int SkinMesh::GetVertexSize() const { return sizeof(SkinVertex); }
 
+  uint64 SkinMesh::GetCpuMemory() const
+  {
+    return Mesh::GetCpuMemory() + m_clientSideVertices.capacity() * sizeof(SkinVertex);
+  }
+
   bool SkinMesh::IsSkinned() const { return true; }
 
   void SkinMesh::InitVertices(bool flush)
@@ -116,6 +116,18 @@ namespace ToolKit
      */
     virtual int GetVertexSize() const;
 
+    /**
+     * @brief Calculates the cpu memory held by the client side arrays of the mesh and its submeshes.
+     * @return The memory in bytes.
+     */
+    uint64 GetCpuMemory() const override;
+
+    /**
+     * @brief Calculates the gpu memory held by the vertex and index buffers of the mesh and its submeshes.
+     * @return The memory in bytes.
+     */
+    uint64 GetGpuMemory() const override;
+
     /**
      * @brief Retrieves the total number of vertices in the mesh.
      *
@@ -212,6 +224,14 @@ namespace ToolKit
      */
     void SetMaterial(MaterialPtr material);
 
+    /**
+     * @brief Uploads client side vertices to a dynamic vertex buffer.
+     *
+     * Meant for meshes that are rebuilt frequently such as ui batches. The vertex buffer is kept and only grows,
+     * vertices are streamed in to it with a sub data update. Client side vertices are not flushed.
+     */
+    void StreamVertices();
+
    protected:
     XmlNode* SerializeImp(XmlDocument* doc, XmlNode* parent) const override;
     XmlNode* DeSerializeImp(const SerializationFileInfo& info, XmlNode* parent) override;
@@ -237,11 +257,12 @@ namespace ToolKit
    public:
     VertexArray m_clientSideVertices; //!< Array of vertices stored on the client side.
     UIntArray m_clientSideIndices;    //!< Array of indices stored on the client side.
-    uint m_vboVertexId = 0;           //!< ID of the vertex buffer object.
-    uint m_vboIndexId  = 0;           //!< ID of the index buffer object.
-    uint m_vaoId       = 0;           //!< ID of the vertex array object.
-    uint m_vertexCount = 0;           //!< Count of vertices.
-    uint m_indexCount  = 0;           //!< Count of indices.
+    uint m_vboVertexId    = 0;        //!< ID of the vertex buffer object.
+    uint m_vboIndexId     = 0;        //!< ID of the index buffer object.
+    uint m_vaoId          = 0;        //!< ID of the vertex array object.
+    uint m_vertexCount    = 0;        //!< Count of vertices.
+    uint m_indexCount     = 0;        //!< Count of indices.
+    uint m_vertexCapacity = 0;        //!< Vertex count that the streamed vertex buffer can hold.
     MaterialPtr m_material;           //!< Pointer to the material used by the mesh.
     MeshPtrArray m_subMeshes;         //!< Array of pointers to submeshes.
     BoundingBox m_boundingBox;        //!< Bounding box of the mesh.
@@ -346,6 +367,12 @@ namespace ToolKit
      */
     int GetVertexSize() const override;
 
+    /**
+     * @brief Calculates the cpu memory held by the client side arrays, including the skinned vertices.
+     * @return The memory in bytes.
+     */
+    uint64 GetCpuMemory() const override;
+
     /**
      * @brief Determines if the mesh is a skin mesh.
      *
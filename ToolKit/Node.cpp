@@ -8,15 +8,21 @@
 #include "Node.h"
 
 #include "MathUtil.h"
+#include "ObjectPool.h"
 #include "Scene.h"
 #include "ToolKit.h"
 #include "Util.h"
 
+#include <atomic>
+
 #include "DebugNew.h"
 
 namespace ToolKit
 {
 
+  /** Incremented on every parent change of any node. */
+  static std::atomic<uint64> g_hierarchyRevision = 0;
+
   Node::Node() : m_scale(Vec3(1.0f))
   {
     m_id           = GetHandleManager()->GenerateHandle();
@@ -39,6 +45,50 @@ namespace ToolKit
     }
   }
 
+#pragma push_macro("new")
+#undef new
+
+  /** Pool of all nodes. Never destroyed, nodes may be released during the static destruction. */
+  static ObjectPool& GetNodePool()
+  {
+    static ObjectPool* pool = new ObjectPool(sizeof(Node), 1024);
+    return *pool;
+  }
+
+  void* Node::operator new(size_t size)
+  {
+    // Allocations of a different size come from derived types.
+    if (void* memory = GetNodePool().Allocate(size))
+    {
+      return memory;
+    }
+
+    return ::operator new(size);
+  }
+
+  void Node::operator delete(void* memory, size_t size)
+  {
+    if (GetNodePool().IsPooled(size))
+    {
+      GetNodePool().Free(memory);
+    }
+    else
+    {
+      ::operator delete(memory);
+    }
+  }
+
+#ifdef _MSC_VER
+  void* Node::operator new(size_t size, int blockType, const char* file, int line) { return operator new(size); }
+
+  void Node::operator delete(void* memory, int blockType, const char* file, int line)
+  {
+    operator delete(memory, sizeof(Node));
+  }
+#endif
+
+#pragma pop_macro("new")
+
   void Node::Translate(const Vec3& val, TransformationSpace space)
   {
     Vec3 adjustedVal = val;
@@ -183,6 +233,7 @@ namespace ToolKit
 
     m_children.insert(m_children.begin() + index, child);
     child->m_parent = this;
+    g_hierarchyRevision++;
     child->m_dirty  = true;
     child->SetChildrenDirty();
 
@@ -221,6 +272,7 @@ namespace ToolKit
     child->m_dirty  = true;
     child->SetChildrenDirty();
     m_children.erase(m_children.begin() + index);
+    g_hierarchyRevision++;
 
     if (preserveTransform)
     {
@@ -259,6 +311,8 @@ namespace ToolKit
     }
   }
 
+  uint64 Node::GetHierarchyRevision() { return g_hierarchyRevision; }
+
   Node* Node::GetRoot() const
   {
     if (m_parent == nullptr)
@@ -34,6 +34,16 @@ namespace ToolKit
     Node();
     ~Node();
 
+    /** Nodes are allocated from a pool, which keeps the transforms of the scene close in memory. */
+    static void* operator new(size_t size);
+    static void operator delete(void* memory, size_t size);
+
+#ifdef _MSC_VER
+    /** Debug allocation form used by DebugNew.h. */
+    static void* operator new(size_t size, int blockType, const char* file, int line);
+    static void operator delete(void* memory, int blockType, const char* file, int line);
+#endif
+
     /**
      * Apply translation to the node in given space.
      * @param val the delta vector for translation.
@@ -167,6 +177,12 @@ namespace ToolKit
      */
     void OrphanSelf(bool preserveTransform = false);
 
+    /**
+     * Returns a counter that is incremented each time a node is added to or removed from a parent.
+     * Views caching the hierarchy compare it against their last seen value to know when to rebuild.
+     */
+    static uint64 GetHierarchyRevision();
+
     /**
      * Finds the root node.
      * @return the furthest parent node which doesn't have a parent.
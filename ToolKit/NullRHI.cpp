@@ -0,0 +1,696 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "NullRHI.h"
+
+#include "TKOpenGL.h"
+
+#include <unordered_set>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+#if !defined(TK_ANDROID) && !defined(TK_WEB)
+
+  namespace
+  {
+
+    // Null Gl State
+    //////////////////////////////////////////
+
+    struct NullGlState
+    {
+      GLuint nextHandle     = 1;
+      GLuint activeTexture  = 0;
+      GLuint currentProgram = 0;
+      GLuint renderbuffer   = 0;
+
+      std::unordered_map<GLenum, GLuint> boundBuffers;  //!< Buffer bound to each target.
+      std::unordered_map<uint64, GLuint> boundTextures; //!< Texture bound to each unit and target pair.
+
+      std::unordered_map<GLuint, uint64> buffers;       //!< Buffer handles to their sizes.
+      std::unordered_map<GLuint, uint64> renderbuffers; //!< Render buffer handles to their sizes.
+
+      /** Texture handles to the sizes of their images. Images are keyed by target and mip level. */
+      std::unordered_map<GLuint, std::unordered_map<uint64, uint64>> textures;
+
+      std::unordered_set<GLuint> framebuffers;
+      std::unordered_set<GLuint> vertexArrays;
+      std::unordered_set<GLuint> shaders;
+      std::unordered_set<GLuint> programs;
+      std::unordered_set<GLuint> queries;
+
+      uint64 bufferMemory       = 0;
+      uint64 textureMemory      = 0;
+      uint64 renderbufferMemory = 0;
+    };
+
+    NullGlState g_nullGl;
+
+    uint64 BytesOfInternalFormat(GLenum internalFormat)
+    {
+      switch (internalFormat)
+      {
+      case GL_DEPTH_COMPONENT16:
+        return 2;
+      case GL_DEPTH_COMPONENT24:
+      case GL_DEPTH24_STENCIL8:
+      case GL_DEPTH_COMPONENT32F:
+        return 4;
+      case GL_DEPTH32F_STENCIL8:
+        return 8;
+      default:
+        return (uint64) BytesOfFormat((GraphicTypes) internalFormat);
+      }
+    }
+
+    uint64 BytesOfPixelData(GLenum format, GLenum type)
+    {
+      uint64 components = 4;
+      switch (format)
+      {
+      case GL_RED:
+      case GL_DEPTH_COMPONENT:
+        components = 1;
+        break;
+      case GL_RG:
+        components = 2;
+        break;
+      case GL_RGB:
+        components = 3;
+        break;
+      }
+
+      switch (type)
+      {
+      case GL_UNSIGNED_BYTE:
+        return components;
+      case GL_HALF_FLOAT:
+        return components * 2;
+      default:
+        return components * 4;
+      }
+    }
+
+    /** Cube map faces are bound to the cube map target. */
+    GLenum BindingTarget(GLenum target)
+    {
+      if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+      {
+        return GL_TEXTURE_CUBE_MAP;
+      }
+
+      return target;
+    }
+
+    uint64 TextureBindingKey(GLuint unit, GLenum target) { return ((uint64) unit << 32) | (uint64) target; }
+
+    uint64 TextureImageKey(GLenum target, GLint level) { return ((uint64) target << 32) | (uint64) (uint) level; }
+
+    GLuint BoundTexture(GLenum target)
+    {
+      auto binding = g_nullGl.boundTextures.find(TextureBindingKey(g_nullGl.activeTexture, BindingTarget(target)));
+      return binding == g_nullGl.boundTextures.end() ? 0 : binding->second;
+    }
+
+    void SetTextureImage(GLenum target, GLint level, uint64 bytes)
+    {
+      auto texture = g_nullGl.textures.find(BoundTexture(target));
+      if (texture == g_nullGl.textures.end())
+      {
+        return;
+      }
+
+      uint64& imageBytes      = texture->second[TextureImageKey(target, level)];
+      g_nullGl.textureMemory -= imageBytes;
+      imageBytes              = bytes;
+      g_nullGl.textureMemory += imageBytes;
+    }
+
+    void GenHandles(GLsizei n, GLuint* handles, std::unordered_set<GLuint>& objects)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        handles[i] = g_nullGl.nextHandle++;
+        objects.insert(handles[i]);
+      }
+    }
+
+    void DeleteHandles(GLsizei n, const GLuint* handles, std::unordered_set<GLuint>& objects)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        objects.erase(handles[i]);
+      }
+    }
+
+    // Resources
+    //////////////////////////////////////////
+
+    void GLAD_API_PTR NullGenBuffers(GLsizei n, GLuint* buffers)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        buffers[i]                   = g_nullGl.nextHandle++;
+        g_nullGl.buffers[buffers[i]] = 0;
+      }
+    }
+
+    void GLAD_API_PTR NullDeleteBuffers(GLsizei n, const GLuint* buffers)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        auto buffer = g_nullGl.buffers.find(buffers[i]);
+        if (buffer != g_nullGl.buffers.end())
+        {
+          g_nullGl.bufferMemory -= buffer->second;
+          g_nullGl.buffers.erase(buffer);
+        }
+
+        for (auto& binding : g_nullGl.boundBuffers)
+        {
+          if (binding.second == buffers[i])
+          {
+            binding.second = 0;
+          }
+        }
+      }
+    }
+
+    void GLAD_API_PTR NullBindBuffer(GLenum target, GLuint buffer) { g_nullGl.boundBuffers[target] = buffer; }
+
+    void GLAD_API_PTR NullBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+      g_nullGl.boundBuffers[target] = buffer;
+    }
+
+    void GLAD_API_PTR NullBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+      auto buffer = g_nullGl.buffers.find(g_nullGl.boundBuffers[target]);
+      if (buffer != g_nullGl.buffers.end())
+      {
+        g_nullGl.bufferMemory -= buffer->second;
+        buffer->second         = (uint64) size;
+        g_nullGl.bufferMemory += buffer->second;
+      }
+    }
+
+    void GLAD_API_PTR NullGenTextures(GLsizei n, GLuint* textures)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        textures[i] = g_nullGl.nextHandle++;
+        g_nullGl.textures[textures[i]].clear();
+      }
+    }
+
+    void GLAD_API_PTR NullDeleteTextures(GLsizei n, const GLuint* textures)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        auto texture = g_nullGl.textures.find(textures[i]);
+        if (texture != g_nullGl.textures.end())
+        {
+          for (auto& image : texture->second)
+          {
+            g_nullGl.textureMemory -= image.second;
+          }
+          g_nullGl.textures.erase(texture);
+        }
+
+        for (auto& binding : g_nullGl.boundTextures)
+        {
+          if (binding.second == textures[i])
+          {
+            binding.second = 0;
+          }
+        }
+      }
+    }
+
+    void GLAD_API_PTR NullActiveTexture(GLenum texture) { g_nullGl.activeTexture = texture - GL_TEXTURE0; }
+
+    void GLAD_API_PTR NullBindTexture(GLenum target, GLuint texture)
+    {
+      g_nullGl.boundTextures[TextureBindingKey(g_nullGl.activeTexture, target)] = texture;
+    }
+
+    void GLAD_API_PTR NullTexImage2D(GLenum target,
+                                     GLint level,
+                                     GLint internalformat,
+                                     GLsizei width,
+                                     GLsizei height,
+                                     GLint border,
+                                     GLenum format,
+                                     GLenum type,
+                                     const void* pixels)
+    {
+      SetTextureImage(target, level, (uint64) width * height * BytesOfInternalFormat((GLenum) internalformat));
+    }
+
+    void GLAD_API_PTR NullCompressedTexImage2D(GLenum target,
+                                               GLint level,
+                                               GLenum internalformat,
+                                               GLsizei width,
+                                               GLsizei height,
+                                               GLint border,
+                                               GLsizei imageSize,
+                                               const void* data)
+    {
+      SetTextureImage(target, level, (uint64) imageSize);
+    }
+
+    void GLAD_API_PTR NullTexStorage3D(GLenum target,
+                                       GLsizei levels,
+                                       GLenum internalformat,
+                                       GLsizei width,
+                                       GLsizei height,
+                                       GLsizei depth)
+    {
+      uint64 bytesPerPixel = BytesOfInternalFormat(internalformat);
+      for (GLsizei level = 0; level < levels; level++)
+      {
+        uint64 levelWidth  = (uint64) glm::max(1, width >> level);
+        uint64 levelHeight = (uint64) glm::max(1, height >> level);
+        SetTextureImage(target, level, levelWidth * levelHeight * depth * bytesPerPixel);
+      }
+    }
+
+    void GLAD_API_PTR NullGenerateMipmap(GLenum target)
+    {
+      auto texture = g_nullGl.textures.find(BoundTexture(target));
+      if (texture == g_nullGl.textures.end())
+      {
+        return;
+      }
+
+      // Each base image gets a mip chain, where every level is a quarter of the previous one.
+      std::vector<std::pair<GLenum, uint64>> baseImages;
+      for (auto& image : texture->second)
+      {
+        if ((image.first & 0xFFFFFFFF) == 0)
+        {
+          baseImages.push_back({(GLenum) (image.first >> 32), image.second});
+        }
+      }
+
+      for (auto& image : baseImages)
+      {
+        GLint level = 1;
+        for (uint64 bytes = image.second >> 2; bytes > 0; bytes >>= 2)
+        {
+          SetTextureImage(image.first, level++, bytes);
+        }
+      }
+    }
+
+    void GLAD_API_PTR NullGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        renderbuffers[i]                         = g_nullGl.nextHandle++;
+        g_nullGl.renderbuffers[renderbuffers[i]] = 0;
+      }
+    }
+
+    void GLAD_API_PTR NullDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+    {
+      for (GLsizei i = 0; i < n; i++)
+      {
+        auto renderbuffer = g_nullGl.renderbuffers.find(renderbuffers[i]);
+        if (renderbuffer != g_nullGl.renderbuffers.end())
+        {
+          g_nullGl.renderbufferMemory -= renderbuffer->second;
+          g_nullGl.renderbuffers.erase(renderbuffer);
+        }
+
+        if (g_nullGl.renderbuffer == renderbuffers[i])
+        {
+          g_nullGl.renderbuffer = 0;
+        }
+      }
+    }
+
+    void GLAD_API_PTR NullBindRenderbuffer(GLenum target, GLuint renderbuffer)
+    {
+      g_nullGl.renderbuffer = renderbuffer;
+    }
+
+    void GLAD_API_PTR NullRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+    {
+      auto renderbuffer = g_nullGl.renderbuffers.find(g_nullGl.renderbuffer);
+      if (renderbuffer != g_nullGl.renderbuffers.end())
+      {
+        g_nullGl.renderbufferMemory -= renderbuffer->second;
+        renderbuffer->second         = (uint64) width * height * BytesOfInternalFormat(internalformat);
+        g_nullGl.renderbufferMemory += renderbuffer->second;
+      }
+    }
+
+    void GLAD_API_PTR NullGenFramebuffers(GLsizei n, GLuint* framebuffers)
+    {
+      GenHandles(n, framebuffers, g_nullGl.framebuffers);
+    }
+
+    void GLAD_API_PTR NullDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+    {
+      DeleteHandles(n, framebuffers, g_nullGl.framebuffers);
+    }
+
+    void GLAD_API_PTR NullGenVertexArrays(GLsizei n, GLuint* arrays) { GenHandles(n, arrays, g_nullGl.vertexArrays); }
+
+    void GLAD_API_PTR NullDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+    {
+      DeleteHandles(n, arrays, g_nullGl.vertexArrays);
+    }
+
+    void GLAD_API_PTR NullGenQueries(GLsizei n, GLuint* ids) { GenHandles(n, ids, g_nullGl.queries); }
+
+    void GLAD_API_PTR NullDeleteQueries(GLsizei n, const GLuint* ids) { DeleteHandles(n, ids, g_nullGl.queries); }
+
+    // Shaders
+    //////////////////////////////////////////
+
+    GLuint GLAD_API_PTR NullCreateShader(GLenum type)
+    {
+      GLuint shader = g_nullGl.nextHandle++;
+      g_nullGl.shaders.insert(shader);
+      return shader;
+    }
+
+    void GLAD_API_PTR NullDeleteShader(GLuint shader) { g_nullGl.shaders.erase(shader); }
+
+    GLuint GLAD_API_PTR NullCreateProgram()
+    {
+      GLuint program = g_nullGl.nextHandle++;
+      g_nullGl.programs.insert(program);
+      return program;
+    }
+
+    void GLAD_API_PTR NullDeleteProgram(GLuint program) { g_nullGl.programs.erase(program); }
+
+    void GLAD_API_PTR NullUseProgram(GLuint program) { g_nullGl.currentProgram = program; }
+
+    void GLAD_API_PTR NullGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+    {
+      *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+    }
+
+    void GLAD_API_PTR NullGetProgramiv(GLuint program, GLenum pname, GLint* params)
+    {
+      *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+    }
+
+    void GLAD_API_PTR NullGetInfoLog(GLuint object, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+    {
+      if (length != nullptr)
+      {
+        *length = 0;
+      }
+
+      if (bufSize > 0)
+      {
+        infoLog[0] = '\0';
+      }
+    }
+
+    // There are no active uniforms, uniform updates are skipped by the callers.
+    GLint GLAD_API_PTR NullGetUniformLocation(GLuint program, const GLchar* name) { return -1; }
+
+    GLuint GLAD_API_PTR NullGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName)
+    {
+      return GL_INVALID_INDEX;
+    }
+
+    // Queries
+    //////////////////////////////////////////
+
+    const GLubyte* GLAD_API_PTR NullGetString(GLenum name)
+    {
+      switch (name)
+      {
+      case GL_VENDOR:
+        return (const GLubyte*) "OtSoftware";
+      case GL_RENDERER:
+        return (const GLubyte*) "ToolKit Null RHI";
+      case GL_VERSION:
+        return (const GLubyte*) "OpenGL ES 3.2 Null";
+      case GL_SHADING_LANGUAGE_VERSION:
+        return (const GLubyte*) "OpenGL ES GLSL ES 3.20";
+      default:
+        return (const GLubyte*) "";
+      }
+    }
+
+    void GLAD_API_PTR NullGetIntegerv(GLenum pname, GLint* data)
+    {
+      switch (pname)
+      {
+      case GL_CURRENT_PROGRAM:
+        *data = (GLint) g_nullGl.currentProgram;
+        break;
+      case GL_MAX_ARRAY_TEXTURE_LAYERS:
+        *data = 256;
+        break;
+      case GL_MAX_TEXTURE_SIZE:
+        *data = 16384;
+        break;
+      default:
+        *data = 0;
+        break;
+      }
+    }
+
+    void GLAD_API_PTR NullGetFloatv(GLenum pname, GLfloat* data) { *data = 0.0f; }
+
+    void GLAD_API_PTR NullGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) { *params = 0; }
+
+    GLenum GLAD_API_PTR NullGetError() { return GL_NO_ERROR; }
+
+    GLenum GLAD_API_PTR NullCheckFramebufferStatus(GLenum target) { return GL_FRAMEBUFFER_COMPLETE; }
+
+    void GLAD_API_PTR
+    NullReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+    {
+      memset(pixels, 0, (size_t) width * height * BytesOfPixelData(format, type));
+    }
+
+    // No-op Functions
+    //////////////////////////////////////////
+
+    void GLAD_API_PTR NullEnum(GLenum) {}
+
+    void GLAD_API_PTR NullEnum2(GLenum, GLenum) {}
+
+    void GLAD_API_PTR NullEnum3(GLenum, GLenum, GLenum) {}
+
+    void GLAD_API_PTR NullUint(GLuint) {}
+
+    void GLAD_API_PTR NullUint2(GLuint, GLuint) {}
+
+    void GLAD_API_PTR NullUint3(GLuint, GLuint, GLuint) {}
+
+    void GLAD_API_PTR NullFloat(GLfloat) {}
+
+    void GLAD_API_PTR NullBool(GLboolean) {}
+
+    void GLAD_API_PTR NullBool4(GLboolean, GLboolean, GLboolean, GLboolean) {}
+
+    void GLAD_API_PTR NullFloat4(GLfloat, GLfloat, GLfloat, GLfloat) {}
+
+    void GLAD_API_PTR NullRect(GLint, GLint, GLsizei, GLsizei) {}
+
+    void GLAD_API_PTR NullEnumUint(GLenum, GLuint) {}
+
+    void GLAD_API_PTR NullEnumIntUint(GLenum, GLint, GLuint) {}
+
+    void GLAD_API_PTR NullSizeEnums(GLsizei, const GLenum*) {}
+
+    void GLAD_API_PTR NullEnumSizeEnums(GLenum, GLsizei, const GLenum*) {}
+
+    void GLAD_API_PTR NullBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+
+    void GLAD_API_PTR NullCopyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr) {}
+
+    void GLAD_API_PTR NullTexParameterf(GLenum, GLenum, GLfloat) {}
+
+    void GLAD_API_PTR NullTexParameteri(GLenum, GLenum, GLint) {}
+
+    void GLAD_API_PTR
+    NullTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*)
+    {
+    }
+
+    void GLAD_API_PTR NullCopyTexSubImage2D(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei) {}
+
+    void GLAD_API_PTR NullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+
+    void GLAD_API_PTR NullFramebufferTextureLayer(GLenum, GLenum, GLuint, GLint, GLint) {}
+
+    void GLAD_API_PTR NullFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) {}
+
+    void GLAD_API_PTR
+    NullBlitFramebuffer(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum)
+    {
+    }
+
+    void GLAD_API_PTR NullShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+
+    void GLAD_API_PTR NullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+
+    void GLAD_API_PTR NullDrawArrays(GLenum, GLint, GLsizei) {}
+
+    void GLAD_API_PTR NullDrawElements(GLenum, GLsizei, GLenum, const void*) {}
+
+    void GLAD_API_PTR NullUniform1f(GLint, GLfloat) {}
+
+    void GLAD_API_PTR NullUniform1i(GLint, GLint) {}
+
+    void GLAD_API_PTR NullUniform1ui(GLint, GLuint) {}
+
+    void GLAD_API_PTR NullUniformiv(GLint, GLsizei, const GLint*) {}
+
+    void GLAD_API_PTR NullUniformfv(GLint, GLsizei, const GLfloat*) {}
+
+    void GLAD_API_PTR NullUniformMatrixfv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+
+    // Function Table
+    //////////////////////////////////////////
+
+    const std::unordered_map<String, void*> g_nullGlFunctions = {
+        {"glActiveTexture",            (void*) &NullActiveTexture          },
+        {"glAttachShader",             (void*) &NullUint2                  },
+        {"glBeginQuery",               (void*) &NullEnumUint               },
+        {"glBindBuffer",               (void*) &NullBindBuffer             },
+        {"glBindBufferBase",           (void*) &NullBindBufferBase         },
+        {"glBindFramebuffer",          (void*) &NullEnumUint               },
+        {"glBindRenderbuffer",         (void*) &NullBindRenderbuffer       },
+        {"glBindTexture",              (void*) &NullBindTexture            },
+        {"glBindVertexArray",          (void*) &NullUint                   },
+        {"glBlendEquation",            (void*) &NullEnum                   },
+        {"glBlendFunc",                (void*) &NullEnum2                  },
+        {"glBlitFramebuffer",          (void*) &NullBlitFramebuffer        },
+        {"glBufferData",               (void*) &NullBufferData             },
+        {"glBufferSubData",            (void*) &NullBufferSubData          },
+        {"glCheckFramebufferStatus",   (void*) &NullCheckFramebufferStatus },
+        {"glClear",                    (void*) &NullUint                   },
+        {"glClearColor",               (void*) &NullFloat4                 },
+        {"glClearDepthf",              (void*) &NullFloat                  },
+        {"glColorMask",                (void*) &NullBool4                  },
+        {"glCompileShader",            (void*) &NullUint                   },
+        {"glCompressedTexImage2D",     (void*) &NullCompressedTexImage2D   },
+        {"glCopyBufferSubData",        (void*) &NullCopyBufferSubData      },
+        {"glCopyTexSubImage2D",        (void*) &NullCopyTexSubImage2D      },
+        {"glCreateProgram",            (void*) &NullCreateProgram          },
+        {"glCreateShader",             (void*) &NullCreateShader           },
+        {"glCullFace",                 (void*) &NullEnum                   },
+        {"glDeleteBuffers",            (void*) &NullDeleteBuffers          },
+        {"glDeleteFramebuffers",       (void*) &NullDeleteFramebuffers     },
+        {"glDeleteProgram",            (void*) &NullDeleteProgram          },
+        {"glDeleteQueries",            (void*) &NullDeleteQueries          },
+        {"glDeleteRenderbuffers",      (void*) &NullDeleteRenderbuffers    },
+        {"glDeleteShader",             (void*) &NullDeleteShader           },
+        {"glDeleteTextures",           (void*) &NullDeleteTextures         },
+        {"glDeleteVertexArrays",       (void*) &NullDeleteVertexArrays     },
+        {"glDepthFunc",                (void*) &NullEnum                   },
+        {"glDepthMask",                (void*) &NullBool                   },
+        {"glDetachShader",             (void*) &NullUint2                  },
+        {"glDisable",                  (void*) &NullEnum                   },
+        {"glDisableVertexAttribArray", (void*) &NullUint                   },
+        {"glDrawArrays",               (void*) &NullDrawArrays             },
+        {"glDrawBuffers",              (void*) &NullSizeEnums              },
+        {"glDrawElements",             (void*) &NullDrawElements           },
+        {"glEnable",                   (void*) &NullEnum                   },
+        {"glEnableVertexAttribArray",  (void*) &NullUint                   },
+        {"glEndQuery",                 (void*) &NullEnum                   },
+        {"glFramebufferRenderbuffer",  (void*) &NullFramebufferRenderbuffer},
+        {"glFramebufferTexture2D",     (void*) &NullFramebufferTexture2D   },
+        {"glFramebufferTextureLayer",  (void*) &NullFramebufferTextureLayer},
+        {"glGenBuffers",               (void*) &NullGenBuffers             },
+        {"glGenFramebuffers",          (void*) &NullGenFramebuffers        },
+        {"glGenQueries",               (void*) &NullGenQueries             },
+        {"glGenRenderbuffers",         (void*) &NullGenRenderbuffers       },
+        {"glGenTextures",              (void*) &NullGenTextures            },
+        {"glGenVertexArrays",          (void*) &NullGenVertexArrays        },
+        {"glGenerateMipmap",           (void*) &NullGenerateMipmap         },
+        {"glGetError",                 (void*) &NullGetError               },
+        {"glGetFloatv",                (void*) &NullGetFloatv              },
+        {"glGetIntegerv",              (void*) &NullGetIntegerv            },
+        {"glGetProgramInfoLog",        (void*) &NullGetInfoLog             },
+        {"glGetProgramiv",             (void*) &NullGetProgramiv           },
+        {"glGetQueryObjectuiv",        (void*) &NullGetQueryObjectuiv      },
+        {"glGetShaderInfoLog",         (void*) &NullGetInfoLog             },
+        {"glGetShaderiv",              (void*) &NullGetShaderiv            },
+        {"glGetString",                (void*) &NullGetString              },
+        {"glGetUniformBlockIndex",     (void*) &NullGetUniformBlockIndex   },
+        {"glGetUniformLocation",       (void*) &NullGetUniformLocation     },
+        {"glInvalidateFramebuffer",    (void*) &NullEnumSizeEnums          },
+        {"glLineWidth",                (void*) &NullFloat                  },
+        {"glLinkProgram",              (void*) &NullUint                   },
+        {"glReadPixels",               (void*) &NullReadPixels             },
+        {"glRenderbufferStorage",      (void*) &NullRenderbufferStorage    },
+        {"glScissor",                  (void*) &NullRect                   },
+        {"glShaderSource",             (void*) &NullShaderSource           },
+        {"glStencilFunc",              (void*) &NullEnumIntUint            },
+        {"glStencilMask",              (void*) &NullUint                   },
+        {"glStencilOp",                (void*) &NullEnum3                  },
+        {"glTexImage2D",               (void*) &NullTexImage2D             },
+        {"glTexParameterf",            (void*) &NullTexParameterf          },
+        {"glTexParameteri",            (void*) &NullTexParameteri          },
+        {"glTexStorage3D",             (void*) &NullTexStorage3D           },
+        {"glTexSubImage2D",            (void*) &NullTexSubImage2D          },
+        {"glUniform1f",                (void*) &NullUniform1f              },
+        {"glUniform1i",                (void*) &NullUniform1i              },
+        {"glUniform1iv",               (void*) &NullUniformiv              },
+        {"glUniform1ui",               (void*) &NullUniform1ui             },
+        {"glUniform2fv",               (void*) &NullUniformfv              },
+        {"glUniform3fv",               (void*) &NullUniformfv              },
+        {"glUniform4fv",               (void*) &NullUniformfv              },
+        {"glUniformBlockBinding",      (void*) &NullUint3                  },
+        {"glUniformMatrix3fv",         (void*) &NullUniformMatrixfv        },
+        {"glUniformMatrix4fv",         (void*) &NullUniformMatrixfv        },
+        {"glUseProgram",               (void*) &NullUseProgram             },
+        {"glVertexAttribPointer",      (void*) &NullVertexAttribPointer    },
+        {"glViewport",                 (void*) &NullRect                   }
+    };
+
+  } // namespace
+
+  void* NullRHI::GetProcAddress(const char* name)
+  {
+    auto function = g_nullGlFunctions.find(name);
+    return function == g_nullGlFunctions.end() ? nullptr : function->second;
+  }
+
+  NullRHIStats NullRHI::GetStats()
+  {
+    NullRHIStats stats;
+    stats.bufferCount        = (int) g_nullGl.buffers.size();
+    stats.textureCount       = (int) g_nullGl.textures.size();
+    stats.renderbufferCount  = (int) g_nullGl.renderbuffers.size();
+    stats.framebufferCount   = (int) g_nullGl.framebuffers.size();
+    stats.vertexArrayCount   = (int) g_nullGl.vertexArrays.size();
+    stats.shaderCount        = (int) g_nullGl.shaders.size();
+    stats.programCount       = (int) g_nullGl.programs.size();
+    stats.bufferMemory       = g_nullGl.bufferMemory;
+    stats.textureMemory      = g_nullGl.textureMemory;
+    stats.renderbufferMemory = g_nullGl.renderbufferMemory;
+
+    return stats;
+  }
+
+#else
+
+  void* NullRHI::GetProcAddress(const char* name) { return nullptr; }
+
+  NullRHIStats NullRHI::GetStats() { return NullRHIStats(); }
+
+#endif
+
+} // namespace ToolKit
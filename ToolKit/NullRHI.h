@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /** Live gpu resources and their memory sizes as recorded by the null backend. */
+  struct NullRHIStats
+  {
+    int bufferCount           = 0; //!< Number of live buffer objects.
+    int textureCount          = 0; //!< Number of live texture objects.
+    int renderbufferCount     = 0; //!< Number of live render buffer objects.
+    int framebufferCount      = 0; //!< Number of live frame buffer objects.
+    int vertexArrayCount      = 0; //!< Number of live vertex array objects.
+    int shaderCount           = 0; //!< Number of live shader objects.
+    int programCount          = 0; //!< Number of live program objects.
+    uint64 bufferMemory       = 0; //!< Bytes allocated for buffer objects.
+    uint64 textureMemory      = 0; //!< Bytes allocated for all mip levels, faces and layers of textures.
+    uint64 renderbufferMemory = 0; //!< Bytes allocated for render buffer storages.
+  };
+
+  /**
+   * Gpu less backend for headless runs such as dedicated servers, ci machines and benchmarks. Provides no-op
+   * implementations of the opengl functions used by the engine. Object handles are generated and resource memory sizes
+   * are recorded, but no call reaches a driver. Loaded in place of the platform functions when Main::m_headless is set.
+   * Only available on platforms that load opengl through glad.
+   */
+  class TK_API NullRHI
+  {
+   public:
+    /**
+     * Provides the null implementation of an opengl function. Can be used as a glad loader.
+     * @param name is the name of the opengl function.
+     * @return Address of the null implementation or nullptr if the function is not provided.
+     */
+    static void* GetProcAddress(const char* name);
+
+    /** @return Live resource counts and memory sizes. */
+    static NullRHIStats GetStats();
+  };
+
+} // namespace ToolKit
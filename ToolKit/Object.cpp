@@ -67,7 +67,11 @@ namespace ToolKit
     GetHandleManager()->ReleaseHandle(id);
     m_localData.m_version = m_version;
     m_localData.DeSerialize(info, parent);
-    PreventIdCollision();
+
+    if (!info.DeferIdCollision)
+    {
+      PreventIdCollision();
+    }
 
     // Construction progress from bottom up.
     return parent;
@@ -95,15 +99,12 @@ namespace ToolKit
     HandleManager* handleMan = GetHandleManager();
     ObjectId idInFile        = GetIdVal();
 
-    if (!handleMan->IsHandleUnique(idInFile))
+    // Test and acquire at once, objects may be deserialized concurrently.
+    if (!handleMan->TryAddHandle(idInFile))
     {
       _idBeforeCollision = idInFile;
       SetIdVal(handleMan->GenerateHandle());
     }
-    else
-    {
-      handleMan->AddHandle(idInFile);
-    }
   }
 
 } // namespace ToolKit
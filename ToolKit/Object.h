@@ -187,6 +187,7 @@ namespace ToolKit
     void PreDeserializeImp(const SerializationFileInfo& info, XmlNode* parent) override;
     void PostDeSerializeImp(const SerializationFileInfo& info, XmlNode* parent) override;
 
+   public:
     /**
      * Utility function that checks if the current id is colliding with anything currently in the handle manager.
      * If a collision happens, it sets _idBeforeCollision with the colliding id to resolve parent - child relations
@@ -194,7 +195,6 @@ namespace ToolKit
      */
     void PreventIdCollision();
 
-   public:
     TKDeclareParam(ObjectId, Id);
 
     /**
@@ -12,6 +12,7 @@
 #include "Audio.h"
 #include "Camera.h"
 #include "Canvas.h"
+#include "Component.h"
 #include "DirectionComponent.h"
 #include "Dpad.h"
 #include "Drawable.h"
@@ -40,9 +41,25 @@
 namespace ToolKit
 {
 
-  ObjectFactory::ObjectFactory() {}
+  ObjectFactory::ObjectFactory() { m_pooledBaseClasses = {Entity::StaticClass(), Component::StaticClass()}; }
 
-  ObjectFactory::~ObjectFactory() {}
+  ObjectFactory::~ObjectFactory()
+  {
+    for (auto& pool : m_objectPools)
+    {
+      // Objects that outlive the factory return their memory to the pool, so it is left behind.
+      if (pool.second->GetLiveCount() == 0)
+      {
+        SafeDel(pool.second);
+      }
+      else
+      {
+        TK_WRN("%zu objects of class %s outlive the object factory.",
+               pool.second->GetLiveCount(),
+               pool.first->Name.c_str());
+      }
+    }
+  }
 
   void ObjectFactory::CallMetaProcessors(const MetaMap& metaKeys, const MetaProcessorMap& metaProcessorMap)
   {
@@ -101,6 +118,43 @@ namespace ToolKit
     return nullptr;
   }
 
+  ObjectPtr ObjectFactory::MakeNewShared(const StringView Class)
+  {
+    auto sharedConstructorFn = m_sharedConstructorFnMap.find(Class);
+    if (sharedConstructorFn != m_sharedConstructorFnMap.end())
+    {
+      return sharedConstructorFn->second();
+    }
+
+    if (Object* object = MakeNew(Class))
+    {
+      return ObjectPtr(object);
+    }
+
+    return nullptr;
+  }
+
+  ObjectPool* ObjectFactory::GetObjectPool(ClassMeta* Class)
+  {
+    auto poolItr = m_objectPools.find(Class);
+    if (poolItr != m_objectPools.end())
+    {
+      return poolItr->second;
+    }
+
+    for (ClassMeta* pooledClass : m_pooledBaseClasses)
+    {
+      if (Class->IsSublcassOf(pooledClass))
+      {
+        ObjectPool* pool = new ObjectPool();
+        m_objectPools.insert({Class, pool});
+        return pool;
+      }
+    }
+
+    return nullptr;
+  }
+
   void ObjectFactory::Init()
   {
     for (auto fn : GetRegisterFnList())
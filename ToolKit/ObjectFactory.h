@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Logger.h"
+#include "ObjectPool.h"
 #include "ToolKit.h"
 #include "Types.h"
 
@@ -40,6 +41,7 @@ namespace ToolKit
     };
 
     typedef std::function<Object*()> ObjectConstructorCallback;        //!< Type for object constructor callbacks.
+    typedef std::function<ObjectPtr()> SharedConstructorCallback;      //!< Type for pooled shared constructors.
     typedef std::function<void(StringView val)> MetaProcessorCallback; //!< Type for MetaKey callbacks.
 
     /**
@@ -55,11 +57,13 @@ namespace ToolKit
     void CallMetaProcessors(const MetaMap& metaKeys, const MetaProcessorMap& metaProcessorMap);
 
     /**
-     * Registers or overrides the default constructor of given Object type.
-     * @param constructorFn - This is the callback function that is responsible of creating the given object.
+     * Registers or overrides the default constructor of given Object type. When the default constructor is used and the
+     * class derives from one of the m_pooledBaseClasses, shared instances are allocated from the pool of the class.
+     * @param constructorFn - This is the callback function that is responsible of creating the given object. If
+     * nullptr, the object is constructed with its default constructor.
      */
     template <typename T>
-    void Register(ObjectConstructorCallback constructorFn = []() -> T* { return new T(); }, bool overrideClass = false)
+    void Register(ObjectConstructorCallback constructorFn = nullptr, bool overrideClass = false)
     {
       ClassMeta* objectClass = T::StaticClass();
 
@@ -90,11 +94,23 @@ namespace ToolKit
 
       m_allRegisteredClasses.insert({objectClass->HashId, objectClass});
 
+      bool defaultConstructor = constructorFn == nullptr;
+      if (defaultConstructor)
+      {
+        constructorFn = []() -> T* { return new T(); };
+      }
+
       m_constructorFnMap[objectClass->Name] = constructorFn;
+      m_sharedConstructorFnMap.erase(objectClass->Name);
 
       objectClass->SuperClassLookUp.clear();
       ClassLookUpBuilder(objectClass, objectClass);
 
+      if (defaultConstructor)
+      {
+        RegisterSharedConstructor<T>();
+      }
+
       CallMetaProcessors(objectClass->MetaKeys, m_metaProcessorRegisterMap);
     }
 
@@ -103,6 +119,7 @@ namespace ToolKit
     {
       ClassMeta* objectClass = T::StaticClass();
       m_constructorFnMap.erase(objectClass->Name);
+      m_sharedConstructorFnMap.erase(objectClass->Name);
       m_allRegisteredClasses.erase(objectClass->HashId);
 
       CallMetaProcessors(objectClass->MetaKeys, m_metaProcessorUnRegisterMap);
@@ -116,11 +133,23 @@ namespace ToolKit
      * the derived ones. So when a scene is serialized, instead of the EditorCamera, Camera will appear in the file.
      */
     template <typename DerivedCls, typename BaseCls>
-    void Override(ObjectConstructorCallback constructorFn = []() -> DerivedCls* { return new DerivedCls(); })
+    void Override(ObjectConstructorCallback constructorFn = nullptr)
     {
+      bool defaultConstructor = constructorFn == nullptr;
+      if (defaultConstructor)
+      {
+        constructorFn = []() -> DerivedCls* { return new DerivedCls(); };
+      }
+
       DerivedCls::StaticClass()->Name = BaseCls::StaticClass()->Name;
       Register<DerivedCls>(constructorFn, true);
       Register<BaseCls>(constructorFn, true);
+
+      // Both classes share the name, base class constructs the derived one from the pool of the derived class.
+      if (defaultConstructor)
+      {
+        RegisterSharedConstructor<DerivedCls>();
+      }
     }
 
     /**
@@ -135,6 +164,17 @@ namespace ToolKit
      */
     Object* MakeNew(const StringView Class);
 
+    /**
+     * Constructs a new shared Object from class name. Pooled classes are allocated together with their control block
+     * from the pool of the class, others are constructed with MakeNew.
+     * @param Class is the class name of the object to be created.
+     * @return A new shared instance of the object with the given class name.
+     */
+    ObjectPtr MakeNewShared(const StringView Class);
+
+    /** @return The pool of the class or nullptr if the class is not pooled. */
+    ObjectPool* GetObjectPool(ClassMeta* Class);
+
     /**
      * Constructs a new Object of type T. In case the T does not have a static class, just returns a regular object.
      * @return A new instance of Object.
@@ -174,6 +214,18 @@ namespace ToolKit
      */
     void ClassLookUpBuilder(ClassMeta* Class, ClassMeta* FirstClass);
 
+    /** Registers a shared constructor that allocates T from its pool, if the class of T is pooled. */
+    template <typename T>
+    void RegisterSharedConstructor()
+    {
+      ClassMeta* objectClass = T::StaticClass();
+      if (ObjectPool* pool = GetObjectPool(objectClass))
+      {
+        m_sharedConstructorFnMap[objectClass->Name] = [pool]() -> ObjectPtr
+        { return std::allocate_shared<T>(PoolAllocator<T>(pool)); };
+      }
+    }
+
    public:
     /**
      * Each MetaKey has a corresponding meta processor. When a class registered and it has a MetaKey that corresponds to
@@ -187,8 +239,16 @@ namespace ToolKit
      */
     MetaProcessorMap m_metaProcessorUnRegisterMap;
 
+    /**
+     * Classes derived from these are allocated from pools. Entities and components are created and destroyed in large
+     * numbers, pooling keeps them next to each other in memory and saves the separate control block allocation.
+     */
+    std::vector<ClassMeta*> m_pooledBaseClasses;
+
    private:
     std::unordered_map<StringView, ObjectConstructorCallback> m_constructorFnMap;
+    std::unordered_map<StringView, SharedConstructorCallback> m_sharedConstructorFnMap;
+    std::unordered_map<ClassMeta*, ObjectPool*> m_objectPools;
     ObjectConstructorCallback m_nullFn = nullptr;
     std::unordered_map<ObjectId, ClassMeta*> m_allRegisteredClasses;
   };
@@ -202,7 +262,7 @@ namespace ToolKit
       {
         if constexpr (ObjectFactory::HasStaticClass<T>::value)
         {
-          std::shared_ptr<T> obj = std::shared_ptr<T>(of->MakeNew<T>());
+          std::shared_ptr<T> obj = std::static_pointer_cast<T>(of->MakeNewShared(T::StaticClass()->Name));
           obj->m_self            = obj;
           obj->NativeConstruct(std::forward<Args>(args)...);
           return obj;
@@ -224,7 +284,7 @@ namespace ToolKit
     {
       if (ObjectFactory* of = main->m_objectFactory)
       {
-        std::shared_ptr<T> obj = std::shared_ptr<T>(static_cast<T*>(of->MakeNew(Class)));
+        std::shared_ptr<T> obj = std::static_pointer_cast<T>(of->MakeNewShared(Class));
         assert(obj->template IsA<T>() && "Wrong type cast.");
 
         if constexpr (ObjectFactory::HasStaticClass<T>::value)
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "ObjectPool.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  ObjectPool::ObjectPool(size_t objectSize, size_t objectsPerSlab)
+      : m_objectSize(objectSize), m_objectsPerSlab(glm::max((size_t) 1, objectsPerSlab))
+  {
+  }
+
+  ObjectPool::~ObjectPool()
+  {
+    assert(m_liveCount == 0 && "Pool is destroyed while objects are alive.");
+
+    for (uint8* slab : m_slabs)
+    {
+      free(slab);
+    }
+  }
+
+  void* ObjectPool::Allocate(size_t size)
+  {
+    SpinlockGuard guard(m_lock);
+
+    if (m_slotSize == 0)
+    {
+      if (m_objectSize == 0)
+      {
+        m_objectSize.store(size, std::memory_order_release);
+      }
+
+      constexpr size_t alignment = alignof(std::max_align_t);
+      size_t slotSize            = glm::max(m_objectSize.load(), sizeof(FreeSlot));
+      m_slotSize                 = (slotSize + alignment - 1) & ~(alignment - 1);
+    }
+
+    if (size != m_objectSize)
+    {
+      return nullptr;
+    }
+
+    if (m_freeList == nullptr)
+    {
+      // Slots of the new slab are linked in address order, so consecutive allocations are next to each other.
+      uint8* slab = (uint8*) malloc(m_slotSize * m_objectsPerSlab);
+      if (slab == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+
+      m_slabs.push_back(slab);
+      for (size_t i = m_objectsPerSlab; i > 0; i--)
+      {
+        FreeSlot* slot = (FreeSlot*) (slab + (i - 1) * m_slotSize);
+        slot->next     = m_freeList;
+        m_freeList     = slot;
+      }
+    }
+
+    FreeSlot* slot = m_freeList;
+    m_freeList     = slot->next;
+    m_liveCount++;
+
+    return slot;
+  }
+
+  void ObjectPool::Free(void* memory)
+  {
+    if (memory == nullptr)
+    {
+      return;
+    }
+
+    SpinlockGuard guard(m_lock);
+
+    FreeSlot* slot = (FreeSlot*) memory;
+    slot->next     = m_freeList;
+    m_freeList     = slot;
+    m_liveCount--;
+  }
+
+} // namespace ToolKit
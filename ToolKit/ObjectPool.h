@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Threads.h"
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /**
+   * Fixed size allocator that places objects of a single type next to each other in slabs. Released slots are kept in
+   * a free list and reused by the next allocation, slabs are only released when the pool is destroyed. Thread safe.
+   * Slot size can be left to the first allocation, which allows pooling types whose size is only known to the
+   * standard library, such as the combined control block and object of std::allocate_shared.
+   */
+  class TK_API ObjectPool
+  {
+   public:
+    /**
+     * Constructs the pool.
+     * @param objectSize is the size of each slot. If zero, the size of the first allocation is used.
+     * @param objectsPerSlab is the number of slots that are allocated at once.
+     */
+    ObjectPool(size_t objectSize = 0, size_t objectsPerSlab = 256);
+
+    /** Releases the slabs. Pool must be empty. */
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * Allocates a slot. Alignment of the slots is the fundamental alignment.
+     * @return A slot or nullptr if the size doesn't match the slot size.
+     */
+    void* Allocate(size_t size);
+
+    /** Returns the slot to the pool. Slot must be allocated from this pool. */
+    void Free(void* memory);
+
+    /** States if the memory of the given size is served by the pool. */
+    bool IsPooled(size_t size) const { return size == m_objectSize.load(std::memory_order_acquire); }
+
+    /** @return Number of slots that are in use. */
+    size_t GetLiveCount() const { return m_liveCount; }
+
+    /** @return Number of slots in all slabs. */
+    size_t GetCapacity() const { return m_slabs.size() * m_objectsPerSlab; }
+
+   private:
+    /** Slot in the free list. */
+    struct FreeSlot
+    {
+      FreeSlot* next;
+    };
+
+    std::atomic<size_t> m_objectSize;
+    size_t m_slotSize       = 0; //!< Object size rounded up to the fundamental alignment.
+    size_t m_objectsPerSlab = 0;
+    size_t m_liveCount      = 0;
+    FreeSlot* m_freeList    = nullptr;
+    std::vector<uint8*> m_slabs;
+    Spinlock m_lock;
+  };
+
+  /**
+   * Stl compatible allocator that allocates single objects from an ObjectPool. Used with std::allocate_shared, the
+   * object and its control block share a slot. Allocations that don't fit the slot fall back to the heap.
+   */
+  template <typename T>
+  class PoolAllocator
+  {
+   public:
+    typedef T value_type;
+
+    explicit PoolAllocator(ObjectPool* pool) : m_pool(pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : m_pool(other.m_pool)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+      if (count == 1 && alignof(T) <= alignof(std::max_align_t))
+      {
+        if (void* memory = m_pool->Allocate(sizeof(T)))
+        {
+          return (T*) memory;
+        }
+      }
+
+      return (T*) ::operator new(count * sizeof(T));
+    }
+
+    void deallocate(T* memory, size_t count)
+    {
+      if (count == 1 && alignof(T) <= alignof(std::max_align_t) && m_pool->IsPooled(sizeof(T)))
+      {
+        m_pool->Free(memory);
+      }
+      else
+      {
+        ::operator delete(memory);
+      }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const
+    {
+      return m_pool == other.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const
+    {
+      return m_pool != other.m_pool;
+    }
+
+   public:
+    ObjectPool* m_pool = nullptr;
+  };
+
+} // namespace ToolKit
@@ -17,6 +17,8 @@
 namespace ToolKit
 {
 
+  static const UniformHandle g_colorHandle("Color");
+
   OutlinePass::OutlinePass() : Pass("OutlinePass")
   {
     m_stencilPass  = MakeNewPtr<StencilRenderPass>();
@@ -37,7 +39,7 @@ namespace ToolKit
     GetRenderer()->SetTexture(0, m_stencilAsRt->m_textureId);
 
     m_outlinePass->SetFragmentShader(m_dilateShader, GetRenderer());
-    m_outlinePass->UpdateUniform(ShaderUniform("Color", m_params.OutlineColor));
+    m_outlinePass->UpdateUniform(g_colorHandle, m_params.OutlineColor);
 
     // Draw outline to the viewport.
     m_outlinePass->m_params.frameBuffer      = m_params.FrameBuffer;
@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "PakBuilder.h"
+
+#include "Logger.h"
+#include "MappedFile.h"
+#include "TextureCompressor.h"
+#include "Threads.h"
+#include "ToolKit.h"
+#include "Util.h"
+
+#include <mz.h>
+#include <unzip.h>
+#include <zip.h>
+
+#include <fstream>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  /** Files are written to the archives in chunks of this size. */
+  static const uint64 g_pakChunkSize    = 1 << 20;
+
+  /** Version of the manifest, manifests of other versions are ignored. */
+  static const int g_pakManifestVersion = 1;
+
+  /** @return Absolute path of the resource that the xml refers to. Empty if it is an engine resource. */
+  static String ResolveReference(const String& file)
+  {
+    String path = file;
+    NormalizePathInplace(path);
+
+    // All engine resources are already packed.
+    if (path.empty() || HasToolKitRoot(path))
+    {
+      return String();
+    }
+
+    String ext;
+    DecomposePath(path, nullptr, nullptr, &ext);
+
+    if (ext == MESH || ext == SKINMESH || ext == ANIM || ext == SKELETON)
+    {
+      return MeshPath(path);
+    }
+
+    if (ext == MATERIAL)
+    {
+      return MaterialPath(path);
+    }
+
+    if (ext == SHADER)
+    {
+      return ShaderPath(path);
+    }
+
+    if (ext == LAYER)
+    {
+      return LayerPath(path);
+    }
+
+    if (ext == SCENE)
+    {
+      return ScenePath(path);
+    }
+
+    if (SupportedImageFormat(ext))
+    {
+      return TexturePath(path);
+    }
+
+    if (SupportedAudioFormat(ext))
+    {
+      return AudioPath(path);
+    }
+
+    return String();
+  }
+
+  // ResourceDependencyScanner
+  //////////////////////////////////////////
+
+  void ResourceDependencyScanner::AddRoot(const String& file) { AddFile(file); }
+
+  void ResourceDependencyScanner::AddFolder(const String& path)
+  {
+    if (!CheckSystemFile(path))
+    {
+      return;
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(path))
+    {
+      if (!entry.is_regular_file())
+      {
+        continue;
+      }
+
+      String ext = entry.path().extension().string();
+      if (ext == SCENE || ext == LAYER)
+      {
+        AddFile(entry.path().string());
+      }
+    }
+  }
+
+  void ResourceDependencyScanner::Scan()
+  {
+    using poolstl::iota_iter;
+
+    while (!m_queue.empty())
+    {
+      StringArray level;
+      level.swap(m_queue);
+
+      std::vector<StringArray> references(level.size());
+      std::for_each(TKExecByConditional(level.size() > 1, WorkerManager::FramePool),
+                    iota_iter<int>(0),
+                    iota_iter<int>((int) level.size()),
+                    [&](int i) -> void { ScanFile(level[i], references[i]); });
+
+      // Merged in order, the next level is the same regardless of the thread count.
+      for (const StringArray& fileReferences : references)
+      {
+        for (const String& reference : fileReferences)
+        {
+          AddFile(reference);
+        }
+      }
+    }
+  }
+
+  const StringSet& ResourceDependencyScanner::GetFiles() const { return m_files; }
+
+  void ResourceDependencyScanner::ScanFile(const String& file, StringArray& references) const
+  {
+    if (!CheckSystemFile(file))
+    {
+      return;
+    }
+
+    XmlFile xmlFile(file.c_str());
+    XmlDocument doc;
+    doc.parse<0>(xmlFile.data());
+
+    for (XmlNode* node = doc.first_node(); node; node = node->next_sibling())
+    {
+      ScanNode(node, references);
+    }
+  }
+
+  void ResourceDependencyScanner::ScanNode(XmlNode* node, StringArray& references) const
+  {
+    String name = node->name();
+    if (name == XmlResRefElement)
+    {
+      // Resource parameters of entities, components and materials.
+      if (XmlAttribute* attr = node->first_attribute("File"))
+      {
+        String path = ResolveReference(attr->value());
+        if (!path.empty())
+        {
+          references.push_back(path);
+        }
+      }
+    }
+    else if (name == "material")
+    {
+      // Materials of the sub meshes.
+      if (XmlAttribute* attr = node->first_attribute("name"))
+      {
+        String path = ResolveReference(attr->value());
+        if (!path.empty())
+        {
+          references.push_back(path);
+        }
+      }
+    }
+    else if (name == "include")
+    {
+      // Shader includes are searched in the project first, engine shaders are already packed.
+      if (XmlAttribute* attr = node->first_attribute("name"))
+      {
+        String path = ResolveReference(attr->value());
+        if (!path.empty() && CheckSystemFile(path))
+        {
+          references.push_back(path);
+        }
+      }
+    }
+    else if (name == XmlParamterElement)
+    {
+      // Prefabs refer to their scene through a string parameter.
+      XmlAttribute* nameAttr = node->first_attribute("name");
+      XmlAttribute* valAttr  = node->first_attribute(XmlParamterValAttr.c_str());
+      if (nameAttr != nullptr && valAttr != nullptr && String(nameAttr->value()) == "PrefabPath")
+      {
+        String path = valAttr->value();
+        NormalizePathInplace(path);
+        if (!path.empty())
+        {
+          references.push_back(PrefabPath(path));
+        }
+      }
+    }
+
+    for (XmlNode* child = node->first_node(); child; child = child->next_sibling())
+    {
+      ScanNode(child, references);
+    }
+  }
+
+  void ResourceDependencyScanner::AddFile(const String& file)
+  {
+    String path = std::filesystem::absolute(file).lexically_normal().string();
+    if (!m_files.insert(path).second)
+    {
+      return;
+    }
+
+    if (!CheckSystemFile(path))
+    {
+      TK_WRN("Referenced resource is missing: %s", path.c_str());
+      return;
+    }
+
+    String ext;
+    DecomposePath(path, nullptr, nullptr, &ext);
+
+    if (ext == SCENE || ext == LAYER || ext == MATERIAL || ext == MESH || ext == SKINMESH || ext == SHADER)
+    {
+      m_queue.push_back(path);
+    }
+    else if (SupportedImageFormat(ext))
+    {
+      // Cooked image is packed along with the source, runtime picks the one that the driver can sample.
+      String cookedPath = TextureCompressor::CookedFilePath(path);
+      if (!cookedPath.empty() && CheckSystemFile(cookedPath))
+      {
+        m_files.insert(cookedPath);
+      }
+    }
+  }
+
+  // PakBuilder
+  //////////////////////////////////////////
+
+  PakBuilder::PakBuilder() {}
+
+  PakBuilder::~PakBuilder() {}
+
+  bool PakBuilder::Build(const String& pakFile, const StringSet& files)
+  {
+    // Entries are ordered by their names, files that map to the same entry are added once.
+    std::map<String, String> entryFiles;
+    for (const String& file : files)
+    {
+      if (!CheckSystemFile(file) || std::filesystem::is_directory(file))
+      {
+        TK_WRN("Failed to add this file to pak: %s\n", file.c_str());
+        continue;
+      }
+
+      String name = GetEntryName(file);
+      if (name.empty())
+      {
+        TK_ERR("Resource is not under resources path: %s", file.c_str());
+        continue;
+      }
+
+      entryFiles.insert({name, file});
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(entryFiles.size());
+    for (const auto& [name, file] : entryFiles)
+    {
+      Entry entry;
+      entry.name = name;
+      entry.file = file;
+      entries.push_back(entry);
+    }
+
+    ManifestMap manifest;
+    ZipFile previousPak = nullptr;
+    if (CheckSystemFile(pakFile))
+    {
+      ReadManifest(pakFile, manifest);
+      if (!manifest.empty())
+      {
+        previousPak = unzOpen64(pakFile.c_str());
+      }
+    }
+
+    if (previousPak == nullptr)
+    {
+      manifest.clear();
+    }
+
+    using poolstl::iota_iter;
+    std::for_each(TKExecBy(WorkerManager::FramePool),
+                  entries.begin(),
+                  entries.end(),
+                  [&](Entry& entry) -> void { UpdateEntry(entry, manifest); });
+
+    // Changed entries are distributed over temporary archives, one for each worker.
+    std::vector<int> pending;
+    for (int i = 0; i < (int) entries.size(); i++)
+    {
+      if (!entries[i].reuse)
+      {
+        pending.push_back(i);
+      }
+    }
+
+    int threadCount    = glm::max(1, GetWorkerManager()->GetThreadCount(WorkerManager::FramePool));
+    int shardCount     = glm::min((int) pending.size(), threadCount);
+
+    String shardFolder = pakFile + ".shards";
+    StringArray shardFiles(shardCount);
+    if (shardCount > 0)
+    {
+      std::error_code err;
+      std::filesystem::create_directories(shardFolder, err);
+    }
+
+    for (int shard = 0; shard < shardCount; shard++)
+    {
+      shardFiles[shard] = ConcatPaths({shardFolder, std::to_string(shard) + ".zip"});
+    }
+
+    for (int i = 0; i < (int) pending.size(); i++)
+    {
+      entries[pending[i]].shard = i % shardCount;
+    }
+
+    std::for_each(TKExecBy(WorkerManager::FramePool),
+                  iota_iter<int>(0),
+                  iota_iter<int>(shardCount),
+                  [&](int shard) -> void
+                  {
+                    ZipFile zfile = zipOpen64(shardFiles[shard].c_str(), 0);
+                    for (int i = shard; i < (int) pending.size(); i += shardCount)
+                    {
+                      Entry& entry = entries[pending[i]];
+                      if (zfile == nullptr || !AddFileToZip(zfile, entry))
+                      {
+                        entry.shard = -1;
+                      }
+                    }
+
+                    if (zfile != nullptr)
+                    {
+                      zipClose(zfile, nullptr);
+                    }
+                  });
+
+    // Write the pak next to the previous one, which is still being read.
+    String tempPak = pakFile + ".tmp";
+    ZipFile pak    = zipOpen64(tempPak.c_str(), 0);
+    if (pak == nullptr)
+    {
+      TK_ERR("Can't create pak: %s", tempPak.c_str());
+    }
+
+    std::vector<ZipFile> shards(shardCount, nullptr);
+    for (int shard = 0; shard < shardCount && pak != nullptr; shard++)
+    {
+      shards[shard] = unzOpen64(shardFiles[shard].c_str());
+    }
+
+    int reusedCount     = 0;
+    int compressedCount = 0;
+    std::vector<Entry> written;
+    for (int i = 0; i < (int) entries.size() && pak != nullptr; i++)
+    {
+      Entry& entry = entries[i];
+
+      bool added   = false;
+      if (entry.reuse)
+      {
+        added = CopyEntry(previousPak, pak, entry.name);
+      }
+      else if (entry.shard != -1 && shards[entry.shard] != nullptr)
+      {
+        added = CopyEntry(shards[entry.shard], pak, entry.name);
+      }
+
+      if (added && entry.reuse)
+      {
+        reusedCount++;
+      }
+      else if (added)
+      {
+        compressedCount++;
+      }
+      else if (AddFileToZip(pak, entry))
+      {
+        // Compress in place if the entry can't be copied.
+        added = true;
+        compressedCount++;
+      }
+
+      if (added)
+      {
+        written.push_back(entry);
+      }
+      else
+      {
+        TK_WRN("Failed to add this file to pak: %s\n", entry.file.c_str());
+      }
+    }
+
+    for (ZipFile shard : shards)
+    {
+      if (shard != nullptr)
+      {
+        unzClose(shard);
+      }
+    }
+
+    if (previousPak != nullptr)
+    {
+      unzClose(previousPak);
+    }
+
+    std::error_code err;
+    std::filesystem::remove_all(shardFolder, err);
+
+    if (pak == nullptr)
+    {
+      return false;
+    }
+
+    zipClose(pak, nullptr);
+
+    std::filesystem::rename(tempPak, pakFile, err);
+    if (err)
+    {
+      TK_ERR("Can't replace pak: %s message: %s", pakFile.c_str(), err.message().c_str());
+      return false;
+    }
+
+    WriteManifest(pakFile, written);
+
+    TK_LOG("Pak entries: %d reused: %d compressed: %d\n", (int) written.size(), reusedCount, compressedCount);
+
+    return true;
+  }
+
+  PakEntryPolicy PakBuilder::GetEntryPolicy(const String& file) const
+  {
+    String ext;
+    DecomposePath(file, nullptr, nullptr, &ext);
+    ext = ToLower(ext);
+
+    PakEntryPolicy policy;
+
+    // Compressed formats don't shrink any further, storing them saves the time.
+    if (ext == PNG || ext == JPG || ext == JPEG || ext == MP3 || ext == KTX)
+    {
+      policy.store = true;
+      policy.level = 0;
+      return policy;
+    }
+
+    static const StringArray textFormats = {ToLower(SCENE),
+                                            ToLower(LAYER),
+                                            ToLower(MATERIAL),
+                                            ToLower(SHADER),
+                                            ToLower(MESH),
+                                            ToLower(SKINMESH),
+                                            ToLower(ANIM),
+                                            ToLower(SKELETON),
+                                            ".xml"};
+
+    if (std::find(textFormats.begin(), textFormats.end(), ext) != textFormats.end())
+    {
+      policy.level = m_textLevel;
+    }
+    else
+    {
+      policy.level = m_binaryLevel;
+    }
+
+    return policy;
+  }
+
+  String PakBuilder::GetEntryName(const String& file)
+  {
+    String name  = file;
+    size_t index = name.find("Resources");
+    if (index == String::npos)
+    {
+      return String();
+    }
+
+    constexpr int length = sizeof("Resources");
+    name                 = name.substr(index + length);
+    UnixifyPath(name);
+
+    return name;
+  }
+
+  void PakBuilder::ReadManifest(const String& pakFile, ManifestMap& manifest) const
+  {
+    String file = pakFile + ".manifest";
+    if (!CheckSystemFile(file))
+    {
+      return;
+    }
+
+    XmlFile xmlFile(file.c_str());
+    XmlDocument doc;
+    doc.parse<0>(xmlFile.data());
+
+    XmlNode* root = doc.first_node("PakManifest");
+    if (root == nullptr)
+    {
+      return;
+    }
+
+    // Manifest must belong to the pak on the disk, otherwise its entries can't be trusted.
+    int version   = 0;
+    ObjectId size = 0;
+    ReadAttr(root, "version", version);
+    ReadAttr(root, "pakSize", size);
+
+    std::error_code err;
+    uint64 pakSize = std::filesystem::file_size(pakFile, err);
+    if (version != g_pakManifestVersion || err || size != pakSize)
+    {
+      return;
+    }
+
+    for (XmlNode* node = root->first_node("Entry"); node; node = node->next_sibling("Entry"))
+    {
+      Entry entry;
+      ReadAttr(node, "name", entry.name);
+      ReadAttr(node, "size", entry.size);
+      ReadAttr(node, "time", entry.writeTime);
+      ReadAttr(node, "hash", entry.hash);
+      ReadAttr(node, "store", entry.policy.store);
+      ReadAttr(node, "level", entry.policy.level);
+
+      manifest[entry.name] = entry;
+    }
+  }
+
+  void PakBuilder::WriteManifest(const String& pakFile, const std::vector<Entry>& entries) const
+  {
+    std::error_code err;
+    uint64 pakSize = std::filesystem::file_size(pakFile, err);
+    if (err)
+    {
+      return;
+    }
+
+    XmlDocument doc;
+    XmlNode* root = CreateXmlNode(&doc, "PakManifest");
+    WriteAttr(root, &doc, "version", std::to_string(g_pakManifestVersion));
+    WriteAttr(root, &doc, "pakSize", std::to_string(pakSize));
+
+    for (const Entry& entry : entries)
+    {
+      XmlNode* node = CreateXmlNode(&doc, "Entry", root);
+      WriteAttr(node, &doc, "name", entry.name);
+      WriteAttr(node, &doc, "size", std::to_string(entry.size));
+      WriteAttr(node, &doc, "time", std::to_string(entry.writeTime));
+      WriteAttr(node, &doc, "hash", std::to_string(entry.hash));
+      WriteAttr(node, &doc, "store", std::to_string((int) entry.policy.store));
+      WriteAttr(node, &doc, "level", std::to_string(entry.policy.level));
+    }
+
+    std::string xml;
+    rapidxml::print(std::back_inserter(xml), doc);
+
+    std::ofstream stream(pakFile + ".manifest", std::ios::trunc);
+    stream << xml;
+  }
+
+  void PakBuilder::UpdateEntry(Entry& entry, const ManifestMap& manifest) const
+  {
+    std::error_code err;
+    entry.size      = std::filesystem::file_size(entry.file, err);
+    entry.writeTime = (uint64) std::filesystem::last_write_time(entry.file, err).time_since_epoch().count();
+    entry.policy    = GetEntryPolicy(entry.file);
+
+    auto previous   = manifest.find(entry.name);
+    if (previous == manifest.end())
+    {
+      entry.hash = FileContentHash(entry.file);
+      return;
+    }
+
+    // Unchanged size and write time is trusted, the file is hashed only if one of them changes.
+    const Entry& previousEntry = previous->second;
+    if (previousEntry.size == entry.size && previousEntry.writeTime == entry.writeTime)
+    {
+      entry.hash = previousEntry.hash;
+    }
+    else
+    {
+      entry.hash = FileContentHash(entry.file);
+    }
+
+    entry.reuse = previousEntry.hash == entry.hash && previousEntry.policy == entry.policy;
+  }
+
+  bool PakBuilder::AddFileToZip(ZipFile zfile, const Entry& entry) const
+  {
+    MappedFile mapped;
+    if (entry.size > 0 && !mapped.Open(entry.file))
+    {
+      return false;
+    }
+
+    int method = entry.policy.store ? MZ_COMPRESS_METHOD_STORE : MZ_COMPRESS_METHOD_ZSTD;
+    int level  = entry.policy.store ? 0 : entry.policy.level;
+    int zip64  = mapped.Size() >= 0xffffffff ? 1 : 0;
+
+    if (zipOpenNewFileInZip64(zfile,
+                              entry.name.c_str(),
+                              nullptr,
+                              nullptr,
+                              0,
+                              nullptr,
+                              0,
+                              nullptr,
+                              method,
+                              level,
+                              zip64) != ZIP_OK)
+    {
+      return false;
+    }
+
+    int ret           = ZIP_OK;
+    const uint8* data = mapped.Data();
+    uint64 remaining  = mapped.Size();
+    while (ret == ZIP_OK && remaining > 0)
+    {
+      uint64 size = std::min(remaining, g_pakChunkSize);
+      ret         = zipWriteInFileInZip(zfile, data, (uint) size);
+      data       += size;
+      remaining  -= size;
+    }
+
+    zipCloseFileInZip(zfile);
+
+    return ret == ZIP_OK;
+  }
+
+  bool PakBuilder::CopyEntry(ZipFile source, ZipFile target, const String& name) const
+  {
+    if (unzLocateFile(source, name.c_str(), 0) != UNZ_OK)
+    {
+      return false;
+    }
+
+    unz_file_info64 info;
+    memset(&info, 0, sizeof(unz_file_info64));
+    if (unzGetCurrentFileInfo64(source, &info, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
+    {
+      return false;
+    }
+
+    // Raw mode reads and writes the compressed bytes, crc and size of the entry are carried over.
+    int method = 0;
+    int level  = 0;
+    if (unzOpenCurrentFile2(source, &method, &level, 1) != UNZ_OK)
+    {
+      return false;
+    }
+
+    int zip64 = info.uncompressed_size >= 0xffffffff ? 1 : 0;
+    if (zipOpenNewFileInZip2_64(target,
+                                name.c_str(),
+                                nullptr,
+                                nullptr,
+                                0,
+                                nullptr,
+                                0,
+                                nullptr,
+                                method,
+                                level,
+                                1,
+                                zip64) != ZIP_OK)
+    {
+      unzCloseCurrentFile(source);
+      return false;
+    }
+
+    std::vector<uint8> buffer(g_pakChunkSize);
+    int ret  = ZIP_OK;
+    int read = 0;
+    while (ret == ZIP_OK && (read = unzReadCurrentFile(source, buffer.data(), (uint) buffer.size())) > 0)
+    {
+      ret = zipWriteInFileInZip(target, buffer.data(), (uint) read);
+    }
+
+    zipCloseFileInZipRaw64(target, info.uncompressed_size, info.crc);
+    unzCloseCurrentFile(source);
+
+    return ret == ZIP_OK && read >= 0;
+  }
+
+} // namespace ToolKit
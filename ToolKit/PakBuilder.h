@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /**
+   * Collects the resources that scenes and layers refer to by reading their xml files. Nothing is loaded or
+   * instantiated, references are followed through prefabs, materials, meshes and shaders. Engine resources are not
+   * followed since all of them are packed.
+   */
+  class TK_API ResourceDependencyScanner
+  {
+   public:
+    /** Adds the file and the files that it refers to, to the scan. */
+    void AddRoot(const String& file);
+
+    /** Adds all scene and layer files under the folder, including its sub folders, to the scan. */
+    void AddFolder(const String& path);
+
+    /** Follows the references of the added files, level by level, reading the files of a level in parallel. */
+    void Scan();
+
+    /** @return Absolute paths of all the files that are found. */
+    const StringSet& GetFiles() const;
+
+   private:
+    /** Reads the file and appends the files that it refers to. */
+    void ScanFile(const String& file, StringArray& references) const;
+
+    /** Visits the node and all of its children for resource references. */
+    void ScanNode(XmlNode* node, StringArray& references) const;
+
+    /** Adds the file to the result and queues it for scanning if it may refer to other files. */
+    void AddFile(const String& file);
+
+   private:
+    StringSet m_files;
+    StringArray m_queue;
+  };
+
+  /** Compression of a pak entry. */
+  struct PakEntryPolicy
+  {
+    bool store = false; //!< Stores the entry as is, for files that are already compressed.
+    int level  = -1;    //!< Zstd compression level, -1 for the default level.
+
+    bool operator==(const PakEntryPolicy& other) const { return store == other.store && level == other.level; }
+  };
+
+  /**
+   * Builds the resource pak incrementally. A manifest that keeps the content hash and the compression of each entry is
+   * written next to the pak. On the next build, entries whose content and compression didn't change are copied from
+   * the previous pak as compressed bytes. Remaining entries are compressed in parallel, each worker writes to its own
+   * temporary archive and the results are copied in to the pak in a deterministic order.
+   */
+  class TK_API PakBuilder
+  {
+   public:
+    PakBuilder();
+    ~PakBuilder();
+
+    /**
+     * Builds the pak from the files. Files must be under a Resources folder, entries are named relative to it.
+     * @param pakFile is the pak to write. The previous pak and its manifest are reused if they exist.
+     * @param files are the absolute paths of the files to pack.
+     * @return False if the pak can't be written.
+     */
+    bool Build(const String& pakFile, const StringSet& files);
+
+    /** @return Compression of the file, decided by its extension. */
+    PakEntryPolicy GetEntryPolicy(const String& file) const;
+
+    /** @return Entry name of the file in the pak, relative to the Resources folder. Empty if not in resources. */
+    static String GetEntryName(const String& file);
+
+   private:
+    struct Entry
+    {
+      String name;           //!< Name in the pak.
+      String file;           //!< Path on the disk.
+      uint64 size      = 0;  //!< File size in bytes.
+      uint64 writeTime = 0;  //!< Last write time of the file.
+      uint64 hash      = 0;  //!< Content hash of the file.
+      PakEntryPolicy policy; //!< Compression of the entry.
+      bool reuse = false;    //!< Copied from the previous pak.
+      int shard  = -1;       //!< Temporary archive that the entry is compressed in to.
+    };
+
+    typedef std::unordered_map<String, Entry> ManifestMap;
+
+    /** Reads the manifest of the previous build. */
+    void ReadManifest(const String& file, ManifestMap& manifest) const;
+
+    /** Writes the manifest for the entries. */
+    void WriteManifest(const String& file, const std::vector<Entry>& entries) const;
+
+    /** Hashes the content of the entry unless the manifest states that the file is unchanged. */
+    void UpdateEntry(Entry& entry, const ManifestMap& manifest) const;
+
+    /** Compresses the file in to the archive. */
+    bool AddFileToZip(ZipFile zfile, const Entry& entry) const;
+
+    /** Copies the compressed entry from an archive to another without decompressing it. */
+    bool CopyEntry(ZipFile source, ZipFile target, const String& name) const;
+
+   public:
+    int m_textLevel   = 9;  //!< Zstd level for xml based files. They compress well and change rarely.
+    int m_binaryLevel = -1; //!< Zstd level for the remaining files.
+  };
+
+} // namespace ToolKit
@@ -15,6 +15,7 @@
 #include "Mesh.h"
 #include "Renderer.h"
 #include "Scene.h"
+#include "Texture.h"
 #include "Threads.h"
 #include "ToolKit.h"
 #include "Viewport.h"
@@ -24,6 +25,45 @@
 namespace ToolKit
 {
 
+  // PassParameterBlock
+  //////////////////////////////////////////
+
+  PassParameterBlock::PassParameterBlock(StringView blockName, uint64 size) : m_blockName(blockName)
+  {
+    m_data.resize(size);
+  }
+
+  void PassParameterBlock::Set(const void* data)
+  {
+    if (memcmp(m_data.data(), data, m_data.size()) != 0)
+    {
+      memcpy(m_data.data(), data, m_data.size());
+      m_dirty = true;
+    }
+  }
+
+  void PassParameterBlock::Bind(GpuProgram* program)
+  {
+    if (!m_initialized)
+    {
+      m_buffer.Init(m_data.size());
+      m_buffer.m_slot = RHIConstants::PassParameterBlockSlot;
+      m_initialized   = true;
+    }
+
+    if (m_dirty)
+    {
+      m_buffer.Map(m_data.data(), m_data.size());
+      m_dirty = false;
+    }
+
+    program->SetUniformBlockBinding(m_blockName, RHIConstants::PassParameterBlockSlot);
+    RHI::BindUniformBuffer(RHIConstants::PassParameterBlockSlot, m_buffer.m_id);
+  }
+
+  // Pass
+  //////////////////////////////////////////
+
   Pass::Pass(StringView name) : m_name(name) {}
 
   Pass::~Pass() {}
@@ -53,19 +93,37 @@ namespace ToolKit
     }
   }
 
+  void Pass::UpdateUniform(const UniformHandle& handle, const UniformValue& value)
+  {
+    if (m_program != nullptr)
+    {
+      m_program->SetUniform(handle, value);
+    }
+  }
+
+  void Pass::BindParameterBlock(PassParameterBlock& block)
+  {
+    if (m_program != nullptr)
+    {
+      block.Bind(m_program.get());
+    }
+  }
+
   void RenderJobProcessor::CreateRenderJobs(RenderJobArray& jobArray,
                                             EntityRawPtrArray& entities,
                                             bool ignoreVisibility,
                                             int dirLightEndIndex,
                                             const LightRawPtrArray& lights,
-                                            const EnvironmentComponentPtrArray& environments)
+                                            const EnvironmentComponentPtrArray& environments,
+                                            Camera* camera,
+                                            float viewportHeight)
   {
     // Each entity can contain several meshes. This submeshIndexLookup array will be used
     // to find the index of the submesh for a given entity index.
     // Ex: Entity index is 4 and it has 3 submesh,
     // its submesh indexes would be = {4, 5, 6}
     // to look them up: {nttIndex + 0, nttIndex + 1, nttIndex + 3} formula is used.
-    IntArray submeshIndexLookup;
+    FrameArray<int> submeshIndexLookup;
     int size = 0;
 
     // Apply ntt visibility check.
@@ -171,6 +229,27 @@ namespace ToolKit
                       AssignEnvironment(job, environments);
                     }
                   });
+
+    RequestTextureMips(jobArray, camera, viewportHeight);
+  }
+
+  void RenderJobProcessor::RequestTextureMips(const RenderJobArray& jobArray, Camera* camera, float viewportHeight)
+  {
+    // Jobs that are not viewed by a camera, such as shadow casters, would pin the textures at the largest level.
+    TextureStreamer* streamer = GetTextureManager()->m_streamer;
+    if (streamer == nullptr || !streamer->IsEnabled() || camera == nullptr)
+    {
+      return;
+    }
+
+    for (const RenderJob& job : jobArray)
+    {
+      if (job.Material != nullptr)
+      {
+        float screenSize = TextureStreamer::EstimateScreenSize(job.BoundingBox, camera, viewportHeight);
+        streamer->RequestMaterial(job.Material, screenSize);
+      }
+    }
   }
 
   void RenderJobProcessor::CreateRenderJobs(RenderJobArray& jobArray, EntityPtr entity)
@@ -9,6 +9,7 @@
 
 #include "EnvironmentComponent.h"
 #include "Renderer.h"
+#include "UniformBuffer.h"
 
 namespace ToolKit
 {
@@ -16,6 +17,43 @@ namespace ToolKit
   typedef std::shared_ptr<class Pass> PassPtr;
   typedef std::vector<PassPtr> PassPtrArray;
 
+  /**
+   * Parameters of a pass kept in a std140 uniform block. Parameters are uploaded only when they change and the block is
+   * bound to RHIConstants::PassParameterBlockSlot right before the pass draws, so passes can share the slot. Shaders
+   * declare the block with the same name and layout, such as: layout(std140) uniform DofParams { ... };
+   */
+  class TK_API PassParameterBlock
+  {
+   public:
+    /**
+     * Constructs the block.
+     * @param blockName is the name of the uniform block in the shader.
+     * @param size is the size of the std140 layout of the block in bytes.
+     */
+    PassParameterBlock(StringView blockName, uint64 size);
+
+    /** Copies the parameters. They are uploaded on the next bind if they differ from the current ones. */
+    void Set(const void* data);
+
+    /** Typed version of Set. DataLayout must match the std140 layout of the block. */
+    template <typename DataLayout>
+    void Set(const DataLayout& data)
+    {
+      assert(sizeof(DataLayout) == m_data.size() && "Parameter block layout size mismatch.");
+      Set((const void*) &data);
+    }
+
+    /** Uploads the changed parameters and binds the block for the program. */
+    void Bind(GpuProgram* program);
+
+   private:
+    UniformHandle m_blockName;
+    UniformBuffer m_buffer;
+    std::vector<uint8> m_data;
+    bool m_initialized = false;
+    bool m_dirty       = true;
+  };
+
   /** Base Pass class. */
   class TK_API Pass
   {
@@ -34,6 +72,12 @@ namespace ToolKit
     /** This function is used to pass custom uniforms to this pass. */
     void UpdateUniform(const ShaderUniform& shaderUniform);
 
+    /** Sets a custom uniform of this pass without string operations. Handles should be created once and kept. */
+    void UpdateUniform(const UniformHandle& handle, const UniformValue& value);
+
+    /** Binds the parameter block for the program of this pass. Should be called before rendering the pass. */
+    void BindParameterBlock(PassParameterBlock& block);
+
    protected:
     GpuProgramPtr m_program = nullptr; //!< Program used to draw objects with in the pass.
     StringView m_name; //!< Label that appears in the gpu profile / debug applications (RenderDoc etc...).
@@ -57,7 +101,7 @@ namespace ToolKit
     Mat4 WorldTransform;     //!< World transform of the entity.
     AnimData animData;       //!< Animation data of render job.
 
-    LightRawPtrArray lights;
+    FrameArray<Light*> lights; //!< Lights effecting the job. In the frame arena, jobs must be recreated each frame.
   };
 
   typedef RenderJobArray::iterator RenderJobItr;
@@ -108,13 +152,25 @@ namespace ToolKit
      * @param lights are the list of lights to consider. Lights must be presorted before sending them to this function.
      * @param environments are the environment volumes to consider.
      * @param ingnoreVisibility when set true, construct jobs for entities that has visibility set to false.
+     * @param camera is the camera that views the jobs. Used to request the texture mip levels that fit the screen size
+     * of the jobs. If not provided, no levels are requested. Passes without a view such as shadows sample the levels
+     * that the views request.
+     * @param viewportHeight is the height of the viewport that the camera renders to in pixels.
      */
     static void CreateRenderJobs(RenderJobArray& jobArray,
                                  EntityRawPtrArray& entities,
                                  bool ignoreVisibility                            = false,
                                  int dirLightEndIndex                             = 0,
                                  const LightRawPtrArray& lights                   = {},
-                                 const EnvironmentComponentPtrArray& environments = {});
+                                 const EnvironmentComponentPtrArray& environments = {},
+                                 Camera* camera                                   = nullptr,
+                                 float viewportHeight                             = 0.0f);
+
+    /**
+     * Requests mip levels of the streamed textures of the jobs from the TextureStreamer.
+     * @param camera is used to estimate the screen size of the jobs. If nullptr, nothing is requested.
+     */
+    static void RequestTextureMips(const RenderJobArray& jobArray, Camera* camera, float viewportHeight);
 
     static void CreateRenderJobs(RenderJobArray& jobArray, EntityPtr entity);
 
@@ -7,6 +7,8 @@
 
 #include "RHI.h"
 
+#include <cstring>
+
 #include "DebugNew.h"
 
 namespace ToolKit
@@ -15,7 +17,30 @@ namespace ToolKit
   GLuint RHI::m_currentDrawFramebufferID = UINT_MAX;
   GLuint RHI::m_currentFramebufferID     = UINT_MAX;
   GLuint RHI::m_currentVAO               = UINT_MAX;
-  RHI::TextureIdSlotMap RHI::m_textureIdSlotMap;
+  RHI::TextureSlotArray RHI::m_textureSlots;
+  RHI::StateCache RHI::m_state;
+  uint64 RHI::m_issuedGlCallCount        = 0;
+  uint64 RHI::m_skippedGlCallCount       = 0;
+
+  // UniformValueCache
+  //////////////////////////////////////////
+
+  bool UniformValueCache::Update(GLint location, const void* data, size_t size)
+  {
+    std::vector<uint8>& value = m_values[location];
+    if (value.size() == size && memcmp(value.data(), data, size) == 0)
+    {
+      return false;
+    }
+
+    value.assign((const uint8*) data, (const uint8*) data + size);
+    return true;
+  }
+
+  void UniformValueCache::Clear() { m_values.clear(); }
+
+  // RHI
+  //////////////////////////////////////////
 
   void RHI::SetFramebuffer(GLenum target, GLuint framebufferID)
   {
@@ -23,6 +48,7 @@ namespace ToolKit
     {
       if (m_currentReadFramebufferID == framebufferID)
       {
+        m_skippedGlCallCount++;
         return;
       }
       else
@@ -34,6 +60,7 @@ namespace ToolKit
     {
       if (m_currentDrawFramebufferID == framebufferID)
       {
+        m_skippedGlCallCount++;
         return;
       }
       else
@@ -46,6 +73,7 @@ namespace ToolKit
       if (m_currentFramebufferID == framebufferID && m_currentReadFramebufferID == framebufferID &&
           m_currentDrawFramebufferID == framebufferID)
       {
+        m_skippedGlCallCount++;
         return;
       }
       else
@@ -57,6 +85,7 @@ namespace ToolKit
     }
 
     glBindFramebuffer(target, framebufferID);
+    m_issuedGlCallCount++;
   }
 
   void RHI::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
@@ -89,25 +118,33 @@ namespace ToolKit
 
   void RHI::SetTexture(GLenum target, GLuint textureID, GLenum textureSlot)
   {
-    assert(textureSlot >= 0 && textureSlot <= 31);
+    assert(textureSlot >= 0 && textureSlot < RHIConstants::TextureSlotCount);
 
-    if (m_textureIdSlotMap[textureSlot] != textureID)
+    if (m_textureSlots[textureSlot] == textureID)
     {
-      glActiveTexture(GL_TEXTURE0 + textureSlot);
-      glBindTexture(target, textureID);
+      m_skippedGlCallCount++;
+      return;
+    }
 
-      m_textureIdSlotMap[textureSlot] = textureID;
+    if (UpdateState(m_state.activeTextureSlot, (GLuint) textureSlot))
+    {
+      glActiveTexture(GL_TEXTURE0 + textureSlot);
     }
+
+    glBindTexture(target, textureID);
+    m_issuedGlCallCount++;
+
+    m_textureSlots[textureSlot] = textureID;
   }
 
   void RHI::DeleteTexture(GLuint textureID)
   {
     // iterate over all slots and reset texture id if it matches given texture
-    for (auto& it : m_textureIdSlotMap)
+    for (GLuint& slotTextureID : m_textureSlots)
     {
-      if (it.second == textureID)
+      if (slotTextureID == textureID)
       {
-        it.second = -1;
+        slotTextureID = UINT_MAX;
       }
     }
 
@@ -116,12 +153,330 @@ namespace ToolKit
 
   void RHI::BindVertexArray(GLuint VAO)
   {
-    if (m_currentVAO != VAO)
+    if (UpdateState(m_currentVAO, VAO))
     {
       glBindVertexArray(VAO);
+    }
+  }
+
+  void RHI::UseProgram(GLuint program)
+  {
+    if (UpdateState(m_state.program, program))
+    {
+      glUseProgram(program);
+    }
+  }
 
-      m_currentVAO = VAO;
+  void RHI::DeleteProgram(GLuint program)
+  {
+    // A new program may take the handle, which must not be mistaken for the current one.
+    if (m_state.program == program)
+    {
+      m_state.program = UINT_MAX;
+    }
+
+    glDeleteProgram(program);
+  }
+
+  GLuint RHI::GetCurrentProgram() { return m_state.program; }
+
+  void RHI::BindUniformBuffer(GLuint binding, GLuint buffer)
+  {
+    if (binding >= m_state.uniformBuffers.size())
+    {
+      glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+      m_issuedGlCallCount++;
+      return;
+    }
+
+    if (UpdateState(m_state.uniformBuffers[binding], buffer))
+    {
+      glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+    }
+  }
+
+  void RHI::DeleteBuffer(GLuint buffer)
+  {
+    for (GLuint& bindingBuffer : m_state.uniformBuffers)
+    {
+      if (bindingBuffer == buffer)
+      {
+        bindingBuffer = UINT_MAX;
+      }
+    }
+
+    glDeleteBuffers(1, &buffer);
+  }
+
+  void RHI::SetCapability(GLenum capability, bool enable)
+  {
+    int index = CapabilityCount;
+    switch (capability)
+    {
+    case GL_BLEND:
+      index = CapabilityBlend;
+      break;
+    case GL_CULL_FACE:
+      index = CapabilityCullFace;
+      break;
+    case GL_DEPTH_TEST:
+      index = CapabilityDepthTest;
+      break;
+    case GL_STENCIL_TEST:
+      index = CapabilityStencilTest;
+      break;
+    case GL_SCISSOR_TEST:
+      index = CapabilityScissorTest;
+      break;
+    default:
+      break;
+    }
+
+    if (index == CapabilityCount)
+    {
+      // Not tracked.
+      m_issuedGlCallCount++;
+    }
+    else if (!UpdateState(m_state.capabilities[index], (int) enable))
+    {
+      return;
+    }
+
+    if (enable)
+    {
+      glEnable(capability);
+    }
+    else
+    {
+      glDisable(capability);
+    }
+  }
+
+  void RHI::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+  {
+    if (UpdateState(m_state.blendFunc, {sourceFactor, destinationFactor}))
+    {
+      glBlendFunc(sourceFactor, destinationFactor);
+    }
+  }
+
+  void RHI::BlendEquation(GLenum mode)
+  {
+    if (UpdateState(m_state.blendEquation, mode))
+    {
+      glBlendEquation(mode);
+    }
+  }
+
+  void RHI::CullFace(GLenum mode)
+  {
+    if (UpdateState(m_state.cullFace, mode))
+    {
+      glCullFace(mode);
+    }
+  }
+
+  void RHI::DepthFunc(GLenum func)
+  {
+    if (UpdateState(m_state.depthFunc, func))
+    {
+      glDepthFunc(func);
+    }
+  }
+
+  void RHI::DepthMask(bool enable)
+  {
+    if (UpdateState(m_state.depthMask, (int) enable))
+    {
+      glDepthMask(enable);
+    }
+  }
+
+  void RHI::ColorMask(bool r, bool g, bool b, bool a)
+  {
+    int mask = (int) r | (int) g << 1 | (int) b << 2 | (int) a << 3;
+    if (UpdateState(m_state.colorMask, mask))
+    {
+      glColorMask(r, g, b, a);
     }
   }
 
+  void RHI::StencilFunc(GLenum func, GLint ref, GLuint mask)
+  {
+    if (UpdateState(m_state.stencilFunc, {func, (GLuint) ref, mask}))
+    {
+      glStencilFunc(func, ref, mask);
+    }
+  }
+
+  void RHI::StencilOp(GLenum stencilFail, GLenum depthFail, GLenum depthPass)
+  {
+    if (UpdateState(m_state.stencilOp, {stencilFail, depthFail, depthPass}))
+    {
+      glStencilOp(stencilFail, depthFail, depthPass);
+    }
+  }
+
+  void RHI::StencilMask(GLuint mask)
+  {
+    if (UpdateState(m_state.stencilMask, mask))
+    {
+      glStencilMask(mask);
+    }
+  }
+
+  void RHI::LineWidth(float width)
+  {
+    if (UpdateState(m_state.lineWidth, width))
+    {
+      glLineWidth(width);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, int value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform1i(location, value);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, uint value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform1ui(location, value);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, float value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform1f(location, value);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, const Vec2& value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform2fv(location, 1, &value[0]);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, const Vec3& value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform3fv(location, 1, &value[0]);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, const Vec4& value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniform4fv(location, 1, &value[0]);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, const Mat3& value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniformMatrix3fv(location, 1, false, &value[0][0]);
+    }
+  }
+
+  void RHI::SetUniform(UniformValueCache& cache, GLint location, const Mat4& value)
+  {
+    if (location != -1 && UpdateState(cache, location, &value, sizeof(value)))
+    {
+      glUniformMatrix4fv(location, 1, false, &value[0][0]);
+    }
+  }
+
+  void RHI::SetUniformArray(UniformValueCache& cache, GLint location, const int* values, GLsizei count)
+  {
+    if (location != -1 && count > 0 && UpdateState(cache, location, values, count * sizeof(int)))
+    {
+      glUniform1iv(location, count, values);
+    }
+  }
+
+  void RHI::SetUniformArray(UniformValueCache& cache, GLint location, const Vec4* values, GLsizei count)
+  {
+    if (location != -1 && count > 0 && UpdateState(cache, location, values, count * sizeof(Vec4)))
+    {
+      glUniform4fv(location, count, &values[0][0]);
+    }
+  }
+
+  void RHI::SetUniform(GLint location, const UniformValue& value)
+  {
+    if (location == -1)
+    {
+      return;
+    }
+
+    switch ((ShaderUniform::UniformType) value.index())
+    {
+    case ShaderUniform::UniformType::Bool:
+      glUniform1ui(location, std::get<bool>(value));
+      break;
+    case ShaderUniform::UniformType::Float:
+      glUniform1f(location, std::get<float>(value));
+      break;
+    case ShaderUniform::UniformType::Int:
+      glUniform1i(location, std::get<int>(value));
+      break;
+    case ShaderUniform::UniformType::UInt:
+      glUniform1ui(location, std::get<uint>(value));
+      break;
+    case ShaderUniform::UniformType::Vec2:
+      glUniform2fv(location, 1, &std::get<Vec2>(value)[0]);
+      break;
+    case ShaderUniform::UniformType::Vec3:
+      glUniform3fv(location, 1, &std::get<Vec3>(value)[0]);
+      break;
+    case ShaderUniform::UniformType::Vec4:
+      glUniform4fv(location, 1, &std::get<Vec4>(value)[0]);
+      break;
+    case ShaderUniform::UniformType::Mat3:
+      glUniformMatrix3fv(location, 1, false, &std::get<Mat3>(value)[0][0]);
+      break;
+    case ShaderUniform::UniformType::Mat4:
+      glUniformMatrix4fv(location, 1, false, &std::get<Mat4>(value)[0][0]);
+      break;
+    default:
+      assert(false && "Invalid type.");
+      return;
+    }
+
+    m_issuedGlCallCount++;
+  }
+
+  void RHI::InvalidateStateCache()
+  {
+    m_currentReadFramebufferID = UINT_MAX;
+    m_currentDrawFramebufferID = UINT_MAX;
+    m_currentFramebufferID     = UINT_MAX;
+    m_currentVAO               = UINT_MAX;
+    m_state                    = StateCache();
+    m_textureSlots.fill(UINT_MAX);
+  }
+
+  bool RHI::UpdateState(UniformValueCache& cache, GLint location, const void* data, size_t size)
+  {
+    if (cache.Update(location, data, size))
+    {
+      m_issuedGlCallCount++;
+      return true;
+    }
+
+    m_skippedGlCallCount++;
+    return false;
+  }
+
 } // namespace ToolKit
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "ShaderUniform.h"
 #include "Stats.h"
 #include "TKOpenGL.h"
 #include "Types.h"
@@ -23,6 +24,9 @@ namespace ToolKit
     static constexpr uint BrdfLutTextureSize             = 512;
     static constexpr float ShadowBiasMultiplier          = 0.0001f;
 
+    /** Uniform buffer binding point of the PassParameterBlock. Binding points up to 10 are used by global buffers. */
+    static constexpr uint PassParameterBlockSlot         = 11;
+
     /** Update shadow.shader MAX_CASCADE_COUNT accordingly. */
     static constexpr uint MaxCascadeCount                = 4;
 
@@ -46,6 +50,29 @@ namespace ToolKit
 
     /** Update drawDataInc.shader MAX_SPOT_LIGHT_PER_OBJECT accordingly. */
     static constexpr uint MaxSpotLightPerObject          = 24;
+
+    /** Update drawDataInc.shader DIFFUSE_SH_CACHE_ITEM_COUNT accordingly. */
+    static constexpr uint DiffuseSHCacheItemCount        = 32;
+  };
+
+  /**
+   * Last values uploaded to the uniforms of a program. Uniform values are part of the program object, so each program
+   * keeps its own cache. Used by RHI::SetUniform to skip uploads of unchanged values.
+   */
+  class TK_API UniformValueCache
+  {
+   public:
+    /**
+     * Stores the value for the location.
+     * @return True if the value differs from the stored one and needs to be uploaded.
+     */
+    bool Update(GLint location, const void* data, size_t size);
+
+    /** Forgets all values, next uploads are issued regardless of their values. */
+    void Clear();
+
+   private:
+    std::unordered_map<GLint, std::vector<uint8>> m_values;
   };
 
   class TK_API RHI
@@ -57,7 +84,7 @@ namespace ToolKit
     friend class Main;
 
    public:
-    typedef std::unordered_map<int, int> TextureIdSlotMap;
+    typedef std::array<GLuint, RHIConstants::TextureSlotCount> TextureSlotArray;
 
    public:
     /** Sets the given texture to given slot. textureSlot can be between 0 & 31. */
@@ -65,18 +92,120 @@ namespace ToolKit
     static void DeleteTexture(GLuint textureID);
     static void BindVertexArray(GLuint VAO);
 
+    /** Makes the program current. */
+    static void UseProgram(GLuint program);
+    static void DeleteProgram(GLuint program);
+
+    /** @return Program that is current or UINT_MAX if it is not known. */
+    static GLuint GetCurrentProgram();
+
+    /** Binds the uniform buffer to the binding point. */
+    static void BindUniformBuffer(GLuint binding, GLuint buffer);
+    static void DeleteBuffer(GLuint buffer);
+
+    /** Enables or disables a capability such as GL_BLEND. Only blend, cull, depth, stencil and scissor are tracked. */
+    static void SetCapability(GLenum capability, bool enable);
+    static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    static void BlendEquation(GLenum mode);
+    static void CullFace(GLenum mode);
+    static void DepthFunc(GLenum func);
+    static void DepthMask(bool enable);
+    static void ColorMask(bool r, bool g, bool b, bool a);
+    static void StencilFunc(GLenum func, GLint ref, GLuint mask);
+    static void StencilOp(GLenum stencilFail, GLenum depthFail, GLenum depthPass);
+    static void StencilMask(GLuint mask);
+    static void LineWidth(float width);
+
+    /**
+     * Uploads the value to the uniform of the current program if it differs from the value in the cache. The cache
+     * must belong to the current program.
+     */
+    static void SetUniform(UniformValueCache& cache, GLint location, int value);
+    static void SetUniform(UniformValueCache& cache, GLint location, uint value);
+    static void SetUniform(UniformValueCache& cache, GLint location, float value);
+    static void SetUniform(UniformValueCache& cache, GLint location, const Vec2& value);
+    static void SetUniform(UniformValueCache& cache, GLint location, const Vec3& value);
+    static void SetUniform(UniformValueCache& cache, GLint location, const Vec4& value);
+    static void SetUniform(UniformValueCache& cache, GLint location, const Mat3& value);
+    static void SetUniform(UniformValueCache& cache, GLint location, const Mat4& value);
+    static void SetUniformArray(UniformValueCache& cache, GLint location, const int* values, GLsizei count);
+    static void SetUniformArray(UniformValueCache& cache, GLint location, const Vec4* values, GLsizei count);
+
+    /** Uploads the value to the uniform of the current program. Callers are responsible to skip unchanged values. */
+    static void SetUniform(GLint location, const UniformValue& value);
+
+    /**
+     * Forgets all shadowed states, next calls are issued regardless of their values. Must be called after gl state is
+     * changed without going through RHI, such as after a context loss.
+     */
+    static void InvalidateStateCache();
+
    private:
     static void SetFramebuffer(GLenum target, GLuint framebufferID);
     static void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
     static void InvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments);
 
+    /** Counts a state change as issued if the shadowed value is updated, skipped otherwise. */
+    template <typename T>
+    static bool UpdateState(T& shadow, const T& value)
+    {
+      if (shadow == value)
+      {
+        m_skippedGlCallCount++;
+        return false;
+      }
+
+      shadow = value;
+      m_issuedGlCallCount++;
+      return true;
+    }
+
+    /** Counts a uniform upload as issued if the value in the cache is updated, skipped otherwise. */
+    static bool UpdateState(UniformValueCache& cache, GLint location, const void* data, size_t size);
+
    private:
+    /** Indices of the tracked capabilities. */
+    enum Capability
+    {
+      CapabilityBlend,
+      CapabilityCullFace,
+      CapabilityDepthTest,
+      CapabilityStencilTest,
+      CapabilityScissorTest,
+      CapabilityCount
+    };
+
+    /** Shadow of the gl state. UINT_MAX and negative values mark unknown states. */
+    struct StateCache
+    {
+      StateCache() { uniformBuffers.fill(UINT_MAX); }
+
+      GLuint program                    = UINT_MAX;
+      GLuint activeTextureSlot          = UINT_MAX;
+      int capabilities[CapabilityCount] = {-1, -1, -1, -1, -1};
+      std::array<GLenum, 2> blendFunc   = {UINT_MAX, UINT_MAX};
+      GLenum blendEquation              = UINT_MAX;
+      GLenum cullFace                   = UINT_MAX;
+      GLenum depthFunc                  = UINT_MAX;
+      int depthMask                     = -1;
+      int colorMask                     = -1; //!< Channels packed in to the lowest four bits.
+      std::array<GLuint, 3> stencilFunc = {UINT_MAX, UINT_MAX, UINT_MAX};
+      std::array<GLenum, 3> stencilOp   = {UINT_MAX, UINT_MAX, UINT_MAX};
+      GLuint stencilMask                = UINT_MAX;
+      float lineWidth                   = -1.0f;
+      std::array<GLuint, 16> uniformBuffers; //!< Buffers bound to the uniform buffer binding points.
+    };
+
     static GLuint m_currentReadFramebufferID;
     static GLuint m_currentDrawFramebufferID;
     static GLuint m_currentFramebufferID;
     static GLuint m_currentVAO;
 
-    static TextureIdSlotMap m_textureIdSlotMap;
+    static TextureSlotArray m_textureSlots;
+    static StateCache m_state;
+
+    static uint64 m_issuedGlCallCount;  //!< State changes that are sent to gl since the last frame begin.
+    static uint64 m_skippedGlCallCount; //!< State changes that are dropped as redundant since the last frame begin.
   };
 
 } // namespace ToolKit
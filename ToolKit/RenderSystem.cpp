@@ -143,8 +143,15 @@ namespace ToolKit
 
   void RenderSystem::InitGl(void* glGetProcAddres, GlReportCallback callback)
   {
-    // Initialize opengl functions.
-    LoadGlFunctions(glGetProcAddres);
+    // Initialize opengl functions. Headless runs don't have a context, the null backend is loaded instead.
+    if (Main::GetInstance()->m_headless)
+    {
+      LoadNullGlFunctions();
+    }
+    else
+    {
+      LoadGlFunctions(glGetProcAddres);
+    }
 
     InitGLErrorReport(callback);
     TestSRGBBackBuffer();
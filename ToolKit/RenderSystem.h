@@ -96,7 +96,7 @@ namespace ToolKit
 
     /**
      * Host application must provide opengl function addresses. This function
-     * initialize opengl functions.
+     * initialize opengl functions. In headless mode the null backend is loaded and the address is ignored.
      * @param glGetProcAddress is the address of opengl function getter.
      * @param callback is error callback function for opengl.
      */
@@ -98,8 +98,8 @@ namespace ToolKit
     GetLogger()->Log(String("Graphics Card ") + renderer);
 
     // Default states.
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_DEPTH_TEST);
+    RHI::SetCapability(GL_CULL_FACE, true);
+    RHI::SetCapability(GL_DEPTH_TEST, true);
 
     glClearDepthf(1.0f);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -209,7 +209,10 @@ namespace ToolKit
         if (job.animData.blendAnimation != nullptr)
         {
           animTexture = animPlayer->GetAnimationDataTexture(skel->GetIdVal(), job.animData.blendAnimation->GetIdVal());
-          SetTexture(2, animTexture->m_textureId);
+          if (animTexture != nullptr)
+          {
+            SetTexture(2, animTexture->m_textureId);
+          }
         }
       }
       else
@@ -238,22 +241,23 @@ namespace ToolKit
 
     auto activateSkinning = [&](const Mesh* mesh)
     {
-      GLint isSkinnedLoc = m_currentProgram->GetDefaultUniformLocation(Uniform::IS_SKINNED);
-      bool isSkinned     = mesh->IsSkinned();
+      UniformValueCache& uniformCache = m_currentProgram->m_uniformCache;
+      GLint isSkinnedLoc              = m_currentProgram->GetDefaultUniformLocation(Uniform::IS_SKINNED);
+      bool isSkinned                  = mesh->IsSkinned();
       if (isSkinned)
       {
         SkeletonPtr skel = static_cast<SkinMesh*>(job.Mesh)->m_skeleton;
         assert(skel != nullptr);
 
         GLint numBonesLoc = m_currentProgram->GetDefaultUniformLocation(Uniform::NUM_BONES);
-        glUniform1ui(isSkinnedLoc, 1);
+        RHI::SetUniform(uniformCache, isSkinnedLoc, 1u);
 
         GLuint boneCount = (GLuint) skel->m_bones.size();
-        glUniform1f(numBonesLoc, (float) boneCount);
+        RHI::SetUniform(uniformCache, numBonesLoc, (float) boneCount);
       }
       else
       {
-        glUniform1ui(isSkinnedLoc, 0);
+        RHI::SetUniform(uniformCache, isSkinnedLoc, 0u);
       }
     };
 
@@ -330,27 +334,19 @@ namespace ToolKit
     {
       if (targetMode == CullingType::TwoSided)
       {
-        glDisable(GL_CULL_FACE);
+        RHI::SetCapability(GL_CULL_FACE, false);
       }
 
       if (targetMode == CullingType::Front)
       {
-        if (m_renderState.cullMode == CullingType::TwoSided)
-        {
-          glEnable(GL_CULL_FACE);
-        }
-
-        glCullFace(GL_FRONT);
+        RHI::SetCapability(GL_CULL_FACE, true);
+        RHI::CullFace(GL_FRONT);
       }
 
       if (targetMode == CullingType::Back)
       {
-        if (m_renderState.cullMode == CullingType::TwoSided)
-        {
-          glEnable(GL_CULL_FACE);
-        }
-
-        glCullFace(GL_BACK);
+        RHI::SetCapability(GL_CULL_FACE, true);
+        RHI::CullFace(GL_BACK);
       }
 
       m_renderState.cullMode = targetMode;
@@ -365,20 +361,20 @@ namespace ToolKit
         {
         case BlendFunction::SRC_ALPHA_ONE_MINUS_SRC_ALPHA:
         {
-          glEnable(GL_BLEND);
-          glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+          RHI::SetCapability(GL_BLEND, true);
+          RHI::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         }
         break;
         case BlendFunction::ONE_TO_ONE:
         {
-          glEnable(GL_BLEND);
-          glBlendFunc(GL_ONE, GL_ONE);
-          glBlendEquation(GL_FUNC_ADD);
+          RHI::SetCapability(GL_BLEND, true);
+          RHI::BlendFunc(GL_ONE, GL_ONE);
+          RHI::BlendEquation(GL_FUNC_ADD);
         }
         break;
         default:
         {
-          glDisable(GL_BLEND);
+          RHI::SetCapability(GL_BLEND, false);
         }
         break;
         }
@@ -392,7 +388,7 @@ namespace ToolKit
     if (m_renderState.lineWidth != state->lineWidth)
     {
       m_renderState.lineWidth = state->lineWidth;
-      glLineWidth(m_renderState.lineWidth);
+      RHI::LineWidth(m_renderState.lineWidth);
     }
   }
 
@@ -401,24 +397,24 @@ namespace ToolKit
     switch (op)
     {
     case StencilOperation::None:
-      glDisable(GL_STENCIL_TEST);
-      glStencilMask(0x00);
+      RHI::SetCapability(GL_STENCIL_TEST, false);
+      RHI::StencilMask(0x00);
       break;
     case StencilOperation::AllowAllPixels:
-      glEnable(GL_STENCIL_TEST);
-      glStencilMask(0xFF);
-      glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-      glStencilFunc(GL_ALWAYS, 0xFF, 0xFF);
+      RHI::SetCapability(GL_STENCIL_TEST, true);
+      RHI::StencilMask(0xFF);
+      RHI::StencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+      RHI::StencilFunc(GL_ALWAYS, 0xFF, 0xFF);
       break;
     case StencilOperation::AllowPixelsPassingStencil:
-      glEnable(GL_STENCIL_TEST);
-      glStencilFunc(GL_EQUAL, 0xFF, 0xFF);
-      glStencilMask(0x00);
+      RHI::SetCapability(GL_STENCIL_TEST, true);
+      RHI::StencilFunc(GL_EQUAL, 0xFF, 0xFF);
+      RHI::StencilMask(0x00);
       break;
     case StencilOperation::AllowPixelsFailingStencil:
-      glEnable(GL_STENCIL_TEST);
-      glStencilFunc(GL_NOTEQUAL, 0xFF, 0xFF);
-      glStencilMask(0x00);
+      RHI::SetCapability(GL_STENCIL_TEST, true);
+      RHI::StencilFunc(GL_NOTEQUAL, 0xFF, 0xFF);
+      RHI::StencilMask(0x00);
       break;
     }
   }
@@ -514,7 +510,7 @@ namespace ToolKit
     glClear((GLbitfield) fields);
   }
 
-  void Renderer::ColorMask(bool r, bool g, bool b, bool a) { glColorMask(r, g, b, a); }
+  void Renderer::ColorMask(bool r, bool g, bool b, bool a) { RHI::ColorMask(r, g, b, a); }
 
   void Renderer::CopyFrameBuffer(FramebufferPtr src, FramebufferPtr dest, GraphicBitFields fields)
   {
@@ -706,32 +702,15 @@ namespace ToolKit
     m_blendStateOverrideEnable = enableOverride;
   }
 
-  void Renderer::EnableBlending(bool enable)
-  {
-    if (enable)
-    {
-      glEnable(GL_BLEND);
-    }
-    else
-    {
-      glDisable(GL_BLEND);
-    }
-  }
+  void Renderer::EnableBlending(bool enable) { RHI::SetCapability(GL_BLEND, enable); }
 
-  void Renderer::EnableDepthWrite(bool enable) { glDepthMask(enable); }
+  void Renderer::EnableDepthWrite(bool enable) { RHI::DepthMask(enable); }
 
   void Renderer::EnableDepthTest(bool enable)
   {
     if (m_renderState.depthTestEnabled != enable)
     {
-      if (enable)
-      {
-        glEnable(GL_DEPTH_TEST);
-      }
-      else
-      {
-        glDisable(GL_DEPTH_TEST);
-      }
+      RHI::SetCapability(GL_DEPTH_TEST, enable);
       m_renderState.depthTestEnabled = enable;
     }
   }
@@ -741,7 +720,7 @@ namespace ToolKit
     if (m_renderState.depthFunction != func)
     {
       m_renderState.depthFunction = func;
-      glDepthFunc((int) func);
+      RHI::DepthFunc((GLenum) func);
     }
   }
 
@@ -882,28 +861,32 @@ namespace ToolKit
     }
   }
 
-  void Renderer::SetLights(const LightRawPtrArray& lights)
+  void Renderer::SetLights(const FrameArray<Light*>& lights)
   {
     SpotLightCache& spotCache   = m_globalGpuBuffers->spotLightBuffer;
     PointLightCache& pointCache = m_globalGpuBuffers->pointLighBuffer;
 
-    // Update directional light cache.
-    IDArray activePoint, activeSpot;
+    // Slot indexes are stable, the index of the light in the cache is known as soon as it is added. Lights beyond the
+    // per object limit are not added, they can't be referenced by the draw and would evict lights in use.
+    int pointCount              = 0;
+    int spotCount               = 0;
     for (Light* light : lights)
     {
       if (light->GetLightType() == Light::Point)
       {
-        PointLight* pl                   = static_cast<PointLight*>(light);
-        const PointLightCacheItem& cache = pl->GetCacheItem();
-        pointCache.AddOrUpdateItem(cache);
-        activePoint.push_back(cache.id);
+        if (pointCount < (int) RHIConstants::MaxPointLightPerObject)
+        {
+          PointLight* pl                          = static_cast<PointLight*>(light);
+          m_activePointLightIndices[pointCount++] = pointCache.AddOrUpdateItem(pl->GetCacheItem());
+        }
       }
       else if (light->GetLightType() == Light::Spot)
       {
-        SpotLight* sl                   = static_cast<SpotLight*>(light);
-        const SpotLightCacheItem& cache = sl->GetCacheItem();
-        spotCache.AddOrUpdateItem(cache);
-        activeSpot.push_back(cache.id);
+        if (spotCount < (int) RHIConstants::MaxSpotLightPerObject)
+        {
+          SpotLight* sl                         = static_cast<SpotLight*>(light);
+          m_activeSpotLightIndices[spotCount++] = spotCache.AddOrUpdateItem(sl->GetCacheItem());
+        }
       }
     }
 
@@ -923,24 +906,10 @@ namespace ToolKit
       }
     }
 
-    // Look up indexes from cache.
-    auto updateData = [](int& updateCount, IntArray& cpuIndex, int* gpuIndex) -> void
-    {
-      int limit   = (int) cpuIndex.size();
-      updateCount = limit;
-
-      for (int i = 0; i < limit; i++)
-      {
-        gpuIndex[i] = cpuIndex[i];
-      }
-    };
-
-    IntArray indexes = pointCache.LookUp(activePoint, RHIConstants::MaxPointLightPerObject);
-    updateData(m_activePointLightCount, indexes, m_activePointLightIndices.data());
+    m_activePointLightCount = pointCount;
     m_drawCommand.SetActivePointLightCount(m_activePointLightCount);
 
-    indexes = spotCache.LookUp(activeSpot, RHIConstants::MaxSpotLightPerObject);
-    updateData(m_activeSpotLightCount, indexes, m_activeSpotLightIndices.data());
+    m_activeSpotLightCount = spotCount;
     m_drawCommand.SetActiveSpotLightCount(m_activeSpotLightCount);
   }
 
@@ -956,11 +925,9 @@ namespace ToolKit
 
   void Renderer::BindProgram(const GpuProgramPtr& program)
   {
-    if (m_currentProgram == nullptr || m_currentProgram->m_handle != program->m_handle)
-    {
-      m_currentProgram = program;
-      glUseProgram(program->m_handle);
-    }
+    // Program manager may change the current program while creating programs, RHI knows the actual one.
+    m_currentProgram = program;
+    RHI::UseProgram(program->m_handle);
   }
 
   void Renderer::ResetUsedTextureSlots()
@@ -988,6 +955,7 @@ namespace ToolKit
 
     // Sky and Ibl data.
     m_drawCommand.SetIblInUse(false);
+    m_drawCommand.SetDiffuseSHIndex(-1);
     const EnvironmentComponent* envCom = job.EnvironmentVolume;
     if (envCom)
     {
@@ -995,9 +963,22 @@ namespace ToolKit
       CubeMapPtr& diffuseEnvMap  = hdriPtr->m_diffuseEnvMap;
       CubeMapPtr& specularEnvMap = hdriPtr->m_specularEnvMap;
 
-      if (diffuseEnvMap && specularEnvMap && m_brdfLut)
+      // Spherical harmonics are also used when the hdri has no diffuse env map.
+      bool useDiffuseSH          = hdriPtr->m_diffuseSH.isValid && (envCom->GetDiffuseSHVal() || !diffuseEnvMap);
+
+      if ((diffuseEnvMap || useDiffuseSH) && specularEnvMap && m_brdfLut)
       {
-        SetTexture(7, diffuseEnvMap->m_textureId);
+        if (useDiffuseSH)
+        {
+          DiffuseSHCache& shCache = m_globalGpuBuffers->diffuseSHBuffer;
+          m_drawCommand.SetDiffuseSHIndex(shCache.AddOrUpdateItem(hdriPtr->m_diffuseSH));
+          shCache.Map();
+        }
+        else
+        {
+          SetTexture(7, diffuseEnvMap->m_textureId);
+        }
+
         SetTexture(15, specularEnvMap->m_textureId);
         SetTexture(16, m_brdfLut->m_textureId);
 
@@ -1041,6 +1022,8 @@ namespace ToolKit
 
   void Renderer::FeedUniforms(const GpuProgramPtr& program, const RenderJob& job)
   {
+    UniformValueCache& uniformCache = program->m_uniformCache;
+
     // Built-in shader uniforms.
     for (auto& uniform : program->m_defaultUniformLocation)
     {
@@ -1050,22 +1033,22 @@ namespace ToolKit
         switch (uniform.first)
         {
         case Uniform::MODEL:
-          glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&m_model));
+          RHI::SetUniform(uniformCache, loc, m_model);
           break;
         case Uniform::MODEL_WITHOUT_TRANSLATE:
-          glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&m_modelWithoutTranslate));
+          RHI::SetUniform(uniformCache, loc, m_modelWithoutTranslate);
           break;
         case Uniform::INVERSE_MODEL:
-          glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&m_inverseModel));
+          RHI::SetUniform(uniformCache, loc, m_inverseModel);
           break;
         case Uniform::INVERSE_TRANSPOSE_MODEL:
-          glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&m_inverseTransposeModel));
+          RHI::SetUniform(uniformCache, loc, m_inverseTransposeModel);
           break;
         case Uniform::IBL_ROTATION:
-          glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&m_iblRotation));
+          RHI::SetUniform(uniformCache, loc, m_iblRotation);
           break;
         case Uniform::NORMAL_MAP_IN_USE:
-          glUniform1i(loc, m_normalMapInUse);
+          RHI::SetUniform(uniformCache, loc, (int) m_normalMapInUse);
           break;
         default:
           break;
@@ -1084,7 +1067,10 @@ namespace ToolKit
         int loc = program->GetDefaultUniformLocation(Uniform::DRAW_COMMAND, 0);
         if (loc != -1)
         {
-          glUniform4fv(loc, sizeof(DrawCommand) / sizeof(Vec4), (float*) &m_drawCommand);
+          RHI::SetUniformArray(uniformCache,
+                               loc,
+                               reinterpret_cast<const Vec4*>(&m_drawCommand),
+                               sizeof(DrawCommand) / sizeof(Vec4));
         }
       }
       break;
@@ -1093,10 +1079,7 @@ namespace ToolKit
         int loc = program->GetDefaultUniformLocation(Uniform::ACTIVE_POINT_LIGHT_INDEXES, 0);
         if (loc != -1)
         {
-          if (m_activePointLightCount > 0)
-          {
-            glUniform1iv(loc, m_activePointLightCount, m_activePointLightIndices.data());
-          }
+          RHI::SetUniformArray(uniformCache, loc, m_activePointLightIndices.data(), m_activePointLightCount);
         }
       }
       break;
@@ -1105,10 +1088,7 @@ namespace ToolKit
         int loc = program->GetDefaultUniformLocation(Uniform::ACTIVE_SPOT_LIGHT_INDEXES, 0);
         if (loc != -1)
         {
-          if (m_activeSpotLightCount > 0)
-          {
-            glUniform1iv(loc, m_activeSpotLightCount, m_activeSpotLightIndices.data());
-          }
+          RHI::SetUniformArray(uniformCache, loc, m_activeSpotLightIndices.data(), m_activeSpotLightCount);
         }
       }
       break;
@@ -1138,53 +1118,26 @@ namespace ToolKit
       }
     }
 
-    // Custom shader uniforms.
-    for (auto& uniform : program->m_customUniforms)
+    // Custom shader uniforms. Only the changed ones are uploaded, values stay in the program.
+    for (GpuProgram::CustomUniform& uniform : program->m_customUniforms)
     {
-      GLint loc = program->GetCustomUniformLocation(uniform.second);
-      switch (uniform.second.GetType())
+      if (uniform.dirty)
       {
-      case ShaderUniform::UniformType::Bool:
-        glUniform1ui(loc, uniform.second.GetVal<bool>());
-        break;
-      case ShaderUniform::UniformType::Float:
-        glUniform1f(loc, uniform.second.GetVal<float>());
-        break;
-      case ShaderUniform::UniformType::Int:
-        glUniform1i(loc, uniform.second.GetVal<int>());
-        break;
-      case ShaderUniform::UniformType::UInt:
-        glUniform1ui(loc, uniform.second.GetVal<uint>());
-        break;
-      case ShaderUniform::UniformType::Vec2:
-        glUniform2fv(loc, 1, reinterpret_cast<float*>(&uniform.second.GetVal<Vec2>()));
-        break;
-      case ShaderUniform::UniformType::Vec3:
-        glUniform3fv(loc, 1, reinterpret_cast<float*>(&uniform.second.GetVal<Vec3>()));
-        break;
-      case ShaderUniform::UniformType::Vec4:
-        glUniform4fv(loc, 1, reinterpret_cast<float*>(&uniform.second.GetVal<Vec4>()));
-        break;
-      case ShaderUniform::UniformType::Mat3:
-        glUniformMatrix3fv(loc, 1, false, reinterpret_cast<float*>(&uniform.second.GetVal<Mat3>()));
-        break;
-      case ShaderUniform::UniformType::Mat4:
-        glUniformMatrix4fv(loc, 1, false, reinterpret_cast<float*>(&uniform.second.GetVal<Mat4>()));
-        break;
-      default:
-        assert(false && "Invalid type.");
-        break;
+        RHI::SetUniform(uniform.location, uniform.value);
+        uniform.dirty = false;
       }
     }
   }
 
   void Renderer::FeedAnimationUniforms(const GpuProgramPtr& program, const RenderJob& job)
   {
+    UniformValueCache& uniformCache = program->m_uniformCache;
+
     // Send if its animated or not.
     int uniformLoc = program->GetDefaultUniformLocation(Uniform::IS_ANIMATED);
     if (uniformLoc != -1)
     {
-      glUniform1ui(uniformLoc, job.animData.currentAnimation != nullptr);
+      RHI::SetUniform(uniformCache, uniformLoc, (uint) (job.animData.currentAnimation != nullptr));
     }
 
     if (job.animData.currentAnimation == nullptr)
@@ -1197,7 +1150,7 @@ namespace ToolKit
     uniformLoc = program->GetDefaultUniformLocation(Uniform::KEY_FRAME_COUNT);
     if (uniformLoc != -1)
     {
-      glUniform1f(uniformLoc, job.animData.keyFrameCount);
+      RHI::SetUniform(uniformCache, uniformLoc, job.animData.keyFrameCount);
     }
 
     if (job.animData.keyFrameCount > 0)
@@ -1205,19 +1158,19 @@ namespace ToolKit
       uniformLoc = program->GetDefaultUniformLocation(Uniform::KEY_FRAME_1);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.firstKeyFrame);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.firstKeyFrame);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::KEY_FRAME_2);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.secondKeyFrame);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.secondKeyFrame);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::KEY_FRAME_INT_TIME);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.keyFrameInterpolationTime);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.keyFrameInterpolationTime);
       }
     }
 
@@ -1225,7 +1178,7 @@ namespace ToolKit
     uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_ANIMATION);
     if (uniformLoc != -1)
     {
-      glUniform1i(uniformLoc, job.animData.blendAnimation != nullptr);
+      RHI::SetUniform(uniformCache, uniformLoc, (int) (job.animData.blendAnimation != nullptr));
     }
 
     if (job.animData.blendAnimation != nullptr)
@@ -1233,31 +1186,31 @@ namespace ToolKit
       uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_FACTOR);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.animationBlendFactor);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.animationBlendFactor);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_KEY_FRAME_1);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.blendFirstKeyFrame);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.blendFirstKeyFrame);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_KEY_FRAME_2);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.blendSecondKeyFrame);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.blendSecondKeyFrame);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_KEY_FRAME_INT_TIME);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.blendKeyFrameInterpolationTime);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.blendKeyFrameInterpolationTime);
       }
 
       uniformLoc = program->GetDefaultUniformLocation(Uniform::BLEND_KEY_FRAME_COUNT);
       if (uniformLoc != -1)
       {
-        glUniform1f(uniformLoc, job.animData.blendKeyFrameCount);
+        RHI::SetUniform(uniformCache, uniformLoc, job.animData.blendKeyFrameCount);
       }
     }
   }
@@ -1444,6 +1397,35 @@ namespace ToolKit
     }
   }
 
+  void Renderer::ReadCubeMapLevel(CubeMapPtr cubemap, int level, std::vector<float>& pixels)
+  {
+    int size = glm::max(1, cubemap->m_width >> level);
+    pixels.resize((size_t) size * size * 4 * 6);
+
+    FramebufferSettings fbs;
+    fbs.width                 = cubemap->m_width;
+    fbs.height                = cubemap->m_height;
+    fbs.useDefaultDepth       = false;
+
+    FramebufferPtr readBuffer = MakeNewPtr<Framebuffer>(fbs);
+    readBuffer->Init();
+
+    FramebufferPtr prevBuffer = GetFrameBuffer();
+    for (int i = 0; i < 6; i++)
+    {
+      // Attaching binds the buffer for reading as well.
+      readBuffer->SetColorAttachment(Framebuffer::Attachment::ColorAttachment0,
+                                     cubemap->m_consumedRT,
+                                     level,
+                                     -1,
+                                     Framebuffer::CubemapFace(i));
+
+      glReadPixels(0, 0, size, size, GL_RGBA, GL_FLOAT, pixels.data() + (size_t) i * size * size * 4);
+    }
+
+    SetFramebuffer(prevBuffer, GraphicBitFields::None);
+  }
+
   CubeMapPtr Renderer::GenerateDiffuseEnvMap(CubeMapPtr cubemap, int size)
   {
     const TextureSettings set = {GraphicTypes::TargetCubeMap,
@@ -1516,6 +1498,37 @@ namespace ToolKit
     return newCubeMap;
   }
 
+  SH9 Renderer::GenerateDiffuseSH(CubeMapPtr cubemap)
+  {
+    // Low frequency lighting doesn't need the full resolution. Radiance is projected from a small, box filtered mip of
+    // a copy, mip levels of the source are not touched.
+    TextureSettings set    = cubemap->Settings();
+    set.MinFilter          = GraphicTypes::SampleLinearMipmapLinear;
+    set.GenerateMipMap     = false;
+
+    RenderTargetPtr copyRt = MakeNewPtr<RenderTarget>(cubemap->m_width, cubemap->m_height, set, "DiffuseSHSourceRT");
+    copyRt->Init();
+
+    CubeMapPtr copy = MakeNewPtr<CubeMap>();
+    copy->Consume(copyRt);
+
+    CopyCubeMapToMipLevel(cubemap, copy, 0);
+    copy->AllocateMipMapStorage();
+    copy->GenerateMipMaps();
+
+    const int maxProjectionSize = 32;
+    int level                   = 0;
+    while ((copy->m_width >> level) > maxProjectionSize)
+    {
+      level++;
+    }
+
+    std::vector<float> pixels;
+    ReadCubeMapLevel(copy, level, pixels);
+
+    return SH9::ProjectCubeMap(pixels.data(), glm::max(1, copy->m_width >> level)).ToIrradiance();
+  }
+
   CubeMapPtr Renderer::GenerateSpecularEnvMap(CubeMapPtr cubemap, int size, int mipMaps)
   {
     const TextureSettings set = {GraphicTypes::TargetCubeMap,
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Camera.h"
+#include "FrameAllocator.h"
 #include "GenericBuffers.h"
 #include "GpuProgram.h"
 #include "Material.h"
@@ -15,6 +16,7 @@
 #include "RHI.h"
 #include "RenderState.h"
 #include "Sky.h"
+#include "SphericalHarmonics.h"
 #include "Types.h"
 #include "Viewport.h"
 
@@ -26,7 +28,7 @@ namespace ToolKit
 
   struct DrawCommand
   {
-    /** x: iblIntensity, y: iblInUse, z: ambientOcclusionInUse, w: pad0 */
+    /** x: iblIntensity, y: iblInUse, z: ambientOcclusionInUse, w: diffuseSHIndex */
     Vec4 data1;
 
     /** x: activePointLightCount, y: activeSpotLightCount, z: activeDirectionalLightCount, w: pad1 */
@@ -38,6 +40,9 @@ namespace ToolKit
 
     void SetAmbientOcclusionInUse(bool inUse) { data1.z = inUse ? 1.0f : 0.0f; }
 
+    /** Index of the environment in the diffuse sh cache, -1 if diffuse irradiance is sampled from the cube map. */
+    void SetDiffuseSHIndex(int index) { data1.w = (float) index; }
+
     void SetActivePointLightCount(int count) { data2.x = (float) count; }
 
     void SetActiveSpotLightCount(int count) { data2.y = (float) count; }
@@ -85,6 +90,10 @@ namespace ToolKit
     SpotLightCache spotLightBuffer;
     int spotLightBufferId = 0;
 
+    /** Cached diffuse irradiance coefficients of the environments in gpu. */
+    DiffuseSHCache diffuseSHBuffer;
+    int diffuseSHBufferId = 0;
+
     void InitGlobalGpuBuffers()
     {
       graphicConstantBuffer.Init();
@@ -102,6 +111,9 @@ namespace ToolKit
 
       spotLightBuffer.Init();
       spotLightBufferId = spotLightBuffer.m_gpuBuffer.m_id;
+
+      diffuseSHBuffer.Init();
+      diffuseSHBufferId = diffuseSHBuffer.m_gpuBuffer.m_id;
     }
   };
 
@@ -192,12 +204,21 @@ namespace ToolKit
     /** Copies the source cube map into destination cube map's given mip level. Expects cubemaps tobe rgba float. */
     void CopyCubeMapToMipLevel(CubeMapPtr src, CubeMapPtr dst, int mipLevel);
 
+    /**
+     * Reads back all faces of the cube map's mip level as rgba float, in the cube map face order. Cube map must be
+     * consumed from a render target.
+     */
+    void ReadCubeMapLevel(CubeMapPtr cubemap, int level, std::vector<float>& pixels);
+
     /** Generates specular environment for given number of mip levels. */
     CubeMapPtr GenerateSpecularEnvMap(CubeMapPtr cubemap, int size, int mipMaps);
 
     /** Generates irradiance map. */
     CubeMapPtr GenerateDiffuseEnvMap(CubeMapPtr cubemap, int size);
 
+    /** Projects the cube map on to spherical harmonics and returns the irradiance coefficients. */
+    SH9 GenerateDiffuseSH(CubeMapPtr cubemap);
+
     /**
      * Sets the blend state directly which causes by passing material system.
      * @param enableOverride when set true, disables the material system setting blend state per material.
@@ -247,7 +268,7 @@ namespace ToolKit
     void SetMaterial(Material* mat);
 
     /** Sets active lights to be used in the render. Doesn't include directional lights. */
-    void SetLights(const LightRawPtrArray& lights);
+    void SetLights(const FrameArray<Light*>& lights);
 
     /**
      * Sets directional lights to be used for render. Should be called once per pass because all objects effected from
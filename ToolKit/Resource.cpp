@@ -9,6 +9,7 @@
 
 #include "FileManager.h"
 #include "Material.h"
+#include "MemoryTracker.h"
 #include "Mesh.h"
 #include "ResourceManager.h"
 #include "Skeleton.h"
@@ -24,11 +25,13 @@ namespace ToolKit
 
   Resource::Resource()
   {
-    static ObjectId globalCounter = 1;
-    m_name                        = "Resource_" + std::to_string(globalCounter++);
+    static std::atomic<ObjectId> globalCounter {1}; // Resources may be constructed from loader threads.
+    m_name = "Resource_" + std::to_string(globalCounter++);
+
+    MemoryTracker::OnResourceCreated();
   }
 
-  Resource::~Resource() {}
+  Resource::~Resource() { MemoryTracker::OnResourceDestroyed(); }
 
   void Resource::Save(bool onlyIfDirty)
   {
@@ -85,6 +88,10 @@ namespace ToolKit
 
   bool Resource::IsDynamic() { return GetFile().empty(); }
 
+  uint64 Resource::GetCpuMemory() const { return 0; }
+
+  uint64 Resource::GetGpuMemory() const { return 0; }
+
   void Resource::CopyTo(Resource* other)
   {
     assert(other->Class() == Class());
@@ -70,6 +70,12 @@ namespace ToolKit
      */
     bool IsDynamic();
 
+    /** @return Bytes of cpu memory held by the resource, such as client side arrays and decoded images. */
+    virtual uint64 GetCpuMemory() const;
+
+    /** @return Bytes of gpu memory held by the resource, such as buffers and textures. */
+    virtual uint64 GetGpuMemory() const;
+
    protected:
     virtual void CopyTo(Resource* other);
 
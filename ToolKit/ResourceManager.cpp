@@ -39,23 +39,25 @@ namespace ToolKit
 
   void ResourceManager::Manage(ResourcePtr resource)
   {
-    String file  = resource->GetFile();
-    bool sane    = !file.empty();
-    sane        &= !Exist(file);
-    sane        &= CanStore(resource->Class());
-
-    if (sane)
+    String file = resource->GetFile();
+    if (!file.empty() && CanStore(resource->Class()))
     {
-      m_storage[file] = resource;
+      Store(file, resource);
     }
   }
 
   String ResourceManager::GetDefaultResource(ClassMeta* Class) { return String(); }
 
-  bool ResourceManager::Exist(const String& file) { return m_storage.find(file) != m_storage.end(); }
+  bool ResourceManager::Exist(const String& file)
+  {
+    SpinlockGuard lock(m_storageLock);
+    return m_storage.find(file) != m_storage.end();
+  }
 
   ResourcePtr ResourceManager::Remove(const String& file)
   {
+    SpinlockGuard lock(m_storageLock);
+
     ResourcePtr resource = nullptr;
     auto mapItr          = m_storage.find(file);
     if (mapItr != m_storage.end())
@@ -67,4 +69,42 @@ namespace ToolKit
     return resource;
   }
 
+  ResourcePtr ResourceManager::Find(const String& file)
+  {
+    SpinlockGuard lock(m_storageLock);
+
+    auto mapItr = m_storage.find(file);
+    if (mapItr != m_storage.end())
+    {
+      return mapItr->second;
+    }
+
+    return nullptr;
+  }
+
+  void ResourceManager::GatherMemoryUsage(MemoryRecordArray& records)
+  {
+    SpinlockGuard lock(m_storageLock);
+
+    for (auto& item : m_storage)
+    {
+      const ResourcePtr& resource = item.second;
+
+      MemoryRecord& record        = records.emplace_back();
+      record.type                 = resource->Class()->Name;
+      record.name                 = item.first;
+      record.cpu                  = (int64) resource->GetCpuMemory();
+      record.gpu                  = (int64) resource->GetGpuMemory();
+    }
+  }
+
+  ResourcePtr ResourceManager::Store(const String& file, ResourcePtr resource)
+  {
+    SpinlockGuard lock(m_storageLock);
+
+    // Don't replace a resource that is stored by an other thread while this one is loading.
+    auto result = m_storage.try_emplace(file, resource);
+    return result.first->second;
+  }
+
 } // namespace ToolKit
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Logger.h"
+#include "MemoryTracker.h"
 #include "ObjectFactory.h"
 #include "Resource.h"
 #include "ToolKit.h"
@@ -33,37 +34,44 @@ namespace ToolKit
     ResourceManager(const ResourceManager&) = delete;
     void operator=(const ResourceManager&)  = delete;
 
+    /**
+     * Returns the resource for the given file. If the resource is not in the storage, creates and loads it.
+     * Can be called from multiple threads. Loading is done outside of the storage lock, if the same file is requested
+     * concurrently, the resource stored first is returned to all callers.
+     */
     template <typename T>
     std::shared_ptr<T> Create(const String& file, ProgressCallback progressCallback = nullptr)
     {
-      if (!Exist(file))
+      if (ResourcePtr stored = Find(file))
       {
-        ResourcePtr resource = MakeNewPtr<T>();
-        if (!CheckFile(file))
-        {
-          String def = GetDefaultResource(T::StaticClass());
-          if (!CheckFile(def))
-          {
-            TK_ERR("No default for Class %s", T::StaticClass()->Name.c_str());
-            assert(0 && "No default resource!");
-            return nullptr;
-          }
-
-          String rel = GetRelativeResourcePath(file);
-          TK_WRN("File: %s is missing. Using default resource.", rel.c_str());
-          resource->SetFile(def);
-          resource->_missingFile = file;
-        }
-        else
+        return tk_reinterpret_pointer_cast<T>(stored);
+      }
+
+      ResourcePtr resource = MakeNewPtr<T>();
+      if (!CheckFile(file))
+      {
+        String def = GetDefaultResource(T::StaticClass());
+        if (!CheckFile(def))
         {
-          resource->SetFile(file);
+          TK_ERR("No default for Class %s", T::StaticClass()->Name.c_str());
+          assert(0 && "No default resource!");
+          return nullptr;
         }
 
-        resource->SetProgressCallback(progressCallback);
-        resource->Load();
-        m_storage[file] = resource;
+        String rel = GetRelativeResourcePath(file);
+        TK_WRN("File: %s is missing. Using default resource.", rel.c_str());
+        resource->SetFile(def);
+        resource->_missingFile = file;
+      }
+      else
+      {
+        resource->SetFile(file);
       }
-      return tk_reinterpret_pointer_cast<T>(m_storage[file]);
+
+      resource->SetProgressCallback(progressCallback);
+      resource->Load();
+
+      return tk_reinterpret_pointer_cast<T>(Store(file, resource));
     }
 
     template <typename T>
@@ -82,9 +90,25 @@ namespace ToolKit
     bool Exist(const String& file);
     ResourcePtr Remove(const String& file);
 
+    /** Returns the stored resource for the given file or nullptr if it does not exist. Thread safe. */
+    ResourcePtr Find(const String& file);
+
+    /** Appends the cpu and gpu memory held by each stored resource to the records. Thread safe. */
+    void GatherMemoryUsage(MemoryRecordArray& records);
+
+   protected:
+    /**
+     * Stores the resource for the given file if there is not any. Thread safe.
+     * @return The resource in the storage for the file, which is either the given one or the one stored before.
+     */
+    ResourcePtr Store(const String& file, ResourcePtr resource);
+
    public:
     std::unordered_map<String, ResourcePtr> m_storage;
     ClassMeta* m_baseType = nullptr;
+
+   protected:
+    Spinlock m_storageLock; //!< Guards the storage against concurrent access from Create, Manage, Exist and Remove.
   };
 
 } // namespace ToolKit
@@ -196,6 +196,113 @@ namespace ToolKit
     }
   }
 
+  void Scene::SaveSimulationState()
+  {
+    RestoreSimulationState();
+
+    auto readLocalTransform = [](Node* node) -> LocalTransform
+    {
+      return {node->GetTranslation(TransformationSpace::TS_LOCAL),
+              node->GetOrientation(TransformationSpace::TS_LOCAL),
+              node->GetScale()};
+    };
+
+    // Realign the states with the entity list, entities that are kept preserve their states.
+    if (m_simulationStateRevision != m_entityListRevision)
+    {
+      std::unordered_map<ObjectId, SimulationState> oldStates;
+      for (const SimulationState& state : m_simulationStates)
+      {
+        oldStates[state.id] = state;
+      }
+
+      m_simulationStates.resize(m_entities.size());
+      for (size_t i = 0; i < m_entities.size(); i++)
+      {
+        const EntityPtr& ntt = m_entities[i];
+        auto oldState        = oldStates.find(ntt->GetIdVal());
+        if (oldState != oldStates.end() && oldState->second.entity.lock() == ntt)
+        {
+          m_simulationStates[i] = oldState->second;
+        }
+        else
+        {
+          m_simulationStates[i].entity = ntt;
+          m_simulationStates[i].id     = ntt->GetIdVal();
+          m_simulationStates[i].latest = readLocalTransform(ntt->m_node);
+        }
+      }
+
+      m_simulationStateRevision = m_entityListRevision;
+    }
+
+    for (size_t i = 0; i < m_entities.size(); i++)
+    {
+      SimulationState& state   = m_simulationStates[i];
+      state.previous           = state.latest;
+      state.latest             = readLocalTransform(m_entities[i]->m_node);
+
+      const LocalTransform& t0 = state.previous;
+      const LocalTransform& t1 = state.latest;
+      bool translated          = !VecAllEqual(t0.translation, t1.translation);
+      bool scaled              = !VecAllEqual(t0.scale, t1.scale);
+      state.moving             = translated || scaled || t0.orientation != t1.orientation;
+    }
+  }
+
+  void Scene::InterpolateSimulationState(float alpha)
+  {
+    // States are stale if the entity list is changed after the last tick.
+    if (m_simulationStateRevision != m_entityListRevision)
+    {
+      return;
+    }
+
+    for (SimulationState& state : m_simulationStates)
+    {
+      if (!state.moving)
+      {
+        continue;
+      }
+
+      if (EntityPtr ntt = state.entity.lock())
+      {
+        const LocalTransform& t0 = state.previous;
+        const LocalTransform& t1 = state.latest;
+        ntt->m_node->SetLocalTransforms(glm::mix(t0.translation, t1.translation, alpha),
+                                        glm::slerp(t0.orientation, t1.orientation, alpha),
+                                        glm::mix(t0.scale, t1.scale, alpha));
+      }
+    }
+
+    m_simulationStateInterpolated = true;
+  }
+
+  void Scene::RestoreSimulationState()
+  {
+    if (!m_simulationStateInterpolated)
+    {
+      return;
+    }
+
+    // Entity list may be changed since the interpolation, entities that are destroyed are skipped.
+    for (SimulationState& state : m_simulationStates)
+    {
+      if (!state.moving)
+      {
+        continue;
+      }
+
+      if (EntityPtr ntt = state.entity.lock())
+      {
+        const LocalTransform& t1 = state.latest;
+        ntt->m_node->SetLocalTransforms(t1.translation, t1.orientation, t1.scale);
+      }
+    }
+
+    m_simulationStateInterpolated = false;
+  }
+
   void Scene::Merge(ScenePtr other)
   {
     HandleManager* handleMan = GetHandleManager();
@@ -307,26 +414,28 @@ namespace ToolKit
 
   EntityPtr Scene::GetEntity(ObjectId id, int* index) const
   {
-    for (int i = 0; i < (int) m_entities.size(); i++)
+    auto nttItr = m_entityLookup.find(id);
+    if (nttItr == m_entityLookup.end())
     {
-      EntityPtr ntt = m_entities[i];
-      if (ntt->GetIdVal() == id)
+      if (index != nullptr)
       {
-        if (index != nullptr)
-        {
-          *index = i;
-        }
-
-        return ntt;
+        *index = -1;
       }
+
+      return nullptr;
     }
 
+    const EntityPtr& ntt = nttItr->second;
     if (index != nullptr)
     {
-      *index = -1;
+      // Index is only needed for modifying the list, which is linear already.
+      auto listItr = std::find(m_entities.begin(), m_entities.end(), ntt);
+      assert(listItr != m_entities.end() && "Entity look up is out of sync with the entity list.");
+
+      *index = listItr == m_entities.end() ? -1 : (int) std::distance(m_entities.begin(), listItr);
     }
 
-    return nullptr;
+    return ntt;
   }
 
   void Scene::AddEntity(EntityPtr entity, int index)
@@ -349,6 +458,8 @@ namespace ToolKit
         }
 
         UpdateEntityCaches(entity, true);
+        m_entityListRevision++;
+        m_entityLookup[entity->GetIdVal()] = entity;
 
         if (index < 0 || index >= (int) m_entities.size())
         {
@@ -413,6 +524,8 @@ namespace ToolKit
 
     UpdateEntityCaches(removed, false);
     m_entities.erase(m_entities.begin() + indx);
+    m_entityLookup.erase(id);
+    m_entityListRevision++;
 
     if (deep)
     {
@@ -442,10 +555,17 @@ namespace ToolKit
     }
   }
 
-  void Scene::RemoveAllEntities() { m_entities.clear(); }
+  void Scene::RemoveAllEntities()
+  {
+    m_entities.clear();
+    m_entityLookup.clear();
+    m_entityListRevision++;
+  }
 
   const EntityPtrArray& Scene::GetEntities() const { return m_entities; }
 
+  uint64 Scene::GetEntityListRevision() const { return m_entityListRevision; }
+
   const LightRawPtrArray& Scene::GetLights() const { return m_lightCache; }
 
   const LightRawPtrArray& Scene::GetDirectionalLights() const { return m_directionalLightCache; }
@@ -556,6 +676,8 @@ namespace ToolKit
     }
 
     m_entities.clear();
+    m_entityLookup.clear();
+    m_entityListRevision++;
     m_aabbTree.Reset();
 
     m_lightCache.clear();
@@ -577,14 +699,24 @@ namespace ToolKit
     // Construct prefab.
     ScenePtr prefab            = MakeNewPtr<Scene>();
     prefab->AddEntity(entity);
-    GetChildren(entity, prefab->m_entities);
+
+    // Children are only listed for saving, they stay in this scene.
+    EntityPtrArray children;
+    GetChildren(entity, children);
+    for (const EntityPtr& child : children)
+    {
+      prefab->m_entities.push_back(child);
+      prefab->m_entityLookup[child->GetIdVal()] = child;
+    }
+    prefab->m_entityListRevision++;
+
     String prefabName = name.empty() ? entity->GetNameVal() + SCENE : name + SCENE;
     String prefabPath = path.empty() ? prefabName : ConcatPaths({path, prefabName});
     String fullPath   = PrefabPath(prefabPath);
     prefab->SetFile(fullPath);
     prefab->m_name = name;
     prefab->Save(false);
-    prefab->m_entities.clear();
+    prefab->RemoveAllEntities();
 
     // Restore the old node.
     entity->m_node->m_children.clear();
@@ -596,6 +728,8 @@ namespace ToolKit
   {
     m_aabbTree.Reset();
     m_entities.clear();
+    m_entityLookup.clear();
+    m_entityListRevision++;
   }
 
   const BoundingBox& Scene::GetSceneBoundary() { return m_aabbTree.GetRootBoundingBox(); }
@@ -614,6 +748,12 @@ namespace ToolKit
     {
       DeepCopy(ntt, cpy->m_entities);
     }
+
+    cpy->m_entityLookup.reserve(cpy->m_entities.size());
+    for (const EntityPtr& ntt : cpy->m_entities)
+    {
+      cpy->m_entityLookup[ntt->GetIdVal()] = ntt;
+    }
   }
 
   void Scene::UpdateEntityCaches(const EntityPtr& ntt, bool add)
@@ -733,10 +873,14 @@ namespace ToolKit
     const char* xmlRootObject = XmlEntityElement.c_str();
     const char* xmlObjectType = XmlEntityTypeAttr.c_str();
 
-    EntityPtrArray prefabList;
-    EntityPtrArray deserializedEntities;
-
+    std::vector<XmlNode*> entityNodes;
     for (XmlNode* node = parent->first_node(xmlRootObject); node; node = node->next_sibling(xmlRootObject))
+    {
+      entityNodes.push_back(node);
+    }
+
+    // Ids are regenerated after the relations are solved, the file ids are used until then.
+    auto deserializeFn = [&](XmlNode* node) -> EntityPtr
     {
       XmlAttribute* typeAttr      = node->first_attribute(xmlObjectType);
       EntityFactory::EntityType t = (EntityFactory::EntityType) std::atoi(typeAttr->value());
@@ -744,12 +888,6 @@ namespace ToolKit
       ntt->m_version              = m_version;
 
       ntt->DeSerialize(info, node);
-      UpdateProgress(1);
-
-      if (ntt->IsA<Prefab>())
-      {
-        prefabList.push_back(ntt);
-      }
 
       // Old file id trick.
       ObjectId id = 0;
@@ -757,19 +895,34 @@ namespace ToolKit
 
       // Temporary id. This will be regenerated later. Do not use this id until it is regenerated later.
       ntt->SetIdVal(id);
-      deserializedEntities.push_back(ntt);
+      return ntt;
+    };
+
+    EntityPtrArray deserializedEntities;
+    DeSerializeEntities(entityNodes, deserializeFn, deserializedEntities, false);
+
+    EntityPtrArray prefabList;
+    std::unordered_map<ObjectId, Entity*> entityById;
+    entityById.reserve(deserializedEntities.size());
+
+    for (const EntityPtr& ntt : deserializedEntities)
+    {
+      if (ntt->IsA<Prefab>())
+      {
+        prefabList.push_back(ntt);
+      }
+
+      // First entity with the id is the parent in case of duplicates.
+      entityById.emplace(ntt->GetIdVal(), ntt.get());
     }
 
     // Solve the parent-child relations
-    for (EntityPtr ntt : deserializedEntities)
+    for (const EntityPtr& ntt : deserializedEntities)
     {
-      for (EntityPtr parentCandidate : deserializedEntities)
+      auto parentItr = entityById.find(ntt->_parentId);
+      if (parentItr != entityById.end())
       {
-        if (parentCandidate->GetIdVal() == ntt->_parentId)
-        {
-          parentCandidate->m_node->AddChild(ntt->m_node);
-          break;
-        }
+        parentItr->second->m_node->AddChild(ntt->m_node);
       }
     }
 
@@ -801,59 +954,76 @@ namespace ToolKit
 
   void Scene::DeSerializeImpV045(const SerializationFileInfo& info, XmlNode* parent)
   {
-    XmlNode* root = info.Document->first_node(XmlSceneElement.c_str());
-    XmlNode* node = nullptr;
-
-    EntityPtrArray prefabList;
-    EntityPtrArray deserializedEntities;
+    XmlNode* root             = info.Document->first_node(XmlSceneElement.c_str());
 
     const char* xmlRootObject = Object::StaticClass()->Name.c_str();
     const char* xmlObjectType = XmlObjectClassAttr.data();
 
-    for (node = root->first_node(xmlRootObject); node; node = node->next_sibling(xmlRootObject))
+    std::vector<XmlNode*> objectNodes;
+    for (XmlNode* node = root->first_node(xmlRootObject); node; node = node->next_sibling(xmlRootObject))
+    {
+      objectNodes.push_back(node);
+    }
+
+    // Ids are acquired after all the entities are deserialized.
+    SerializationFileInfo parallelInfo = info;
+    parallelInfo.DeferIdCollision      = true;
+
+    auto deserializeFn = [&](XmlNode* node) -> EntityPtr
     {
       XmlAttribute* typeAttr = node->first_attribute(xmlObjectType);
       ObjectPtr obj          = MakeNewPtrCasted<Object>(typeAttr->value());
       obj->m_version         = m_version;
 
-      if (EntityPtr ntt = SafeCast<Entity>(obj))
+      EntityPtr ntt          = SafeCast<Entity>(obj);
+      if (ntt != nullptr)
       {
-        ntt->DeSerialize(info, node);
-        UpdateProgress(1);
+        ntt->DeSerialize(parallelInfo, node);
+      }
 
-        if (Prefab* prefab = ntt->As<Prefab>())
-        {
-          prefab->Load();
-          prefabList.push_back(ntt);
-        }
+      return ntt;
+    };
 
-        deserializedEntities.push_back(ntt);
-      }
-    }
+    EntityPtrArray deserializedEntities;
+    DeSerializeEntities(objectNodes, deserializeFn, deserializedEntities, true);
 
-    // Solve the parent-child relations
-    m_entities.reserve(deserializedEntities.size());
+    // Remove the objects that are not entities.
+    deserializedEntities.erase(std::remove(deserializedEntities.begin(), deserializedEntities.end(), nullptr),
+                               deserializedEntities.end());
 
-    for (EntityPtr ntt : deserializedEntities)
+    // Ids in the file are used for linking, collided ones are replaced with new ids after deserialization.
+    std::unordered_map<ObjectId, Entity*> entityById;
+    entityById.reserve(deserializedEntities.size());
+
+    for (const EntityPtr& ntt : deserializedEntities)
     {
-      if (ntt->_parentId == NullHandle)
+      // Prefab scenes are loaded in file order on the calling thread.
+      if (Prefab* prefab = ntt->As<Prefab>())
       {
-        AddEntity(ntt);
-        continue;
+        prefab->Load();
       }
 
-      for (EntityPtr parentCandidate : deserializedEntities)
+      ObjectId id = ntt->_idBeforeCollision;
+      if (id == NullHandle)
       {
-        ObjectId id = parentCandidate->_idBeforeCollision;
-        if (id == NullHandle)
-        {
-          id = parentCandidate->GetIdVal();
-        }
+        id = ntt->GetIdVal();
+      }
 
-        if (ntt->_parentId == id)
+      // First entity with the id is the parent in case of duplicates.
+      entityById.emplace(id, ntt.get());
+    }
+
+    // Solve the parent-child relations
+    m_entities.reserve(deserializedEntities.size());
+
+    for (const EntityPtr& ntt : deserializedEntities)
+    {
+      if (ntt->_parentId != NullHandle)
+      {
+        auto parentItr = entityById.find(ntt->_parentId);
+        if (parentItr != entityById.end())
         {
-          parentCandidate->m_node->AddChild(ntt->m_node);
-          break;
+          parentItr->second->m_node->AddChild(ntt->m_node);
         }
       }
 
@@ -870,6 +1040,49 @@ namespace ToolKit
     }
   }
 
+  void Scene::DeSerializeEntities(const std::vector<XmlNode*>& nodes,
+                                  const std::function<EntityPtr(XmlNode*)>& deserializeFn,
+                                  EntityPtrArray& entities,
+                                  bool deferIdCollision)
+  {
+    // Batches let the progress to be reported while loading big scenes.
+    const int batchSize = 256;
+    const int nodeCount = (int) nodes.size();
+    entities.resize(nodes.size());
+
+    using poolstl::iota_iter;
+    for (int batchBegin = 0; batchBegin < nodeCount; batchBegin += batchSize)
+    {
+      int batchEnd = glm::min(batchBegin + batchSize, nodeCount);
+      std::for_each(TKExecByConditional(batchEnd - batchBegin > 16, WorkerManager::FramePool),
+                    iota_iter<int>(batchBegin),
+                    iota_iter<int>(batchEnd),
+                    [&](int nodeIndex) -> void { entities[nodeIndex] = deserializeFn(nodes[nodeIndex]); });
+
+      UpdateProgress(batchEnd - batchBegin);
+    }
+
+    if (!deferIdCollision)
+    {
+      return;
+    }
+
+    // Ids are acquired in file order, so the same objects get new ids on collisions regardless of the thread timing.
+    for (const EntityPtr& ntt : entities)
+    {
+      if (ntt == nullptr)
+      {
+        continue;
+      }
+
+      ntt->PreventIdCollision();
+      for (const ComponentPtr& com : ntt->GetComponentPtrArray())
+      {
+        com->PreventIdCollision();
+      }
+    }
+  }
+
   ObjectId Scene::GetBiggestEntityId()
   {
     ObjectId lastId = 0;
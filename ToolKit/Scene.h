@@ -86,6 +86,22 @@ namespace ToolKit
      */
     virtual void Update(float deltaTime);
 
+    /**
+     * Records the local transforms of the entities as the latest simulation state. Called after each fixed time step.
+     * Entities whose transforms differ between the last two states are blended by InterpolateSimulationState.
+     */
+    void SaveSimulationState();
+
+    /**
+     * Sets the local transforms of the moving entities to a blend of the last two simulation states for rendering.
+     * RestoreSimulationState must be called before the simulation advances.
+     * @param alpha is the blend factor in [0, 1]. 0 gives the previous state and 1 gives the latest state.
+     */
+    void InterpolateSimulationState(float alpha);
+
+    /** Puts the interpolated entities back to the latest simulation state. */
+    void RestoreSimulationState();
+
     /**
      * Merges the entities from another scene into this scene and clears the other scene.
      * @param other A pointer to the other scene to merge.
@@ -146,6 +162,12 @@ namespace ToolKit
      */
     const EntityPtrArray& GetEntities() const;
 
+    /**
+     * Returns a counter that is incremented each time an entity is added to or removed from the scene.
+     * Systems caching entity lists compare it against their last seen value to know when to rebuild.
+     */
+    uint64 GetEntityListRevision() const;
+
     /** Returns all lights in the scene including directional lights.  */
     const LightRawPtrArray& GetLights() const;
 
@@ -299,6 +321,39 @@ namespace ToolKit
      */
     void _RemoveChildren(EntityPtr removed);
 
+    /**
+     * Constructs and deserializes an entity for each of the given nodes. Nodes are processed in parallel batches on the
+     * frame pool and the loading progress is updated on the calling thread after each batch. Entities must not be added
+     * to the scene or linked to each other within the deserialize function. Must not be called from the frame pool.
+     * @param nodes are the xml nodes to deserialize.
+     * @param deserializeFn creates and deserializes the entity for a node. Returns null for nodes to skip.
+     * @param entities are the resulting entities, index aligned with the nodes.
+     * @param deferIdCollision states that the deserialize function defers the id collisions. Ids of the entities and
+     * their components are then acquired in node order after all the nodes are deserialized.
+     */
+    void DeSerializeEntities(const std::vector<XmlNode*>& nodes,
+                             const std::function<EntityPtr(XmlNode*)>& deserializeFn,
+                             EntityPtrArray& entities,
+                             bool deferIdCollision);
+
+    /** Local transform of an entity in a simulation step. */
+    struct LocalTransform
+    {
+      Vec3 translation;
+      Quaternion orientation;
+      Vec3 scale;
+    };
+
+    /** Last two simulation states of an entity. */
+    struct SimulationState
+    {
+      EntityWeakPtr entity; //!< Expires when the entity is destroyed after its removal from the scene.
+      ObjectId id = NullHandle;
+      LocalTransform previous;
+      LocalTransform latest;
+      bool moving = false;
+    };
+
    public:
     PostProcessingSettingsPtr m_postProcessSettings; //!< Post process settings that this scene uses
 
@@ -306,14 +361,23 @@ namespace ToolKit
     AABBTree m_aabbTree;
 
    protected:
-    EntityPtrArray m_entities; //!< The entities in the scene.
-    bool m_isPrefab;           //!< Whether or not the scene is a prefab.
-    bool m_isLayer;            //!< Whether or not the scene is a 2D layer.
+    EntityPtrArray m_entities;       //!< The entities in the scene.
+    bool m_isPrefab;                 //!< Whether or not the scene is a prefab.
+    bool m_isLayer;                  //!< Whether or not the scene is a 2D layer.
+    uint64 m_entityListRevision = 0; //!< Incremented on every entity list change.
+
+    /** Entities in the scene by their ids. Provides constant time look ups. */
+    std::unordered_map<ObjectId, EntityPtr> m_entityLookup;
 
     mutable LightRawPtrArray m_lightCache;                         //!< Cached light entities which is added to scene.
     mutable LightRawPtrArray m_directionalLightCache;              //!< Cached directional lights in the scene.
     mutable EnvironmentComponentPtrArray m_environmentVolumeCache; //!< Environment volumes in the scene.
     mutable SkyBasePtr m_skyCache;                                 //!< Last added sky.
+
+   private:
+    std::vector<SimulationState> m_simulationStates; //!< States that are index aligned with the entity list.
+    uint64 m_simulationStateRevision   = UINT64_MAX; //!< Entity list revision that the states are aligned with.
+    bool m_simulationStateInterpolated = false;      //!< States if the moving entities are at interpolated transforms.
   };
 
   /**
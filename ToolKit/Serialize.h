@@ -22,6 +22,12 @@ namespace ToolKit
     String File;
     String Version;
     XmlDocument* Document = nullptr;
+
+    /**
+     * Objects keep the ids in the file without acquiring them. Set while deserializing concurrently, the caller must
+     * call Object::PreventIdCollision in a deterministic order afterwards.
+     */
+    bool DeferIdCollision = false;
   };
 
   /** Serializable object base class. */
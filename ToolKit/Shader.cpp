@@ -504,9 +504,9 @@ namespace ToolKit
 
   bool ShaderManager::CanStore(ClassMeta* Class) { return Class == Shader::StaticClass(); }
 
-  ShaderPtr ShaderManager::GetDefaultVertexShader() { return Cast<Shader>(m_storage[m_defaultVertexShaderFile]); }
+  ShaderPtr ShaderManager::GetDefaultVertexShader() { return Cast<Shader>(Find(m_defaultVertexShaderFile)); }
 
-  ShaderPtr ShaderManager::GetPbrForwardShader() { return Cast<Shader>(m_storage[m_pbrForwardShaderFile]); }
+  ShaderPtr ShaderManager::GetPbrForwardShader() { return Cast<Shader>(Find(m_pbrForwardShaderFile)); }
 
   const String& ShaderManager::PbrForwardShaderFile() { return m_pbrForwardShaderFile; }
 
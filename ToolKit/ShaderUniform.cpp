@@ -9,6 +9,8 @@
 
 #include "TKAssert.h"
 
+#include <mutex>
+
 #include "DebugNew.h"
 
 namespace ToolKit
@@ -70,6 +72,56 @@ namespace ToolKit
     }
   }
 
+  // UniformHandle
+  //////////////////////////////////////////
+
+  namespace
+  {
+    /** Registered uniform names. Names are never removed, so references to them stay valid. */
+    struct UniformNameRegistry
+    {
+      std::mutex lock;
+      std::deque<String> names;
+      std::unordered_map<StringView, int> ids;
+    };
+
+    UniformNameRegistry& GetUniformNameRegistry()
+    {
+      static UniformNameRegistry registry;
+      return registry;
+    }
+  } // namespace
+
+  UniformHandle::UniformHandle(StringView name)
+  {
+    UniformNameRegistry& registry = GetUniformNameRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    auto id = registry.ids.find(name);
+    if (id != registry.ids.end())
+    {
+      m_id = id->second;
+      return;
+    }
+
+    m_id = (int) registry.names.size();
+    registry.names.emplace_back(name);
+    registry.ids[registry.names.back()] = m_id;
+  }
+
+  const String& UniformHandle::GetName() const
+  {
+    static const String empty;
+    if (m_id == -1)
+    {
+      return empty;
+    }
+
+    UniformNameRegistry& registry = GetUniformNameRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    return registry.names[m_id];
+  }
+
   // ShaderUniform
   //////////////////////////////////////////
 
@@ -59,6 +59,34 @@ namespace ToolKit
 
   extern const char* GetUniformName(Uniform u);
 
+  // UniformHandle
+  //////////////////////////////////////////
+
+  /**
+   * Identifies a custom uniform or a uniform block by its name. Names are registered once when the handle is created
+   * and programs resolve the location of each handle on its first use. Setting a uniform through a handle involves no
+   * string hashing or allocation, so handles should be created once, such as at pass construction, and kept.
+   */
+  class TK_API UniformHandle
+  {
+   public:
+    UniformHandle() = default;
+
+    /** Registers the name if it is not already registered. Thread safe. */
+    explicit UniformHandle(StringView name);
+
+    /** @return Dense index of the handle, starting from zero. -1 for default constructed handles. */
+    int GetId() const { return m_id; }
+
+    /** @return Name of the uniform that the handle refers to. */
+    const String& GetName() const;
+
+    bool IsValid() const { return m_id != -1; }
+
+   private:
+    int m_id = -1;
+  };
+
   // ShaderUniform
   //////////////////////////////////////////
 
@@ -260,9 +260,8 @@ namespace ToolKit
       cullCamera->SetFarClipVal(glm::distance(outerPoint, pos) + cullCamera->Far());
     }
 
-    // Create render jobs for shadow map generation.
-    RenderJobArray jobs;
-    RenderData renderData;
+    // Create render jobs for shadow map generation. Job array is reused across the faces to keep its capacity.
+    RenderData& renderData     = m_renderData;
 
     Frustum frustum            = ExtractFrustum(cullCamera->GetProjectViewMatrix(), false);
     EntityRawPtrArray entities = m_params.scene->m_aabbTree.VolumeQuery(frustum);
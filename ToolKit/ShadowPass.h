@@ -71,6 +71,7 @@ namespace ToolKit
     BinPack2D m_packer;
 
     LightRawPtrArray m_lights; // Shadow casters in scene.
+    RenderData m_renderData;   // Jobs of the shadow map being rendered.
   };
 
   typedef std::shared_ptr<ShadowPass> ShadowPassPtr;
@@ -31,7 +31,7 @@ namespace ToolKit
   {
     TexturePtr ptr = MakeNewPtr<Texture>();
     ptr->m_height  = 1;
-    ptr->m_width   = (int) (skeleton->m_bones.size()) * 4;
+    ptr->m_width   = (int) (skeleton->m_bones.size()) * 3; // Same layout with the animation data textures.
     TextureSettings set;
     set.GenerateMipMap = false;
     set.InternalFormat = GraphicTypes::FormatRGBA32F;
@@ -57,8 +57,10 @@ namespace ToolKit
 
   void uploadBoneMatrix(Mat4 mat, TexturePtr& ptr, uint boneIndx)
   {
+    // Only the top three rows are uploaded, the last row is always (0, 0, 0, 1).
+    Mat4 transposed = glm::transpose(mat);
     RHI::SetTexture(GL_TEXTURE_2D, ptr->m_textureId);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, boneIndx * 4, 0, 4, 1, GL_RGBA, GL_FLOAT, &mat);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, boneIndx * 3, 0, 3, 1, GL_RGBA, GL_FLOAT, &transposed);
   };
 
   // DynamicBoneMap
@@ -114,6 +116,18 @@ namespace ToolKit
     }
   }
 
+  void DynamicBoneMap::UpdateMatrixPalette(const Skeleton* skeleton)
+  {
+    m_matrixPalette.resize(skeleton->m_bones.size());
+    for (auto& dBoneIter : m_boneMap)
+    {
+      const DynamicBone& dBone        = dBoneIter.second;
+      const StaticBone* sBone         = skeleton->m_bones[dBone.boneIndx];
+      Mat4 boneTransform              = dBone.node->GetTransform(TransformationSpace::TS_WORLD);
+      m_matrixPalette[dBone.boneIndx] = boneTransform * sBone->m_inverseWorldMatrix;
+    }
+  }
+
   DynamicBoneMap::DynamicBoneMap() {}
 
   DynamicBoneMap::~DynamicBoneMap()
@@ -181,8 +195,7 @@ namespace ToolKit
     m_bindPoseTexture = CreateBoneTransformTexture(this);
     for (uint boneIndx = 0; boneIndx < m_bones.size(); boneIndx++)
     {
-      Mat4 transform = m_Tpose.m_boneMap[m_bones[boneIndx]->m_name].node->GetTransform();
-      uploadBoneMatrix(transform * m_bones[boneIndx]->m_inverseWorldMatrix, m_bindPoseTexture, (uint) boneIndx);
+      uploadBoneMatrix(m_Tpose.m_matrixPalette[boneIndx], m_bindPoseTexture, (uint) boneIndx);
     }
 
     m_initiated = true;
@@ -204,6 +217,19 @@ namespace ToolKit
     }
   }
 
+  uint64 Skeleton::GetCpuMemory() const
+  {
+    uint64 memory = m_bones.capacity() * sizeof(StaticBone*);
+    for (StaticBone* bone : m_bones)
+    {
+      memory += sizeof(StaticBone) + bone->m_name.capacity();
+    }
+
+    return memory;
+  }
+
+  uint64 Skeleton::GetGpuMemory() const { return m_bindPoseTexture != nullptr ? m_bindPoseTexture->GetGpuMemory() : 0; }
+
   void Skeleton::Load()
   {
     if (!m_loaded)
@@ -352,6 +378,9 @@ namespace ToolKit
       Traverse(node, nullptr, this);
     }
 
+    // Bind pose never changes, palette is computed once.
+    m_Tpose.UpdateMatrixPalette(this);
+
     return nullptr;
   }
 
@@ -46,8 +46,21 @@ namespace ToolKit
     void ForEachRootBone(std::function<void(const DynamicBone*)> childProcessFunc) const;
     void AddDynamicBone(const String& boneName, DynamicBone& bone, DynamicBone* parent);
 
+    /**
+     * Computes the skinning matrix of each bone for the current pose. Must be called after the pose changes and
+     * before skinning on cpu.
+     * @param skeleton is the skeleton that this bone map is created for.
+     */
+    void UpdateMatrixPalette(const Skeleton* skeleton);
+
    public:
     std::map<String, DynamicBone> m_boneMap;
+
+    /**
+     * Bone transforms multiplied with inverse bind pose matrices, indexed by bone index. Transforms vertices from
+     * bind pose to the pose that the palette is last updated for.
+     */
+    Mat4Array m_matrixPalette;
   };
 
   class TK_API Skeleton : public Resource
@@ -63,6 +76,12 @@ namespace ToolKit
     void UnInit() override;
     void Load() override;
 
+    /** @return Memory held by the static bones. */
+    uint64 GetCpuMemory() const override;
+
+    /** @return Memory held by the bind pose texture. */
+    uint64 GetGpuMemory() const override;
+
     int GetBoneIndex(const String& bone);
     StaticBone* GetBone(const String& bone);
 
@@ -12,6 +12,7 @@
 #include "FileManager.h"
 #include "GradientSky.h"
 #include "Image.h"
+#include "IrradianceCache.h"
 #include "Material.h"
 #include "RenderSystem.h"
 #include "Shader.h"
@@ -142,21 +143,6 @@ namespace ToolKit
                    SkyBasePtr skyBase = self.lock();
                    if (HdriPtr hdr = skyBase->GetHdri())
                    {
-                     auto bakeFn = [renderer, skyBase](CubeMapPtr cubemap, const String& file, int level) -> void
-                     {
-                       float* pixelBuffer;
-                       float exposure = 1.0f;
-
-                       renderer->GenerateEquiRectengularProjection(cubemap, level, exposure, (void**) &pixelBuffer);
-
-                       UVec2 rectSize = cubemap->GetEquiRectengularMapSize();
-                       int mipWidth   = rectSize.x >> level;
-                       int mipHeight  = rectSize.y >> level;
-
-                       WriteHdr(file, mipWidth, mipHeight, 4, pixelBuffer);
-                       SafeDelArray(pixelBuffer);
-                     };
-
                      // Create cache folder.
                      const static String cacheFolder = TexturePath(TKIrradianceCacheFolder);
                      if (!CheckFile(cacheFolder))
@@ -164,29 +150,28 @@ namespace ToolKit
                        GetFileManager()->CreateResourceFolder(cacheFolder);
                      }
 
-                     // Bake diffuse env map for level 0.
-                     String baseName = hdr->GenerateBakedEnvironmentFileBaseName();
-                     skyBase->SetIrradianceBakeFileVal(baseName);
-
-                     String bakeFile = hdr->ToDiffuseIrradianceFileName(baseName) + HDR;
-                     bakeFile        = TexturePath(bakeFile);
-                     bakeFn(hdr->m_diffuseEnvMap, bakeFile, 0);
+                     // Bake diffuse and all specular levels in to a single file.
+                     String baseName  = hdr->GenerateBakedEnvironmentFileBaseName();
+                     String cacheFile = TexturePath(hdr->ToIrradianceCacheFileName(baseName) + ENVBAKE);
 
-                     // Bake specular env map for all levels.
+                     int lodCount     = 1;
                      if (hdr->m_specularEnvMap)
                      {
-                       int lodCount = glm::min(hdr->m_specularEnvMap->CalculateMipmapLevels(),
-                                               (int) RHIConstants::SpecularIBLLods);
-
-                       bakeFile     = hdr->ToSpecularIrradianceFileName(baseName);
-                       for (int i = 1; i < lodCount; i++) // Skip first lod which is the original texture.
-                       {
-                         String file = bakeFile + std::to_string(i) + HDR;
-                         file        = TexturePath(file);
-                         bakeFn(hdr->m_specularEnvMap, file, i);
-                       }
+                       lodCount = glm::min(hdr->m_specularEnvMap->CalculateMipmapLevels(),
+                                           (int) RHIConstants::SpecularIBLLods);
+                     }
+
+                     if (!IrradianceCache::Write(renderer,
+                                                 cacheFile,
+                                                 hdr->m_diffuseEnvMap,
+                                                 hdr->m_specularEnvMap,
+                                                 lodCount))
+                     {
+                       return;
                      }
 
+                     skyBase->SetIrradianceBakeFileVal(baseName);
+
                      TK_LOG("Irradiance map baked.");
                    }
                  }
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "SphericalHarmonics.h"
+
+#include "RHI.h"
+#include "Threads.h"
+#include "ToolKit.h"
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  // SH9
+  //////////////////////////////////////////
+
+  /** Radiance of a single row of a face, summed in parallel and reduced in order. */
+  struct SHRowSum
+  {
+    Vec4 coefficients[9];
+    float weight = 0.0f;
+  };
+
+  /**
+   * Direction of the texel for the given face, where u and v are the s and t coordinates of the face in [-1, 1].
+   * Follows the cube map face selection of the gl specification.
+   */
+  static Vec3 CubeMapDirection(int face, float u, float v)
+  {
+    switch (face)
+    {
+    case 0:
+      return Vec3(1.0f, -v, -u);
+    case 1:
+      return Vec3(-1.0f, -v, u);
+    case 2:
+      return Vec3(u, 1.0f, v);
+    case 3:
+      return Vec3(u, -1.0f, -v);
+    case 4:
+      return Vec3(u, -v, 1.0f);
+    default:
+      return Vec3(-u, -v, -1.0f);
+    }
+  }
+
+  SH9 SH9::ProjectCubeMap(const float* faces, int size)
+  {
+    SH9 sh;
+    if (faces == nullptr || size <= 0)
+    {
+      return sh;
+    }
+
+    int rowCount = size * 6;
+    std::vector<SHRowSum> rows(rowCount);
+
+    using poolstl::iota_iter;
+    std::for_each(TKExecByConditional(rowCount > 64, WorkerManager::FramePool),
+                  iota_iter<int>(0),
+                  iota_iter<int>(rowCount),
+                  [&](int row) -> void
+                  {
+                    int face         = row / size;
+                    int y            = row % size;
+                    float v          = 2.0f * (y + 0.5f) / size - 1.0f;
+                    const float* rgb = faces + (size_t) row * size * 4;
+
+                    SHRowSum& sum = rows[row];
+                    float basis[9];
+                    for (int x = 0; x < size; x++)
+                    {
+                      float u = 2.0f * (x + 0.5f) / size - 1.0f;
+
+                      // Solid angle of the texel is proportional to 1 / (1 + u^2 + v^2)^(3/2).
+                      float t      = 1.0f + u * u + v * v;
+                      float weight = 1.0f / (t * glm::sqrt(t));
+
+                      EvaluateBasis(glm::normalize(CubeMapDirection(face, u, v)), basis);
+
+                      Vec4 radiance = Vec4(rgb[x * 4], rgb[x * 4 + 1], rgb[x * 4 + 2], 0.0f) * weight;
+                      for (int i = 0; i < 9; i++)
+                      {
+                        sum.coefficients[i] += radiance * basis[i];
+                      }
+
+                      sum.weight += weight;
+                    }
+                  });
+
+    // Rows are reduced in order, result doesn't depend on the thread count.
+    float weightSum = 0.0f;
+    for (const SHRowSum& sum : rows)
+    {
+      for (int i = 0; i < 9; i++)
+      {
+        sh.coefficients[i] += sum.coefficients[i];
+      }
+
+      weightSum += sum.weight;
+    }
+
+    // Normalize the weights to the solid angle of the sphere.
+    float normalization = 4.0f * glm::pi<float>() / weightSum;
+    for (int i = 0; i < 9; i++)
+    {
+      sh.coefficients[i] *= normalization;
+    }
+
+    return sh;
+  }
+
+  void SH9::EvaluateBasis(const Vec3& direction, float basis[9])
+  {
+    const float x = direction.x;
+    const float y = direction.y;
+    const float z = direction.z;
+
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * y;
+    basis[2] = 0.488603f * z;
+    basis[3] = 0.488603f * x;
+    basis[4] = 1.092548f * x * y;
+    basis[5] = 1.092548f * y * z;
+    basis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+    basis[7] = 1.092548f * x * z;
+    basis[8] = 0.546274f * (x * x - y * y);
+  }
+
+  SH9 SH9::ToIrradiance() const
+  {
+    // Cosine lobe convolution per band divided by pi, times the constant of each basis function. Polynomial parts
+    // of the basis are left to the evaluation.
+    static const float factors[9] = {1.0f * 0.282095f,
+                                     2.0f / 3.0f * 0.488603f,
+                                     2.0f / 3.0f * 0.488603f,
+                                     2.0f / 3.0f * 0.488603f,
+                                     0.25f * 1.092548f,
+                                     0.25f * 1.092548f,
+                                     0.25f * 0.315392f,
+                                     0.25f * 1.092548f,
+                                     0.25f * 0.546274f};
+
+    SH9 irradiance;
+    for (int i = 0; i < 9; i++)
+    {
+      irradiance.coefficients[i] = coefficients[i] * factors[i];
+    }
+
+    return irradiance;
+  }
+
+  Vec3 SH9::EvaluateIrradiance(const Vec3& normal) const
+  {
+    const float x = normal.x;
+    const float y = normal.y;
+    const float z = normal.z;
+
+    Vec4 result = coefficients[0] + coefficients[1] * y + coefficients[2] * z + coefficients[3] * x +
+                  coefficients[4] * (x * y) + coefficients[5] * (y * z) + coefficients[6] * (3.0f * z * z - 1.0f) +
+                  coefficients[7] * (x * z) + coefficients[8] * (x * x - y * y);
+
+    return glm::max(Vec3(result), Vec3(0.0f));
+  }
+
+  // DiffuseSHCache
+  //////////////////////////////////////////
+
+  DiffuseSHCache::DiffuseSHCache() : LRUCache(RHIConstants::DiffuseSHCacheItemCount * sizeof(SH9)) {}
+
+  DiffuseSHCache::~DiffuseSHCache() {}
+
+  void DiffuseSHCache::Init()
+  {
+    m_gpuBuffer.Init(m_cacheSize);
+    m_gpuBuffer.m_slot = BindingSlot;
+  }
+
+  bool DiffuseSHCache::Map()
+  {
+    return LRUCache::Map([this](const void* data, uint64 offset, uint64 size)
+                         { m_gpuBuffer.MapRange(data, offset, size); });
+  }
+
+} // namespace ToolKit
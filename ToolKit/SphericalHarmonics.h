@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "GenericBuffers.h"
+#include "UniformBuffer.h"
+
+namespace ToolKit
+{
+
+  // SH9
+  //////////////////////////////////////////
+
+  /**
+   * Lighting of all directions projected on to the first three bands of the real spherical harmonics. Nine rgb
+   * coefficients are enough to represent diffuse irradiance with a small error, which lets environments light the
+   * scene without a diffuse irradiance cube map.
+   */
+  struct TK_API SH9
+  {
+    /** Rgb coefficients ordered by band, w is unused. Padded to vec4 for std140 layout. */
+    Vec4 coefficients[9] = {};
+
+    /**
+     * Projects the radiance in a cube map on to the spherical harmonics. Texels are weighted by their solid angle and
+     * processed in parallel.
+     * @param faces are the rgba float pixels of the 6 faces in the gl cube map face order, rows start from t = 0.
+     * @param size is the width and height of a face in pixels.
+     * @return Radiance coefficients.
+     */
+    static SH9 ProjectCubeMap(const float* faces, int size);
+
+    /** Evaluates the 9 basis functions for the unit direction. */
+    static void EvaluateBasis(const Vec3& direction, float basis[9]);
+
+    /**
+     * Convolves the radiance with the clamped cosine lobe and folds the basis constants in to the coefficients, so
+     * that the shaders evaluate irradiance with a few multiply adds. Result is irradiance divided by pi, same as the
+     * diffuse env maps generated by the renderer.
+     */
+    SH9 ToIrradiance() const;
+
+    /** Evaluates the coefficients that are produced by ToIrradiance for the unit normal. */
+    Vec3 EvaluateIrradiance(const Vec3& normal) const;
+  };
+
+  // DiffuseSHCacheItem
+  //////////////////////////////////////////
+
+  /** Irradiance coefficients of an environment in gpu. Id is the id of the hdri that the coefficients belong to. */
+  struct TK_API DiffuseSHCacheItem : CacheItem
+  {
+    SH9 data;
+
+    void* GetData() override { return &data; }
+  };
+
+  // DiffuseSHCache
+  //////////////////////////////////////////
+
+  /** Irradiance coefficients of the environments in use. Draws refer to their environment by its slot index. */
+  class TK_API DiffuseSHCache : public LRUCache<DiffuseSHCacheItem, sizeof(SH9)>
+  {
+   public:
+    DiffuseSHCache();
+    virtual ~DiffuseSHCache();
+
+    void Init();
+    bool Map();
+
+   public:
+    static constexpr int BindingSlot = 12;
+    UniformBuffer m_gpuBuffer;
+  };
+
+} // namespace ToolKit
@@ -46,7 +46,14 @@ namespace ToolKit
     renderer->SetFramebuffer(m_viewport->m_framebuffer, GraphicBitFields::AllBits);
 
     EntityRawPtrArray rawEntities = ToEntityRawPtrArray(m_splashScreen->m_scene->GetEntities());
-    RenderJobProcessor::CreateRenderJobs(m_uiRenderData.jobs, rawEntities);
+    RenderJobProcessor::CreateRenderJobs(m_uiRenderData.jobs,
+                                         rawEntities,
+                                         false,
+                                         0,
+                                         {},
+                                         {},
+                                         m_uiPass->m_params.Cam.get(),
+                                         m_viewport->m_wndContentAreaSize.y);
     RenderJobProcessor::SeperateRenderData(m_uiRenderData, true);
     m_uiPass->m_params.renderData = &m_uiRenderData;
 
@@ -24,7 +24,14 @@ namespace ToolKit
   // SSAOPass
   //////////////////////////////////////////
 
-  StringArray SSAOPass::m_ssaoSamplesStrCache;
+  std::vector<UniformHandle> SSAOPass::m_ssaoSampleHandles;
+
+  static const UniformHandle g_screenSizeHandle("screenSize");
+  static const UniformHandle g_biasHandle("bias");
+  static const UniformHandle g_kernelSizeHandle("kernelSize");
+  static const UniformHandle g_projectionHandle("projection");
+  static const UniformHandle g_viewMatrixHandle("viewMatrix");
+  static const UniformHandle g_radiusHandle("radius");
 
   SSAOPass::SSAOPass() : Pass("SSAOPass")
   {
@@ -39,10 +46,13 @@ namespace ToolKit
     m_noiseTexture          = MakeNewPtr<DataTexture>(4, 4, noiseSet);
     m_quadPass              = MakeNewPtr<FullQuadPass>();
 
-    m_ssaoSamplesStrCache.reserve(128);
-    for (int i = 0; i < m_ssaoSamplesStrCacheSize; ++i)
+    if (m_ssaoSampleHandles.empty())
     {
-      m_ssaoSamplesStrCache.push_back("samples[" + std::to_string(i) + "]");
+      m_ssaoSampleHandles.reserve(m_ssaoSampleHandleCount);
+      for (int i = 0; i < m_ssaoSampleHandleCount; ++i)
+      {
+        m_ssaoSampleHandles.push_back(UniformHandle("samples[" + std::to_string(i) + "]"));
+      }
     }
 
     m_ssaoShader = GetShaderManager()->Create<Shader>(ShaderPath("ssaoCalcFrag.shader", true));
@@ -121,19 +131,19 @@ namespace ToolKit
       // Update kernel
       for (int i = 0; i < m_params.KernelSize; ++i)
       {
-        m_quadPass->UpdateUniform(ShaderUniform(m_ssaoSamplesStrCache[i], m_ssaoKernel[i]));
+        m_quadPass->UpdateUniform(m_ssaoSampleHandles[i], m_ssaoKernel[i]);
       }
 
       m_prevSpread = m_params.spread;
     }
 
-    m_quadPass->UpdateUniform(ShaderUniform("screenSize", Vec2(width, height)));
-    m_quadPass->UpdateUniform(ShaderUniform("bias", m_params.Bias));
-    m_quadPass->UpdateUniform(ShaderUniform("kernelSize", m_params.KernelSize));
-    m_quadPass->UpdateUniform(ShaderUniform("projection", m_params.Cam->GetProjectionMatrix()));
-    m_quadPass->UpdateUniform(ShaderUniform("viewMatrix", m_params.Cam->GetViewMatrix()));
-    m_quadPass->UpdateUniform(ShaderUniform("radius", m_params.Radius));
-    m_quadPass->UpdateUniform(ShaderUniform("bias", m_params.Bias));
+    m_quadPass->UpdateUniform(g_screenSizeHandle, Vec2(width, height));
+    m_quadPass->UpdateUniform(g_biasHandle, m_params.Bias);
+    m_quadPass->UpdateUniform(g_kernelSizeHandle, m_params.KernelSize);
+    m_quadPass->UpdateUniform(g_projectionHandle, m_params.Cam->GetProjectionMatrix());
+    m_quadPass->UpdateUniform(g_viewMatrixHandle, m_params.Cam->GetViewMatrix());
+    m_quadPass->UpdateUniform(g_radiusHandle, m_params.Radius);
+    m_quadPass->UpdateUniform(g_biasHandle, m_params.Bias);
   }
 
   void SSAOPass::PostRender()
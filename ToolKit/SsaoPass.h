@@ -72,8 +72,8 @@ namespace ToolKit
     // Used to detect if the spread has changed. If so, kernel updated.
     float m_prevSpread               = -1.0f;
 
-    static StringArray m_ssaoSamplesStrCache;
-    static constexpr int m_ssaoSamplesStrCacheSize = 128;
+    static std::vector<UniformHandle> m_ssaoSampleHandles;
+    static constexpr int m_ssaoSampleHandleCount = 128;
   };
 
   typedef std::shared_ptr<SSAOPass> SSAOPassPtr;
@@ -7,6 +7,7 @@
 
 #include "Stats.h"
 
+#include "EngineSettings.h"
 #include "RenderSystem.h"
 #include "TKAssert.h"
 #include "TKOpenGL.h"
@@ -78,9 +79,36 @@ namespace ToolKit
     snprintf(buffer, sizeof(buffer), "Total Hardware Render Pass: %llu\n", Stats::GetRenderPassCount());
     stats += buffer;
 
+    snprintf(buffer, sizeof(buffer), "UI Jobs Merged In To Batches: %llu\n", Stats::GetUIBatchedJobCount());
+    stats += buffer;
+
     snprintf(buffer, sizeof(buffer), "Approximate Total VRAM Usage: %llu MB\n", Stats::GetTotalVRAMUsageInMB());
     stats += buffer;
 
+    snprintf(buffer,
+             sizeof(buffer),
+             "VRAM Saved By Texture Compression: %llu MB\n",
+             m_compressedTextureSavings / (1024 * 1024));
+    stats += buffer;
+
+    if (GetEngineSettings().m_graphics->GetTextureStreamingVal())
+    {
+      snprintf(buffer,
+               sizeof(buffer),
+               "Streamed Texture Memory: %llu / %llu MB\n",
+               m_streamedTextureMemory / (1024 * 1024),
+               m_textureStreamingBudget / (1024 * 1024));
+      stats += buffer;
+    }
+
+    snprintf(buffer,
+             sizeof(buffer),
+             "Audio Voices: %llu / %llu, Decoded Audio Memory: %llu MB\n",
+             m_activeAudioVoices,
+             m_maxAudioVoices,
+             m_decodedAudioMemory / (1024 * 1024));
+    stats += buffer;
+
     snprintf(buffer,
              sizeof(buffer),
              "Light Cache Invalidation Per Frame: %llu\n",
@@ -99,6 +127,18 @@ namespace ToolKit
     snprintf(buffer, sizeof(buffer), "UBO updates Per Frame: %llu\n", Stats::GetUboUpdatesPerFrame());
     stats += buffer;
 
+#ifdef TK_COUNT_HEAP_ALLOCATIONS
+    snprintf(buffer, sizeof(buffer), "Heap Allocations Per Frame: %llu\n", Stats::GetHeapAllocationsPerFrame());
+    stats += buffer;
+#endif
+
+    snprintf(buffer,
+             sizeof(buffer),
+             "Gl Calls Per Frame: %llu (skipped: %llu)\n",
+             Stats::GetGlCallsPerFrame(),
+             Stats::GetSkippedGlCallsPerFrame());
+    stats += buffer;
+
     return stats;
   }
 
@@ -270,6 +310,54 @@ namespace ToolKit
       }
     }
 
+    uint64 GetUIBatchedJobCount()
+    {
+      if (TKStats* tkStats = GetTKStats())
+      {
+        return tkStats->GetUIBatchedJobCount();
+      }
+      else
+      {
+        return 0;
+      }
+    }
+
+    uint64 GetHeapAllocationsPerFrame()
+    {
+      if (TKStats* tkStats = GetTKStats())
+      {
+        return tkStats->m_heapAllocationsPerFramePrev;
+      }
+      else
+      {
+        return 0;
+      }
+    }
+
+    uint64 GetGlCallsPerFrame()
+    {
+      if (TKStats* tkStats = GetTKStats())
+      {
+        return tkStats->m_glCallsPerFramePrev;
+      }
+      else
+      {
+        return 0;
+      }
+    }
+
+    uint64 GetSkippedGlCallsPerFrame()
+    {
+      if (TKStats* tkStats = GetTKStats())
+      {
+        return tkStats->m_skippedGlCallsPerFramePrev;
+      }
+      else
+      {
+        return 0;
+      }
+    }
+
     void GetRenderTime(float& cpu, float& gpu)
     {
       if (TKStats* tkStats = GetTKStats())
@@ -63,6 +63,11 @@ namespace ToolKit
 
     inline uint64 GetRenderPassCount() { return m_renderPassCountPrev; }
 
+    // Ui Batching
+    //////////////////////////////////////////
+
+    inline uint64 GetUIBatchedJobCount() { return m_uiBatchedJobsPerFramePrev; }
+
     /** Returns all measured per frame statistics as string. */
     String GetPerFrameStats();
 
@@ -99,6 +104,32 @@ namespace ToolKit
     uint64 m_renderPassCount                     = 0;
     uint64 m_renderPassCountPrev                 = 0;
 
+    /** Number of ui render jobs merged in to batches in a frame. */
+    uint64 m_uiBatchedJobsPerFrame               = 0;
+    uint64 m_uiBatchedJobsPerFramePrev           = 0;
+
+    /** Number of heap allocations in a frame. See FrameArena::GetHeapAllocationCount. */
+    uint64 m_heapAllocationsAtFrameBegin         = 0;
+    uint64 m_heapAllocationsPerFramePrev         = 0;
+
+    /** Number of gl state changes and uniform uploads issued and skipped as redundant by RHI in a frame. */
+    uint64 m_glCallsPerFramePrev                 = 0;
+    uint64 m_skippedGlCallsPerFramePrev          = 0;
+
+    /** Gpu memory used by the resident mip levels of streamed textures. */
+    uint64 m_streamedTextureMemory               = 0;
+    /** Gpu memory budget for the streamed textures. */
+    uint64 m_textureStreamingBudget              = 0;
+    /** Gpu memory that block compressed textures save compared to rgba8. */
+    uint64 m_compressedTextureSavings            = 0;
+
+    /** Number of the audio voices that are assigned to sources. */
+    uint64 m_activeAudioVoices                   = 0;
+    /** Maximum number of the audio voices. */
+    uint64 m_maxAudioVoices                      = 0;
+    /** Memory used by the pcm data of the audio that is decoded at load time. */
+    uint64 m_decodedAudioMemory                  = 0;
+
     /** Timers added to the source. */
     std::unordered_map<String, TimeArgs> m_profileTimerMap;
 
@@ -125,6 +156,10 @@ namespace ToolKit
     TK_API void AddDrawCall();
     TK_API uint64 GetDrawCallCount();
     TK_API uint64 GetRenderPassCount();
+    TK_API uint64 GetUIBatchedJobCount();
+    TK_API uint64 GetHeapAllocationsPerFrame();
+    TK_API uint64 GetGlCallsPerFrame();
+    TK_API uint64 GetSkippedGlCallsPerFrame();
     TK_API void GetRenderTime(float& cpu, float& gpu);
     TK_API void GetRenderTimeAvg(float& cpu, float& gpu);
 
@@ -67,6 +67,12 @@ namespace ToolKit
     SetPivotOffsetVal(offset);
   }
 
+  void Surface::InvalidateSpatialCaches()
+  {
+    Super::InvalidateSpatialCaches();
+    m_hitTestCacheInvalidated = true;
+  }
+
   void Surface::UpdateLocalBoundingBox()
   {
     Vec2 size                   = GetSizeVal();
@@ -276,6 +282,20 @@ namespace ToolKit
     MeshPtr mesh               = GetMeshComponent()->GetMeshVal();
     mesh->m_clientSideVertices = vertices;
     mesh->CalculateAABB();
+
+    // Images packed in to an atlas sample their region of the page. V runs from 0 at the bottom to -1 at the top,
+    // which wraps to the first row of the texture, the top of the image.
+    MaterialComponentPtr matCom = GetMaterialComponent();
+    MaterialPtr material        = matCom != nullptr ? matCom->GetFirstMaterial() : nullptr;
+    TexturePtr texture          = material != nullptr ? material->GetDiffuseTextureVal() : nullptr;
+    if (texture != nullptr && texture->GetAtlasPage() != nullptr)
+    {
+      const Vec4& rect = texture->GetAtlasRect();
+      for (Vertex& vertex : mesh->m_clientSideVertices)
+      {
+        vertex.tex = Vec2(rect.x, rect.y) + Vec2(vertex.tex.x, 1.0f + vertex.tex.y) * Vec2(rect.z, rect.w);
+      }
+    }
   }
 
   void Surface::CreateQuat(const SpriteEntry& val)
@@ -421,6 +441,13 @@ namespace ToolKit
     {
       mat->SetDiffuseTextureVal(hoverImage);
     }
+
+    // Quad samples the atlas region of the shown image, it is rebuilt for the new image.
+    MaterialPtr current = GetMaterialComponent()->GetFirstMaterial();
+    if (current != nullptr && (current == GetButtonMaterialVal() || current == GetHoverMaterialVal()))
+    {
+      UpdateGeometry(false);
+    }
   }
 
   void Button::ResetCallbacks()
@@ -34,6 +34,9 @@ namespace ToolKit
     void CalculateAnchorOffsets(Vec3 canvas[4], Vec3 surface[4]);
     virtual void ResetCallbacks();
 
+    /** Also marks the surface for re insertion to its layer's hit test grid. */
+    void InvalidateSpatialCaches() override;
+
     /**
      * To reflect the size & pivot changes,this function regenerates the geometry.
      * @param byTexture - if true send, the geometry is updated based on material's diffuse texture.
@@ -70,6 +73,9 @@ namespace ToolKit
     bool m_mouseOver    = false;
     bool m_mouseClicked = false;
 
+    /** Set when the surface bounds changed and its UILayer needs to re bucket it for hit testing. */
+    bool m_hitTestCacheInvalidated = true;
+
     struct AnchorParams
     {
       float m_anchorRatios[4] = {0.f, 1.f, 0.f, 1.f};
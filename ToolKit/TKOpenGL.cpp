@@ -8,6 +8,7 @@
 #define GLAD_GLES2_IMPLEMENTATION
 #include "TKOpenGL.h"
 
+#include "NullRHI.h"
 #include "Types.h"
 
 #ifdef TK_WEB
@@ -38,6 +39,31 @@ namespace ToolKit
 
   int TK_GL_OES_texture_float_linear                                           = 0;
 
+  int TK_GL_texture_compression_etc2                                           = 0;
+
+  int TK_GL_KHR_texture_compression_astc_ldr                                   = 0;
+
+  /** Checks the compressed formats that the driver reports. Emulated formats are not reported. */
+  static void QueryCompressedTextureFormats()
+  {
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+
+    std::vector<GLint> formats(glm::max(formatCount, 0));
+    if (formatCount > 0)
+    {
+      glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    }
+
+    auto hasFormatFn = [&formats](GraphicTypes format) -> bool
+    { return std::find(formats.begin(), formats.end(), (GLint) format) != formats.end(); };
+
+    TK_GL_texture_compression_etc2 =
+        hasFormatFn(GraphicTypes::FormatRGB8_ETC2) && hasFormatFn(GraphicTypes::FormatRGBA8_ETC2_EAC);
+
+    TK_GL_KHR_texture_compression_astc_ldr = hasFormatFn(GraphicTypes::FormatRGBA_ASTC_4x4);
+  }
+
   void LoadGlFunctions(void* glGetProcAddres)
   {
 #ifdef TK_WIN
@@ -132,6 +158,32 @@ namespace ToolKit
     TK_GL_OES_texture_float_linear       = extensionsStr.find("GL_OES_texture_float_linear") != std::string::npos;
     TK_GL_EXT_texture_filter_anisotropic = extensionsStr.find("GL_EXT_texture_filter_anisotropic") != std::string::npos;
 
+#endif
+
+    QueryCompressedTextureFormats();
+  }
+
+  void LoadNullGlFunctions()
+  {
+#if defined(TK_ANDROID) || defined(TK_WEB)
+    assert(false && "Headless mode is only supported on platforms that load opengl with glad.");
+#else
+    gladLoadGLES2((GLADloadfunc) NullRHI::GetProcAddress);
+
+    // No extension is advertised by the null backend.
+    tk_glFramebufferTexture2DMultisampleEXT = nullptr;
+    tk_glRenderbufferStorageMultisampleEXT  = nullptr;
+    tk_glInsertEventMarkerEXT               = nullptr;
+    tk_glPopGroupMarkerEXT                  = nullptr;
+    tk_glPushGroupMarkerEXT                 = nullptr;
+    tk_glLabelObjectEXT                     = nullptr;
+    tk_glGetObjectLabelEXT                  = nullptr;
+    TK_GL_EXT_texture_filter_anisotropic    = 0;
+    TK_GL_OES_texture_float_linear          = 0;
+
+    // Compressed images are only measured, any format is accepted.
+    TK_GL_texture_compression_etc2          = 1;
+    TK_GL_KHR_texture_compression_astc_ldr  = 1;
 #endif
   }
 
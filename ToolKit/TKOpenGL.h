@@ -105,9 +105,21 @@ namespace ToolKit
 
   extern int TK_GL_OES_texture_float_linear;
 
+  // Compressed texture formats
+  //////////////////////////////////////////
+
+  /** States if etc2 / eac formats are reported by the driver. Core in gles 3.0 but not exposed by all drivers. */
+  extern int TK_GL_texture_compression_etc2;
+
+  /** States if 4x4 ldr astc formats are reported by the driver. */
+  extern int TK_GL_KHR_texture_compression_astc_ldr;
+
   // GL Loader function
   //////////////////////////////////////////
 
   extern void LoadGlFunctions(void* glGetProcAddres);
 
+  /** Loads the gpu less null backend in place of the platform functions. Extensions are not provided. */
+  extern void LoadNullGlFunctions();
+
 } // namespace ToolKit
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "FileManager.h"
 #include "FullQuadPass.h"
 #include "Image.h"
+#include "IrradianceCache.h"
 #include "Logger.h"
 #include "Material.h"
 #include "RHI.h"
@@ -26,6 +27,30 @@
 namespace ToolKit
 {
 
+  /**
+   * Accounts the gpu memory that block compression saves on the resident levels of a texture, compared to rgba8.
+   * Released levels are removed from the savings.
+   */
+  static void UpdateCompressionSavings(GraphicTypes format, uint64 residentSize, bool released)
+  {
+    TKStats* stats = GetTKStats();
+    if (stats == nullptr || !IsCompressedFormat(format))
+    {
+      return;
+    }
+
+    // A 4x4 block is 64 bytes in rgba8.
+    uint64 savings = residentSize * 64 / BytesOfCompressedBlock(format) - residentSize;
+    if (released)
+    {
+      stats->m_compressedTextureSavings -= glm::min(savings, stats->m_compressedTextureSavings);
+    }
+    else
+    {
+      stats->m_compressedTextureSavings += savings;
+    }
+  }
+
   // Texture
   //////////////////////////////////////////
 
@@ -89,6 +114,32 @@ namespace ToolKit
     }
     else
     {
+      // Published paks may contain a cooked, block compressed version of the image which is uploaded without decoding.
+      String ext;
+      DecomposePath(GetFile(), nullptr, nullptr, &ext);
+      if (ext == KTX)
+      {
+        m_loaded = LoadCompressed(GetFile());
+        return;
+      }
+
+      // Published ui images may be packed in to an atlas page, which all of them share.
+      if (LoadFromAtlas())
+      {
+        m_loaded = true;
+        return;
+      }
+
+      String cookedFile = TextureCompressor::CookedFilePath(GetFile());
+      if (!cookedFile.empty() && GetFileManager()->CheckFileFromPak(cookedFile))
+      {
+        if (LoadCompressed(cookedFile))
+        {
+          m_loaded = true;
+          return;
+        }
+      }
+
       if ((m_image = GetFileManager()->GetImageFile(GetFile(), &m_width, &m_height, &m_numChannels, 4)))
       {
         m_loaded = true;
@@ -96,6 +147,90 @@ namespace ToolKit
     }
   }
 
+  bool Texture::LoadCompressed(const String& file)
+  {
+    CompressedImagePtr image = std::make_shared<CompressedImage>();
+    if (!TextureCompressor::ReadKTX(GetFileManager()->GetBinaryFile(file), *image))
+    {
+      TK_WRN("Invalid compressed image: %s", file.c_str());
+      return false;
+    }
+
+    // Cooked images hold the linear format, texture settings decide how they are sampled.
+    if (m_settings.InternalFormat == GraphicTypes::FormatSRGB8_A8)
+    {
+      image->format = TextureCompressor::ToSRGBFormat(image->format);
+    }
+
+    if (TextureCompressor::IsFormatSupported(image->format))
+    {
+      m_compressedFile          = file;
+      m_compressedImage         = image;
+      m_width                   = image->width;
+      m_height                  = image->height;
+      m_numChannels             = 4;
+      m_settings.InternalFormat = image->format;
+      return true;
+    }
+
+    // Driver can't sample the format, fall back to an uncompressed image.
+    UInt8Array rgba;
+    if (!TextureCompressor::Decompress(*image, 0, rgba))
+    {
+      return false;
+    }
+
+    // Released with ImageFree, which expects a tracked block.
+    m_image = (uint8*) TKMalloc(rgba.size(), MemoryTag::Texture);
+    memcpy(m_image, rgba.data(), rgba.size());
+    m_width       = image->width;
+    m_height      = image->height;
+    m_numChannels = 4;
+
+    return true;
+  }
+
+  bool Texture::LoadFromAtlas()
+  {
+    // Only plain file textures are packed.
+    if (Class() != Texture::StaticClass() || GetFile().empty())
+    {
+      return false;
+    }
+
+    TextureManager* textureMan = GetTextureManager();
+    TextureAtlas* atlas        = textureMan != nullptr ? textureMan->GetAtlas() : nullptr;
+    if (atlas == nullptr)
+    {
+      return false;
+    }
+
+    const AtlasRegion* region = atlas->Find(GetFile());
+    if (region == nullptr)
+    {
+      return false;
+    }
+
+    m_atlasPage = textureMan->Create<Texture>(atlas->GetPageFile(region->page));
+    if (m_atlasPage == nullptr)
+    {
+      return false;
+    }
+
+    // Ui is drawn at 1:1, pages are not mipmapped so that the smaller levels can't bleed the neighbour images in.
+    TextureSettings pageSettings = m_atlasPage->Settings();
+    pageSettings.MinFilter       = GraphicTypes::SampleLinear;
+    pageSettings.GenerateMipMap  = false;
+    m_atlasPage->Settings(pageSettings);
+
+    m_atlasRect   = atlas->GetUVRect(*region);
+    m_width       = region->rect.Width;
+    m_height      = region->rect.Height;
+    m_numChannels = 4;
+
+    return true;
+  }
+
   void Texture::Init(bool flushClientSideArray)
   {
     if (m_initiated)
@@ -103,8 +238,17 @@ namespace ToolKit
       return;
     }
 
+    // Packed images are drawn with the gpu texture of their page.
+    if (m_atlasPage != nullptr)
+    {
+      m_atlasPage->Init(flushClientSideArray);
+      m_textureId = m_atlasPage->m_textureId;
+      m_initiated = true;
+      return;
+    }
+
     // Sanity checks
-    if ((m_image == nullptr && m_imagef == nullptr))
+    if (m_image == nullptr && m_imagef == nullptr && m_compressedImage == nullptr)
     {
       assert(0 && "No texture data.");
       return;
@@ -120,20 +264,25 @@ namespace ToolKit
     glGenTextures(1, &m_textureId);
     RHI::SetTexture((GLenum) m_settings.Target, m_textureId);
 
-    uint64 pixelCount = (uint64) m_width * (uint64) m_height;
-    if (m_settings.Type != GraphicTypes::TypeFloat)
+    m_mipCount    = 1;
+    m_residentMip = 0;
+    if (IsStreamable())
     {
-      glTexImage2D(GL_TEXTURE_2D,
-                   0,
-                   (GLint) m_settings.InternalFormat,
-                   m_width,
-                   m_height,
-                   0,
-                   GL_RGBA,
-                   GL_UNSIGNED_BYTE,
-                   m_image);
+      InitStreamed();
+    }
+    else if (m_compressedImage != nullptr)
+    {
+      // Baked mip chain is skipped if the texture is not mipmapped.
+      const std::vector<ByteArray>& levels = m_compressedImage->mipLevels;
+      int levelCount                       = m_settings.GenerateMipMap ? (int) levels.size() : 1;
+      for (int level = 0; level < levelCount; level++)
+      {
+        UploadMip(level, &levels[level]);
+      }
 
-      Stats::AddVRAMUsageInBytes(pixelCount * BytesOfFormat(m_settings.InternalFormat));
+      // Limit sampling to the uploaded levels.
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+      m_mipCount = levelCount;
     }
     else
     {
@@ -144,16 +293,20 @@ namespace ToolKit
                    m_height,
                    0,
                    GL_RGBA,
-                   GL_FLOAT,
-                   m_imagef);
+                   m_settings.Type == GraphicTypes::TypeFloat ? GL_FLOAT : GL_UNSIGNED_BYTE,
+                   m_settings.Type == GraphicTypes::TypeFloat ? (void*) m_imagef : (void*) m_image);
 
-      Stats::AddVRAMUsageInBytes(pixelCount * BytesOfFormat(m_settings.InternalFormat));
+      if (m_settings.GenerateMipMap)
+      {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        m_mipCount = CalculateMipmapLevels();
+      }
     }
 
-    if (m_settings.GenerateMipMap)
-    {
-      glGenerateMipmap(GL_TEXTURE_2D);
-    }
+    // Generated mip levels are accounted too.
+    m_residentSize = CalculateMipMemory(m_residentMip, m_mipCount - 1);
+    Stats::AddVRAMUsageInBytes(m_residentSize);
+    UpdateCompressionSavings(m_settings.InternalFormat, m_residentSize, false);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint) m_settings.MinFilter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint) m_settings.MagFilter);
@@ -174,7 +327,8 @@ namespace ToolKit
       glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, aniso);
     }
 
-    if (flushClientSideArray)
+    // Streamer reloads the levels from the file, client side image is not needed anymore.
+    if (flushClientSideArray || m_streamed)
     {
       Clear();
     }
@@ -182,6 +336,153 @@ namespace ToolKit
     m_initiated = true;
   }
 
+  bool Texture::IsStreamable() const
+  {
+    if (Class() != Texture::StaticClass() || GetFile().empty())
+    {
+      return false;
+    }
+
+    TextureManager* textureMan = GetTextureManager();
+    if (textureMan == nullptr || textureMan->m_streamer == nullptr || !textureMan->m_streamer->IsEnabled())
+    {
+      return false;
+    }
+
+    // Pages are sampled through the textures of the packed images, their screen size is never requested.
+    if (TextureAtlas* atlas = textureMan->GetAtlas())
+    {
+      if (atlas->IsPage(GetFile()))
+      {
+        return false;
+      }
+    }
+
+    if (m_settings.Target != GraphicTypes::Target2D || m_settings.Type == GraphicTypes::TypeFloat)
+    {
+      return false;
+    }
+
+    // Compressed images must come with their full mip chain.
+    if (m_compressedImage != nullptr)
+    {
+      int levelCount = glm::log2(glm::max(m_width, m_height)) + 1;
+      if ((int) m_compressedImage->mipLevels.size() != levelCount)
+      {
+        return false;
+      }
+    }
+    else if (m_image == nullptr || !m_settings.GenerateMipMap)
+    {
+      return false;
+    }
+
+    return glm::max(m_width, m_height) > textureMan->m_streamer->m_minResidentSize;
+  }
+
+  void Texture::InitStreamed()
+  {
+    TextureStreamer* streamer = GetTextureManager()->m_streamer;
+
+    m_mipCount                = CalculateMipmapLevels();
+    m_residentMip             = streamer->CalculateMinResidentMip(m_width, m_height);
+
+    // Only the smallest levels are uploaded, the rest is loaded by the streamer when the texture is seen up close.
+    if (m_compressedImage != nullptr)
+    {
+      for (int level = m_residentMip; level < m_mipCount; level++)
+      {
+        UploadMip(level, &m_compressedImage->mipLevels[level]);
+      }
+    }
+    else
+    {
+      std::vector<UInt8Array> chain;
+      bool srgb = m_settings.InternalFormat == GraphicTypes::FormatSRGB8_A8;
+      TextureCompressor::GenerateMipChain(m_image, m_width, m_height, srgb, chain);
+
+      for (int level = m_residentMip; level < m_mipCount; level++)
+      {
+        const UInt8Array& pixels = chain[level - 1];
+        ByteArray data(pixels.begin(), pixels.end());
+        UploadMip(level, &data);
+      }
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, m_residentMip);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_mipCount - 1);
+
+    m_streamed = true;
+    streamer->Register(this);
+  }
+
+  void Texture::UploadMip(int level, const ByteArray* data)
+  {
+    // Zero sized image releases the level's memory.
+    int width       = data != nullptr ? glm::max(1, m_width >> level) : 0;
+    int height      = data != nullptr ? glm::max(1, m_height >> level) : 0;
+    const void* ptr = data != nullptr ? data->data() : nullptr;
+
+    if (IsCompressedFormat(m_settings.InternalFormat))
+    {
+      GLsizei size = data != nullptr ? (GLsizei) data->size() : 0;
+      glCompressedTexImage2D(GL_TEXTURE_2D, level, (GLenum) m_settings.InternalFormat, width, height, 0, size, ptr);
+    }
+    else
+    {
+      glTexImage2D(GL_TEXTURE_2D,
+                   level,
+                   (GLint) m_settings.InternalFormat,
+                   width,
+                   height,
+                   0,
+                   GL_RGBA,
+                   GL_UNSIGNED_BYTE,
+                   ptr);
+    }
+  }
+
+  void Texture::LoadMips(int firstMip, const std::vector<ByteArray>& levels)
+  {
+    assert(firstMip + (int) levels.size() == m_residentMip && "Levels must end before the resident levels.");
+
+    RHI::SetTexture(GL_TEXTURE_2D, m_textureId);
+    for (int i = 0; i < (int) levels.size(); i++)
+    {
+      UploadMip(firstMip + i, &levels[i]);
+    }
+
+    // Sampling switches to the new levels once they are all defined.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstMip);
+
+    uint64 size     = CalculateMipMemory(firstMip, m_residentMip - 1);
+    m_residentMip   = firstMip;
+    m_residentSize += size;
+    Stats::AddVRAMUsageInBytes(size);
+    UpdateCompressionSavings(m_settings.InternalFormat, size, false);
+  }
+
+  void Texture::EvictMips(int residentMip)
+  {
+    if (residentMip <= m_residentMip)
+    {
+      return;
+    }
+
+    RHI::SetTexture(GL_TEXTURE_2D, m_textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, residentMip);
+    for (int level = m_residentMip; level < residentMip; level++)
+    {
+      UploadMip(level, nullptr);
+    }
+
+    uint64 size     = CalculateMipMemory(m_residentMip, residentMip - 1);
+    m_residentMip   = residentMip;
+    m_residentSize -= size;
+    Stats::RemoveVRAMUsageInBytes(size);
+    UpdateCompressionSavings(m_settings.InternalFormat, size, true);
+  }
+
   void Texture::UnInit()
   {
     if (m_textureId == 0 || !m_initiated)
@@ -189,8 +490,38 @@ namespace ToolKit
       return;
     }
 
+    // Gpu texture belongs to the atlas page.
+    if (m_atlasPage != nullptr)
+    {
+      m_textureId = 0;
+      m_initiated = false;
+      return;
+    }
+
+    if (m_streamed)
+    {
+      if (TextureManager* textureMan = GetTextureManager())
+      {
+        if (textureMan->m_streamer != nullptr)
+        {
+          textureMan->m_streamer->Unregister(this);
+        }
+      }
+
+      // Image data is released after the initialization, it must be loaded again.
+      m_streamed = false;
+      m_loaded   = false;
+    }
+
     uint64 pixelCount = (uint64) m_width * (uint64) m_height;
-    if (m_settings.Target == GraphicTypes::Target2D)
+    if (m_residentSize > 0)
+    {
+      Stats::RemoveVRAMUsageInBytes(m_residentSize);
+      UpdateCompressionSavings(m_settings.InternalFormat, m_residentSize, true);
+      m_residentSize = 0;
+      m_residentMip  = 0;
+    }
+    else if (m_settings.Target == GraphicTypes::Target2D)
     {
       Stats::RemoveVRAMUsageInBytes(pixelCount * BytesOfFormat(m_settings.InternalFormat));
     }
@@ -231,13 +562,74 @@ namespace ToolKit
     glGenerateMipmap((GLenum) m_settings.Target);
   }
 
+  uint64 Texture::GetCpuMemory() const
+  {
+    uint64 pixelCount = (uint64) m_width * (uint64) m_height;
+    uint64 memory     = 0;
+    if (m_image != nullptr)
+    {
+      memory += pixelCount * 4;
+    }
+
+    if (m_imagef != nullptr)
+    {
+      memory += pixelCount * 4 * sizeof(float);
+    }
+
+    if (m_compressedImage != nullptr)
+    {
+      memory += m_compressedImage->DataSize();
+    }
+
+    return memory;
+  }
+
+  uint64 Texture::GetGpuMemory() const
+  {
+    // Accounted by the atlas page.
+    if (m_atlasPage != nullptr)
+    {
+      return 0;
+    }
+
+    if (m_residentSize > 0 || !m_initiated)
+    {
+      return m_residentSize;
+    }
+
+    // Same as the sizes removed from the vram usage in UnInit.
+    uint64 memory = (uint64) m_width * (uint64) m_height * BytesOfFormat(m_settings.InternalFormat);
+    if (m_settings.Target == GraphicTypes::Target2DArray)
+    {
+      memory *= glm::max(1, m_settings.Layers);
+    }
+    else if (m_settings.Target == GraphicTypes::TargetCubeMap)
+    {
+      memory *= 6;
+    }
+
+    return memory;
+  }
+
+  uint64 Texture::CalculateMipMemory(int firstMip, int lastMip) const
+  {
+    uint64 size = 0;
+    for (int level = firstMip; level <= lastMip; level++)
+    {
+      size += BytesOfImage(m_settings.InternalFormat, glm::max(1, m_width >> level), glm::max(1, m_height >> level));
+    }
+
+    return size;
+  }
+
   void Texture::Clear()
   {
     ImageFree(m_image);
     ImageFree(m_imagef);
 
-    m_image  = nullptr;
-    m_imagef = nullptr;
+    m_image           = nullptr;
+    m_imagef          = nullptr;
+    m_compressedImage = nullptr;
   }
 
   // DepthTexture
@@ -568,11 +960,25 @@ namespace ToolKit
     }
   }
 
+  uint64 CubeMap::GetCpuMemory() const
+  {
+    uint64 memory = 0;
+    for (uint8* image : m_images)
+    {
+      if (image != nullptr)
+      {
+        memory += (uint64) m_width * (uint64) m_height * 4;
+      }
+    }
+
+    return memory;
+  }
+
   void CubeMap::Clear()
   {
     for (int i = 0; i < m_images.size(); i++)
     {
-      free(m_images[i]);
+      ImageFree(m_images[i]);
       m_images[i] = nullptr;
     }
     m_loaded = false;
@@ -623,7 +1029,7 @@ namespace ToolKit
     Texture::Init(flushClientSideArray);
     m_initiated = false;
 
-    if (_diffuseBakeFile.empty())
+    if (_diffuseBakeFile.empty() && _irradianceCacheFile.empty())
     {
       RenderTask task = {[this](Renderer* renderer) -> void
                          {
@@ -669,6 +1075,7 @@ namespace ToolKit
                            // reflect during editor time or in game requests.
                            _diffuseBakeFile.clear();
                            _specularBakeFile.clear();
+                           _irradianceCacheFile.clear();
                          }};
 
       GetRenderSystem()->AddRenderTask(task);
@@ -703,29 +1110,13 @@ namespace ToolKit
 
   void Hdri::LoadIrradianceCaches(Renderer* renderer)
   {
-    // Convert hdri image to cubemap images.
-    // Floating point texture settings for caches.
-    TextureSettings fTexture;
-    fTexture.InternalFormat = GraphicTypes::FormatRGBA16F;
-    fTexture.Type           = GraphicTypes::TypeFloat;
-
-    // Read diffuse irradiance cache map.
-    String cacheFile        = _diffuseBakeFile + HDR;
-    TexturePtr envCache     = MakeNewPtr<Texture>();
-    envCache->Settings(fTexture);
-    envCache->SetFile(cacheFile);
-    envCache->Load();
-
     TextureManager* texMan = GetTextureManager();
-    texMan->Manage(envCache);
 
     // One face of the cube map is 1/4 of the width.
-    auto eq2Cube    = [](int width) -> int { return width / 4; };
-
-    uint size       = eq2Cube(envCache->m_width);
-    m_diffuseEnvMap = renderer->GenerateCubemapFrom2DTexture(envCache, size, 1.0f);
+    auto eq2Cube           = [](int width) -> int { return width / 4; };
 
-    // Read specular irradiance cache map. First image will be same as the hdri for specular IR cache.
+    // Specular IR cache's first level is the same as the hdri.
+    uint size              = 0;
     if (IsDynamic())
     {
       // This is not read from equirect image file.
@@ -740,6 +1131,54 @@ namespace ToolKit
       m_cubemap       = renderer->GenerateCubemapFrom2DTexture(self, size, 1.0f);
     }
 
+    // Prefer the single cache file, its images are uploaded as is.
+    IrradianceCache cache;
+    bool useCache = !_irradianceCacheFile.empty() && cache.Open(_irradianceCacheFile + ENVBAKE);
+    if (useCache && cache.GetSpecularSize() != (int) size)
+    {
+      TK_WRN("Irradiance cache doesn't match the hdri: %s", _irradianceCacheFile.c_str());
+      useCache = false;
+    }
+
+    if (!useCache && _diffuseBakeFile.empty())
+    {
+      // Nothing usable on the disk.
+      GenerateIrradianceCaches(renderer);
+      return;
+    }
+
+    // Floating point texture settings for caches.
+    TextureSettings fTexture;
+    fTexture.InternalFormat = GraphicTypes::FormatRGBA16F;
+    fTexture.Type           = GraphicTypes::TypeFloat;
+
+    if (m_diffuseSHOnly)
+    {
+      GenerateDiffuseSH(renderer);
+      m_diffuseEnvMap = nullptr;
+    }
+    else if (useCache && cache.HasDiffuseEnvMap())
+    {
+      m_diffuseEnvMap = cache.CreateDiffuseEnvMap();
+    }
+    else if (useCache)
+    {
+      // Cache is baked for spherical harmonics only.
+      m_diffuseEnvMap = renderer->GenerateDiffuseEnvMap(m_cubemap, glm::max(64, m_width / 32));
+    }
+    else
+    {
+      // Read diffuse irradiance cache map.
+      String cacheFile    = _diffuseBakeFile + HDR;
+      TexturePtr envCache = MakeNewPtr<Texture>();
+      envCache->Settings(fTexture);
+      envCache->SetFile(cacheFile);
+      envCache->Load();
+      texMan->Manage(envCache);
+
+      m_diffuseEnvMap = renderer->GenerateCubemapFrom2DTexture(envCache, eq2Cube(envCache->m_width), 1.0f);
+    }
+
     // Initial level '0' is just the copy of color map.
     TextureSettings srtSettings = m_cubemap->Settings();
     srtSettings.MinFilter       = GraphicTypes::SampleLinearMipmapLinear;
@@ -757,6 +1196,12 @@ namespace ToolKit
     m_specularEnvMap->AllocateMipMapStorage();
     m_specularEnvMap->GenerateMipMaps();
 
+    if (useCache)
+    {
+      cache.UploadSpecularLods(m_specularEnvMap);
+      return;
+    }
+
     for (int i = 1; i < RHIConstants::SpecularIBLLods; i++)
     {
       String cacheFile = _specularBakeFile + std::to_string(i) + HDR;
@@ -783,9 +1228,44 @@ namespace ToolKit
     // Pre-filtered and mip mapped environment map
     m_specularEnvMap = renderer->GenerateSpecularEnvMap(m_cubemap, m_cubemap->m_width, RHIConstants::SpecularIBLLods);
 
+    if (m_diffuseSHOnly)
+    {
+      GenerateDiffuseSH(renderer);
+      m_diffuseEnvMap = nullptr;
+      return;
+    }
+
     // Generate diffuse irradience cubemap images
-    int size         = glm::max(64, m_width / 32); // Smaller size for diffuse.
-    m_diffuseEnvMap  = renderer->GenerateDiffuseEnvMap(m_cubemap, size);
+    int size        = glm::max(64, m_width / 32); // Smaller size for diffuse.
+    m_diffuseEnvMap = renderer->GenerateDiffuseEnvMap(m_cubemap, size);
+  }
+
+  void Hdri::GenerateDiffuseSH(Renderer* renderer)
+  {
+    m_diffuseSH.data = renderer->GenerateDiffuseSH(m_cubemap);
+    m_diffuseSH.id   = GetIdVal();
+    m_diffuseSH.Validate();
+  }
+
+  void Hdri::GenerateMissingDiffuseIrradiance(Renderer* renderer)
+  {
+    if (m_cubemap == nullptr)
+    {
+      return;
+    }
+
+    if (m_diffuseSHOnly)
+    {
+      if (!m_diffuseSH.isValid)
+      {
+        GenerateDiffuseSH(renderer);
+      }
+    }
+    else if (m_diffuseEnvMap == nullptr)
+    {
+      int size        = glm::max(64, m_width / 32); // Smaller size for diffuse.
+      m_diffuseEnvMap = renderer->GenerateDiffuseEnvMap(m_cubemap, size);
+    }
   }
 
   String Hdri::GenerateBakedEnvironmentFileBaseName()
@@ -837,11 +1317,27 @@ namespace ToolKit
     return ConcatPaths({TKIrradianceCacheFolder, file + "_spec_env_bake_"});
   }
 
+  String Hdri::ToIrradianceCacheFileName(const String& file)
+  {
+    if (HasToolKitRoot(file))
+    {
+      return CreateDefaultBakePath(file, "_env_bake");
+    }
+
+    return ConcatPaths({TKIrradianceCacheFolder, file + "_env_bake"});
+  }
+
   void Hdri::TrySettingCacheFiles(const String& baseName)
   {
     // Check sky hdr caches.
     if (!baseName.empty())
     {
+      String cacheFile = TexturePath(ToIrradianceCacheFileName(baseName));
+      if (CheckFile(cacheFile + ENVBAKE))
+      {
+        _irradianceCacheFile = cacheFile;
+      }
+
       String bakeFile = TexturePath(ToDiffuseIrradianceFileName(baseName));
       if (CheckFile(bakeFile + HDR))
       {
@@ -973,6 +1469,23 @@ namespace ToolKit
 
   TextureManager::~TextureManager() {}
 
+  void TextureManager::Init()
+  {
+    ResourceManager::Init();
+    m_streamer = new TextureStreamer();
+  }
+
+  void TextureManager::Uninit()
+  {
+    // Textures unregister from the streamer while they are released.
+    ResourceManager::Uninit();
+    SafeDel(m_streamer);
+
+    LockGuard lock(m_atlasMutex);
+    SafeDel(m_atlas);
+    m_atlasChecked = false;
+  }
+
   bool TextureManager::CanStore(ClassMeta* Class)
   {
     if (Class->IsSublcassOf(Texture::StaticClass()))
@@ -983,6 +1496,28 @@ namespace ToolKit
     return false;
   }
 
+  TextureAtlas* TextureManager::GetAtlas()
+  {
+    LockGuard lock(m_atlasMutex);
+    if (!m_atlasChecked)
+    {
+      m_atlasChecked  = true;
+
+      String manifest = TextureAtlas::GetManifestPath();
+      if (GetFileManager()->CheckFileFromPak(manifest))
+      {
+        m_atlas = new TextureAtlas();
+        if (!m_atlas->Load(manifest))
+        {
+          TK_WRN("Texture atlas can't be loaded: %s", manifest.c_str());
+          SafeDel(m_atlas);
+        }
+      }
+    }
+
+    return m_atlas;
+  }
+
   String TextureManager::GetDefaultResource(ClassMeta* Class)
   {
     if (Class == Hdri::StaticClass())
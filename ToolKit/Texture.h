@@ -9,6 +9,10 @@
 
 #include "Resource.h"
 #include "ResourceManager.h"
+#include "SphericalHarmonics.h"
+#include "TextureAtlas.h"
+#include "TextureCompressor.h"
+#include "TextureStreamer.h"
 #include "Types.h"
 
 namespace ToolKit
@@ -38,6 +42,8 @@ namespace ToolKit
 
   class TK_API Texture : public Resource
   {
+    friend class TextureStreamer;
+
    public:
     TKDeclareClass(Texture, Resource);
 
@@ -63,21 +69,93 @@ namespace ToolKit
     /** Generate mip maps for the texture. */
     void GenerateMipMaps();
 
+    /** Calculates the gpu memory of the mip levels in the range in bytes. */
+    uint64 CalculateMipMemory(int firstMip, int lastMip) const;
+
+    /** States if the mip levels of the texture are managed by the TextureStreamer. */
+    bool IsStreamed() const { return m_streamed; }
+
+    /** @return The largest mip level that is resident on the gpu. */
+    int GetResidentMip() const { return m_residentMip; }
+
+    /** @return Number of mip levels that the texture has, resident or not. */
+    int GetMipCount() const { return m_mipCount; }
+
+    /** @return Gpu memory used by the resident mip levels in bytes. */
+    uint64 GetResidentMemory() const { return m_residentSize; }
+
+    /** @return Memory held by the decoded or compressed image that is waiting to be uploaded. */
+    uint64 GetCpuMemory() const override;
+
+    /** @return Memory held by all levels, faces and layers on the gpu. */
+    uint64 GetGpuMemory() const override;
+
+    /** @return Atlas page that the image is sampled from, nullptr if the image is not packed in to an atlas. */
+    const TexturePtr& GetAtlasPage() const { return m_atlasPage; }
+
+    /**
+     * Region of the image in its atlas page in normalized texture coordinates, xy is the first texel and zw is the
+     * size. Covers the whole texture if the image is not packed in to an atlas.
+     */
+    const Vec4& GetAtlasRect() const { return m_atlasRect; }
+
    protected:
     /** Removes image data. */
     virtual void Clear();
 
+    /** States if the texture can be streamed. Only 8 bit 2d file textures with mip maps are streamed. */
+    bool IsStreamable() const;
+
+    /** Uploads the smallest levels and registers the texture to the TextureStreamer. */
+    void InitStreamed();
+
+    /** Defines the mip level on the gpu. Passing nullptr frees the level. */
+    void UploadMip(int level, const ByteArray* data);
+
+    /**
+     * Uploads the levels that are larger than the resident levels.
+     * @param firstMip is the level of the first element in levels. Levels must end right before the resident levels.
+     */
+    void LoadMips(int firstMip, const std::vector<ByteArray>& levels);
+
+    /** Frees the levels that are larger than the given level, which becomes the largest resident level. */
+    void EvictMips(int residentMip);
+
+    /**
+     * Loads a cooked block compressed image. If the format is not supported by the driver, decodes the largest level
+     * in to m_image instead.
+     * @return False if the image can't be loaded or decoded.
+     */
+    bool LoadCompressed(const String& file);
+
+    /**
+     * Points the texture to its region of an atlas page if the image is packed in to the atlas of the pak. The texture
+     * keeps the size of the image and shares the gpu texture of the page.
+     * @return False if the image is not in the atlas.
+     */
+    bool LoadFromAtlas();
+
    public:
-    uint m_textureId  = 0;
-    int m_width       = 0;
-    int m_height      = 0;
-    int m_numChannels = 0; //!< Number of channels (r, g, b, a) for loaded images.
-    uint8* m_image    = nullptr;
-    float* m_imagef   = nullptr;
+    uint m_textureId                     = 0;
+    int m_width                          = 0;
+    int m_height                         = 0;
+    int m_numChannels                    = 0; //!< Number of channels (r, g, b, a) for loaded images.
+    uint8* m_image                       = nullptr;
+    float* m_imagef                      = nullptr;
+    CompressedImagePtr m_compressedImage = nullptr; //!< Block compressed image with its mip chain, uploaded as is.
     StringView m_label; //!< Debug label which appears in the gpu debuggers.
 
    protected:
     TextureSettings m_settings;
+    uint64 m_residentSize = 0;     //!< Gpu memory used by the resident mip levels in bytes.
+    int m_mipCount        = 1;     //!< Number of mip levels that the texture has.
+    int m_residentMip     = 0;     //!< Largest mip level that is resident on the gpu.
+    bool m_streamed       = false; //!< States if the texture is registered to the TextureStreamer.
+    String m_compressedFile;       //!< Cooked file that the compressed image is loaded from.
+    TexturePtr m_atlasPage;        //!< Atlas page that the image is sampled from.
+
+    /** Region of the image in the atlas page, see GetAtlasRect. */
+    Vec4 m_atlasRect = Vec4(0.0f, 0.0f, 1.0f, 1.0f);
   };
 
   // DepthTexture
@@ -176,6 +254,9 @@ namespace ToolKit
      */
     void AllocateMipMapStorage();
 
+    /** @return Memory held by the face images. */
+    uint64 GetCpuMemory() const override;
+
    protected:
     /** Free the image data for each face. */
     void Clear() override;
@@ -215,12 +296,24 @@ namespace ToolKit
      */
     void GenerateIrradianceCaches(class Renderer* renderer);
 
+    /** Projects the m_cubemap on to spherical harmonics. Make sure this called from render thread. Use render task. */
+    void GenerateDiffuseSH(class Renderer* renderer);
+
+    /**
+     * Generates the diffuse irradiance that m_diffuseSHOnly requires if it is missing, spherical harmonics or the
+     * diffuse env map. Used when the environment switches between them after the caches are ready. Make sure this
+     * called from render thread. Use render task.
+     */
+    void GenerateMissingDiffuseIrradiance(class Renderer* renderer);
+
     /** Returns the environment map baked file name without mip level post fix. */
     String GenerateBakedEnvironmentFileBaseName();
     /** Returns diffuse irradiance file name for the given hdri image. */
     String ToDiffuseIrradianceFileName(const String& file);
     /** Returns specular irradiance file name for the given hdri image. */
     String ToSpecularIrradianceFileName(const String& file);
+    /** Returns the file name of the cache that holds both diffuse and specular irradiance for the given hdri image. */
+    String ToIrradianceCacheFileName(const String& file);
 
     /** Checks the cache files, if they exist, assign them to cache file fields. */
     void TrySettingCacheFiles(const String& baseName);
@@ -232,12 +325,22 @@ namespace ToolKit
     /** Indicates there is a task to initiate the hdri. */
     bool m_waitingForInit           = false;
 
+    /**
+     * If set to true, diffuse irradiance is only kept as spherical harmonics and no diffuse env map is created.
+     * Environments that use the hdri must sample the spherical harmonics.
+     */
+    bool m_diffuseSHOnly            = false;
+
     CubeMapPtr m_cubemap            = nullptr;
     CubeMapPtr m_specularEnvMap     = nullptr;
     CubeMapPtr m_diffuseEnvMap      = nullptr;
 
-    String _diffuseBakeFile;  //!< If not null, init will try to look up baked environment maps.
-    String _specularBakeFile; //!< If not null, init will try to look up baked environment maps.
+    /** Diffuse irradiance as spherical harmonics. Valid once the irradiance caches are generated or loaded. */
+    DiffuseSHCacheItem m_diffuseSH;
+
+    String _diffuseBakeFile;     //!< If not null, init will try to look up baked environment maps.
+    String _specularBakeFile;    //!< If not null, init will try to look up baked environment maps.
+    String _irradianceCacheFile; //!< If not null, caches are uploaded from this file instead of the baked maps.
   };
 
   // RenderTarget
@@ -266,8 +369,25 @@ namespace ToolKit
    public:
     TextureManager();
     virtual ~TextureManager();
+    void Init() override;
+    void Uninit() override;
     bool CanStore(ClassMeta* Class) override;
     String GetDefaultResource(ClassMeta*) override;
+
+    /**
+     * @return Atlas of the ui and sprite images in the pak, nullptr if the pak has none. Loose files, as in the editor,
+     * are never atlased. Manifest is read on the first call.
+     */
+    TextureAtlas* GetAtlas();
+
+   public:
+    /** Streams the mip levels of file textures. Valid between Init and Uninit. */
+    TextureStreamer* m_streamer = nullptr;
+
+   private:
+    TextureAtlas* m_atlas = nullptr;
+    bool m_atlasChecked   = false; //!< States if the pak is checked for an atlas.
+    Mutex m_atlasMutex;            //!< Textures are loaded from multiple threads.
   };
 
 } // namespace ToolKit
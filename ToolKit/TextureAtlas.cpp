@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "TextureAtlas.h"
+
+#include "FileManager.h"
+#include "Image.h"
+#include "Logger.h"
+#include "PakBuilder.h"
+#include "ToolKit.h"
+#include "Util.h"
+
+#include <fstream>
+#include <numeric>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  static const int g_atlasManifestVersion = 1;
+
+  // RectPacker
+  //////////////////////////////////////////
+
+  RectPacker::RectPacker(int width, int height) : m_width(width), m_height(height)
+  {
+    m_freeRects.push_back({0, 0, width, height});
+  }
+
+  bool RectPacker::Insert(int width, int height, Rect<int>& rect)
+  {
+    // Best short side fit, the free rectangle that leaves the least space on one of the sides is used.
+    int best          = -1;
+    int bestShortSide = TK_INT_MAX;
+    int bestLongSide  = TK_INT_MAX;
+    for (int i = 0; i < (int) m_freeRects.size(); i++)
+    {
+      const Rect<int>& free = m_freeRects[i];
+      if (free.Width < width || free.Height < height)
+      {
+        continue;
+      }
+
+      int leftoverX = free.Width - width;
+      int leftoverY = free.Height - height;
+      int shortSide = glm::min(leftoverX, leftoverY);
+      int longSide  = glm::max(leftoverX, leftoverY);
+      if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+      {
+        best          = i;
+        bestShortSide = shortSide;
+        bestLongSide  = longSide;
+      }
+    }
+
+    if (best == -1)
+    {
+      return false;
+    }
+
+    rect = {m_freeRects[best].X, m_freeRects[best].Y, width, height};
+    SplitFreeRects(rect);
+    PruneFreeRects();
+
+    m_usedArea += (uint64) width * (uint64) height;
+    return true;
+  }
+
+  float RectPacker::GetOccupancy() const
+  {
+    uint64 area = (uint64) m_width * (uint64) m_height;
+    return area > 0 ? (float) ((double) m_usedArea / (double) area) : 0.0f;
+  }
+
+  void RectPacker::SplitFreeRects(const Rect<int>& used)
+  {
+    std::vector<Rect<int>> parts;
+    for (int i = 0; i < (int) m_freeRects.size();)
+    {
+      Rect<int> free = m_freeRects[i];
+      if (used.X >= free.X + free.Width || used.X + used.Width <= free.X || used.Y >= free.Y + free.Height ||
+          used.Y + used.Height <= free.Y)
+      {
+        i++;
+        continue;
+      }
+
+      m_freeRects[i] = m_freeRects.back();
+      m_freeRects.pop_back();
+
+      // Maximal parts of the free rectangle on each side of the used one. The parts overlap each other.
+      if (used.X > free.X)
+      {
+        parts.push_back({free.X, free.Y, used.X - free.X, free.Height});
+      }
+
+      if (used.X + used.Width < free.X + free.Width)
+      {
+        parts.push_back({used.X + used.Width, free.Y, free.X + free.Width - used.X - used.Width, free.Height});
+      }
+
+      if (used.Y > free.Y)
+      {
+        parts.push_back({free.X, free.Y, free.Width, used.Y - free.Y});
+      }
+
+      if (used.Y + used.Height < free.Y + free.Height)
+      {
+        parts.push_back({free.X, used.Y + used.Height, free.Width, free.Y + free.Height - used.Y - used.Height});
+      }
+    }
+
+    m_freeRects.insert(m_freeRects.end(), parts.begin(), parts.end());
+  }
+
+  void RectPacker::PruneFreeRects()
+  {
+    auto contains = [](const Rect<int>& outer, const Rect<int>& inner) -> bool
+    {
+      return inner.X >= outer.X && inner.Y >= outer.Y && inner.X + inner.Width <= outer.X + outer.Width &&
+             inner.Y + inner.Height <= outer.Y + outer.Height;
+    };
+
+    for (int i = 0; i < (int) m_freeRects.size(); i++)
+    {
+      for (int j = i + 1; j < (int) m_freeRects.size(); j++)
+      {
+        if (contains(m_freeRects[j], m_freeRects[i]))
+        {
+          m_freeRects.erase(m_freeRects.begin() + i);
+          i--;
+          break;
+        }
+
+        if (contains(m_freeRects[i], m_freeRects[j]))
+        {
+          m_freeRects.erase(m_freeRects.begin() + j);
+          j--;
+        }
+      }
+    }
+  }
+
+  // TextureAtlas
+  //////////////////////////////////////////
+
+  bool TextureAtlas::Load(const String& file)
+  {
+    XmlFilePtr xmlFile = GetFileManager()->GetXmlFile(file);
+    if (xmlFile == nullptr)
+    {
+      return false;
+    }
+
+    XmlDocument doc;
+    doc.parse<0>(xmlFile->data());
+
+    XmlNode* root = doc.first_node("TextureAtlas");
+    if (root == nullptr)
+    {
+      return false;
+    }
+
+    int version = 0;
+    ReadAttr(root, "version", version);
+    if (version != g_atlasManifestVersion)
+    {
+      return false;
+    }
+
+    ReadAttr(root, "pageSize", m_pageSize);
+    ReadAttr(root, "padding", m_padding);
+
+    m_pages.clear();
+    for (XmlNode* node = root->first_node("Page"); node; node = node->next_sibling("Page"))
+    {
+      String page;
+      ReadAttr(node, "file", page);
+      m_pages.push_back(page);
+    }
+
+    m_regions.clear();
+    for (XmlNode* node = root->first_node("Image"); node; node = node->next_sibling("Image"))
+    {
+      String name;
+      AtlasRegion region;
+      ReadAttr(node, "name", name);
+      ReadAttr(node, "page", region.page);
+      ReadAttr(node, "x", region.rect.X);
+      ReadAttr(node, "y", region.rect.Y);
+      ReadAttr(node, "w", region.rect.Width);
+      ReadAttr(node, "h", region.rect.Height);
+
+      m_regions[name] = region;
+    }
+
+    m_folder = Path(file).parent_path().string();
+    return true;
+  }
+
+  bool TextureAtlas::Save(const String& file) const
+  {
+    XmlDocument doc;
+    XmlNode* root = CreateXmlNode(&doc, "TextureAtlas");
+    WriteAttr(root, &doc, "version", std::to_string(g_atlasManifestVersion));
+    WriteAttr(root, &doc, "pageSize", std::to_string(m_pageSize));
+    WriteAttr(root, &doc, "padding", std::to_string(m_padding));
+
+    for (const String& page : m_pages)
+    {
+      XmlNode* node = CreateXmlNode(&doc, "Page", root);
+      WriteAttr(node, &doc, "file", page);
+    }
+
+    // Images are written in order, the same atlas produces the same manifest.
+    StringArray names;
+    names.reserve(m_regions.size());
+    for (const auto& region : m_regions)
+    {
+      names.push_back(region.first);
+    }
+    std::sort(names.begin(), names.end());
+
+    for (const String& name : names)
+    {
+      const AtlasRegion& region = m_regions.at(name);
+      XmlNode* node             = CreateXmlNode(&doc, "Image", root);
+      WriteAttr(node, &doc, "name", name);
+      WriteAttr(node, &doc, "page", std::to_string(region.page));
+      WriteAttr(node, &doc, "x", std::to_string(region.rect.X));
+      WriteAttr(node, &doc, "y", std::to_string(region.rect.Y));
+      WriteAttr(node, &doc, "w", std::to_string(region.rect.Width));
+      WriteAttr(node, &doc, "h", std::to_string(region.rect.Height));
+    }
+
+    std::string xml;
+    rapidxml::print(std::back_inserter(xml), doc);
+
+    std::ofstream stream(file, std::ios::trunc);
+    stream << xml;
+
+    return stream.good();
+  }
+
+  const AtlasRegion* TextureAtlas::Find(const String& file) const
+  {
+    auto region = m_regions.find(PakBuilder::GetEntryName(file));
+    if (region == m_regions.end() || region->second.page < 0 || region->second.page >= (int) m_pages.size())
+    {
+      return nullptr;
+    }
+
+    return &region->second;
+  }
+
+  bool TextureAtlas::IsPage(const String& file) const
+  {
+    String name = PakBuilder::GetEntryName(file);
+    if (name.empty())
+    {
+      return false;
+    }
+
+    for (int page = 0; page < (int) m_pages.size(); page++)
+    {
+      if (PakBuilder::GetEntryName(GetPageFile(page)) == name)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  String TextureAtlas::GetPageFile(int page) const { return ConcatPaths({m_folder, m_pages[page]}); }
+
+  Vec4 TextureAtlas::GetUVRect(const AtlasRegion& region) const
+  {
+    float size = (float) m_pageSize;
+    return Vec4(region.rect.X / size, region.rect.Y / size, region.rect.Width / size, region.rect.Height / size);
+  }
+
+  String TextureAtlas::GetManifestPath() { return TexturePath(ConcatPaths({TKTextureAtlasFolder, "UI.atlas"})); }
+
+  // TextureAtlasBuilder
+  //////////////////////////////////////////
+
+  void TextureAtlasBuilder::AddImage(const String& file) { m_files.insert(file); }
+
+  void TextureAtlasBuilder::AddFolder(const String& path)
+  {
+    std::error_code err;
+    for (auto it = std::filesystem::recursive_directory_iterator(path, err);
+         it != std::filesystem::recursive_directory_iterator();
+         it.increment(err))
+    {
+      if (err)
+      {
+        TK_WRN("%s", err.message().c_str());
+        return;
+      }
+
+      if (!it->is_regular_file())
+      {
+        continue;
+      }
+
+      // Hdr images are not sampled by the ui.
+      String ext = ToLower(it->path().extension().string());
+      if (SupportedImageFormat(ext) && ext != HDR)
+      {
+        AddImage(std::filesystem::absolute(it->path()).string());
+      }
+    }
+  }
+
+  bool TextureAtlasBuilder::Build(const String& manifestFile)
+  {
+    // Images are keyed by their entry names, which are the same on every machine.
+    StringArray files(m_files.begin(), m_files.end());
+    StringArray names;
+    names.reserve(files.size());
+    for (const String& file : files)
+    {
+      names.push_back(PakBuilder::GetEntryName(file));
+    }
+
+    if (files.empty() && !CheckSystemFile(manifestFile))
+    {
+      return true;
+    }
+
+    if (IsUpToDate(manifestFile, files, names))
+    {
+      TK_LOG("Texture atlas is up to date.\n");
+      return true;
+    }
+
+    TextureAtlas previous;
+    if (CheckSystemFile(manifestFile))
+    {
+      previous.Load(manifestFile);
+    }
+
+    // Images that are too large or can't be loaded are left with a zero size, which is not packed.
+    std::vector<uint8*> images(files.size(), nullptr);
+    std::vector<IVec2> sizes(files.size(), IVec2(0));
+    for (int i = 0; i < (int) files.size(); i++)
+    {
+      int width    = 0;
+      int height   = 0;
+      int channels = 0;
+      images[i]    = ImageLoad(files[i], &width, &height, &channels, 4);
+      if (images[i] == nullptr)
+      {
+        TK_WRN("Image can't be loaded for the atlas: %s", files[i].c_str());
+        continue;
+      }
+
+      if (width > m_maxImageSize || height > m_maxImageSize)
+      {
+        ImageFree(images[i]);
+        images[i] = nullptr;
+        continue;
+      }
+
+      sizes[i] = IVec2(width, height);
+    }
+
+    float occupancy = 0.0f;
+    std::vector<AtlasRegion> regions;
+    int pageCount = Pack(sizes, regions, &occupancy);
+
+    TextureAtlas atlas;
+    atlas.m_pageSize = m_pageSize;
+    atlas.m_padding  = m_padding;
+
+    String folder    = Path(manifestFile).parent_path().string();
+    String name      = Path(manifestFile).stem().string();
+
+    std::error_code err;
+    std::filesystem::create_directories(folder, err);
+
+    bool written = true;
+    std::vector<uint8> page((size_t) m_pageSize * (size_t) m_pageSize * 4);
+    for (int p = 0; p < pageCount && written; p++)
+    {
+      // Space between the images is transparent.
+      std::fill(page.begin(), page.end(), (uint8) 0);
+      for (int i = 0; i < (int) files.size(); i++)
+      {
+        if (regions[i].page == p)
+        {
+          Blit(images[i], regions[i], page.data());
+        }
+      }
+
+      String pageFile = name + "_" + std::to_string(p) + PNG;
+      String pagePath = ConcatPaths({folder, pageFile});
+      written         = WritePNG(pagePath, m_pageSize, m_pageSize, 4, page.data(), m_pageSize * 4) != 0;
+      atlas.m_pages.push_back(pageFile);
+    }
+
+    int packedCount = 0;
+    for (int i = 0; i < (int) files.size(); i++)
+    {
+      ImageFree(images[i]);
+      atlas.m_regions[names[i]]  = regions[i];
+      packedCount               += regions[i].page != -1 ? 1 : 0;
+    }
+
+    if (!written)
+    {
+      TK_ERR("Texture atlas page can't be written: %s", atlas.m_pages.back().c_str());
+      return false;
+    }
+
+    // Pages of the previous build that are not written again.
+    for (const String& pageFile : previous.m_pages)
+    {
+      if (!contains(atlas.m_pages, pageFile))
+      {
+        std::filesystem::remove(ConcatPaths({folder, pageFile}), err);
+      }
+    }
+
+    if (!atlas.Save(manifestFile))
+    {
+      TK_ERR("Texture atlas manifest can't be written: %s", manifestFile.c_str());
+      return false;
+    }
+
+    TK_LOG("Packed %d images in to %d atlas pages, %.1f%% occupancy.\n", packedCount, pageCount, occupancy * 100.0f);
+    return true;
+  }
+
+  int TextureAtlasBuilder::Pack(const std::vector<IVec2>& sizes,
+                                std::vector<AtlasRegion>& regions,
+                                float* occupancy) const
+  {
+    regions.assign(sizes.size(), AtlasRegion());
+
+    // Larger images are placed first, they are the hardest to fit. Equal sizes keep their order.
+    IntArray order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&sizes](int a, int b) -> bool
+                     {
+                       int sideA = glm::max(sizes[a].x, sizes[a].y);
+                       int sideB = glm::max(sizes[b].x, sizes[b].y);
+                       return sideA != sideB ? sideA > sideB : sizes[a].x * sizes[a].y > sizes[b].x * sizes[b].y;
+                     });
+
+    // Cells start and end on block boundaries.
+    auto alignFn = [](int size) -> int { return (size + 3) & ~3; };
+
+    std::vector<RectPacker> pages;
+    uint64 imageArea = 0;
+    for (int index : order)
+    {
+      const IVec2& size = sizes[index];
+      int cellWidth     = alignFn(size.x + m_padding * 2);
+      int cellHeight    = alignFn(size.y + m_padding * 2);
+      if (size.x <= 0 || size.y <= 0 || cellWidth > m_pageSize || cellHeight > m_pageSize)
+      {
+        continue;
+      }
+
+      // First page that the cell fits in, a new page is started if none.
+      Rect<int> cell = {0, 0, 0, 0};
+      int page       = 0;
+      while (page < (int) pages.size() && !pages[page].Insert(cellWidth, cellHeight, cell))
+      {
+        page++;
+      }
+
+      if (page == (int) pages.size())
+      {
+        pages.emplace_back(m_pageSize, m_pageSize);
+        pages.back().Insert(cellWidth, cellHeight, cell);
+      }
+
+      AtlasRegion& region  = regions[index];
+      region.page          = page;
+      region.rect          = {cell.X + m_padding, cell.Y + m_padding, size.x, size.y};
+      imageArea           += (uint64) size.x * (uint64) size.y;
+    }
+
+    if (occupancy != nullptr)
+    {
+      uint64 pageArea = (uint64) pages.size() * (uint64) m_pageSize * (uint64) m_pageSize;
+      *occupancy      = pageArea > 0 ? (float) ((double) imageArea / (double) pageArea) : 0.0f;
+    }
+
+    return (int) pages.size();
+  }
+
+  void TextureAtlasBuilder::Blit(const uint8* image, const AtlasRegion& region, uint8* page) const
+  {
+    const Rect<int>& rect = region.rect;
+
+    // Padding repeats the nearest border pixel, as if the image is sampled with clamp to edge.
+    for (int y = -m_padding; y < rect.Height + m_padding; y++)
+    {
+      const uint8* source = image + (size_t) glm::clamp(y, 0, rect.Height - 1) * rect.Width * 4;
+      uint8* target       = page + ((size_t) (rect.Y + y) * m_pageSize + (rect.X - m_padding)) * 4;
+      for (int x = -m_padding; x < rect.Width + m_padding; x++)
+      {
+        memcpy(target, source + glm::clamp(x, 0, rect.Width - 1) * 4, 4);
+        target += 4;
+      }
+    }
+  }
+
+  bool TextureAtlasBuilder::IsUpToDate(const String& manifestFile,
+                                       const StringArray& files,
+                                       const StringArray& names) const
+  {
+    if (!CheckSystemFile(manifestFile))
+    {
+      return false;
+    }
+
+    TextureAtlas previous;
+    if (!previous.Load(manifestFile) || previous.m_pageSize != m_pageSize || previous.m_padding != m_padding ||
+        previous.m_regions.size() != names.size())
+    {
+      return false;
+    }
+
+    for (const String& name : names)
+    {
+      if (previous.m_regions.count(name) == 0)
+      {
+        return false;
+      }
+    }
+
+    for (int page = 0; page < (int) previous.m_pages.size(); page++)
+    {
+      if (!CheckSystemFile(previous.GetPageFile(page)))
+      {
+        return false;
+      }
+    }
+
+    std::error_code err;
+    auto manifestTime = std::filesystem::last_write_time(manifestFile, err);
+    if (err)
+    {
+      return false;
+    }
+
+    for (const String& file : files)
+    {
+      if (std::filesystem::last_write_time(file, err) > manifestTime || err)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+} // namespace ToolKit
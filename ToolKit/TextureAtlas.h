@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "GeometryTypes.h"
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  /** Place of an image in a texture atlas. */
+  struct AtlasRegion
+  {
+    int page       = -1;           //!< Page that the image is packed in to, -1 if the image is not packed.
+    Rect<int> rect = {0, 0, 0, 0}; //!< Pixels of the image in the page, excluding the padding. Y goes down.
+  };
+
+  // RectPacker
+  //////////////////////////////////////////
+
+  /**
+   * Packs rectangles in to a fixed size area with the max rects algorithm. All the maximal free rectangles are kept
+   * and each rectangle is placed in to the free rectangle that leaves the shortest side, which packs much tighter than
+   * BinPack2D for rectangles of mixed sizes.
+   */
+  class TK_API RectPacker
+  {
+   public:
+    RectPacker(int width, int height);
+
+    /**
+     * Places a rectangle of the given size.
+     * @param rect is the placed rectangle.
+     * @return False if there is no free area that the rectangle fits in.
+     */
+    bool Insert(int width, int height, Rect<int>& rect);
+
+    /** @return Ratio of the occupied area to the total area. */
+    float GetOccupancy() const;
+
+   private:
+    /** Cuts the used rectangle out of the free rectangles. */
+    void SplitFreeRects(const Rect<int>& used);
+
+    /** Removes the free rectangles that are contained in another one. */
+    void PruneFreeRects();
+
+   private:
+    int m_width       = 0;
+    int m_height      = 0;
+    uint64 m_usedArea = 0;
+    std::vector<Rect<int>> m_freeRects;
+  };
+
+  // TextureAtlas
+  //////////////////////////////////////////
+
+  /**
+   * Manifest of the atlas pages that the ui and sprite images are packed in to. Published paks carry the pages along
+   * with the manifest, textures of the packed images sample their region of a page instead of a texture of their own.
+   */
+  class TK_API TextureAtlas
+  {
+   public:
+    /** Reads the manifest from the pak or the disk. @return False if the manifest can't be read. */
+    bool Load(const String& file);
+
+    /** Writes the manifest to the disk. @return False if the file can't be written. */
+    bool Save(const String& file) const;
+
+    /** @return Region of the image file, nullptr if the image is not packed. */
+    const AtlasRegion* Find(const String& file) const;
+
+    /** States if the file is one of the pages. */
+    bool IsPage(const String& file) const;
+
+    /** @return Path of the page image, next to the manifest. */
+    String GetPageFile(int page) const;
+
+    /**
+     * Region in normalized texture coordinates of the page. Xy is the top left corner of the image, which is the first
+     * row of the texture since 8 bit images are not flipped on load, and zw is the size.
+     */
+    Vec4 GetUVRect(const AtlasRegion& region) const;
+
+    /** @return Manifest of the atlas that the packer builds from the project's ui and sprite images. */
+    static String GetManifestPath();
+
+   public:
+    int m_pageSize = 0;  //!< Width and height of the pages in pixels.
+    int m_padding  = 0;  //!< Pixels that the borders of the images are extruded to.
+    StringArray m_pages; //!< File names of the pages.
+
+    /**
+     * Regions of the images, keyed by their path relative to the Resources folder. Images that are too large to pack
+     * are kept with page -1, so that the builder can tell that the sources didn't change.
+     */
+    std::unordered_map<String, AtlasRegion> m_regions;
+
+   private:
+    String m_folder; //!< Folder of the manifest and the pages.
+  };
+
+  // TextureAtlasBuilder
+  //////////////////////////////////////////
+
+  /**
+   * Packs small images in to atlas pages and writes the pages with their manifest. Images are padded and their border
+   * pixels are extruded in to the padding, so that bilinear filtering doesn't bleed the neighbours in. Pages are
+   * sampled without mip levels, the padding doesn't cover the smaller levels. Cells are aligned to 4 pixels to keep
+   * images in separate blocks when the pages are cooked to block compressed formats.
+   */
+  class TK_API TextureAtlasBuilder
+  {
+   public:
+    /** Adds the image to the atlas. */
+    void AddImage(const String& file);
+
+    /** Adds all images under the folder, including its sub folders, to the atlas. */
+    void AddFolder(const String& path);
+
+    /**
+     * Packs the added images and writes the pages next to the manifest. Nothing is written if the previous manifest is
+     * newer than all the images and packs the same images with the same settings.
+     * @return False if the pages or the manifest can't be written.
+     */
+    bool Build(const String& manifestFile);
+
+    /**
+     * Packs images of the given sizes in to pages, larger images first. Only decides the places, images are not
+     * touched.
+     * @param sizes are the sizes of the images in pixels.
+     * @param regions is filled with the region of each image. Images that don't fit in to a page are left with page -1.
+     * @param occupancy is the ratio of the area of the images to the area of the pages, if not nullptr.
+     * @return Number of pages.
+     */
+    int Pack(const std::vector<IVec2>& sizes, std::vector<AtlasRegion>& regions, float* occupancy = nullptr) const;
+
+    /** Copies the rgba image in to its region of the rgba page and extrudes its border pixels in to the padding. */
+    void Blit(const uint8* image, const AtlasRegion& region, uint8* page) const;
+
+   private:
+    /** States if the manifest is newer than the images and packs the same images with the same settings. */
+    bool IsUpToDate(const String& manifestFile, const StringArray& files, const StringArray& names) const;
+
+   public:
+    int m_pageSize     = 2048; //!< Width and height of the pages in pixels.
+    int m_padding      = 2;    //!< Pixels that the borders of the images are extruded to.
+    int m_maxImageSize = 512;  //!< Larger images are left as textures on their own.
+
+   private:
+    StringSet m_files;
+  };
+
+} // namespace ToolKit
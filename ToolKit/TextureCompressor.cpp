@@ -0,0 +1,869 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "TextureCompressor.h"
+
+#include "Image.h"
+#include "Logger.h"
+#include "TKOpenGL.h"
+#include "Threads.h"
+#include "ToolKit.h"
+#include "Util.h"
+
+#include <fstream>
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  /** Intensity modifiers of the etc1 / etc2 individual and differential modes. */
+  static const int g_etcModifiers[8][2] = {
+      {2,  8  },
+      {5,  17 },
+      {9,  29 },
+      {13, 42 },
+      {18, 60 },
+      {24, 80 },
+      {33, 106},
+      {47, 183}
+  };
+
+  /** Alpha modifiers of the eac blocks. */
+  static const int g_eacModifiers[16][8] = {
+      {-3, -6, -9, -15, 2, 5, 8, 14},
+      {-3, -7, -10, -13, 2, 6, 9, 12},
+      {-2, -5, -8, -13, 1, 4, 7, 12},
+      {-2, -4, -6, -13, 1, 3, 5, 12},
+      {-3, -6, -8, -12, 2, 5, 7, 11},
+      {-3, -7, -9, -11, 2, 6, 8, 10},
+      {-4, -7, -8, -11, 3, 6, 7, 10},
+      {-3, -5, -8, -11, 2, 4, 7, 10},
+      {-2, -6, -8, -10, 1, 5, 7, 9 },
+      {-2, -5, -8, -10, 1, 4, 7, 9 },
+      {-2, -4, -8, -10, 1, 3, 7, 9 },
+      {-2, -5, -7, -10, 1, 4, 6, 9 },
+      {-3, -4, -7, -10, 2, 3, 6, 9 },
+      {-1, -2, -3, -10, 0, 1, 2, 9 },
+      {-4, -6, -8, -9,  3, 5, 7, 8 },
+      {-3, -5, -7, -9,  2, 4, 6, 8 }
+  };
+
+  static const uint8 g_ktxIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+  /** Key of the color space in the key value data of the ktx containers. Values are "srgb" and "linear". */
+  static const String g_ktxColorSpaceKey = "TKColorSpace";
+
+  /** Header of the ktx 1.1 container, follows the identifier. */
+  struct KTXHeader
+  {
+    uint endianness            = 0x04030201;
+    uint glType                = 0; //!< Zero for compressed images.
+    uint glTypeSize            = 1;
+    uint glFormat              = 0; //!< Zero for compressed images.
+    uint glInternalFormat      = 0;
+    uint glBaseInternalFormat  = 0;
+    uint pixelWidth            = 0;
+    uint pixelHeight           = 0;
+    uint pixelDepth            = 0;
+    uint numberOfArrayElements = 0;
+    uint numberOfFaces         = 1;
+    uint numberOfMipmapLevels  = 1;
+    uint bytesOfKeyValueData   = 0;
+  };
+
+  /** Modifier of the etc table for the given 2 bit pixel index. */
+  static inline int EtcModifier(int table, int index)
+  {
+    int modifier = g_etcModifiers[table][index & 1];
+    return (index & 2) ? -modifier : modifier;
+  }
+
+  static inline int ClampByte(int val) { return glm::clamp(val, 0, 255); }
+
+  /** States if the pixel at x, y belongs to the second sub block. */
+  static inline bool InSecondSubBlock(int x, int y, bool flip) { return flip ? y >= 2 : x >= 2; }
+
+  /**
+   * Finds the best table and pixel indexes for a sub block with the given base color.
+   * @return Squared error of the sub block.
+   */
+  static int FitEtcSubBlock(const uint8* pixels,
+                            const int base[3],
+                            int subBlock,
+                            bool flip,
+                            int& table,
+                            int indexes[16])
+  {
+    int bestError = TK_INT_MAX;
+    for (int t = 0; t < 8; t++)
+    {
+      int error = 0;
+      int tableIndexes[16];
+      for (int y = 0; y < 4; y++)
+      {
+        for (int x = 0; x < 4; x++)
+        {
+          if ((int) InSecondSubBlock(x, y, flip) != subBlock)
+          {
+            continue;
+          }
+
+          const uint8* pixel = pixels + (y * 4 + x) * 4;
+          int bestPixelError = TK_INT_MAX;
+          for (int i = 0; i < 4; i++)
+          {
+            int modifier   = EtcModifier(t, i);
+            int dr         = ClampByte(base[0] + modifier) - pixel[0];
+            int dg         = ClampByte(base[1] + modifier) - pixel[1];
+            int db         = ClampByte(base[2] + modifier) - pixel[2];
+            int pixelError = dr * dr + dg * dg + db * db;
+            if (pixelError < bestPixelError)
+            {
+              bestPixelError           = pixelError;
+              tableIndexes[y * 4 + x] = i;
+            }
+          }
+
+          error += bestPixelError;
+        }
+      }
+
+      if (error < bestError)
+      {
+        bestError = error;
+        table     = t;
+        for (int y = 0; y < 4; y++)
+        {
+          for (int x = 0; x < 4; x++)
+          {
+            if ((int) InSecondSubBlock(x, y, flip) == subBlock)
+            {
+              indexes[y * 4 + x] = tableIndexes[y * 4 + x];
+            }
+          }
+        }
+      }
+    }
+
+    return bestError;
+  }
+
+  static inline void WriteBigEndian(uint64 bits, uint8* block)
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      block[i] = (uint8) (bits >> (56 - i * 8));
+    }
+  }
+
+  static inline uint64 ReadBigEndian(const uint8* block)
+  {
+    uint64 bits = 0;
+    for (int i = 0; i < 8; i++)
+    {
+      bits = (bits << 8) | block[i];
+    }
+
+    return bits;
+  }
+
+  void TextureCompressor::EncodeETC2Block(const uint8* pixels, uint8* block)
+  {
+    uint64 bestBits = 0;
+    int bestError   = TK_INT_MAX;
+
+    // Only the individual and differential modes are used, which are common with etc1.
+    for (int flip = 0; flip < 2; flip++)
+    {
+      // Average color of each sub block.
+      int average[2][3] = {};
+      for (int y = 0; y < 4; y++)
+      {
+        for (int x = 0; x < 4; x++)
+        {
+          int subBlock = (int) InSecondSubBlock(x, y, flip);
+          for (int c = 0; c < 3; c++)
+          {
+            average[subBlock][c] += pixels[(y * 4 + x) * 4 + c];
+          }
+        }
+      }
+
+      int q4[2][3], q5[2][3];
+      for (int s = 0; s < 2; s++)
+      {
+        for (int c = 0; c < 3; c++)
+        {
+          float avg = average[s][c] / 8.0f;
+          q4[s][c]  = (int) glm::round(avg * 15.0f / 255.0f);
+          q5[s][c]  = (int) glm::round(avg * 31.0f / 255.0f);
+        }
+      }
+
+      bool canDiff = true;
+      for (int c = 0; c < 3; c++)
+      {
+        int diff  = q5[1][c] - q5[0][c];
+        canDiff  &= diff >= -4 && diff <= 3;
+      }
+
+      for (int diffMode = 0; diffMode < 2; diffMode++)
+      {
+        if (diffMode == 1 && !canDiff)
+        {
+          continue;
+        }
+
+        int base[2][3];
+        for (int s = 0; s < 2; s++)
+        {
+          for (int c = 0; c < 3; c++)
+          {
+            base[s][c] = diffMode ? (q5[s][c] << 3) | (q5[s][c] >> 2) : (q4[s][c] << 4) | q4[s][c];
+          }
+        }
+
+        int tables[2]   = {};
+        int indexes[16] = {};
+        int error       = FitEtcSubBlock(pixels, base[0], 0, flip, tables[0], indexes);
+        error          += FitEtcSubBlock(pixels, base[1], 1, flip, tables[1], indexes);
+        if (error >= bestError)
+        {
+          continue;
+        }
+
+        uint64 bits = 0;
+        if (diffMode)
+        {
+          for (int c = 0; c < 3; c++)
+          {
+            uint64 delta  = (uint64) ((q5[1][c] - q5[0][c]) & 7);
+            bits         |= ((uint64) q5[0][c] << (59 - c * 8)) | (delta << (56 - c * 8));
+          }
+        }
+        else
+        {
+          for (int c = 0; c < 3; c++)
+          {
+            bits |= ((uint64) q4[0][c] << (60 - c * 8)) | ((uint64) q4[1][c] << (56 - c * 8));
+          }
+        }
+
+        bits |= ((uint64) tables[0] << 37) | ((uint64) tables[1] << 34);
+        bits |= ((uint64) diffMode << 33) | ((uint64) flip << 32);
+
+        // Pixel indexes are stored column by column, most significant bits first.
+        for (int y = 0; y < 4; y++)
+        {
+          for (int x = 0; x < 4; x++)
+          {
+            int p      = x * 4 + y;
+            int index  = indexes[y * 4 + x];
+            bits      |= ((uint64) (index >> 1) << (16 + p)) | ((uint64) (index & 1) << p);
+          }
+        }
+
+        bestError = error;
+        bestBits  = bits;
+      }
+    }
+
+    WriteBigEndian(bestBits, block);
+  }
+
+  bool TextureCompressor::DecodeETC2Block(const uint8* block, uint8* pixels)
+  {
+    uint64 bits   = ReadBigEndian(block);
+    bool diffMode = (bits >> 33) & 1;
+    bool flip     = (bits >> 32) & 1;
+
+    int base[2][3];
+    for (int c = 0; c < 3; c++)
+    {
+      if (diffMode)
+      {
+        int c0 = (int) (bits >> (59 - c * 8)) & 31;
+        int d  = (int) (bits >> (56 - c * 8)) & 7;
+        int c1 = c0 + (d >= 4 ? d - 8 : d);
+        if (c1 < 0 || c1 > 31)
+        {
+          // T, H or planar mode.
+          return false;
+        }
+
+        base[0][c] = (c0 << 3) | (c0 >> 2);
+        base[1][c] = (c1 << 3) | (c1 >> 2);
+      }
+      else
+      {
+        int c0     = (int) (bits >> (60 - c * 8)) & 15;
+        int c1     = (int) (bits >> (56 - c * 8)) & 15;
+        base[0][c] = (c0 << 4) | c0;
+        base[1][c] = (c1 << 4) | c1;
+      }
+    }
+
+    int tables[2] = {(int) (bits >> 37) & 7, (int) (bits >> 34) & 7};
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        int p        = x * 4 + y;
+        int index    = (int) (((bits >> (16 + p)) & 1) << 1 | ((bits >> p) & 1));
+        int subBlock = (int) InSecondSubBlock(x, y, flip);
+        int modifier = EtcModifier(tables[subBlock], index);
+
+        uint8* pixel = pixels + (y * 4 + x) * 4;
+        for (int c = 0; c < 3; c++)
+        {
+          pixel[c] = (uint8) ClampByte(base[subBlock][c] + modifier);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  void TextureCompressor::EncodeEACBlock(const uint8* pixels, uint8* block)
+  {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++)
+    {
+      minAlpha = glm::min(minAlpha, (int) pixels[i * 4 + 3]);
+      maxAlpha = glm::max(maxAlpha, (int) pixels[i * 4 + 3]);
+    }
+
+    int bestBase = minAlpha, bestTable = 13, bestMultiplier = 1;
+    int bestIndexes[16];
+    std::fill(bestIndexes, bestIndexes + 16, 4); // Zero modifier of table 13.
+
+    if (minAlpha != maxAlpha)
+    {
+      int bestError = TK_INT_MAX;
+      for (int t = 0; t < 16; t++)
+      {
+        const int* modifiers = g_eacModifiers[t];
+        int range            = modifiers[7] - modifiers[3];
+        int multiplier       = (int) glm::round((maxAlpha - minAlpha) / (float) range);
+
+        for (int m = glm::max(1, multiplier - 1); m <= glm::min(15, multiplier + 1); m++)
+        {
+          int center = (int) glm::round((minAlpha + maxAlpha) * 0.5f - (modifiers[7] + modifiers[3]) * m * 0.5f);
+          for (int base = glm::max(0, center - 1); base <= glm::min(255, center + 1); base++)
+          {
+            int error = 0;
+            int indexes[16];
+            for (int p = 0; p < 16 && error < bestError; p++)
+            {
+              int alpha          = pixels[p * 4 + 3];
+              int bestPixelError = TK_INT_MAX;
+              for (int i = 0; i < 8; i++)
+              {
+                int delta      = ClampByte(base + modifiers[i] * m) - alpha;
+                int pixelError = delta * delta;
+                if (pixelError < bestPixelError)
+                {
+                  bestPixelError = pixelError;
+                  indexes[p]     = i;
+                }
+              }
+
+              error += bestPixelError;
+            }
+
+            if (error < bestError)
+            {
+              bestError      = error;
+              bestBase       = base;
+              bestTable      = t;
+              bestMultiplier = m;
+              std::copy(indexes, indexes + 16, bestIndexes);
+            }
+          }
+        }
+      }
+    }
+
+    // 3 bit indexes are stored column by column, most significant bits first.
+    uint64 bits = ((uint64) bestBase << 56) | ((uint64) bestMultiplier << 52) | ((uint64) bestTable << 48);
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        int p  = x * 4 + y;
+        bits  |= (uint64) bestIndexes[y * 4 + x] << (45 - p * 3);
+      }
+    }
+
+    WriteBigEndian(bits, block);
+  }
+
+  void TextureCompressor::DecodeEACBlock(const uint8* block, uint8* pixels)
+  {
+    uint64 bits          = ReadBigEndian(block);
+    int base             = (int) (bits >> 56) & 255;
+    int multiplier       = (int) (bits >> 52) & 15;
+    const int* modifiers = g_eacModifiers[(bits >> 48) & 15];
+
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        int p                     = x * 4 + y;
+        int index                 = (int) (bits >> (45 - p * 3)) & 7;
+        pixels[(y * 4 + x) * 4 + 3] = (uint8) ClampByte(base + modifiers[index] * multiplier);
+      }
+    }
+  }
+
+  uint64 CompressedImage::DataSize() const
+  {
+    uint64 size = 0;
+    for (const ByteArray& level : mipLevels)
+    {
+      size += level.size();
+    }
+
+    return size;
+  }
+
+  void TextureCompressor::GenerateMipChain(const uint8* rgba,
+                                           int width,
+                                           int height,
+                                           bool srgb,
+                                           std::vector<UInt8Array>& levels)
+  {
+    // Colors are averaged in linear space to preserve the brightness of the image on lower levels.
+    static const std::array<float, 256> srgbToLinear = []()
+    {
+      std::array<float, 256> table;
+      for (int i = 0; i < 256; i++)
+      {
+        float c  = i / 255.0f;
+        table[i] = c <= 0.04045f ? c / 12.92f : glm::pow((c + 0.055f) / 1.055f, 2.4f);
+      }
+      return table;
+    }();
+
+    auto toByteFn = [srgb](float c, int channel) -> uint8
+    {
+      if (srgb && channel < 3)
+      {
+        c = c <= 0.0031308f ? c * 12.92f : 1.055f * glm::pow(c, 1.0f / 2.4f) - 0.055f;
+      }
+      return (uint8) ClampByte((int) glm::round(c * 255.0f));
+    };
+
+    levels.clear();
+
+    const uint8* source = rgba;
+    int sourceWidth     = width;
+    int sourceHeight    = height;
+    while (sourceWidth > 1 || sourceHeight > 1)
+    {
+      int levelWidth    = glm::max(1, sourceWidth / 2);
+      int levelHeight   = glm::max(1, sourceHeight / 2);
+      UInt8Array& level = levels.emplace_back((size_t) levelWidth * levelHeight * 4);
+
+      for (int y = 0; y < levelHeight; y++)
+      {
+        for (int x = 0; x < levelWidth; x++)
+        {
+          int x0 = glm::min(x * 2, sourceWidth - 1), x1 = glm::min(x * 2 + 1, sourceWidth - 1);
+          int y0 = glm::min(y * 2, sourceHeight - 1), y1 = glm::min(y * 2 + 1, sourceHeight - 1);
+
+          for (int c = 0; c < 4; c++)
+          {
+            auto sampleFn = [&](int sx, int sy) -> float
+            {
+              uint8 val = source[((size_t) sy * sourceWidth + sx) * 4 + c];
+              return srgb && c < 3 ? srgbToLinear[val] : val / 255.0f;
+            };
+
+            float sum = sampleFn(x0, y0) + sampleFn(x1, y0) + sampleFn(x0, y1) + sampleFn(x1, y1);
+            level[((size_t) y * levelWidth + x) * 4 + c] = toByteFn(sum * 0.25f, c);
+          }
+        }
+      }
+
+      source       = level.data();
+      sourceWidth  = levelWidth;
+      sourceHeight = levelHeight;
+    }
+  }
+
+  /** Compresses a single level in to the given block array. */
+  static void CompressLevel(const uint8* rgba, int width, int height, bool hasAlpha, ByteArray& blocks)
+  {
+    int blocksX   = (width + 3) / 4;
+    int blocksY   = (height + 3) / 4;
+    int blockSize = hasAlpha ? 16 : 8;
+    blocks.resize((size_t) blocksX * blocksY * blockSize);
+
+    using poolstl::iota_iter;
+    std::for_each(TKExecByConditional(blocksY > 4, WorkerManager::FramePool),
+                  iota_iter<int>(0),
+                  iota_iter<int>(blocksY),
+                  [&](int by) -> void
+                  {
+                    uint8 pixels[64];
+                    for (int bx = 0; bx < blocksX; bx++)
+                    {
+                      // Edge blocks repeat the last row and column.
+                      for (int y = 0; y < 4; y++)
+                      {
+                        for (int x = 0; x < 4; x++)
+                        {
+                          int sx = glm::min(bx * 4 + x, width - 1);
+                          int sy = glm::min(by * 4 + y, height - 1);
+                          memcpy(pixels + (y * 4 + x) * 4, rgba + ((size_t) sy * width + sx) * 4, 4);
+                        }
+                      }
+
+                      uint8* block = (uint8*) blocks.data() + ((size_t) by * blocksX + bx) * blockSize;
+                      if (hasAlpha)
+                      {
+                        TextureCompressor::EncodeEACBlock(pixels, block);
+                        block += 8;
+                      }
+
+                      TextureCompressor::EncodeETC2Block(pixels, block);
+                    }
+                  });
+  }
+
+  bool TextureCompressor::Compress(const uint8* rgba,
+                                   int width,
+                                   int height,
+                                   bool generateMipMaps,
+                                   bool srgb,
+                                   CompressedImage& image)
+  {
+    if (rgba == nullptr || width <= 0 || height <= 0)
+    {
+      return false;
+    }
+
+    bool hasAlpha = false;
+    for (size_t i = 0; i < (size_t) width * height && !hasAlpha; i++)
+    {
+      hasAlpha = rgba[i * 4 + 3] != 255;
+    }
+
+    image.format = hasAlpha ? GraphicTypes::FormatRGBA8_ETC2_EAC : GraphicTypes::FormatRGB8_ETC2;
+    image.width  = width;
+    image.height = height;
+    image.srgb   = srgb;
+    image.mipLevels.clear();
+
+    std::vector<UInt8Array> levels;
+    if (generateMipMaps)
+    {
+      GenerateMipChain(rgba, width, height, srgb, levels);
+    }
+
+    image.mipLevels.resize(levels.size() + 1);
+    CompressLevel(rgba, width, height, hasAlpha, image.mipLevels[0]);
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+      int levelWidth  = glm::max(1, width >> (int) (i + 1));
+      int levelHeight = glm::max(1, height >> (int) (i + 1));
+      CompressLevel(levels[i].data(), levelWidth, levelHeight, hasAlpha, image.mipLevels[i + 1]);
+    }
+
+    return true;
+  }
+
+  bool TextureCompressor::Decompress(const CompressedImage& image, int level, UInt8Array& rgba)
+  {
+    bool hasAlpha = false;
+    switch (image.format)
+    {
+    case GraphicTypes::FormatRGB8_ETC2:
+    case GraphicTypes::FormatSRGB8_ETC2:
+      break;
+    case GraphicTypes::FormatRGBA8_ETC2_EAC:
+    case GraphicTypes::FormatSRGB8_A8_ETC2_EAC:
+      hasAlpha = true;
+      break;
+    default:
+      return false;
+    }
+
+    if (level < 0 || level >= (int) image.mipLevels.size())
+    {
+      return false;
+    }
+
+    int width               = glm::max(1, image.width >> level);
+    int height              = glm::max(1, image.height >> level);
+    int blocksX             = (width + 3) / 4;
+    int blocksY             = (height + 3) / 4;
+    int blockSize           = hasAlpha ? 16 : 8;
+    const ByteArray& blocks = image.mipLevels[level];
+    if (blocks.size() < (size_t) blocksX * blocksY * blockSize)
+    {
+      return false;
+    }
+
+    rgba.resize((size_t) width * height * 4);
+    for (int by = 0; by < blocksY; by++)
+    {
+      for (int bx = 0; bx < blocksX; bx++)
+      {
+        uint8 pixels[64];
+        std::fill(pixels, pixels + 64, (uint8) 255);
+
+        const uint8* block = (const uint8*) blocks.data() + ((size_t) by * blocksX + bx) * blockSize;
+        if (hasAlpha)
+        {
+          DecodeEACBlock(block, pixels);
+          block += 8;
+        }
+
+        if (!DecodeETC2Block(block, pixels))
+        {
+          return false;
+        }
+
+        for (int y = 0; y < 4 && by * 4 + y < height; y++)
+        {
+          for (int x = 0; x < 4 && bx * 4 + x < width; x++)
+          {
+            memcpy(rgba.data() + ((size_t) (by * 4 + y) * width + bx * 4 + x) * 4, pixels + (y * 4 + x) * 4, 4);
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  void TextureCompressor::WriteKTX(const CompressedImage& image, ByteArray& data)
+  {
+    bool hasAlpha = image.format != GraphicTypes::FormatRGB8_ETC2 && image.format != GraphicTypes::FormatSRGB8_ETC2;
+
+    KTXHeader header;
+    header.glInternalFormat     = (uint) image.format;
+    header.glBaseInternalFormat = (uint) (hasAlpha ? GraphicTypes::FormatRGBA : GraphicTypes::FormatRGB);
+    header.pixelWidth           = (uint) image.width;
+    header.pixelHeight          = (uint) image.height;
+    header.numberOfMipmapLevels = (uint) image.mipLevels.size();
+
+    // Key and value are null terminated, the pair is padded to 4 bytes.
+    String keyAndValue          = g_ktxColorSpaceKey + '\0' + (image.srgb ? "srgb" : "linear") + '\0';
+    uint keyAndValueByteSize    = (uint) keyAndValue.size();
+    uint keyValuePadding        = (4 - keyAndValueByteSize % 4) % 4;
+    header.bytesOfKeyValueData  = (uint) sizeof(uint) + keyAndValueByteSize + keyValuePadding;
+
+    data.clear();
+    data.insert(data.end(), (const char*) g_ktxIdentifier, (const char*) g_ktxIdentifier + sizeof(g_ktxIdentifier));
+    data.insert(data.end(), (const char*) &header, (const char*) &header + sizeof(KTXHeader));
+    data.insert(data.end(), (const char*) &keyAndValueByteSize, (const char*) &keyAndValueByteSize + sizeof(uint));
+    data.insert(data.end(), keyAndValue.begin(), keyAndValue.end());
+    data.insert(data.end(), keyValuePadding, 0);
+
+    for (const ByteArray& level : image.mipLevels)
+    {
+      // Block sizes are multiples of 4, no mip padding is needed.
+      uint imageSize = (uint) level.size();
+      data.insert(data.end(), (const char*) &imageSize, (const char*) &imageSize + sizeof(uint));
+      data.insert(data.end(), level.begin(), level.end());
+    }
+  }
+
+  bool TextureCompressor::ReadKTX(const ByteArray& data, CompressedImage& image)
+  {
+    size_t headerEnd = sizeof(g_ktxIdentifier) + sizeof(KTXHeader);
+    if (data.size() < headerEnd || memcmp(data.data(), g_ktxIdentifier, sizeof(g_ktxIdentifier)) != 0)
+    {
+      return false;
+    }
+
+    KTXHeader header;
+    memcpy(&header, data.data() + sizeof(g_ktxIdentifier), sizeof(KTXHeader));
+
+    // Only native endian, single face 2d compressed images are supported.
+    GraphicTypes format = (GraphicTypes) header.glInternalFormat;
+    if (header.endianness != 0x04030201 || header.glType != 0 || !IsCompressedFormat(format) ||
+        header.pixelDepth > 1 || header.numberOfArrayElements > 0 || header.numberOfFaces != 1)
+    {
+      return false;
+    }
+
+    if (header.bytesOfKeyValueData > data.size() - headerEnd)
+    {
+      return false;
+    }
+
+    image.format       = format;
+    image.width        = (int) header.pixelWidth;
+    image.height       = (int) header.pixelHeight;
+    image.srgb         = true;
+    image.mipLevels.clear();
+
+    // Key value pairs are skipped except the color space.
+    size_t cursor      = headerEnd;
+    size_t keyValueEnd = headerEnd + header.bytesOfKeyValueData;
+    while (cursor + sizeof(uint) <= keyValueEnd)
+    {
+      uint keyAndValueByteSize = 0;
+      memcpy(&keyAndValueByteSize, data.data() + cursor, sizeof(uint));
+      cursor += sizeof(uint);
+
+      if (keyAndValueByteSize > keyValueEnd - cursor)
+      {
+        return false;
+      }
+
+      // Key and value are null terminated strings.
+      const char* keyAndValue = data.data() + cursor;
+      size_t keySize          = strnlen(keyAndValue, keyAndValueByteSize);
+      if (keySize < keyAndValueByteSize && g_ktxColorSpaceKey.compare(0, String::npos, keyAndValue, keySize) == 0)
+      {
+        const char* value = keyAndValue + keySize + 1;
+        size_t valueSize  = strnlen(value, keyAndValueByteSize - keySize - 1);
+        image.srgb        = String(value, valueSize) != "linear";
+      }
+
+      cursor += ((size_t) keyAndValueByteSize + 3) & ~(size_t) 3;
+    }
+
+    cursor      = keyValueEnd;
+    uint levels = glm::max(1u, header.numberOfMipmapLevels);
+    for (uint i = 0; i < levels; i++)
+    {
+      uint imageSize = 0;
+      if (cursor + sizeof(uint) > data.size())
+      {
+        return false;
+      }
+
+      memcpy(&imageSize, data.data() + cursor, sizeof(uint));
+      cursor += sizeof(uint);
+
+      int levelWidth  = glm::max(1, image.width >> i);
+      int levelHeight = glm::max(1, image.height >> i);
+      if (cursor + imageSize > data.size() || imageSize != BytesOfImage(format, levelWidth, levelHeight))
+      {
+        return false;
+      }
+
+      image.mipLevels.emplace_back(data.begin() + cursor, data.begin() + cursor + imageSize);
+      cursor += (imageSize + 3) & ~3u;
+    }
+
+    return true;
+  }
+
+  CompressedImagePtr TextureCompressor::CookTexture(const String& sourceFile, const String& cookedFile, bool srgb)
+  {
+    int width = 0, height = 0, comp = 0;
+    uint8* rgba = ImageLoad(sourceFile, &width, &height, &comp, 4);
+    if (rgba == nullptr)
+    {
+      TK_ERR("Can't load image to cook: %s", sourceFile.c_str());
+      return nullptr;
+    }
+
+    CompressedImagePtr image = std::make_shared<CompressedImage>();
+    bool compressed          = Compress(rgba, width, height, true, srgb, *image);
+    ImageFree(rgba);
+
+    if (!compressed)
+    {
+      return nullptr;
+    }
+
+    ByteArray data;
+    WriteKTX(*image, data);
+
+    std::error_code err;
+    std::filesystem::create_directories(Path(cookedFile).parent_path(), err);
+
+    std::ofstream stream(cookedFile, std::ios::binary | std::ios::trunc);
+    stream.write(data.data(), data.size());
+    if (!stream.good())
+    {
+      TK_ERR("Can't write cooked image: %s", cookedFile.c_str());
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  String TextureCompressor::CookedFilePath(const String& file)
+  {
+    String unixPath = file;
+    UnixifyPath(unixPath);
+
+    static const String textureFolder = "Textures/";
+    size_t index                      = unixPath.rfind(textureFolder);
+    if (index == String::npos)
+    {
+      return String();
+    }
+
+    String relative = unixPath.substr(index + textureFolder.size());
+    if (relative.rfind(TKCookedTextureFolder + "/", 0) == 0 || relative.rfind(TKIrradianceCacheFolder + "/", 0) == 0)
+    {
+      return String();
+    }
+
+    // Keep the original path's separators up to the textures folder.
+    return ConcatPaths({file.substr(0, index + textureFolder.size() - 1), TKCookedTextureFolder, relative + KTX});
+  }
+
+  GraphicTypes TextureCompressor::ToSRGBFormat(GraphicTypes format)
+  {
+    switch (format)
+    {
+    case GraphicTypes::FormatRGB8_ETC2:
+      return GraphicTypes::FormatSRGB8_ETC2;
+    case GraphicTypes::FormatRGBA8_ETC2_EAC:
+      return GraphicTypes::FormatSRGB8_A8_ETC2_EAC;
+    case GraphicTypes::FormatRGBA_ASTC_4x4:
+      return GraphicTypes::FormatSRGB8_A8_ASTC_4x4;
+    default:
+      return format;
+    }
+  }
+
+  GraphicTypes TextureCompressor::ToLinearFormat(GraphicTypes format)
+  {
+    switch (format)
+    {
+    case GraphicTypes::FormatSRGB8_ETC2:
+      return GraphicTypes::FormatRGB8_ETC2;
+    case GraphicTypes::FormatSRGB8_A8_ETC2_EAC:
+      return GraphicTypes::FormatRGBA8_ETC2_EAC;
+    case GraphicTypes::FormatSRGB8_A8_ASTC_4x4:
+      return GraphicTypes::FormatRGBA_ASTC_4x4;
+    default:
+      return format;
+    }
+  }
+
+  bool TextureCompressor::IsFormatSupported(GraphicTypes format)
+  {
+    switch (format)
+    {
+    case GraphicTypes::FormatRGB8_ETC2:
+    case GraphicTypes::FormatSRGB8_ETC2:
+    case GraphicTypes::FormatRGBA8_ETC2_EAC:
+    case GraphicTypes::FormatSRGB8_A8_ETC2_EAC:
+      return TK_GL_texture_compression_etc2 == 1;
+    case GraphicTypes::FormatRGBA_ASTC_4x4:
+    case GraphicTypes::FormatSRGB8_A8_ASTC_4x4:
+      return TK_GL_KHR_texture_compression_astc_ldr == 1;
+    default:
+      return false;
+    }
+  }
+
+} // namespace ToolKit
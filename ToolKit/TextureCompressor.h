@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+namespace ToolKit
+{
+
+  typedef std::vector<uint8> UInt8Array;
+
+  /** Block compressed image with its mip chain. */
+  struct TK_API CompressedImage
+  {
+    GraphicTypes format = GraphicTypes::FormatRGBA8_ETC2_EAC; //!< Compressed internal format of the blocks.
+    int width           = 0;                                  //!< Width of the largest mip level in pixels.
+    int height          = 0;                                  //!< Height of the largest mip level in pixels.
+    std::vector<ByteArray> mipLevels;                         //!< Blocks of each mip level, largest level first.
+    bool srgb           = true;                               //!< States if the mip levels are filtered for srgb.
+
+    /** @return Total size of the blocks in all mip levels in bytes. */
+    uint64 DataSize() const;
+  };
+
+  typedef std::shared_ptr<CompressedImage> CompressedImagePtr;
+
+  /**
+   * Cooks 8 bit images in to etc2 / eac block compressed images with pre filtered mip chains and reads / writes them in
+   * ktx containers. Cooked images are uploaded to gpu as is, without decoding on the cpu. Etc2 is a subset of gles 3.0
+   * and webgl 2 with the compressed texture extension. Astc images produced by external tools can be loaded but are not
+   * encoded.
+   */
+  class TK_API TextureCompressor
+  {
+   public:
+    /**
+     * Compresses the image to etc2, with eac alpha if the image is not opaque.
+     * @param rgba is the image to compress with 4 channels per pixel, row by row.
+     * @param width is the width of the image in pixels.
+     * @param height is the height of the image in pixels.
+     * @param generateMipMaps states if the mip chain is generated down to 1x1 and compressed.
+     * @param srgb states if the color channels are in srgb space. Mip levels are filtered in linear space if so.
+     * @param image is the resulting compressed image. Its format is always the linear variant of the format.
+     * @return False if the image can't be compressed.
+     */
+    static bool Compress(const uint8* rgba,
+                         int width,
+                         int height,
+                         bool generateMipMaps,
+                         bool srgb,
+                         CompressedImage& image);
+
+    /**
+     * Decodes a mip level of an etc2 / eac image to 8 bit rgba. Used when the driver doesn't support the format.
+     * Only the individual and differential etc2 modes are decoded, which are the modes that this class produces.
+     * @return False if the format or one of the block modes is not supported.
+     */
+    static bool Decompress(const CompressedImage& image, int level, UInt8Array& rgba);
+
+    /**
+     * Generates box filtered mip levels. Each level is half the size of the previous one down to 1x1.
+     * @param rgba is the largest level with 4 channels per pixel.
+     * @param srgb states if the color channels are in srgb space.
+     * @param levels is filled with the mip levels, excluding the largest one.
+     */
+    static void GenerateMipChain(const uint8* rgba, int width, int height, bool srgb, std::vector<UInt8Array>& levels);
+
+    /** Encodes 4x4 rgba pixels, row by row, in to a 8 byte etc2 rgb block. */
+    static void EncodeETC2Block(const uint8* pixels, uint8* block);
+
+    /** Decodes a 8 byte etc2 rgb block in to 4x4 pixels, row by row. Leaves the alpha channel untouched. */
+    static bool DecodeETC2Block(const uint8* block, uint8* pixels);
+
+    /** Encodes the alpha channel of 4x4 rgba pixels, row by row, in to a 8 byte eac block. */
+    static void EncodeEACBlock(const uint8* pixels, uint8* block);
+
+    /** Decodes a 8 byte eac block in to the alpha channel of 4x4 pixels, row by row. */
+    static void DecodeEACBlock(const uint8* block, uint8* pixels);
+
+    /** Serializes the image in to a ktx 1.1 container. The color space is written as a key value pair. */
+    static void WriteKTX(const CompressedImage& image, ByteArray& data);
+
+    /**
+     * Deserializes a ktx 1.1 container that holds a 2d compressed image. Images without the color space key are
+     * assumed to be srgb. @return False if the data is not valid.
+     */
+    static bool ReadKTX(const ByteArray& data, CompressedImage& image);
+
+    /**
+     * Loads the image file from the disk, compresses it with its mip chain and writes it to the cooked file.
+     * @param srgb states if the texture is sampled as srgb. Linear textures such as normal maps are filtered as is.
+     * @return The compressed image or nullptr if the image can't be loaded or written.
+     */
+    static CompressedImagePtr CookTexture(const String& sourceFile, const String& cookedFile, bool srgb);
+
+    /**
+     * Path of the cooked image for a texture under a Textures folder. Cooked images are kept in a separate folder
+     * next to the source images, such as "Textures/Cooked/ui/button.png.ktx" for "Textures/ui/button.png".
+     * @return Path of the cooked image or an empty string if the texture can't be cooked.
+     */
+    static String CookedFilePath(const String& file);
+
+    /** @return The srgb variant of the format if there is any, otherwise the format itself. */
+    static GraphicTypes ToSRGBFormat(GraphicTypes format);
+
+    /** @return The linear variant of the format if there is any, otherwise the format itself. */
+    static GraphicTypes ToLinearFormat(GraphicTypes format);
+
+    /** States if the format can be uploaded to the gpu as is. Valid after the graphics api is loaded. */
+    static bool IsFormatSupported(GraphicTypes format);
+  };
+
+} // namespace ToolKit
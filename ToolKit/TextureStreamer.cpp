@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "TextureStreamer.h"
+
+#include "Camera.h"
+#include "EngineSettings.h"
+#include "FileManager.h"
+#include "Image.h"
+#include "Material.h"
+#include "Stats.h"
+#include "Texture.h"
+#include "TextureCompressor.h"
+#include "Threads.h"
+#include "ToolKit.h"
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  TextureStreamer::TextureStreamer() {}
+
+  TextureStreamer::~TextureStreamer()
+  {
+    // Results of the loads that are in progress are dropped.
+    m_pendingLoads.clear();
+    m_textures.clear();
+  }
+
+  bool TextureStreamer::IsEnabled() const { return GetEngineSettings().m_graphics->GetTextureStreamingVal(); }
+
+  void TextureStreamer::Register(Texture* texture)
+  {
+    StreamState& state     = m_textures[texture];
+    state.minMip           = texture->GetResidentMip();
+    state.targetMip        = state.minMip;
+    state.lastRequestFrame = m_frame;
+  }
+
+  void TextureStreamer::Unregister(Texture* texture)
+  {
+    m_textures.erase(texture);
+    erase_if(m_pendingLoads, [texture](const PendingLoad& load) -> bool { return load.texture == texture; });
+  }
+
+  bool TextureStreamer::IsRegistered(Texture* texture) const { return m_textures.find(texture) != m_textures.end(); }
+
+  void TextureStreamer::RequestMip(Texture* texture, int mip)
+  {
+    auto state = m_textures.find(texture);
+    if (state != m_textures.end())
+    {
+      state->second.requestedMip = glm::min(state->second.requestedMip, mip);
+    }
+  }
+
+  void TextureStreamer::RequestMaterial(Material* material, float screenSize)
+  {
+    auto requestFn = [this, screenSize](const TexturePtr& texture) -> void
+    {
+      if (texture != nullptr && texture->IsStreamed())
+      {
+        RequestMip(texture.get(), CalculateDesiredMip(texture->m_width, texture->m_height, screenSize));
+      }
+    };
+
+    requestFn(material->GetDiffuseTextureVal());
+    requestFn(material->GetEmissiveTextureVal());
+    requestFn(material->GetMetallicRoughnessTextureVal());
+    requestFn(material->GetNormalTextureVal());
+  }
+
+  void TextureStreamer::Update()
+  {
+    m_frame++;
+
+    CompleteLoads(!Main::GetInstance()->m_threaded);
+    UpdateTargets();
+
+    uint64 budget         = GetBudget();
+    uint64 residentMemory = GetResidentMemory();
+    EvictOverBudget(budget, residentMemory);
+    StartLoads(budget, residentMemory);
+
+    if (TKStats* stats = GetTKStats())
+    {
+      stats->m_streamedTextureMemory  = residentMemory;
+      stats->m_textureStreamingBudget = budget;
+    }
+  }
+
+  void TextureStreamer::Flush() { CompleteLoads(true); }
+
+  uint64 TextureStreamer::GetResidentMemory() const
+  {
+    uint64 memory = 0;
+    for (auto& texture : m_textures)
+    {
+      memory += texture.first->GetResidentMemory();
+    }
+
+    return memory;
+  }
+
+  uint64 TextureStreamer::GetBudget() const
+  {
+    // Without streaming, all levels are loaded.
+    if (!IsEnabled())
+    {
+      return std::numeric_limits<uint64>::max();
+    }
+
+    int budgetInMB = glm::max(0, GetEngineSettings().m_graphics->GetTextureStreamingBudgetVal());
+    return (uint64) budgetInMB * 1024 * 1024;
+  }
+
+  float TextureStreamer::EstimateScreenSize(const BoundingBox& box, Camera* camera, float viewportHeight)
+  {
+    if (!box.IsValid())
+    {
+      return 0.0f;
+    }
+
+    float diameter = glm::length(box.max - box.min);
+    float scale    = camera->GetProjectionMatrix()[1][1] * 0.5f * viewportHeight;
+    if (camera->IsOrtographic())
+    {
+      return diameter * scale;
+    }
+
+    // Distance to the closest point of the box's bounding sphere, clamped to near plane when the camera is inside.
+    float distance = glm::length(box.GetCenter() - camera->Position()) - diameter * 0.5f;
+    distance       = glm::max(distance, camera->Near());
+
+    return diameter * scale / distance;
+  }
+
+  int TextureStreamer::CalculateDesiredMip(int width, int height, float screenSize)
+  {
+    float texels = (float) glm::max(width, height);
+    if (screenSize >= texels)
+    {
+      return 0;
+    }
+
+    if (screenSize < 1.0f)
+    {
+      return TK_INT_MAX;
+    }
+
+    return (int) glm::floor(glm::log2(texels / screenSize));
+  }
+
+  int TextureStreamer::CalculateMinResidentMip(int width, int height) const
+  {
+    int mip     = 0;
+    int maxSize = glm::max(width, height);
+    while ((maxSize >> mip) > m_minResidentSize)
+    {
+      mip++;
+    }
+
+    return mip;
+  }
+
+  std::vector<ByteArray> TextureStreamer::LoadMipLevels(const String& file,
+                                                        bool compressed,
+                                                        bool srgb,
+                                                        int firstMip,
+                                                        int lastMip)
+  {
+    std::vector<ByteArray> levels;
+    if (compressed)
+    {
+      CompressedImage image;
+      if (TextureCompressor::ReadKTX(GetFileManager()->GetBinaryFile(file), image) &&
+          lastMip < (int) image.mipLevels.size())
+      {
+        for (int level = firstMip; level <= lastMip; level++)
+        {
+          levels.push_back(std::move(image.mipLevels[level]));
+        }
+      }
+
+      return levels;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    uint8* pixels = GetFileManager()->GetImageFile(file, &width, &height, &channels, 4);
+    if (pixels == nullptr)
+    {
+      return levels;
+    }
+
+    std::vector<UInt8Array> chain;
+    TextureCompressor::GenerateMipChain(pixels, width, height, srgb, chain);
+
+    if (lastMip <= (int) chain.size())
+    {
+      for (int level = firstMip; level <= lastMip; level++)
+      {
+        if (level == 0)
+        {
+          levels.emplace_back(pixels, pixels + (uint64) width * (uint64) height * 4);
+        }
+        else
+        {
+          levels.emplace_back(chain[level - 1].begin(), chain[level - 1].end());
+        }
+      }
+    }
+
+    ImageFree(pixels);
+
+    return levels;
+  }
+
+  void TextureStreamer::UpdateTargets()
+  {
+    bool enabled = IsEnabled();
+    for (auto& texture : m_textures)
+    {
+      StreamState& state = texture.second;
+      if (!enabled)
+      {
+        state.targetMip = 0;
+      }
+      else if (state.requestedMip != TK_INT_MAX)
+      {
+        state.targetMip        = glm::clamp(state.requestedMip, 0, state.minMip);
+        state.lastRequestFrame = m_frame;
+      }
+      else if (m_frame - state.lastRequestFrame > (uint64) m_unusedFrameCount)
+      {
+        state.targetMip = state.minMip;
+      }
+
+      state.requestedMip = TK_INT_MAX;
+    }
+  }
+
+  void TextureStreamer::EvictOverBudget(uint64 budget, uint64& residentMemory)
+  {
+    // Levels that are not needed anymore are evicted first, least recently requested textures first.
+    while (residentMemory > budget)
+    {
+      Texture* victim          = nullptr;
+      StreamState* victimState = nullptr;
+      for (auto& texture : m_textures)
+      {
+        StreamState& state = texture.second;
+        if (state.loading || texture.first->GetResidentMip() >= state.minMip)
+        {
+          continue;
+        }
+
+        if (victim == nullptr)
+        {
+          victim      = texture.first;
+          victimState = &state;
+          continue;
+        }
+
+        bool unused       = texture.first->GetResidentMip() < state.targetMip;
+        bool victimUnused = victim->GetResidentMip() < victimState->targetMip;
+        if (unused != victimUnused)
+        {
+          if (unused)
+          {
+            victim      = texture.first;
+            victimState = &state;
+          }
+
+          continue;
+        }
+
+        // Among the equally used, the largest one is evicted to free more memory with less textures.
+        if (state.lastRequestFrame < victimState->lastRequestFrame ||
+            (state.lastRequestFrame == victimState->lastRequestFrame &&
+             texture.first->GetResidentMemory() > victim->GetResidentMemory()))
+        {
+          victim      = texture.first;
+          victimState = &state;
+        }
+      }
+
+      if (victim == nullptr)
+      {
+        break;
+      }
+
+      // Drop a single level at a time, which halves the texture's size.
+      uint64 memory          = victim->GetResidentMemory();
+      int residentMip        = victim->GetResidentMip() + 1;
+      victim->EvictMips(residentMip);
+      residentMemory        -= memory - victim->GetResidentMemory();
+      victimState->targetMip = glm::max(victimState->targetMip, residentMip);
+    }
+  }
+
+  void TextureStreamer::StartLoads(uint64 budget, uint64 residentMemory)
+  {
+    uint64 pendingMemory = 0;
+    for (const PendingLoad& load : m_pendingLoads)
+    {
+      pendingMemory += load.size;
+    }
+
+    std::vector<std::pair<Texture*, StreamState*>> candidates;
+    for (auto& texture : m_textures)
+    {
+      if (!texture.second.loading && texture.second.targetMip < texture.first->GetResidentMip())
+      {
+        candidates.push_back({texture.first, &texture.second});
+      }
+    }
+
+    // Most recently requested textures that miss the most levels are loaded first.
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](const std::pair<Texture*, StreamState*>& a, const std::pair<Texture*, StreamState*>& b) -> bool
+              {
+                if (a.second->lastRequestFrame != b.second->lastRequestFrame)
+                {
+                  return a.second->lastRequestFrame > b.second->lastRequestFrame;
+                }
+
+                int missingA = a.first->GetResidentMip() - a.second->targetMip;
+                int missingB = b.first->GetResidentMip() - b.second->targetMip;
+                return missingA > missingB;
+              });
+
+    bool threaded = Main::GetInstance()->m_threaded;
+    for (auto& candidate : candidates)
+    {
+      if ((int) m_pendingLoads.size() >= m_maxLoadsInFlight)
+      {
+        break;
+      }
+
+      Texture* texture   = candidate.first;
+      StreamState* state = candidate.second;
+      int firstMip       = state->targetMip;
+      int lastMip        = texture->GetResidentMip() - 1;
+
+      // Shrink the load to the budget, larger levels are dropped first.
+      uint64 size        = texture->CalculateMipMemory(firstMip, lastMip);
+      while (firstMip <= lastMip && residentMemory + pendingMemory + size > budget)
+      {
+        firstMip++;
+        size = texture->CalculateMipMemory(firstMip, lastMip);
+      }
+
+      if (firstMip > lastMip)
+      {
+        continue;
+      }
+
+      bool compressed = IsCompressedFormat(texture->Settings().InternalFormat);
+      bool srgb       = texture->Settings().InternalFormat == GraphicTypes::FormatSRGB8_A8;
+      String file     = compressed ? texture->m_compressedFile : texture->GetFile();
+
+      if (threaded)
+      {
+        PendingLoad& load = m_pendingLoads.emplace_back();
+        load.texture      = texture;
+        load.firstMip     = firstMip;
+        load.lastMip      = lastMip;
+        load.size         = size;
+
+        ThreadPool& pool  = GetWorkerManager()->GetPool(WorkerManager::BackgroundPool);
+        load.levels       = pool.submit([file, compressed, srgb, firstMip, lastMip]() -> std::vector<ByteArray>
+                                  { return LoadMipLevels(file, compressed, srgb, firstMip, lastMip); });
+
+        state->loading    = true;
+        pendingMemory    += size;
+      }
+      else
+      {
+        // Without worker threads, levels are loaded in place. Keeps the results deterministic for headless runs.
+        FinishLoad(texture, firstMip, lastMip, LoadMipLevels(file, compressed, srgb, firstMip, lastMip));
+        residentMemory += texture->CalculateMipMemory(texture->GetResidentMip(), lastMip);
+      }
+    }
+  }
+
+  void TextureStreamer::CompleteLoads(bool wait)
+  {
+    for (auto it = m_pendingLoads.begin(); it != m_pendingLoads.end();)
+    {
+      if (!wait && it->levels.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        ++it;
+        continue;
+      }
+
+      auto state = m_textures.find(it->texture);
+      if (state != m_textures.end())
+      {
+        state->second.loading = false;
+      }
+
+      FinishLoad(it->texture, it->firstMip, it->lastMip, it->levels.get());
+      it = m_pendingLoads.erase(it);
+    }
+  }
+
+  void TextureStreamer::FinishLoad(Texture* texture, int firstMip, int lastMip, const std::vector<ByteArray>& levels)
+  {
+    if (levels.size() != (size_t) (lastMip - firstMip + 1))
+    {
+      TK_WRN("Mip levels can't be streamed: %s", texture->GetFile().c_str());
+
+      // Keep the resident levels, otherwise the file would be read again every frame.
+      auto state = m_textures.find(texture);
+      if (state != m_textures.end())
+      {
+        state->second.minMip    = texture->GetResidentMip();
+        state->second.targetMip = state->second.minMip;
+      }
+
+      return;
+    }
+
+    // Resident levels may have changed while loading.
+    if (texture->GetResidentMip() != lastMip + 1)
+    {
+      return;
+    }
+
+    texture->LoadMips(firstMip, levels);
+  }
+
+} // namespace ToolKit
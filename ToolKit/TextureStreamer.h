@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Types.h"
+
+#include <future>
+
+namespace ToolKit
+{
+
+  /**
+   * Keeps the mip levels of file textures resident based on their size on screen. Streamed textures are initialized
+   * with their smallest levels. Render job creation requests levels for the textures of the visible materials, higher
+   * levels are loaded on the background pool and uploaded at the end of the frame. When the resident levels exceed the
+   * budget in GraphicSettings, levels that are not needed anymore and then the least recently requested ones are
+   * evicted. Decisions only depend on the requests and the budget, which allows inspecting them in headless runs.
+   */
+  class TK_API TextureStreamer
+  {
+   public:
+    TextureStreamer();
+    ~TextureStreamer();
+
+    /** States if the streaming is enabled in the graphic settings. */
+    bool IsEnabled() const;
+
+    /** Starts streaming the texture. Texture must be initialized with its smallest levels resident. */
+    void Register(Texture* texture);
+
+    /** Stops streaming the texture and drops its pending loads. */
+    void Unregister(Texture* texture);
+
+    /** States if the texture is registered to the streamer. */
+    bool IsRegistered(Texture* texture) const;
+
+    /**
+     * Requests the mip level for the texture to be resident for the current frame. Multiple requests in a frame are
+     * merged and the largest level wins. Must be called from the main thread.
+     */
+    void RequestMip(Texture* texture, int mip);
+
+    /**
+     * Requests levels for the streamed textures of the material.
+     * @param screenSize is the size of the surface on screen in pixels.
+     */
+    void RequestMaterial(Material* material, float screenSize);
+
+    /**
+     * Uploads the loaded levels, decides the resident levels for the requests of the frame, evicts levels over the
+     * budget and starts new loads. Must be called once per frame from the main thread.
+     */
+    void Update();
+
+    /** Uploads all pending loads, waits for the ones that are not ready. */
+    void Flush();
+
+    /** @return Gpu memory used by the resident levels of the streamed textures in bytes. */
+    uint64 GetResidentMemory() const;
+
+    /** @return Budget for the streamed textures in bytes. */
+    uint64 GetBudget() const;
+
+    /** @return Number of loads that are in progress. */
+    int GetPendingLoadCount() const { return (int) m_pendingLoads.size(); }
+
+    /**
+     * Estimates the size of the bounding box on screen.
+     * @param box is the world space bounding box.
+     * @param camera is the camera that views the box.
+     * @param viewportHeight is the height of the viewport in pixels.
+     * @return Diameter of the box on screen in pixels.
+     */
+    static float EstimateScreenSize(const BoundingBox& box, Camera* camera, float viewportHeight);
+
+    /**
+     * Calculates the largest mip level that is needed for a texture that covers the given pixels on screen. Texture is
+     * assumed to be mapped once across the surface.
+     */
+    static int CalculateDesiredMip(int width, int height, float screenSize);
+
+    /** Calculates the level whose largest dimension fits in to the minimum resident size. */
+    int CalculateMinResidentMip(int width, int height) const;
+
+   private:
+    /** Streaming state of a registered texture. */
+    struct StreamState
+    {
+      int minMip              = 0;          //!< Smallest level which is always resident.
+      int targetMip           = 0;          //!< Level that the streamer tries to make resident.
+      int requestedMip        = TK_INT_MAX; //!< Largest level requested in the current frame.
+      uint64 lastRequestFrame = 0;          //!< Last frame that the texture is requested.
+      bool loading            = false;      //!< States if there is a load in progress for the texture.
+    };
+
+    /** Levels that are being loaded in the background. */
+    struct PendingLoad
+    {
+      Texture* texture = nullptr;
+      int firstMip     = 0;
+      int lastMip      = 0;
+      uint64 size      = 0; //!< Gpu memory that the levels will use when uploaded.
+      std::future<std::vector<ByteArray>> levels;
+    };
+
+    /**
+     * Reads the image file and provides its mip levels. Called on a background thread.
+     * @return The levels in range or an empty array if the file can't be read.
+     */
+    static std::vector<ByteArray> LoadMipLevels(const String& file,
+                                                bool compressed,
+                                                bool srgb,
+                                                int firstMip,
+                                                int lastMip);
+
+    void UpdateTargets();
+    void EvictOverBudget(uint64 budget, uint64& residentMemory);
+    void StartLoads(uint64 budget, uint64 residentMemory);
+    void CompleteLoads(bool wait);
+    void FinishLoad(Texture* texture, int firstMip, int lastMip, const std::vector<ByteArray>& levels);
+
+   public:
+    int m_minResidentSize  = 64;  //!< Largest dimension of the smallest level that is kept resident.
+    int m_maxLoadsInFlight = 4;   //!< Number of loads that can be in progress at the same time.
+    int m_unusedFrameCount = 120; //!< Number of frames without a request after which the higher levels are unused.
+
+   private:
+    std::unordered_map<Texture*, StreamState> m_textures;
+    std::vector<PendingLoad> m_pendingLoads;
+    uint64 m_frame = 0;
+  };
+
+} // namespace ToolKit
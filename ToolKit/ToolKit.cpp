@@ -10,6 +10,7 @@
 #include "Audio.h"
 #include "EngineSettings.h"
 #include "FileManager.h"
+#include "FrameAllocator.h"
 #include "GpuProgram.h"
 #include "Logger.h"
 #include "Material.h"
@@ -23,51 +24,298 @@
 #include "Shader.h"
 #include "Stats.h"
 #include "TKOpenGL.h"
+#include "Texture.h"
 #include "Threads.h"
 #include "UIManager.h"
 
+#include <chrono>
+#include <thread>
+
 #include "DebugNew.h"
 
 namespace ToolKit
 {
 
-  HandleManager::HandleManager()
+  // Generated handle layout: tag (1) | salt (8) | slot state (23) | slot index (32). Tag bit is always set, so a
+  // generated handle is never NullHandle.
+  static constexpr uint64 HandleTagBit     = 1ull << 63;
+  static constexpr uint64 HandleSaltShift  = 55;
+  static constexpr uint64 HandleSaltMask   = 0xff;
+  static constexpr uint64 HandleStateShift = 32;
+  static constexpr uint32 HandleStateMask  = (1u << 23) - 1;
+  static constexpr uint64 HandleIndexMask  = 0xffffffff;
+
+  static constexpr size_t HandleCacheBatch = 64;                   //!< Indices moved between caches at once.
+  static constexpr size_t HandleCacheLimit = HandleCacheBatch * 4; //!< Thread cache size that triggers a flush.
+
+  /** Free slot indices of a thread. */
+  struct HandleCache
+  {
+    uint64 instance = 0;
+    std::vector<uint32> indices;
+  };
+
+  static thread_local HandleCache g_handleCache;
+  static std::atomic<uint64> g_handleManagerInstance {0};
+
+  HandleManager::HandleManager() : m_nextIndex(0), m_futureHandleCount(0)
   {
-    ObjectId seed = time(nullptr) + ((ObjectId) (this) ^ m_randomXor[0]);
-    Xoroshiro128PlusSeed(m_randomXor, seed);
+    uint64 randomXor[2];
+    ObjectId seed = time(nullptr) + (ObjectId) (this);
+    Xoroshiro128PlusSeed(randomXor, seed);
+
+    m_salt     = Xoroshiro128Plus(randomXor) & HandleSaltMask;
+    m_instance = ++g_handleManagerInstance;
+
+    for (std::atomic<std::atomic<uint32>*>& segment : m_segments)
+    {
+      segment.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  HandleManager::~HandleManager()
+  {
+    for (std::atomic<std::atomic<uint32>*>& segment : m_segments)
+    {
+      delete[] segment.load();
+    }
   }
 
   ObjectId HandleManager::GenerateHandle()
   {
-    ObjectId id;
-    SpinlockGuard lock(m_uniqueIdWriteLock);
+    while (true)
+    {
+      uint32 index              = AcquireIndex();
+      std::atomic<uint32>* slot = GetSlot(index);
+      uint32 state              = slot->fetch_add(1) + 1; // Odd, alive.
+
+      ObjectId id               = HandleTagBit | (m_salt << HandleSaltShift);
+      id                       |= (uint64) state << HandleStateShift | index;
+
+      // Handles read from files, that may equal to a generated one are skipped.
+      if (m_futureHandleCount.load() == 0 || !HasExternal(id))
+      {
+        return id;
+      }
+
+      slot->fetch_add(1);
+      ReleaseIndex(index);
+    }
+  }
 
-    do
+  void HandleManager::AddHandle(ObjectId val) { TryAddHandle(val); }
+
+  bool HandleManager::IsHandleUnique(ObjectId val) { return MatchSlot(val) != SlotMatch::Live && !HasExternal(val); }
+
+  bool HandleManager::TryAddHandle(ObjectId val)
+  {
+    SlotMatch match = MatchSlot(val);
+    if (match == SlotMatch::Live)
     {
-      id = Xoroshiro128Plus(m_randomXor);
-    } while (m_uniqueIDs.find(id) != m_uniqueIDs.end() || id == NullHandle);
+      return false;
+    }
 
-    m_uniqueIDs.insert(id);
-    return id;
+    if (!TryAddExternal(val, match == SlotMatch::Future))
+    {
+      return false;
+    }
+
+    // A future handle may have been generated concurrently. Generation checks the external handles after
+    // acquiring the slot, this checks the slot after adding the external handle. One of them sees the other.
+    if (match == SlotMatch::Future && MatchSlot(val) == SlotMatch::Live)
+    {
+      EraseExternal(val);
+      return false;
+    }
+
+    return true;
   }
 
-  void HandleManager::AddHandle(ObjectId val)
+  void HandleManager::ReleaseHandle(ObjectId val)
   {
-    SpinlockGuard lock(m_uniqueIdWriteLock);
-    m_uniqueIDs.insert(val);
+    if (MatchSlot(val) == SlotMatch::Live)
+    {
+      uint32 index              = (uint32) (val & HandleIndexMask);
+      uint32 state              = (uint32) (val >> HandleStateShift) & HandleStateMask;
+      std::atomic<uint32>* slot = GetSlot(index);
+
+      // Only one release can advance the state, double releases are ignored.
+      if (slot->compare_exchange_strong(state, state + 1))
+      {
+        ReleaseIndex(index);
+      }
+
+      return;
+    }
+
+    EraseExternal(val);
   }
 
-  bool HandleManager::IsHandleUnique(ObjectId val)
+  HandleManager::SlotMatch HandleManager::MatchSlot(ObjectId val) const
   {
-    SpinlockGuard lock(m_uniqueIdWriteLock);
-    bool unique = (m_uniqueIDs.find(val) == m_uniqueIDs.end());
-    return unique;
+    if ((val & HandleTagBit) == 0 || ((val >> HandleSaltShift) & HandleSaltMask) != m_salt)
+    {
+      return SlotMatch::Foreign;
+    }
+
+    // Generated states are always odd.
+    uint32 state = (uint32) (val >> HandleStateShift) & HandleStateMask;
+    if ((state & 1) == 0)
+    {
+      return SlotMatch::Foreign;
+    }
+
+    uint32 index = (uint32) (val & HandleIndexMask);
+    if (index >= m_nextIndex.load() || index >= SegmentCount * SlotsPerSegment)
+    {
+      return SlotMatch::Future;
+    }
+
+    uint32 current = 0;
+    if (std::atomic<uint32>* slots = m_segments[index / SlotsPerSegment].load())
+    {
+      current = slots[index % SlotsPerSegment].load();
+    }
+
+    if (current == state)
+    {
+      return SlotMatch::Live;
+    }
+
+    return current > state ? SlotMatch::Released : SlotMatch::Future;
   }
 
-  void HandleManager::ReleaseHandle(ObjectId val)
+  std::atomic<uint32>* HandleManager::GetSlot(uint32 index)
+  {
+    std::atomic<std::atomic<uint32>*>& segment = m_segments[index / SlotsPerSegment];
+
+    std::atomic<uint32>* slots                 = segment.load();
+    if (slots == nullptr)
+    {
+      std::atomic<uint32>* created = new std::atomic<uint32>[SlotsPerSegment]();
+      if (segment.compare_exchange_strong(slots, created))
+      {
+        slots = created;
+      }
+      else
+      {
+        delete[] created; // Other thread has created the segment.
+      }
+    }
+
+    return slots + index % SlotsPerSegment;
+  }
+
+  uint32 HandleManager::AcquireIndex()
+  {
+    HandleCache& cache = g_handleCache;
+    if (cache.instance != m_instance)
+    {
+      cache.instance = m_instance;
+      cache.indices.clear();
+    }
+
+    if (cache.indices.empty())
+    {
+      SpinlockGuard lock(m_freeIndexLock);
+
+      size_t count = glm::min(HandleCacheBatch, m_freeIndices.size());
+      cache.indices.insert(cache.indices.end(), m_freeIndices.end() - count, m_freeIndices.end());
+      m_freeIndices.resize(m_freeIndices.size() - count);
+    }
+
+    if (cache.indices.empty())
+    {
+      // Fresh indices are reversed, so they are handed out in ascending order.
+      uint32 first = m_nextIndex.fetch_add((uint32) HandleCacheBatch);
+      assert(first + HandleCacheBatch <= SegmentCount * SlotsPerSegment && "Handle slots exhausted.");
+
+      for (uint32 i = (uint32) HandleCacheBatch; i > 0; i--)
+      {
+        cache.indices.push_back(first + i - 1);
+      }
+    }
+
+    uint32 index = cache.indices.back();
+    cache.indices.pop_back();
+
+    return index;
+  }
+
+  void HandleManager::ReleaseIndex(uint32 index)
+  {
+    // Slots whose state is about to overflow are retired. Reusing them would generate released handles again.
+    if (GetSlot(index)->load() >= HandleStateMask - 1)
+    {
+      return;
+    }
+
+    HandleCache& cache = g_handleCache;
+    if (cache.instance != m_instance)
+    {
+      cache.instance = m_instance;
+      cache.indices.clear();
+    }
+
+    cache.indices.push_back(index);
+    if (cache.indices.size() >= HandleCacheLimit)
+    {
+      SpinlockGuard lock(m_freeIndexLock);
+
+      m_freeIndices.insert(m_freeIndices.end(), cache.indices.end() - HandleCacheBatch, cache.indices.end());
+      cache.indices.resize(cache.indices.size() - HandleCacheBatch);
+    }
+  }
+
+  bool HandleManager::TryAddExternal(ObjectId val, bool future)
   {
-    SpinlockGuard lock(m_uniqueIdWriteLock);
-    m_uniqueIDs.erase(val);
+    if (future)
+    {
+      m_futureHandleCount++;
+    }
+
+    ExternalShard& shard = m_externalShards[val % ShardCount];
+    SpinlockGuard lock(shard.lock);
+
+    if (!shard.handles.insert({val, future}).second)
+    {
+      if (future)
+      {
+        m_futureHandleCount--;
+      }
+
+      return false;
+    }
+
+    return true;
+  }
+
+  bool HandleManager::EraseExternal(ObjectId val)
+  {
+    ExternalShard& shard = m_externalShards[val % ShardCount];
+    SpinlockGuard lock(shard.lock);
+
+    auto handle          = shard.handles.find(val);
+    if (handle == shard.handles.end())
+    {
+      return false;
+    }
+
+    if (handle->second)
+    {
+      m_futureHandleCount--;
+    }
+
+    shard.handles.erase(handle);
+    return true;
+  }
+
+  bool HandleManager::HasExternal(ObjectId val)
+  {
+    ExternalShard& shard = m_externalShards[val % ShardCount];
+    SpinlockGuard lock(shard.lock);
+
+    return shard.handles.find(val) != shard.handles.end();
   }
 
   Main* Main::m_proxy = nullptr;
@@ -88,6 +336,7 @@ namespace ToolKit
   {
     ClearPreUpdateFunctions();
     ClearPostUpdateFunctions();
+    ClearTickFunctions();
 
     assert(m_initiated == false && "Uninitiate before destruct");
     m_proxy = nullptr;
@@ -133,7 +382,14 @@ namespace ToolKit
     m_skeletonManager   = new SkeletonManager();
     m_fileManager       = new FileManager();
 
-    m_preInitiated      = true;
+    // There won't be a host provided context, resources created during Init use the null backend.
+    if (m_headless)
+    {
+      m_logger->Log("Main running headless");
+      m_renderSys->InitGl(nullptr);
+    }
+
+    m_preInitiated = true;
   }
 
   void Main::Init()
@@ -245,6 +501,19 @@ namespace ToolKit
   bool Main::SyncFrameTime()
   {
     m_timing.CurrentTime = GetElapsedMilliSeconds();
+    float remainingTime  = m_timing.LastTime + m_timing.TargetDeltaTime - m_timing.CurrentTime;
+
+    // Sleep most of the remaining time to free the cpu. Os timers are not precise, the rest is awaited by polling.
+    // Web's main loop is driven by the browser, blocking it is not allowed.
+    if constexpr (TK_PLATFORM != PLATFORM::TKWeb)
+    {
+      if (remainingTime > m_timing.SleepMargin)
+      {
+        std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(remainingTime - m_timing.SleepMargin));
+        m_timing.CurrentTime = GetElapsedMilliSeconds();
+      }
+    }
+
     return m_timing.CurrentTime > m_timing.LastTime + m_timing.TargetDeltaTime;
   }
 
@@ -266,6 +535,17 @@ namespace ToolKit
       stats->m_cameraUpdatePerFrame                  = 0;
       stats->m_directionalLightUpdatePerFramePrev    = stats->m_directionalLightUpdatePerFrame;
       stats->m_directionalLightUpdatePerFrame        = 0;
+      stats->m_uiBatchedJobsPerFramePrev             = stats->m_uiBatchedJobsPerFrame;
+      stats->m_uiBatchedJobsPerFrame                 = 0;
+
+      uint64 heapAllocations                         = FrameArena::GetHeapAllocationCount();
+      stats->m_heapAllocationsPerFramePrev           = heapAllocations - stats->m_heapAllocationsAtFrameBegin;
+      stats->m_heapAllocationsAtFrameBegin           = heapAllocations;
+
+      stats->m_glCallsPerFramePrev                   = RHI::m_issuedGlCallCount;
+      stats->m_skippedGlCallsPerFramePrev            = RHI::m_skippedGlCallCount;
+      RHI::m_issuedGlCallCount                       = 0;
+      RHI::m_skippedGlCallCount                      = 0;
     }
 
     GetRenderSystem()->StartFrame();
@@ -302,8 +582,18 @@ namespace ToolKit
     }
 
     m_timing.LastTime = m_timing.CurrentTime;
+
+    // Uploads the streamed mip levels and decides the next ones with the requests of the rendered frame.
+    if (m_textureMan->m_streamer != nullptr)
+    {
+      m_textureMan->m_streamer->Update();
+    }
+
     GetRenderSystem()->EndFrame();
 
+    // Transient allocations of the frame are released.
+    FrameArena::NewFrame();
+
     // Display stat times.
     for (auto& timeStat : TKStatTimerMap)
     {
@@ -317,20 +607,84 @@ namespace ToolKit
 
   void Main::Frame(float deltaTime)
   {
-    // Update external logic.
-    GetPluginManager()->Update(deltaTime);
+    SimulationSettingsPtr simulation = m_engineSettings->m_simulation;
+    bool interpolate                 = false;
 
-    // Update engine.
-    GetAnimationPlayer()->Update(MillisecToSec(deltaTime));
+    if (simulation->GetFixedTimeStepVal())
+    {
+      m_timing.FixedDeltaTime   = 1000.0f / (float) glm::max(1, simulation->GetTickRateVal());
+      m_timing.SimulationAccum += deltaTime;
+
+      int maxTicks              = glm::max(1, simulation->GetMaxTicksPerFrameVal());
+      for (int tick = 0; tick < maxTicks && m_timing.SimulationAccum >= m_timing.FixedDeltaTime; tick++)
+      {
+        Tick(m_timing.FixedDeltaTime);
+
+        // Scene may be changed by the tick.
+        if (ScenePtr scene = GetSceneManager()->GetCurrentScene())
+        {
+          scene->SaveSimulationState();
+        }
+
+        m_timing.SimulationAccum -= m_timing.FixedDeltaTime;
+        m_timing.TickCount++;
+      }
+
+      // Drop the time that can't be caught up within the frame, otherwise slow frames cause even more ticks to come.
+      if (m_timing.SimulationAccum >= m_timing.FixedDeltaTime)
+      {
+        uint64 droppedTicks        = (uint64) (m_timing.SimulationAccum / m_timing.FixedDeltaTime);
+        m_timing.SimulationAccum  -= droppedTicks * m_timing.FixedDeltaTime;
+        m_timing.DroppedTickCount += droppedTicks;
+      }
+
+      m_timing.InterpolationAlpha = m_timing.SimulationAccum / m_timing.FixedDeltaTime;
+      interpolate                 = simulation->GetInterpolateTransformsVal();
+    }
+    else
+    {
+      Tick(deltaTime);
+    }
+
+    // Update presentation once per frame.
     GetUIManager()->Update(deltaTime);
 
-    if (ScenePtr scene = GetSceneManager()->GetCurrentScene())
+    ScenePtr scene = GetSceneManager()->GetCurrentScene();
+    if (scene != nullptr)
     {
+      if (interpolate)
+      {
+        scene->InterpolateSimulationState(m_timing.InterpolationAlpha);
+      }
+
       scene->Update(deltaTime);
     }
 
+    // Voices of the finished sounds are returned to the pool.
+    m_audioMan->Update();
+
     GetRenderSystem()->DecrementSkipFrame();
     GetRenderSystem()->ExecuteRenderTasks();
+
+    // Simulation continues from the latest tick, not from the interpolated transforms.
+    if (scene != nullptr && interpolate)
+    {
+      scene->RestoreSimulationState();
+    }
+  }
+
+  void Main::Tick(float deltaTime)
+  {
+    for (const TKUpdateFn& tickFn : m_tickFunctions)
+    {
+      tickFn(deltaTime);
+    }
+
+    // Update external logic.
+    GetPluginManager()->Update(deltaTime);
+
+    // Update engine.
+    GetAnimationPlayer()->Update(MillisecToSec(deltaTime));
   }
 
   void Main::RegisterPreUpdateFunction(TKUpdateFn preUpdateFn) { m_preUpdateFunctions.push_back(preUpdateFn); }
@@ -341,6 +695,10 @@ namespace ToolKit
 
   void Main::ClearPostUpdateFunctions() { m_postUpdateFunctions.clear(); }
 
+  void Main::RegisterTickFunction(TKUpdateFn tickFn) { m_tickFunctions.push_back(tickFn); }
+
+  void Main::ClearTickFunctions() { m_tickFunctions.clear(); }
+
   int Main::GetCurrentFPS() const { return m_timing.FramesPerSecond; }
 
   float Main::TimeSinceStartup() const { return m_timing.CurrentTime; }
@@ -577,12 +935,16 @@ namespace ToolKit
 
   void Timing::Init(uint fps)
   {
-    LastTime        = GetElapsedMilliSeconds();
-    CurrentTime     = 0.0f;
-    TargetDeltaTime = 1000.0f / float(fps);
-    FramesPerSecond = fps;
-    FrameCount      = 0;
-    TimeAccum       = 0.0f;
+    LastTime           = GetElapsedMilliSeconds();
+    CurrentTime        = 0.0f;
+    TargetDeltaTime    = 1000.0f / float(fps);
+    FramesPerSecond    = fps;
+    FrameCount         = 0;
+    TimeAccum          = 0.0f;
+    SimulationAccum    = 0.0f;
+    InterpolationAlpha = 0.0f;
+    TickCount          = 0;
+    DroppedTickCount   = 0;
   }
 
   float Timing::GetDeltaTime() { return CurrentTime - LastTime; }
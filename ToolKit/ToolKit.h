@@ -29,14 +29,26 @@ namespace ToolKit
    */
   typedef std::function<void(float deltaTime)> TKUpdateFn;
 
-  /** A class that Provides a unique handle when needed. */
+  /**
+   * A class that Provides a unique handle when needed.
+   *
+   * Generated handles are generational indices: a slot index, the state of the slot and a random salt of the session.
+   * Each thread keeps a small cache of free slots, so generating and releasing handles doesn't lock and memory is
+   * proportional to the live handle count. Slot states only grow, a released handle is never generated again in the
+   * session.
+   *
+   * Handles read from files are kept as they are. They are recorded in a sharded set and don't collide with the
+   * generated handles. Only handles that look like future handles of this session, which requires a matching salt,
+   * are checked during generation.
+   */
   class TK_API HandleManager
   {
    public:
     HandleManager(); //!< Default constructor, initializes the handle manager with a random seed.
+    ~HandleManager();
 
     /**
-     * Random id that guarantees uniqueness on runtime. Collisions are resolved during deserialize, if any.
+     * Id that guarantees uniqueness on runtime. Collisions are resolved during deserialize, if any.
      * These ids, freed when using of it completed. So ids are reused and do not overflow.
      */
     ObjectId GenerateHandle();
@@ -44,11 +56,47 @@ namespace ToolKit
     void AddHandle(ObjectId val); //!< Add record for the random id. Prevent it from getting acquired multiple times.
     void ReleaseHandle(ObjectId val);  //!< Free the id for reuse.
     bool IsHandleUnique(ObjectId val); //!< Test if id acquired.
+    bool TryAddHandle(ObjectId val);   //!< Adds record for the id if its not acquired. Returns false if acquired.
+
+   private:
+    /** Result of matching a handle against the slots. */
+    enum class SlotMatch
+    {
+      Foreign,  //!< Handle is not generated by this session.
+      Live,     //!< Handle is generated and alive.
+      Released, //!< Handle is generated and released, it will not be generated again.
+      Future    //!< Handle has the format of this session but has not been generated yet.
+    };
+
+    SlotMatch MatchSlot(ObjectId val) const;
+    std::atomic<uint32>* GetSlot(uint32 index);
+    uint32 AcquireIndex();
+    void ReleaseIndex(uint32 index);
+    bool TryAddExternal(ObjectId val, bool future);
+    bool EraseExternal(ObjectId val);
+    bool HasExternal(ObjectId val);
 
    private:
-    ObjectId m_randomXor[2];                  //!< Random seed.
-    std::unordered_set<ObjectId> m_uniqueIDs; //!< Container for all acquired handles.
-    Spinlock m_uniqueIdWriteLock;             //!< Guaranties thread safety for modifying handle manager's state.
+    static constexpr uint32 SlotsPerSegment = 1 << 16;
+    static constexpr uint32 SegmentCount    = 1 << 12;
+    static constexpr uint32 ShardCount      = 16;
+
+    /** Handles that are not generated by this session, such as the ones read from files. */
+    struct ExternalShard
+    {
+      Spinlock lock;
+      std::unordered_map<ObjectId, bool> handles; //!< Handle and whether it is a future handle.
+    };
+
+    uint64 m_salt     = 0; //!< Random session bits, placed in to the generated handles.
+    uint64 m_instance = 0; //!< Distinguishes thread caches of different managers.
+
+    std::atomic<std::atomic<uint32>*> m_segments[SegmentCount]; //!< Slot states. Odd states are alive.
+    std::atomic<uint32> m_nextIndex;                            //!< First index that is never acquired.
+    std::vector<uint32> m_freeIndices;                          //!< Free indices that overflow the thread caches.
+    Spinlock m_freeIndexLock;                                   //!< Guards m_freeIndices.
+    ExternalShard m_externalShards[ShardCount];                 //!< Handles read from files.
+    std::atomic<uint64> m_futureHandleCount;                    //!< External handles that generation must avoid.
   };
 
   /**
@@ -63,12 +111,21 @@ namespace ToolKit
     /** Returns the elapsed time for the last frame in milliseconds. */
     float GetDeltaTime();
 
-    float CurrentTime     = 0.0f; //!< Total elapsed time in milliseconds. Updated after every frame.
-    float TargetDeltaTime = 0.0f; //!< Target delta time in milliseconds calculated as (1000 / Target Fps)
-    int FramesPerSecond   = 0;    //!< Number of frames drawn within 1 second.
-    int FrameCount        = 0;    //!< Internally used to count number of frames per second.
-    float LastTime        = 0.0f; //!< Internally used to determine if enough time has passed for a new frame.
-    float TimeAccum       = 0.0f; //!< Internally used to determine if enough time has passed for a new frame.
+    float CurrentTime        = 0.0f; //!< Total elapsed time in milliseconds. Updated after every frame.
+    float TargetDeltaTime    = 0.0f; //!< Target delta time in milliseconds calculated as (1000 / Target Fps)
+    int FramesPerSecond      = 0;    //!< Number of frames drawn within 1 second.
+    int FrameCount           = 0;    //!< Internally used to count number of frames per second.
+    float LastTime           = 0.0f; //!< Internally used to determine if enough time has passed for a new frame.
+    float TimeAccum          = 0.0f; //!< Internally used to determine if enough time has passed for a new frame.
+
+    /** Time in milliseconds before the next frame, below which the frame is awaited by polling instead of sleeping. */
+    float SleepMargin        = 2.0f;
+
+    float FixedDeltaTime     = 0.0f; //!< Simulation time step in milliseconds in fixed time step mode.
+    float SimulationAccum    = 0.0f; //!< Frame time in milliseconds that is not yet consumed by the simulation ticks.
+    float InterpolationAlpha = 0.0f; //!< Fraction of the time step that the frame time is ahead of the last tick.
+    uint64 TickCount         = 0;    //!< Number of fixed time steps simulated since the initialization.
+    uint64 DroppedTickCount  = 0;    //!< Number of ticks dropped due to the catch up limit.
   };
 
   /**
@@ -159,6 +216,12 @@ namespace ToolKit
      */
     void RegisterPostUpdateFunction(TKUpdateFn postUpdateFn);
 
+    /**
+     * This function registers function that should be called on every simulation tick. In fixed time step mode, it is
+     * called with the fixed time step, zero or more times per frame. Otherwise it is called once per frame.
+     */
+    void RegisterTickFunction(TKUpdateFn tickFn);
+
     /**
      * This function clears registered pre-update functions.
      */
@@ -169,6 +232,11 @@ namespace ToolKit
      */
     void ClearPostUpdateFunctions();
 
+    /**
+     * This function clears registered tick functions.
+     */
+    void ClearTickFunctions();
+
     /**
      * @return Current frame count per second.
      */
@@ -180,12 +248,14 @@ namespace ToolKit
     float TimeSinceStartup() const;
 
     /**
+     * Sleeps until the next frame is close instead of busy waiting. Expected to be called in a loop.
      * @return true if enough time have passed from previous frame
      */
     bool SyncFrameTime();
 
    private:
     void Frame(float deltaTime); //!< Performs an update for all engine components.
+    void Tick(float deltaTime);  //!< Advances the simulation, which consists of plugins and animations.
 
    public:
     Timing m_timing; //!< Timer that keeps time related data since the Initialization.
@@ -215,6 +285,12 @@ namespace ToolKit
     bool m_preInitiated = false;
     bool m_initiated    = false;
     bool m_threaded     = true;
+
+    /**
+     * Runs the engine without a gpu. Opengl is replaced with the null backend, which issues no gpu calls while the cpu
+     * side of the engine runs as usual. Must be set before PreInit. See NullRHI.
+     */
+    bool m_headless     = false;
     String m_resourceRoot;
     String m_defaultResourceRoot;
     String m_cfgPath;
@@ -225,6 +301,7 @@ namespace ToolKit
 
     std::vector<TKUpdateFn> m_preUpdateFunctions;
     std::vector<TKUpdateFn> m_postUpdateFunctions;
+    std::vector<TKUpdateFn> m_tickFunctions;
   };
 
   // Accessors.
@@ -200,6 +200,7 @@ namespace ToolKit
   typedef std::shared_ptr<class Camera> CameraPtr;
   typedef std::vector<CameraPtr> CameraPtrArray;
   typedef std::shared_ptr<class Surface> SurfacePtr;
+  typedef std::vector<SurfacePtr> SurfacePtrArray;
   typedef std::shared_ptr<class Dpad> DpadPtr;
   typedef std::shared_ptr<class GammaTonemapFxaaPass> GammaTonemapFxaaPassPtr;
 
@@ -252,6 +253,7 @@ namespace ToolKit
   static const String BMP(".bmp");
   static const String PSD(".psd");
   static const String HDR(".hdr");
+  static const String KTX(".ktx");
   static const String WAW(".waw");
   static const String MP3(".mp3");
 
@@ -265,6 +267,7 @@ namespace ToolKit
   static const String SHADER(".shader");
   static const String AUDIO(".wav");
   static const String LAYER(".layer");
+  static const String ENVBAKE(".envBake");
 
   static const ObjectId NullHandle    = 0;  //!< Used for uninitialized handles.
   static const ObjectId InvalidHandle = -1; //!< Used for invalid handles.
@@ -368,6 +371,12 @@ namespace ToolKit
     FormatRGBA32F              = 0x8814,
     FormatR16SNorm             = 0x8F98,
     FormatSRGB8_A8             = 0x8C43,
+    FormatRGB8_ETC2            = 0x9274,
+    FormatSRGB8_ETC2           = 0x9275,
+    FormatRGBA8_ETC2_EAC       = 0x9278,
+    FormatSRGB8_A8_ETC2_EAC    = 0x9279,
+    FormatRGBA_ASTC_4x4        = 0x93B0,
+    FormatSRGB8_A8_ASTC_4x4    = 0x93D0,
     FormatDepth24              = 0x81A6,
     FormatDepth24Stencil8      = 0x88F0,
     ColorAttachment0           = 0x8CE0,
@@ -425,9 +434,60 @@ namespace ToolKit
     }
   }
 
+  /** States if the format is a block compressed format. */
+  inline bool IsCompressedFormat(GraphicTypes type)
+  {
+    switch (type)
+    {
+    case GraphicTypes::FormatRGB8_ETC2:
+    case GraphicTypes::FormatSRGB8_ETC2:
+    case GraphicTypes::FormatRGBA8_ETC2_EAC:
+    case GraphicTypes::FormatSRGB8_A8_ETC2_EAC:
+    case GraphicTypes::FormatRGBA_ASTC_4x4:
+    case GraphicTypes::FormatSRGB8_A8_ASTC_4x4:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  /** Size of a single 4x4 block of a compressed format in bytes. */
+  inline int BytesOfCompressedBlock(GraphicTypes type)
+  {
+    switch (type)
+    {
+    case GraphicTypes::FormatRGB8_ETC2:
+    case GraphicTypes::FormatSRGB8_ETC2:
+      return 8;
+    case GraphicTypes::FormatRGBA8_ETC2_EAC:
+    case GraphicTypes::FormatSRGB8_A8_ETC2_EAC:
+    case GraphicTypes::FormatRGBA_ASTC_4x4:
+    case GraphicTypes::FormatSRGB8_A8_ASTC_4x4:
+      return 16;
+    default:
+      assert(false && "Unsupported compressed format");
+      return 16;
+    }
+  }
+
+  /** Size of a single image with the given dimensions in bytes. Handles both compressed and uncompressed formats. */
+  inline uint64 BytesOfImage(GraphicTypes type, int width, int height)
+  {
+    if (IsCompressedFormat(type))
+    {
+      uint64 blockCount = (uint64) ((width + 3) / 4) * (uint64) ((height + 3) / 4);
+      return blockCount * BytesOfCompressedBlock(type);
+    }
+
+    return (uint64) width * (uint64) height * BytesOfFormat(type);
+  }
+
   // String defines.
   static const String TKBrdfLutTexture        = "GLOBAL_BRDF_LUT_TEXTURE";
   static const String TKIrradianceCacheFolder = "EnvCacheMap";
+  static const String TKCookedTextureFolder   = "Cooked";
+  static const String TKTextureAtlasFolder    = "Atlas";
+  static const String TKAnimationDataFolder   = "Baked";
   static const String TKDefaultGradientSky    = "DefaultGradientSky";
   static const String TKDefaultHdri           = "DefaultHDRI";
   static const String TKDefaultImage          = "default.png";
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#include "UIBatcher.h"
+
+#include "Material.h"
+#include "Mesh.h"
+#include "Stats.h"
+#include "Texture.h"
+#include "ToolKit.h"
+
+#include "DebugNew.h"
+
+namespace ToolKit
+{
+
+  UIBatcher::UIBatcher() {}
+
+  UIBatcher::~UIBatcher() { m_meshPool.clear(); }
+
+  void UIBatcher::Reset() { m_usedMeshCount = 0; }
+
+  void UIBatcher::Batch(const RenderJobArray& jobs, RenderJobArray& batchedJobs)
+  {
+    // Ui camera is orthographic, surfaces overlap on screen if their rectangles overlap regardless of depth.
+    auto overlaps = [](const BoundingBox& b1, const BoundingBox& b2) -> bool
+    { return b1.min.x < b2.max.x && b1.max.x > b2.min.x && b1.min.y < b2.max.y && b1.max.y > b2.min.y; };
+
+    m_batches.clear();
+    for (int i = 0; i < (int) jobs.size(); i++)
+    {
+      const RenderJob& job = jobs[i];
+      bool batchable       = IsBatchable(job);
+
+      // Search for a compatible batch. A job can be moved back to an earlier batch only if it does not overlap any
+      // batch drawn in between, otherwise the draw order would change.
+      int target           = -1;
+      if (batchable)
+      {
+        int lookBackEnd = glm::max(0, (int) m_batches.size() - m_maxLookBack);
+        for (int b = (int) m_batches.size() - 1; b >= lookBackEnd; b--)
+        {
+          const JobBatch& batch = m_batches[b];
+          if (batch.batchable && CanMerge(jobs[batch.jobIndices.front()], job))
+          {
+            target = b;
+            break;
+          }
+
+          if (overlaps(batch.bounds, job.BoundingBox))
+          {
+            break;
+          }
+        }
+      }
+
+      if (target == -1)
+      {
+        JobBatch& batch = m_batches.emplace_back();
+        batch.batchable = batchable;
+        batch.bounds    = job.BoundingBox;
+        batch.jobIndices.push_back(i);
+      }
+      else
+      {
+        JobBatch& batch = m_batches[target];
+        batch.bounds.UpdateBoundary(job.BoundingBox);
+        batch.jobIndices.push_back(i);
+      }
+    }
+
+    for (const JobBatch& batch : m_batches)
+    {
+      if (batch.jobIndices.size() == 1)
+      {
+        batchedJobs.push_back(jobs[batch.jobIndices.front()]);
+      }
+      else
+      {
+        MergeBatch(jobs, batch, batchedJobs);
+      }
+    }
+
+    if (TKStats* stats = GetTKStats())
+    {
+      stats->m_uiBatchedJobsPerFrame += jobs.size() - m_batches.size();
+    }
+  }
+
+  bool UIBatcher::IsBatchable(const RenderJob& job) const
+  {
+    const Mesh* mesh = job.Mesh;
+    if (mesh == nullptr || job.Material == nullptr)
+    {
+      return false;
+    }
+
+    if (mesh->IsSkinned() || mesh->m_indexCount != 0 || mesh->m_clientSideVertices.empty())
+    {
+      return false;
+    }
+
+    // Shader materials may carry their own uniforms, which can't be shared in a batch.
+    return !job.Material->IsShaderMaterial() && job.Material->GetRenderState()->drawType == DrawType::Triangle;
+  }
+
+  bool UIBatcher::CanMerge(const RenderJob& job1, const RenderJob& job2) const
+  {
+    if (job1.requireCullFlip != job2.requireCullFlip)
+    {
+      return false;
+    }
+
+    Material* mat1 = job1.Material;
+    Material* mat2 = job2.Material;
+    if (mat1 == mat2)
+    {
+      return true;
+    }
+
+    // Each surface owns a copy of the ui material, compare the states that effects the draw.
+    RenderState* state1 = mat1->GetRenderState();
+    RenderState* state2 = mat2->GetRenderState();
+    if (state1->blendFunction != state2->blendFunction || state1->cullMode != state2->cullMode ||
+        state1->alphaMaskTreshold != state2->alphaMaskTreshold)
+    {
+      return false;
+    }
+
+    // Images packed in to the same atlas page are drawn with the same gpu texture.
+    auto sampledTextureFn = [](const TexturePtr& texture) -> Texture*
+    {
+      if (texture != nullptr && texture->GetAtlasPage() != nullptr)
+      {
+        return texture->GetAtlasPage().get();
+      }
+
+      return texture.get();
+    };
+
+    return sampledTextureFn(mat1->GetDiffuseTextureVal()) == sampledTextureFn(mat2->GetDiffuseTextureVal()) &&
+           mat1->GetEmissiveTextureVal() == mat2->GetEmissiveTextureVal() &&
+           mat1->GetVertexShaderVal() == mat2->GetVertexShaderVal() &&
+           mat1->GetFragmentShaderVal() == mat2->GetFragmentShaderVal() && mat1->GetColorVal() == mat2->GetColorVal() &&
+           mat1->GetAlphaVal() == mat2->GetAlphaVal() && mat1->GetEmissiveColorVal() == mat2->GetEmissiveColorVal();
+  }
+
+  void UIBatcher::MergeBatch(const RenderJobArray& jobs, const JobBatch& batch, RenderJobArray& batchedJobs)
+  {
+    if (m_usedMeshCount >= (int) m_meshPool.size())
+    {
+      m_meshPool.push_back(MakeNewPtr<Mesh>());
+    }
+
+    MeshPtr mesh          = m_meshPool[m_usedMeshCount++];
+    VertexArray& vertices = mesh->m_clientSideVertices;
+    vertices.clear();
+
+    BoundingBox& meshBound = mesh->m_boundingBox;
+    meshBound              = BoundingBox();
+
+    for (int index : batch.jobIndices)
+    {
+      const RenderJob& job      = jobs[index];
+      const VertexArray& source = job.Mesh->m_clientSideVertices;
+      const Mat4& transform     = job.WorldTransform;
+      Mat3 normalTransform      = glm::transpose(glm::inverse(Mat3(transform)));
+
+      size_t first              = vertices.size();
+      vertices.insert(vertices.end(), source.begin(), source.end());
+
+      for (size_t i = first; i < vertices.size(); i++)
+      {
+        Vertex& v = vertices[i];
+        v.pos     = Vec3(transform * Vec4(v.pos, 1.0f));
+        v.norm    = normalTransform * v.norm;
+        v.btan    = normalTransform * v.btan;
+        meshBound.UpdateBoundary(v.pos);
+      }
+    }
+
+    mesh->StreamVertices();
+
+    // First job represents the batch, vertices are already in world space.
+    RenderJob& merged     = batchedJobs.emplace_back(jobs[batch.jobIndices.front()]);
+    merged.Mesh           = mesh.get();
+    merged.WorldTransform = Mat4(1.0f);
+    merged.BoundingBox    = batch.bounds;
+    merged.lights.clear();
+  }
+
+} // namespace ToolKit
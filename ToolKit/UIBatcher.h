@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019-2025 OtSoftware
+ * This code is licensed under the GNU Lesser General Public License v3.0 (LGPL-3.0).
+ * For more information, including options for a more permissive commercial license,
+ * please visit [otyazilim.com] or contact us at [info@otyazilim.com].
+ */
+
+#pragma once
+
+#include "Pass.h"
+
+namespace ToolKit
+{
+
+  /**
+   * Merges the render jobs of ui layers in to a few batches. Jobs that can be drawn with the same material state, such
+   * as surfaces sharing a texture or a sprite sheet atlas, have their vertices transformed to world space and packed
+   * in to persistent streamed meshes. Draw order of overlapping surfaces is preserved.
+   */
+  class TK_API UIBatcher
+  {
+   public:
+    UIBatcher();
+    ~UIBatcher();
+
+    /**
+     * Batches the given jobs and appends the result to the output array.
+     * @param jobs are the render jobs of a single ui layer in draw order.
+     * @param batchedJobs is the array that resulting jobs are appended to.
+     */
+    void Batch(const RenderJobArray& jobs, RenderJobArray& batchedJobs);
+
+    /** Must be called once per frame before batching the layers. Recycles the streamed meshes. */
+    void Reset();
+
+   public:
+    /** Number of batches to look back for a compatible batch. Limits the cost of the search. */
+    int m_maxLookBack = 32;
+
+   private:
+    struct JobBatch
+    {
+      IntArray jobIndices;
+      BoundingBox bounds;
+      bool batchable = false;
+    };
+
+    /** States if the job is a plain non indexed, non skinned mesh with client side vertices. */
+    bool IsBatchable(const RenderJob& job) const;
+
+    /** States if both jobs render with equivalent material state. */
+    bool CanMerge(const RenderJob& job1, const RenderJob& job2) const;
+
+    /** Creates a single job that renders all the jobs in the batch. */
+    void MergeBatch(const RenderJobArray& jobs, const JobBatch& batch, RenderJobArray& batchedJobs);
+
+   private:
+    std::vector<JobBatch> m_batches;
+    MeshPtrArray m_meshPool; //!< Streamed meshes that are reused across frames.
+    int m_usedMeshCount = 0; //!< Number of meshes in the pool used for the current frame.
+  };
+
+} // namespace ToolKit
@@ -19,6 +19,135 @@
 namespace ToolKit
 {
 
+  // SurfaceHitGrid
+  //////////////////////////////////////////
+
+  void SurfaceHitGrid::Clear()
+  {
+    m_cells.clear();
+    m_entries.clear();
+    m_oversized.clear();
+  }
+
+  int64 SurfaceHitGrid::CellKey(int x, int y) const { return (int64) (((uint64) (uint) x << 32) | (uint64) (uint) y); }
+
+  int SurfaceHitGrid::CellCoordinate(float value) const
+  {
+    // Clamped before the conversion, converting a nan or an out of range float to int is undefined.
+    static const float limit = (float) (1 << 24);
+    float cell               = glm::floor(value / m_cellSize);
+    if (std::isnan(cell))
+    {
+      return 0;
+    }
+
+    return (int) glm::clamp(cell, -limit, limit);
+  }
+
+  void SurfaceHitGrid::Insert(int index, const BoundingBox& box)
+  {
+    Remove(index);
+
+    // Empty boxes and boxes with nan components can't be hit.
+    if (!(box.min.x <= box.max.x && box.min.y <= box.max.y))
+    {
+      return;
+    }
+
+    if (index >= (int) m_entries.size())
+    {
+      m_entries.resize(index + 1);
+    }
+
+    Entry& entry    = m_entries[index];
+    entry.cellRange = IVec4(CellCoordinate(box.min.x),
+                            CellCoordinate(box.min.y),
+                            CellCoordinate(box.max.x),
+                            CellCoordinate(box.max.y));
+
+    int64 cellCount = (int64) (entry.cellRange.z - entry.cellRange.x + 1) * (entry.cellRange.w - entry.cellRange.y + 1);
+    entry.inserted  = true;
+    entry.oversized = cellCount > m_maxCellPerItem;
+
+    if (entry.oversized)
+    {
+      // Canvases and full screen surfaces would fill most of the grid, test them separately.
+      m_oversized.push_back(index);
+      return;
+    }
+
+    for (int y = entry.cellRange.y; y <= entry.cellRange.w; y++)
+    {
+      for (int x = entry.cellRange.x; x <= entry.cellRange.z; x++)
+      {
+        m_cells[CellKey(x, y)].push_back(index);
+      }
+    }
+  }
+
+  void SurfaceHitGrid::Remove(int index)
+  {
+    if (index >= (int) m_entries.size() || !m_entries[index].inserted)
+    {
+      return;
+    }
+
+    auto eraseFn = [index](IntArray& arr) -> void
+    {
+      auto it = std::find(arr.begin(), arr.end(), index);
+      if (it != arr.end())
+      {
+        *it = arr.back();
+        arr.pop_back();
+      }
+    };
+
+    Entry& entry = m_entries[index];
+    if (entry.oversized)
+    {
+      eraseFn(m_oversized);
+    }
+    else
+    {
+      for (int y = entry.cellRange.y; y <= entry.cellRange.w; y++)
+      {
+        for (int x = entry.cellRange.x; x <= entry.cellRange.z; x++)
+        {
+          auto cell = m_cells.find(CellKey(x, y));
+          if (cell != m_cells.end())
+          {
+            eraseFn(cell->second);
+            if (cell->second.empty())
+            {
+              m_cells.erase(cell);
+            }
+          }
+        }
+      }
+    }
+
+    entry.inserted = false;
+  }
+
+  void SurfaceHitGrid::Query(const Vec2& point, IntArray& candidates) const
+  {
+    candidates = m_oversized;
+
+    int x      = CellCoordinate(point.x);
+    int y      = CellCoordinate(point.y);
+
+    auto cell  = m_cells.find(CellKey(x, y));
+    if (cell != m_cells.end())
+    {
+      candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+  }
+
+  // UILayer
+  //////////////////////////////////////////
+
   UILayer::UILayer() { m_id = GetHandleManager()->GenerateHandle(); }
 
   UILayer::UILayer(const String& file) : UILayer() { m_scene = GetSceneManager()->Create<Scene>(file); }
@@ -67,38 +196,130 @@ namespace ToolKit
     }
   }
 
-  bool UIManager::CheckMouseClick(Surface* surface, Event* e, Viewport* vp)
+  void UILayer::UpdateHitTestCaches()
   {
-    if (CheckMouseOver(surface, e, vp))
+    if (m_scene == nullptr)
     {
-      if (e->m_type == Event::EventType::Mouse)
+      m_surfaces.clear();
+      m_dpads.clear();
+      m_hoveredSurfaces.clear();
+      m_hitGrid.Clear();
+      m_cachedScene = nullptr;
+      return;
+    }
+
+    uint64 revision = m_scene->GetEntityListRevision();
+    if (m_cachedScene != m_scene.get() || m_cachedEntityRevision != revision)
+    {
+      m_cachedScene          = m_scene.get();
+      m_cachedEntityRevision = revision;
+
+      m_surfaces.clear();
+      m_dpads.clear();
+      m_hoveredSurfaces.clear();
+      m_hitGrid.Clear();
+
+      for (const EntityPtr& ntt : m_scene->GetEntities())
       {
-        MouseEvent* me = static_cast<MouseEvent*>(e);
-        return me->m_action == EventAction::LeftClick;
+        if (ntt->IsA<Surface>())
+        {
+          Surface* surface                   = ntt->As<Surface>();
+          surface->m_hitTestCacheInvalidated = true;
+
+          int index                          = (int) m_surfaces.size();
+          m_surfaces.push_back(Cast<Surface>(ntt));
+
+          if (ntt->IsA<Dpad>())
+          {
+            m_dpads.push_back(index);
+          }
+
+          if (surface->m_mouseOver)
+          {
+            m_hoveredSurfaces.push_back(index);
+          }
+        }
       }
-      else if (e->m_type == Event::EventType::Touch)
+    }
+
+    // Re bucket the surfaces that are moved, resized or re anchored.
+    for (int i = 0; i < (int) m_surfaces.size(); i++)
+    {
+      Surface* surface = m_surfaces[i].get();
+      if (surface->m_hitTestCacheInvalidated)
       {
-        TouchEvent* te = static_cast<TouchEvent*>(e);
-        return te->m_action == EventAction::Touch;
+        m_hitGrid.Insert(i, surface->GetBoundingBox(true));
+        surface->m_hitTestCacheInvalidated = false;
       }
     }
-    return false;
   }
 
-  bool UIManager::CheckMouseOver(Surface* surface, Event* e, Viewport* vp)
+  void UILayer::QuerySurfaces(const Ray& ray, IntArray& hits)
   {
-    if (e->m_type == Event::EventType::Mouse || e->m_type == Event::EventType::Touch)
+    hits.clear();
+
+    // Ui camera is orthographic and looks along -z, the ray can only hit the surfaces that covers its origin.
+    m_hitGrid.Query(Vec2(ray.position), m_candidates);
 
+    int prevIndex = -1;
+    for (int index : m_candidates)
     {
-      const BoundingBox& box = surface->GetBoundingBox(true);
-      Ray ray                = vp->RayFromMousePosition(); // Game viewport sets the mouse location at its update.
+      // Skip duplicates, a surface appears in a single cell or in the oversized list.
+      if (index == prevIndex)
+      {
+        continue;
+      }
+      prevIndex = index;
 
-      float t                = 0.0f;
-      if (RayBoxIntersection(ray, box, t))
+      float t   = 0.0f;
+      if (RayBoxIntersection(ray, m_surfaces[index]->GetBoundingBox(true), t))
+      {
+        hits.push_back(index);
+      }
+    }
+  }
+
+  SurfacePtr UILayer::PickSurface(const Ray& ray)
+  {
+    IntArray hits;
+    QuerySurfaces(ray, hits);
+
+    SurfacePtr topMost = nullptr;
+    float topDepth     = -TK_FLT_MAX;
+    for (int index : hits)
+    {
+      float depth = m_surfaces[index]->GetBoundingBox(true).max.z;
+      if (depth >= topDepth)
       {
-        return true;
+        topDepth = depth;
+        topMost  = m_surfaces[index];
       }
     }
+
+    return topMost;
+  }
+
+  // UIManager
+  //////////////////////////////////////////
+
+  bool UIManager::IsPointerEvent(Event* e)
+  {
+    return e->m_type == Event::EventType::Mouse || e->m_type == Event::EventType::Touch;
+  }
+
+  bool UIManager::IsClickEvent(Event* e)
+  {
+    if (e->m_type == Event::EventType::Mouse)
+    {
+      MouseEvent* me = static_cast<MouseEvent*>(e);
+      return me->m_action == EventAction::LeftClick;
+    }
+    else if (e->m_type == Event::EventType::Touch)
+    {
+      TouchEvent* te = static_cast<TouchEvent*>(e);
+      return te->m_action == EventAction::Touch;
+    }
+
     return false;
   }
 
@@ -134,33 +355,61 @@ namespace ToolKit
       }
     }
 
-    const EntityPtrArray& entities = layer->m_scene->GetEntities();
-    for (EntityPtr ntt : entities)
+    layer->UpdateHitTestCaches();
+
+    // Callbacks may alter the layer, work on a copy to keep surfaces alive.
+    SurfacePtrArray surfaces = layer->m_surfaces;
+    if (surfaces.empty())
     {
-      // Process events.
-      for (Event* e : events)
+      return;
+    }
+
+    // Game viewport sets the mouse location at its update.
+    Ray ray = vp->RayFromMousePosition();
+
+    for (Event* e : events)
+    {
+      m_hits.clear();
+      if (IsPointerEvent(e))
       {
-        if (!ntt->IsA<Surface>())
-        {
-          continue;
-        }
-        Surface* surface        = ntt->As<Surface>();
+        layer->QuerySurfaces(ray, m_hits);
+      }
+
+      // Only hit surfaces, surfaces that may exit and dpads can change state with this event.
+      m_processList = m_hits;
+      m_processList.insert(m_processList.end(), layer->m_hoveredSurfaces.begin(), layer->m_hoveredSurfaces.end());
+      m_processList.insert(m_processList.end(), layer->m_dpads.begin(), layer->m_dpads.end());
+
+      // Preserve the scene order for callbacks.
+      std::sort(m_processList.begin(), m_processList.end());
+      m_processList.erase(std::unique(m_processList.begin(), m_processList.end()), m_processList.end());
+
+      layer->m_hoveredSurfaces.clear();
+
+      for (int index : m_processList)
+      {
+        SurfacePtr surface      = surfaces[index];
         bool mouseOverPrev      = surface->m_mouseOver;
 
-        surface->m_mouseOver    = CheckMouseOver(surface, e, vp.get());
-        surface->m_mouseClicked = CheckMouseClick(surface, e, vp.get());
+        surface->m_mouseOver    = std::binary_search(m_hits.begin(), m_hits.end(), index);
+        surface->m_mouseClicked = surface->m_mouseOver && IsClickEvent(e);
+
+        if (surface->m_mouseOver)
+        {
+          layer->m_hoveredSurfaces.push_back(index);
+        }
 
-        if (ntt->IsA<Button>())
+        if (surface->IsA<Button>())
         {
-          Button* button        = ntt->As<Button>();
+          Button* button        = surface->As<Button>();
           MaterialPtr hoverMat  = button->GetHoverMaterialVal();
           MaterialPtr normalMat = button->GetButtonMaterialVal();
 
           button->SetMaterialVal(surface->m_mouseOver && hoverMat ? hoverMat : normalMat);
         }
-        else if (ntt->IsA<Dpad>())
+        else if (surface->IsA<Dpad>())
         {
-          Dpad* dpad = ntt->As<Dpad>();
+          Dpad* dpad = surface->As<Dpad>();
           if (m_mouseReleased)
           {
             dpad->Stop();
@@ -175,22 +424,22 @@ namespace ToolKit
 
         if (surface->m_mouseOver && surface->m_onMouseOver)
         {
-          surface->m_onMouseOver(e, ntt);
+          surface->m_onMouseOver(e, surface);
         }
 
         if (surface->m_mouseClicked && surface->m_onMouseClick)
         {
-          surface->m_onMouseClick(e, ntt);
+          surface->m_onMouseClick(e, surface);
         }
 
         if (!mouseOverPrev && surface->m_mouseOver && surface->m_onMouseEnter)
         {
-          surface->m_onMouseEnter(e, ntt);
+          surface->m_onMouseEnter(e, surface);
         }
 
         if (mouseOverPrev && !surface->m_mouseOver && surface->m_onMouseExit)
         {
-          surface->m_onMouseExit(e, ntt);
+          surface->m_onMouseExit(e, surface);
         }
       }
     }
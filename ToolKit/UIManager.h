@@ -19,6 +19,55 @@ namespace ToolKit
   typedef std::vector<UILayerPtr> UILayerPtrArray;
   typedef std::vector<class UILayer*> UILayerRawPtrArray;
 
+  /**
+   * Uniform grid over the canvas space that buckets surface indices by their world space bounding boxes.
+   * Used to find the surfaces under a point without testing every surface in a layer.
+   */
+  class TK_API SurfaceHitGrid
+  {
+   public:
+    /** Removes all entries from the grid. */
+    void Clear();
+
+    /**
+     * Inserts the entry to all the cells that its box overlaps. If the entry is already in the grid, it gets moved.
+     * @param index is the entry index, which is the surface index in the layer's surface cache.
+     * @param box is the world space bounding box of the surface.
+     */
+    void Insert(int index, const BoundingBox& box);
+
+    /** Removes the entry from the grid if it exists. */
+    void Remove(int index);
+
+    /**
+     * Collects the entries whose cells covers the given point. Candidates are not tested against their boxes,
+     * so result may contain entries that does not contain the point. Result is sorted and unique.
+     */
+    void Query(const Vec2& point, IntArray& candidates) const;
+
+   public:
+    float m_cellSize     = 128.0f; //!< Edge length of a square cell in canvas units.
+    int m_maxCellPerItem = 64;     //!< Items covering more cells than this are kept in a list that always gets tested.
+
+   private:
+    struct Entry
+    {
+      IVec4 cellRange = IVec4(0); //!< Covered cells in min x, min y, max x, max y order.
+      bool inserted   = false;
+      bool oversized  = false;
+    };
+
+    int64 CellKey(int x, int y) const;
+
+    /** @return Cell index along an axis for the coordinate, clamped to a range that is safe to convert to int. */
+    int CellCoordinate(float value) const;
+
+   private:
+    std::unordered_map<int64, IntArray> m_cells;
+    std::vector<Entry> m_entries;
+    IntArray m_oversized;
+  };
+
   class TK_API UILayer
   {
    public:
@@ -66,10 +115,40 @@ namespace ToolKit
      */
     void ResizeUI(const Vec2& size);
 
+    /**
+     * Rebuilds the cached surface list if the scene's entity list has changed and re inserts the surfaces whose
+     * bounds have changed to the hit test grid. Called by the UIManager before processing events.
+     */
+    void UpdateHitTestCaches();
+
+    /**
+     * Finds all surfaces that the ray hits.
+     * @param ray is the ray in ui camera's world space.
+     * @param hits is the return array, filled with indices to m_surfaces in ascending order.
+     */
+    void QuerySurfaces(const Ray& ray, IntArray& hits);
+
+    /**
+     * Finds the top most surface that the ray hits. Surfaces closer to the ui camera are on top, for equal depths
+     * the one that comes later in the layer is on top. Uses the caches from the last UpdateHitTestCaches call.
+     * @return The top most surface under the ray or nullptr.
+     */
+    SurfacePtr PickSurface(const Ray& ray);
+
    public:
     ScenePtr m_scene = nullptr; //!< Scene that contains ui objects.
     ObjectId m_id;              //!< Unique layer id trough the runtime.
     Vec2 m_size;                //!< Size of the root Canvases.
+
+    SurfacePtrArray m_surfaces; //!< Cached surfaces of the layer, in scene order.
+    IntArray m_dpads;           //!< Indices of Dpads in m_surfaces which need to be updated for every event.
+    IntArray m_hoveredSurfaces; //!< Indices of surfaces that the mouse was over after the last event.
+
+   private:
+    SurfaceHitGrid m_hitGrid;
+    Scene* m_cachedScene          = nullptr;
+    uint64 m_cachedEntityRevision = 0;
+    IntArray m_candidates;
   };
 
   class TK_API UIManager
@@ -181,24 +260,11 @@ namespace ToolKit
      */
     void UpdateSurfaces(ViewportPtr vp, const UILayerPtr layer);
 
-    /**
-     * Checks if there is a mouse click event on the given surface in given
-     * viewport.
-     * @param surface is the Surface to check actions with.
-     * @param e is the MouseEvent.
-     * @param vp is the Viewport that the layout belongs to.
-     * @return true if mouse is clicked on the surface.
-     */
-    bool CheckMouseClick(Surface* surface, Event* e, Viewport* vp);
+    /** Returns true if the event is a mouse or touch event which can hover surfaces. */
+    bool IsPointerEvent(Event* e);
 
-    /**
-     * Checks if there is a mouse is over the surface.
-     * @param surface is the Surface to check actions with.
-     * @param e is the MouseEvent.
-     * @param vp is the Viewport that the layout belongs to.
-     * @return true if mouse is over the surface.
-     */
-    bool CheckMouseOver(Surface* surface, Event* e, Viewport* vp);
+    /** Returns true if the event is a left click or touch. */
+    bool IsClickEvent(Event* e);
 
    public:
     /**
@@ -215,6 +281,9 @@ namespace ToolKit
     CameraPtr m_uiCamera = nullptr;
     bool m_mouseReleased = true;
 
+    IntArray m_hits;        //!< Surfaces hit by the current event. Kept to avoid per event allocations.
+    IntArray m_processList; //!< Surfaces whose states are updated for the current event.
+
     ViewportPtrArray m_viewportsToUpdateLayers; //!< UIManager only updates the layers in these viewports.
   };
 
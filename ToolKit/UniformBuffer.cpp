@@ -21,7 +21,7 @@ namespace ToolKit
     m_slot = -1;
   }
 
-  UniformBuffer::~UniformBuffer() { glDeleteBuffers(1, &m_id); }
+  UniformBuffer::~UniformBuffer() { RHI::DeleteBuffer(m_id); }
 
   void UniformBuffer::Init(uint64 size)
   {
@@ -60,4 +60,33 @@ namespace ToolKit
     glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
   }
 
+  void UniformBuffer::MapRange(const void* data, uint64 offset, uint64 size)
+  {
+    // Sanitize buffer.
+    if (m_id == NullHandle || m_slot == InvalidHandle)
+    {
+      TK_ERR("Uniform buffer is not initialized properly.");
+      return;
+    }
+
+    if (offset + size > m_size)
+    {
+      TK_ERR("Uniform buffer range is out of bounds.");
+      return;
+    }
+
+    if (size == 0)
+    {
+      return;
+    }
+
+    if (TKStats* tkStats = GetTKStats())
+    {
+      tkStats->m_uboUpdatesPerFrame++;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+  }
+
 } // namespace ToolKit
\ No newline at end of file
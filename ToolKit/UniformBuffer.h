@@ -32,6 +32,14 @@ namespace ToolKit
      */
     void Map(const void* data, uint64 size);
 
+    /**
+     * Maps the cpu data to a portion of the gpu buffer.
+     * @param data is the data to copy starting from the offset.
+     * @param offset is the byte offset in the buffer that the data will be copied to.
+     * @param size is the size of the data in bytes.
+     */
+    void MapRange(const void* data, uint64 offset, uint64 size);
+
    public:
     /** Slot corresponds the buffer's binding location. */
     int m_slot;
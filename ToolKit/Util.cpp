@@ -10,6 +10,7 @@
 #include "Audio.h"
 #include "Common/utf8.h"
 #include "FileManager.h"
+#include "MappedFile.h"
 #include "Material.h"
 #include "MathUtil.h"
 #include "Mesh.h"
@@ -1051,9 +1052,59 @@ namespace ToolKit
     RecursiveCopyDirectoryWithSet(source, destination, ignoredSet);
   }
 
-  void* TKMalloc(size_t sz) { return malloc(sz); }
+  // Size and tag of the allocation are kept in front of the block, which preserves the alignment of malloc.
+  static constexpr size_t TKMallocHeaderSize = 16;
 
-  void TKFree(void* m) { free(m); }
+  void* TKMalloc(size_t sz, MemoryTag tag)
+  {
+    uint8* block = (uint8*) malloc(sz + TKMallocHeaderSize);
+    if (block == nullptr)
+    {
+      return nullptr;
+    }
+
+    *(uint64*) block = (uint64) sz;
+    block[8]         = (uint8) tag;
+    MemoryTracker::OnAllocate(tag, sz);
+
+    return block + TKMallocHeaderSize;
+  }
+
+  void* TKRealloc(void* m, size_t sz, MemoryTag tag)
+  {
+    if (m == nullptr)
+    {
+      return TKMalloc(sz, tag);
+    }
+
+    uint8* block     = (uint8*) m - TKMallocHeaderSize;
+    uint64 oldSize   = *(uint64*) block;
+    MemoryTag oldTag = (MemoryTag) block[8];
+
+    block            = (uint8*) realloc(block, sz + TKMallocHeaderSize);
+    if (block == nullptr)
+    {
+      return nullptr;
+    }
+
+    *(uint64*) block = (uint64) sz;
+    MemoryTracker::OnFree(oldTag, oldSize);
+    MemoryTracker::OnAllocate(oldTag, sz);
+
+    return block + TKMallocHeaderSize;
+  }
+
+  void TKFree(void* m)
+  {
+    if (m == nullptr)
+    {
+      return;
+    }
+
+    uint8* block = (uint8*) m - TKMallocHeaderSize;
+    MemoryTracker::OnFree((MemoryTag) block[8], *(uint64*) block);
+    free(block);
+  }
 
   int IndexOf(EntityPtr ntt, const EntityPtrArray& entities)
   {
@@ -1100,6 +1151,31 @@ namespace ToolKit
     return x ^ (x >> 31ULL);
   }
 
+  uint64 FileContentHash(const String& file)
+  {
+    uint64 hash = 41;
+
+    MappedFile mapped;
+    if (!mapped.Open(file))
+    {
+      return hash;
+    }
+
+    // Hashed in chunks, length of a chunk must fit in to an int.
+    const uint64 chunkSize = 1 << 20;
+    const uint8* data      = mapped.Data();
+    uint64 remaining       = mapped.Size();
+    while (remaining > 0)
+    {
+      uint64 size = glm::min(remaining, chunkSize);
+      hash        = MurmurHash64A(data, (int) size, hash);
+      data       += size;
+      remaining  -= size;
+    }
+
+    return hash;
+  }
+
   void Xoroshiro128PlusSeed(uint64 s[2], uint64 seed)
   {
     s[0]  = MurmurHash(seed);
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "GeometryTypes.h"
+#include "MemoryTracker.h"
 #include "Types.h"
 
 namespace ToolKit
@@ -205,8 +206,11 @@ namespace ToolKit
   // Memory operations.
   //////////////////////////////////////////
 
-  // Useful to force plugin modules to allocate from main toolkit module.
-  TK_API void* TKMalloc(size_t sz);
+  // Useful to force plugin modules to allocate from main toolkit module. Allocations are accounted for the tag, see
+  // MemoryTracker.
+  TK_API void* TKMalloc(size_t sz, MemoryTag tag = MemoryTag::General);
+  // Resizes a block allocated with TKMalloc, the block keeps its tag. Allocates for the tag if the block is null.
+  TK_API void* TKRealloc(void* m, size_t sz, MemoryTag tag = MemoryTag::General);
   //  Use in combination with TKMalloc to free from main toolkit module.
   TK_API void TKFree(void* m);
 
@@ -342,6 +346,9 @@ namespace ToolKit
 
   TK_API uint64 MurmurHash(uint64 x);
 
+  /** @return Hash of the content of the file. Files that can't be read have the same hash with empty files. */
+  TK_API uint64 FileContentHash(const String& file);
+
   TK_API void Xoroshiro128PlusSeed(uint64 s[2], uint64 seed);
 
   TK_API uint64 Xoroshiro128Plus(uint64 s[2]);